@@ -0,0 +1,181 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_VALUE_CONVERSION_H
+#define NIX_VALUE_CONVERSION_H
+
+#include <nix/DataType.hpp>
+#include <nix/Exception.hpp>
+#include <nix/NDSize.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace nix {
+
+/**
+ * Type conversion and selection of values stored in row-major order in
+ * a plain buffer, shared by the back-ends that keep their values this
+ * way, i.e. the memory and the file system back-end.
+ */
+namespace conversion {
+
+/**
+ * Size of one stored element of type dtype.
+ */
+inline size_t element_size(DataType dtype) {
+    switch (dtype) {
+        case DataType::Char:
+        case DataType::Opaque:
+            return 1;
+        case DataType::String:
+            return sizeof(std::string);
+        default:
+            return data_type_to_size(dtype);
+    }
+}
+
+
+template<typename S, typename D>
+void convert_to(const S *src, D *dst, ndsize_t n) {
+    for (ndsize_t i = 0; i < n; i++) {
+        dst[i] = static_cast<D>(src[i]);
+    }
+}
+
+
+template<typename S>
+void convert_from(const S *src, DataType dtype, void *dst, ndsize_t n) {
+    switch (dtype) {
+        case DataType::Bool:   convert_to(src, static_cast<bool *>(dst), n); break;
+        case DataType::Char:   convert_to(src, static_cast<char *>(dst), n); break;
+        case DataType::Float:  convert_to(src, static_cast<float *>(dst), n); break;
+        case DataType::Double: convert_to(src, static_cast<double *>(dst), n); break;
+        case DataType::Int8:   convert_to(src, static_cast<int8_t *>(dst), n); break;
+        case DataType::Int16:  convert_to(src, static_cast<int16_t *>(dst), n); break;
+        case DataType::Int32:  convert_to(src, static_cast<int32_t *>(dst), n); break;
+        case DataType::Int64:  convert_to(src, static_cast<int64_t *>(dst), n); break;
+        case DataType::UInt8:  convert_to(src, static_cast<uint8_t *>(dst), n); break;
+        case DataType::UInt16: convert_to(src, static_cast<uint16_t *>(dst), n); break;
+        case DataType::UInt32: convert_to(src, static_cast<uint32_t *>(dst), n); break;
+        case DataType::UInt64: convert_to(src, static_cast<uint64_t *>(dst), n); break;
+        default:
+            throw std::invalid_argument("DataArray: cannot convert data to " + data_type_to_string(dtype));
+    }
+}
+
+
+/**
+ * Convert n elements of type stype into elements of type dtype.
+ */
+inline void convert(DataType stype, const void *src, DataType dtype, void *dst, ndsize_t n) {
+    if (stype == dtype) {
+        std::memcpy(dst, src, n * element_size(dtype));
+        return;
+    }
+
+    switch (stype) {
+        case DataType::Bool:   convert_from(static_cast<const bool *>(src), dtype, dst, n); break;
+        case DataType::Char:   convert_from(static_cast<const char *>(src), dtype, dst, n); break;
+        case DataType::Float:  convert_from(static_cast<const float *>(src), dtype, dst, n); break;
+        case DataType::Double: convert_from(static_cast<const double *>(src), dtype, dst, n); break;
+        case DataType::Int8:   convert_from(static_cast<const int8_t *>(src), dtype, dst, n); break;
+        case DataType::Int16:  convert_from(static_cast<const int16_t *>(src), dtype, dst, n); break;
+        case DataType::Int32:  convert_from(static_cast<const int32_t *>(src), dtype, dst, n); break;
+        case DataType::Int64:  convert_from(static_cast<const int64_t *>(src), dtype, dst, n); break;
+        case DataType::UInt8:  convert_from(static_cast<const uint8_t *>(src), dtype, dst, n); break;
+        case DataType::UInt16: convert_from(static_cast<const uint16_t *>(src), dtype, dst, n); break;
+        case DataType::UInt32: convert_from(static_cast<const uint32_t *>(src), dtype, dst, n); break;
+        case DataType::UInt64: convert_from(static_cast<const uint64_t *>(src), dtype, dst, n); break;
+        default:
+            throw std::invalid_argument("DataArray: cannot convert data of type " + data_type_to_string(stype));
+    }
+}
+
+
+/**
+ * Call fn(pos, flat, n) for every contiguous run of elements of the selection,
+ * pos is the position of the run in the selection, flat its position in the
+ * stored data and n its length. Trailing dimensions that are selected completely
+ * are merged into a single run.
+ */
+template<typename F>
+void for_each_run(const NDSize &extent, const NDSize &count, const NDSize &offset, F fn) {
+    const size_t rank = extent.size();
+    const ndsize_t total = count.nelms();
+    if (rank == 0 || total == 0) {
+        return;
+    }
+
+    size_t k = rank - 1;
+    ndsize_t run = count[k];
+    while (k > 0 && count[k] == extent[k]) {
+        k--;
+        run *= count[k];
+    }
+
+    NDSize stride(rank, 1);
+    for (size_t i = rank - 1; i > 0; i--) {
+        stride[i - 1] = stride[i] * extent[i];
+    }
+
+    NDSize index(rank, 0);
+    for (ndsize_t pos = 0; pos < total; pos += run) {
+        ndsize_t flat = offset[k] * stride[k];
+        for (size_t i = 0; i < k; i++) {
+            flat += (offset[i] + index[i]) * stride[i];
+        }
+        fn(pos, flat, run);
+
+        for (size_t i = k; i > 0; i--) {
+            if (++index[i - 1] < count[i - 1]) {
+                break;
+            }
+            index[i - 1] = 0;
+        }
+    }
+}
+
+
+/**
+ * Check the selection and turn it into count and offset of the same rank as the data;
+ * an empty offset selects all data, an empty count a single element.
+ */
+inline void resolve_selection(const NDSize &extent, const NDSize &count, const NDSize &offset,
+                              NDSize &sel_count, NDSize &sel_offset, const char *where) {
+    if (!offset) {
+        if (count.nelms() != extent.nelms()) {
+            throw IncompatibleDimensions("Size of the data and the DataArray do not match", where);
+        }
+        sel_count = extent;
+        sel_offset = NDSize(extent.size(), 0);
+        return;
+    }
+
+    sel_offset = offset;
+    sel_count = count ? count : NDSize(offset.size(), 1);
+    if (sel_count.size() != offset.size() && sel_count.nelms() == 1) {
+        // a single element, e.g. a scalar, can be given with any rank
+        sel_count = NDSize(offset.size(), 1);
+    }
+    if (sel_offset.size() != extent.size() || sel_count.size() != extent.size()) {
+        throw IncompatibleDimensions("Rank of the selection and the data do not match", where);
+    }
+    for (size_t i = 0; i < extent.size(); i++) {
+        if (sel_offset[i] + sel_count[i] > extent[i]) {
+            throw OutOfBounds(std::string(where) + ": selection lies outside of the data extent", sel_offset[i]);
+        }
+    }
+}
+
+} // namespace conversion
+} // namespace nix
+
+#endif // NIX_VALUE_CONVERSION_H
@@ -13,6 +13,8 @@
 #include "BlockFS.hpp"
 #include "FeatureFS.hpp"
 
+#include <set>
+
 namespace bfs= boost::filesystem;
 
 namespace nix {
@@ -104,48 +106,60 @@ void BaseTagFS::addReference(const std::string &name_or_id) {
 }
 
 
+void BaseTagFS::addReferences(const std::vector<DataArray> &refs) {
+    // validate all arrays before the first link is created
+    std::vector<std::shared_ptr<DataArrayFS>> targets;
+    for (const DataArray &ref : refs) {
+        auto handle = std::dynamic_pointer_cast<DataArrayFS>(ref.impl());
+        if (!handle)
+            throw std::runtime_error("BaseTagFS::addReferences: DataArray is not stored in a file system file!");
+
+        // link the array of this block, the handle may belong to another
+        // block or file with an array of the same name
+        auto target = std::dynamic_pointer_cast<DataArrayFS>(block()->getDataArray(handle->name()));
+        if (!target || target->id() != handle->id())
+            throw std::runtime_error("BaseTagFS::addReferences: DataArray not found in block!");
+        targets.push_back(target);
+    }
+
+    for (const auto &target : targets) {
+        if (!refs_group.hasObject(target->id())) {
+            refs_group.createDirectoryLink(target->location(), target->id());
+        }
+    }
+}
+
+
 bool BaseTagFS::removeReference(const std::string &name_or_id) {
     return refs_group.removeObjectByNameOrAttribute("name", name_or_id);
 }
 
 
 void BaseTagFS::references(const std::vector<DataArray> &refs_new) {
-    // extract vectors of names from vectors of new & old references
-    std::vector<std::string> names_new(refs_new.size());
-    transform(refs_new.begin(), refs_new.end(), names_new.begin(), util::toName<DataArray>);
-
-    size_t count = nix::check::fits_in_size_t(referenceCount(), "referenceCount() failed! count > than size_t!");
-    std::vector<DataArray> refs_old(count);
-    for (size_t i = 0; i < refs_old.size(); i++){
-        refs_old[i] = getReference(i);
+    // the ids of the current references are the names of the links
+    std::set<std::string> ids_old;
+    for (ndsize_t i = 0; i < referenceCount(); i++) {
+        ids_old.insert(refs_group.sub_dir_by_index(i).filename().string());
     }
 
-    std::vector<std::string> names_old(refs_old.size());
-    std::transform(refs_old.begin(), refs_old.end(), names_old.begin(), util::toName<DataArray>);
-
-    // sort them
-    std::sort(names_new.begin(), names_new.end());
-    std::sort(names_new.begin(), names_new.end());
-
-    // get names only in names_new (add), names only in names_old (remove) & ignore rest
-    std::vector<std::string> names_add;
-    std::vector<std::string> names_rem;
-    std::set_difference(names_new.begin(), names_new.end(), names_old.begin(), names_old.end(),
-                        std::inserter(names_add, names_add.begin()));
-    std::set_difference(names_old.begin(), names_old.end(), names_new.begin(), names_new.end(),
-                        std::inserter(names_rem, names_rem.begin()));
-
-    // check if all new references exist & add sources
-    auto blck = std::dynamic_pointer_cast<BlockFS>(block());
-    for (auto name : names_add) {
-        if (!blck->hasDataArray(name))
-            throw std::runtime_error("One or more data arrays do not exist in this block!");
-        addReference(blck->getDataArray(name)->id());
+    std::set<std::string> ids_new;
+    std::vector<DataArray> refs_add;
+    for (const DataArray &ref : refs_new) {
+        std::string id = ref.id();
+        if (ids_old.count(id) == 0 && ids_new.count(id) == 0) {
+            refs_add.push_back(ref);
+        }
+        ids_new.insert(id);
     }
+
+    // check if all new references exist & add them
+    addReferences(refs_add);
+
     // remove references
-    for (auto name : names_rem) {
-        if (!blck->hasDataArray(name))
-            removeReference(blck->getDataArray(name)->id());
+    for (const std::string &id : ids_old) {
+        if (ids_new.count(id) == 0) {
+            removeReference(id);
+        }
     }
 }
 
@@ -67,6 +67,9 @@ public:
     virtual void addReference(const std::string &name_or_id);
 
 
+    virtual void addReferences(const std::vector<DataArray> &references);
+
+
     virtual bool removeReference(const std::string &name_or_id);
 
     // TODO evaluate if DataArray can be replaced by shared_ptr<IDataArray>
@@ -10,11 +10,41 @@
 #include "MultiTagFS.hpp"
 #include "GroupFS.hpp"
 
+#include <nix/BlockBatch.hpp>
+#include <nix/util/util.hpp>
+
 namespace bfs = boost::filesystem;
 
 namespace nix {
 namespace file {
 
+namespace {
+
+void create_dimension(base::IDataArray &da, ndsize_t index, const BlockBatch::DimensionSpec &spec) {
+    switch (spec.type) {
+        case DimensionType::Sample: {
+            auto dim = da.createSampledDimension(index, spec.sampling_interval);
+            if (spec.offset) dim->offset(*spec.offset);
+            if (spec.unit) dim->unit(*spec.unit);
+            if (spec.label) dim->label(*spec.label);
+            break;
+        }
+        case DimensionType::Set: {
+            auto dim = da.createSetDimension(index);
+            if (!spec.labels.empty()) dim->labels(spec.labels);
+            break;
+        }
+        case DimensionType::Range: {
+            auto dim = da.createRangeDimension(index, spec.ticks);
+            if (spec.unit) dim->unit(*spec.unit);
+            if (spec.label) dim->label(*spec.label);
+            break;
+        }
+    }
+}
+
+}
+
 BlockFS::BlockFS(const std::shared_ptr<base::IFile> &file, const std::string &loc)
     : EntityWithMetadataFS(file, loc)
 {
@@ -154,6 +184,16 @@ bool BlockFS::deleteDataArray(const std::string &name_or_id) {
     return data_array_dir.removeObjectByNameOrAttribute("entity_id", name_or_id);
 }
 
+ndsize_t BlockFS::deleteDataArrays(const std::vector<std::string> &names_or_ids) {
+    ndsize_t deleted = 0;
+    for (const std::string &name_or_id : names_or_ids) {
+        if (deleteDataArray(name_or_id)) {
+            deleted++;
+        }
+    }
+    return deleted;
+}
+
 //--------------------------------------------------
 // Methods concerning tags
 //--------------------------------------------------
@@ -306,6 +346,46 @@ bool BlockFS::deleteGroup(const std::string &name_or_id) {
     return group_dir.removeObjectByNameOrAttribute("entity_id", name_or_id);
 }
 
+//--------------------------------------------------
+// Batched creation
+//--------------------------------------------------
+
+void BlockFS::createBatch(const BlockBatch &batch) {
+    time_t now = util::getTime();
+
+    for (size_t i = 0; i < batch.sourceCount(); i++) {
+        const BlockBatch::SourceSpec &spec = batch.source(i);
+        SourceFS source(file(), block(), source_dir.location(), spec.id, spec.type, spec.name, now);
+    }
+
+    for (size_t i = 0; i < batch.dataArrayCount(); i++) {
+        const BlockBatch::DataArraySpec &spec = batch.dataArray(i);
+        DataArrayFS da(file(), block(), data_array_dir.location(), spec.id, spec.type, spec.name, now);
+        da.createData(spec.data_type, spec.shape);
+        if (spec.unit) da.unit(*spec.unit);
+        if (spec.label) da.label(*spec.label);
+        for (size_t d = 0; d < spec.dimensions.size(); d++) {
+            create_dimension(da, d + 1, spec.dimensions[d]);
+        }
+        for (const std::string &id : spec.sources) {
+            da.addSource(id);
+        }
+    }
+
+    for (size_t i = 0; i < batch.tagCount(); i++) {
+        const BlockBatch::TagSpec &spec = batch.tag(i);
+        TagFS tag(file(), block(), tag_dir.location(), spec.id, spec.type, spec.name, spec.position, now);
+        if (!spec.extent.empty()) tag.extent(spec.extent);
+        if (!spec.units.empty()) tag.units(spec.units);
+        for (const std::string &id : spec.references) {
+            tag.addReference(id);
+        }
+        for (const std::string &id : spec.sources) {
+            tag.addSource(id);
+        }
+    }
+}
+
 
 std::shared_ptr<base::IBlock> BlockFS::block() const {
     return std::const_pointer_cast<BlockFS>(shared_from_this());
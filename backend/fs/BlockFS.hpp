@@ -109,6 +109,9 @@ public:
 
     bool deleteDataArray(const std::string &name_or_id);
 
+
+    ndsize_t deleteDataArrays(const std::vector<std::string> &names_or_ids);
+
     //--------------------------------------------------
     // Methods concerning tags.
     //--------------------------------------------------
@@ -174,6 +177,12 @@ public:
 
     bool deleteGroup(const std::string &name_or_id);
 
+    //--------------------------------------------------
+    // Batched creation
+    //--------------------------------------------------
+
+    void createBatch(const BlockBatch &batch);
+
     //--------------------------------------------------
     // Other methods and functions
     //--------------------------------------------------
@@ -11,12 +11,36 @@
 #include "DataArrayFS.hpp"
 #include "hdf5/h5x/H5DataSet.hpp" // FIXME
 #include "DimensionFS.hpp"
+#include "ValueConversion.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
 
 namespace bfs = boost::filesystem;
+using namespace nix::conversion;
 
 namespace nix {
 namespace file {
 
+/*
+ * The values are stored in the file "data" of the array directory, in
+ * row-major order and little-endian byte order; strings are stored as a
+ * 64 bit length followed by the characters. The conversion and selection
+ * helpers are shared with the memory back-end, see ValueConversion.hpp.
+ */
+
+// the stored byte order is little-endian, swap on big-endian hosts
+static void to_file_order(char *data, ndsize_t n, size_t esize) {
+    const uint16_t one = 1;
+    if (esize == 1 || *reinterpret_cast<const uint8_t *>(&one) == 1) {
+        return;
+    }
+    for (ndsize_t i = 0; i < n; i++) {
+        std::reverse(data + i * esize, data + (i + 1) * esize);
+    }
+}
+
 
 DataArrayFS::DataArrayFS(const std::shared_ptr<base::IFile> &file, const std::shared_ptr<base::IBlock> &block,
                          const std::string &loc)
@@ -220,6 +244,19 @@ bool DataArrayFS::deleteDimensions() {
 }
 
 
+std::vector<DimensionDescriptor> DataArrayFS::dimensionDescriptors() const {
+    std::vector<DimensionDescriptor> descriptors;
+    ndsize_t count = dimensionCount();
+    for (ndsize_t i = 1; i <= count; i++) {
+        std::shared_ptr<base::IDimension> dim = getDimension(i);
+        if (dim) {
+            descriptors.emplace_back(*dim);
+        }
+    }
+    return descriptors;
+}
+
+
 //--------------------------------------------------
 // Other methods and functions
 //--------------------------------------------------
@@ -229,65 +266,142 @@ DataArrayFS::~DataArrayFS() {
 }
 
 
+std::string DataArrayFS::dataPath() const {
+    return (bfs::path(location()) / "data").string();
+}
+
+
+std::vector<std::string> DataArrayFS::readStrings() const {
+    std::vector<std::string> values;
+    std::ifstream in(dataPath(), std::ios::binary);
+    uint64_t length;
+    while (in.read(reinterpret_cast<char *>(&length), sizeof(length))) {
+        to_file_order(reinterpret_cast<char *>(&length), 1, sizeof(length));
+        std::string value(check::fits_in_size_t(length, "String does not fit into memory"), '\0');
+        in.read(&value[0], value.size());
+        values.push_back(std::move(value));
+    }
+    return values;
+}
+
+
+void DataArrayFS::writeStrings(const std::vector<std::string> &values) {
+    std::ofstream out(dataPath(), std::ios::binary | std::ios::trunc);
+    for (const std::string &value : values) {
+        uint64_t length = value.size();
+        to_file_order(reinterpret_cast<char *>(&length), 1, sizeof(length));
+        out.write(reinterpret_cast<const char *>(&length), sizeof(length));
+        out.write(value.data(), value.size());
+    }
+    if (!out) {
+        throw std::runtime_error("DataArrayFS: could not write " + dataPath());
+    }
+}
+
+
 void DataArrayFS::createData(DataType dtype, const NDSize &size) {
+    if (hasData()) {
+        throw ConsistencyError("DataArray's data already exists!");
+    }
     setDtype(dtype);
-    dataExtent(size);
-    /*
-    if (group().hasData("data")) {
-        throw new std::runtime_error("DataArray alread exists"); //TODO: FIXME, better exception
+    storeExtent(size);
+    if (dtype == DataType::Nothing) {
+        return;
     }
 
-    group().createData("data", dtype, size); //FIXME: check if this 2-step creation is needed
-    DataSet ds = group().openData("data");
-    */ //FIXME
+    if (dtype == DataType::String) {
+        writeStrings(std::vector<std::string>(size.nelms()));
+    } else {
+        std::ofstream(dataPath(), std::ios::binary | std::ios::trunc);
+        bfs::resize_file(dataPath(), size.nelms() * element_size(dtype));
+    }
 }
 
 bool DataArrayFS::hasData() const {
-    return hasObject("data");
+    return bfs::exists(dataPath());
 }
 
 void DataArrayFS::write(DataType dtype, const void *data, const NDSize &count, const NDSize &offset) {
-    /*
-    DataSet ds;
-
-    if (!group().hasData("data")) {
-        //FIXME: this case should actually never be possible, replace with exception?
-        ds = group().createData("data", dtype, count);
-    } else {
-        ds = group().openData("data");
+    const DataType stored = dataType();
+    const NDSize extent = dataExtent();
+    if (!hasData()) {
+        if (stored == DataType::Nothing) {
+            throw ConsistencyError("DataArray with missing data");
+        }
+        // arrays created before the values were stored
+        createData(stored, extent);
     }
 
-    if (offset.size()) {
-        Selection fileSel = ds.createSelection();
-        fileSel.select(count, offset);
-        Selection memSel(DataSpace::create(count, false));
+    NDSize sel_count, sel_offset;
+    resolve_selection(extent, count, offset, sel_count, sel_offset, "DataArray::write");
+
+    if (dtype == DataType::String || stored == DataType::String) {
+        if (dtype != stored) {
+            throw std::invalid_argument("DataArrayFS::write: strings cannot be converted to other types");
+        }
+        std::vector<std::string> values = readStrings();
+        values.resize(extent.nelms());
+        const std::string *src = static_cast<const std::string *>(data);
+        for_each_run(extent, sel_count, sel_offset, [&](ndsize_t pos, ndsize_t flat, ndsize_t n) {
+            std::copy(src + pos, src + pos + n, values.begin() + flat);
+        });
+        writeStrings(values);
+        return;
+    }
 
-        ds.write(dtype, data, fileSel, memSel);
-    } else {
-        ds.write(dtype, count, data);
+    std::fstream file(dataPath(), std::ios::binary | std::ios::in | std::ios::out);
+    const char *src = static_cast<const char *>(data);
+    const size_t src_size = element_size(dtype), dst_size = element_size(stored);
+    std::vector<char> run;
+    for_each_run(extent, sel_count, sel_offset, [&](ndsize_t pos, ndsize_t flat, ndsize_t n) {
+        run.resize(check::fits_in_size_t(n * dst_size, "Data does not fit into memory"));
+        convert(dtype, src + pos * src_size, stored, run.data(), n);
+        to_file_order(run.data(), n, dst_size);
+        file.seekp(static_cast<std::streamoff>(flat * dst_size));
+        file.write(run.data(), run.size());
+    });
+    if (!file) {
+        throw std::runtime_error("DataArrayFS: could not write " + dataPath());
     }
-    */ // FIXME
 }
 
 void DataArrayFS::read(DataType dtype, void *data, const NDSize &count, const NDSize &offset) const {
-    if (!hasObject("data")) {
+    if (!hasData()) {
         return;
     }
-    /*
-    DataSet ds = group().openData("data");
 
-    if (offset.size()) {
-        Selection fileSel = ds.createSelection();
-        // if count.size() == 0, i.e. we want to read a scalar,
-        // we have to supply something that fileSel can make sense of
-        fileSel.select(count ? count : NDSize(offset.size(), 1), offset);
-        Selection memSel(DataSpace::create(count, false));
+    const DataType stored = dataType();
+    const NDSize extent = dataExtent();
+    NDSize sel_count, sel_offset;
+    resolve_selection(extent, count, offset, sel_count, sel_offset, "DataArray::read");
+
+    if (dtype == DataType::String || stored == DataType::String) {
+        if (dtype != stored) {
+            throw std::invalid_argument("DataArrayFS::read: strings cannot be converted to other types");
+        }
+        std::vector<std::string> values = readStrings();
+        values.resize(extent.nelms());
+        std::string *dst = static_cast<std::string *>(data);
+        for_each_run(extent, sel_count, sel_offset, [&](ndsize_t pos, ndsize_t flat, ndsize_t n) {
+            std::copy(values.begin() + flat, values.begin() + flat + n, dst + pos);
+        });
+        return;
+    }
 
-        ds.read(dtype, data, fileSel, memSel);
-    } else {
-        ds.read(dtype, count, data);
+    std::ifstream file(dataPath(), std::ios::binary);
+    char *dst = static_cast<char *>(data);
+    const size_t src_size = element_size(stored), dst_size = element_size(dtype);
+    std::vector<char> run;
+    for_each_run(extent, sel_count, sel_offset, [&](ndsize_t pos, ndsize_t flat, ndsize_t n) {
+        run.resize(check::fits_in_size_t(n * src_size, "Data does not fit into memory"));
+        file.seekg(static_cast<std::streamoff>(flat * src_size));
+        file.read(run.data(), run.size());
+        to_file_order(run.data(), n, src_size);
+        convert(stored, run.data(), dtype, dst + pos * dst_size, n);
+    });
+    if (!file) {
+        throw std::runtime_error("DataArrayFS: could not read " + dataPath());
     }
-    */
 }
 
 NDSize DataArrayFS::dataExtent(void) const {
@@ -303,7 +417,7 @@ NDSize DataArrayFS::dataExtent(void) const {
     return extent;
 }
 
-void DataArrayFS::dataExtent(const NDSize &extent) {
+void DataArrayFS::storeExtent(const NDSize &extent) {
     std::vector<int> ext;
     for (ndsize_t i = 0; i < extent.size(); i++) {
         ext.push_back(extent[i]);
@@ -314,6 +428,62 @@ void DataArrayFS::dataExtent(const NDSize &extent) {
     setAttr("extent", ext);
 }
 
+void DataArrayFS::dataExtent(const NDSize &new_extent) {
+    const NDSize extent = dataExtent();
+    if (!hasData() || new_extent == extent) {
+        storeExtent(new_extent);
+        return;
+    }
+    if (new_extent.size() != extent.size()) {
+        throw IncompatibleDimensions("Cannot change the rank of the data", "DataArray::dataExtent");
+    }
+
+    const size_t rank = extent.size();
+    bool same_layout = true;
+    for (size_t i = 1; i < rank; i++) {
+        same_layout = same_layout && extent[i] == new_extent[i];
+    }
+
+    const DataType dtype = dataType();
+    if (dtype == DataType::String) {
+        std::vector<std::string> values = readStrings();
+        values.resize(extent.nelms());
+        std::vector<std::string> resized(new_extent.nelms());
+        NDSize overlap(rank), origin(rank, 0);
+        for (size_t i = 0; i < rank; i++) {
+            overlap[i] = std::min(extent[i], new_extent[i]);
+        }
+        std::vector<std::string> tmp(overlap.nelms());
+        read(dtype, tmp.data(), overlap, origin);
+        for_each_run(new_extent, overlap, origin, [&](ndsize_t pos, ndsize_t flat, ndsize_t n) {
+            std::move(tmp.begin() + pos, tmp.begin() + pos + n, resized.begin() + flat);
+        });
+        writeStrings(resized);
+        storeExtent(new_extent);
+        return;
+    }
+
+    // growing or shrinking along the first dimension keeps the layout, the file
+    // is extended with zeros or truncated
+    const size_t es = element_size(dtype);
+    if (same_layout) {
+        bfs::resize_file(dataPath(), new_extent.nelms() * es);
+        storeExtent(new_extent);
+        return;
+    }
+
+    NDSize overlap(rank), origin(rank, 0);
+    for (size_t i = 0; i < rank; i++) {
+        overlap[i] = std::min(extent[i], new_extent[i]);
+    }
+    std::vector<char> tmp(check::fits_in_size_t(overlap.nelms() * es, "Data does not fit into memory"));
+    read(dtype, tmp.data(), overlap, origin);
+    bfs::resize_file(dataPath(), 0);
+    bfs::resize_file(dataPath(), new_extent.nelms() * es);
+    storeExtent(new_extent);
+    write(dtype, tmp.data(), overlap, origin);
+}
+
 DataType DataArrayFS::dataType(void) const {
     if (!hasAttr("dtype")) {
         return DataType::Nothing;
@@ -324,6 +494,52 @@ DataType DataArrayFS::dataType(void) const {
 }
 
 
+boost::optional<MappedData> DataArrayFS::mapData() const {
+    return boost::none;
+}
+
+
+NDSize DataArrayFS::chunkExtent() const {
+    return NDSize{};
+}
+
+
+bool DataArrayFS::concurrentReads() const {
+    return false;
+}
+
+
+void DataArrayFS::writeChunk(const NDSize &chunk, const void *data, size_t nbytes, uint32_t filter_mask) {
+    throw std::runtime_error("DataArrayFS::writeChunk: chunked storage is not supported by the file system backend!");
+}
+
+
+bool DataArrayFS::readChunk(const NDSize &chunk, Buffer<char> &data, uint32_t &filter_mask) const {
+    throw std::runtime_error("DataArrayFS::readChunk: chunked storage is not supported by the file system backend!");
+}
+
+
+NDSize DataArrayFS::derivedExtent(const std::string &name) const {
+    // nothing is derived without a way to tell whether the data changed
+    return NDSize{};
+}
+
+
+void DataArrayFS::readDerived(const std::string &name, double *data, const NDSize &count, const NDSize &offset) const {
+    throw std::runtime_error("DataArrayFS::readDerived: derived data is not supported by the file system backend!");
+}
+
+
+void DataArrayFS::writeDerived(const std::string &name, const NDSize &extent, const double *data,
+                               const NDSize &count, const NDSize &offset) {
+    throw std::runtime_error("DataArrayFS::writeDerived: derived data is not supported by the file system backend!");
+}
+
+
+void DataArrayFS::deleteDerived(const std::string &name) {
+}
+
+
 void DataArrayFS::setDtype(nix::DataType dtype) {
     if (hasAttr("dtype")) {
         removeAttr("dtype");
@@ -34,6 +34,14 @@ private:
     Directory dimensions;
 
     void setDtype(nix::DataType dtype);
+
+    void storeExtent(const NDSize &extent);
+
+    std::string dataPath() const;
+
+    std::vector<std::string> readStrings() const;
+
+    void writeStrings(const std::vector<std::string> &values);
 public:
 
     /**
@@ -118,6 +126,9 @@ public:
 
     bool deleteDimensions();
 
+
+    std::vector<DimensionDescriptor> dimensionDescriptors() const;
+
     //--------------------------------------------------
     // Other methods and functions
     //--------------------------------------------------
@@ -150,6 +161,34 @@ public:
 
     DataType dataType(void) const;
 
+
+    boost::optional<MappedData> mapData() const;
+
+
+    NDSize chunkExtent() const;
+
+
+    bool concurrentReads() const;
+
+
+    void writeChunk(const NDSize &chunk, const void *data, size_t nbytes, uint32_t filter_mask);
+
+
+    bool readChunk(const NDSize &chunk, Buffer<char> &data, uint32_t &filter_mask) const;
+
+
+    NDSize derivedExtent(const std::string &name) const;
+
+
+    void readDerived(const std::string &name, double *data, const NDSize &count, const NDSize &offset) const;
+
+
+    void writeDerived(const std::string &name, const NDSize &extent, const double *data,
+                      const NDSize &count, const NDSize &offset);
+
+
+    void deleteDerived(const std::string &name);
+
 };
 
 
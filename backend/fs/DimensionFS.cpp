@@ -287,6 +287,17 @@ void SetDimensionFS::labels(const none_t t) {
     }
 }
 
+ndsize_t SetDimensionFS::labelCount() const {
+    return labels().size();
+}
+
+
+std::vector<ndsize_t> SetDimensionFS::indicesOf(const std::vector<std::string> &labels) const {
+    // the labels are stored as one attribute, there is no cheaper way than reading them
+    return DimensionDescriptor(*this).indicesOf(labels);
+}
+
+
 SetDimensionFS::~SetDimensionFS() {}
 
 //--------------------------------------------------------------
@@ -135,6 +135,12 @@ public:
     void labels(const none_t t);
 
 
+    ndsize_t labelCount() const;
+
+
+    std::vector<ndsize_t> indicesOf(const std::vector<std::string> &labels) const;
+
+
     virtual ~SetDimensionFS();
 
 };
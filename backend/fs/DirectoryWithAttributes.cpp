@@ -25,7 +25,7 @@ DirectoryWithAttributes::DirectoryWithAttributes(const bfs::path &location, File
             std::vector<int> version;
             std::string str;
             if (a.has("format"))  {
-                getAttr("format", str);
+                a.get("format", str);
                 if (str != FILE_FORMAT) {
                     check = false;
                 }
@@ -33,7 +33,7 @@ DirectoryWithAttributes::DirectoryWithAttributes(const bfs::path &location, File
                 check = false;
             }
             if (a.has("version")) {
-                getAttr("version", version);
+                a.get("version", version);
                 if (version != FILE_VERSION) {
                     check = false;
                 }
@@ -0,0 +1,55 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_ENTITY_COPY_FS_H
+#define NIX_ENTITY_COPY_FS_H
+
+#include <nix/base/IFile.hpp>
+#include <nix/base/IBlock.hpp>
+#include <nix/base/IDataArray.hpp>
+#include "FileFS.hpp"
+#include "DataArrayFS.hpp"
+
+#include <functional>
+#include <memory>
+
+namespace nix {
+namespace file {
+
+/**
+ * Copies the data of a source array into a new array, which has no
+ * data yet.
+ */
+typedef std::function<void(const std::shared_ptr<base::IDataArray> &src,
+                           const std::shared_ptr<DataArrayFS> &dst)> DataCopy;
+
+/**
+ * Create the data of dst with the type and extent of src and write all
+ * values at once.
+ */
+void copyData(const std::shared_ptr<base::IDataArray> &src, const std::shared_ptr<DataArrayFS> &dst);
+
+/**
+ * Create a copy of a block and all of its entities in a file system
+ * file, with the ids and creation times of the source entities. The
+ * sections the entities refer to must already exist in the file.
+ *
+ * @param file      The file to write to.
+ * @param src       The block to copy, of any back-end.
+ * @param copy_data Called for every data array once its attributes and
+ *                  dimensions are written. Neither array is used by
+ *                  copyBlock afterwards, so the data can be copied on
+ *                  another thread while the block is being copied.
+ */
+void copyBlock(const std::shared_ptr<FileFS> &file, const std::shared_ptr<base::IBlock> &src,
+               const DataCopy &copy_data = copyData);
+
+} // namespace file
+} // namespace nix
+
+#endif // NIX_ENTITY_COPY_FS_H
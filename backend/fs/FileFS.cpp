@@ -9,6 +9,7 @@
 #include "FileFS.hpp"
 #include "BlockFS.hpp"
 #include "SectionFS.hpp"
+#include "PropertyFS.hpp"
 
 namespace bfs = boost::filesystem;
 
@@ -142,6 +143,199 @@ bool FileFS::deleteSection(const std::string &name_or_id) {
     return metadata_dir.removeObjectByNameOrAttribute("entity_id", name_or_id);
 }
 
+//--------------------------------------------------
+// Metadata snapshots
+//--------------------------------------------------
+
+static void snapshot_sections(const std::shared_ptr<base::ISection> &section, size_t parent,
+                              MetadataSnapshot &snapshot) {
+    size_t index = snapshot.addSection(section->name(), section->type(), parent, section->id());
+
+    MetadataSnapshot::SectionNode &node = snapshot.section(index);
+    node.definition = section->definition();
+    node.repository = section->repository();
+    node.mapping = section->mapping();
+    node.created_at = section->createdAt();
+    node.updated_at = section->updatedAt();
+
+    // read the id of the link target directly, ISection::link() searches the whole file
+    bfs::path link = bfs::path(std::dynamic_pointer_cast<SectionFS>(section)->location()) / "link";
+    if (bfs::exists(link)) {
+        std::string link_id;
+        DirectoryWithAttributes(link).getAttr("entity_id", link_id);
+        node.link = link_id;
+    }
+
+    for (ndsize_t i = 0; i < section->propertyCount(); i++) {
+        std::shared_ptr<base::IProperty> prop = section->getProperty(i);
+        std::vector<Value> values = prop->values();
+        size_t pi = values.empty() ?
+                    snapshot.addProperty(index, prop->name(), prop->dataType(), prop->id()) :
+                    snapshot.addProperty(index, prop->name(), values, prop->id());
+
+        MetadataSnapshot::PropertyNode &pnode = snapshot.property(pi);
+        pnode.definition = prop->definition();
+        pnode.unit = prop->unit();
+        pnode.mapping = prop->mapping();
+        pnode.created_at = prop->createdAt();
+        pnode.updated_at = prop->updatedAt();
+    }
+
+    for (ndsize_t i = 0; i < section->sectionCount(); i++) {
+        snapshot_sections(section->getSection(i), index, snapshot);
+    }
+}
+
+
+MetadataSnapshot FileFS::loadMetadataSnapshot() const {
+    MetadataSnapshot snapshot;
+    for (ndsize_t i = 0; i < sectionCount(); i++) {
+        snapshot_sections(getSection(i), MetadataSnapshot::npos, snapshot);
+    }
+    return snapshot;
+}
+
+
+static void store_section(const std::shared_ptr<base::IFile> &file, const MetadataSnapshot &snapshot,
+                          size_t index, const std::shared_ptr<SectionFS> &parent, const bfs::path &loc,
+                          time_t now, std::vector<std::shared_ptr<SectionFS>> &sections) {
+    const MetadataSnapshot::SectionNode &node = snapshot.section(index);
+    std::string id = node.id.empty() ? util::createId() : node.id;
+    time_t created = node.created_at > 0 ? node.created_at : now;
+
+    auto section = std::make_shared<SectionFS>(file, parent, loc.string(), id, node.type, node.name, created);
+    if (node.definition) section->definition(*node.definition);
+    if (node.repository) section->repository(*node.repository);
+    if (node.mapping) section->mapping(*node.mapping);
+
+    bfs::path sec_loc(section->location());
+    for (size_t p : snapshot.properties(index)) {
+        const MetadataSnapshot::PropertyNode &pnode = snapshot.property(p);
+        std::string pid = pnode.id.empty() ? util::createId() : pnode.id;
+
+        PropertyFS prop(file, sec_loc / "properties", pid, pnode.name, pnode.data_type);
+        if (pnode.definition) prop.definition(*pnode.definition);
+        if (pnode.unit) prop.unit(*pnode.unit);
+        if (pnode.mapping) prop.mapping(*pnode.mapping);
+        if (pnode.created_at > 0) prop.forceCreatedAt(pnode.created_at);
+
+        MetadataSnapshot::ValueRange values = snapshot.values(p);
+        if (!values.empty()) {
+            prop.values(std::vector<Value>(values.begin(), values.end()));
+        }
+    }
+
+    sections[index] = section;
+
+    for (size_t c : snapshot.sections(index)) {
+        store_section(file, snapshot, c, section, sec_loc / "sections", now, sections);
+    }
+}
+
+
+void FileFS::storeMetadataSnapshot(const MetadataSnapshot &snapshot) {
+    std::vector<std::shared_ptr<SectionFS>> sections(snapshot.sectionCount());
+    time_t now = util::getTime();
+
+    for (size_t root : snapshot.rootSections()) {
+        store_section(file(), snapshot, root, nullptr, bfs::path(metadata_dir.location()), now, sections);
+    }
+
+    for (size_t i = 0; i < snapshot.sectionCount(); i++) {
+        const boost::optional<std::string> &link = snapshot.section(i).link;
+        if (!link) {
+            continue;
+        }
+
+        size_t target = snapshot.findSectionById(*link);
+        if (target != MetadataSnapshot::npos) {
+            sections[target]->createLink(bfs::path(sections[i]->location()) / "link");
+        } else {
+            // link into the existing part of the file (checked by the front-end)
+            sections[i]->link(*link);
+        }
+    }
+}
+
+
+//--------------------------------------------------
+// Storage report
+//--------------------------------------------------
+
+static ndsize_t count_sources(const std::shared_ptr<base::ISource> &source) {
+    ndsize_t count = 1;
+    for (ndsize_t i = 0; i < source->sourceCount(); i++) {
+        count += count_sources(source->getSource(i));
+    }
+    return count;
+}
+
+
+StorageReport FileFS::storageReport() const {
+    StorageReport report;
+    report.format = format();
+    report.location = location();
+    report.addGroup("/data", static_cast<size_t>(blockCount()));
+    report.addGroup("/metadata", static_cast<size_t>(sectionCount()));
+
+    for (ndsize_t b = 0; b < blockCount(); b++) {
+        std::shared_ptr<base::IBlock> block = getBlock(b);
+        StorageReport::Block stats;
+        stats.name = block->name();
+        const std::string path = "/data/" + stats.name;
+
+        for (ndsize_t i = 0; i < block->dataArrayCount(); i++) {
+            std::shared_ptr<base::IDataArray> da = block->getDataArray(i);
+            StorageReport::Array array;
+            array.block = stats.name;
+            array.name = da->name();
+            array.path = path + "/data_arrays/" + array.name;
+            array.data_type = da->dataType();
+            array.extent = da->dataExtent();
+            array.chunks = da->chunkExtent();
+            if (array.data_type != DataType::Nothing) {
+                array.logical_bytes = array.extent.nelms() * data_type_to_size(array.data_type);
+            }
+            // the values are stored as they are
+            array.allocated_bytes = array.storage_bytes = array.logical_bytes;
+            stats.dimensions += static_cast<size_t>(da->dimensionCount());
+            report.arrays.push_back(std::move(array));
+        }
+
+        for (ndsize_t i = 0; i < block->tagCount(); i++) {
+            stats.features += static_cast<size_t>(block->getTag(i)->featureCount());
+        }
+        for (ndsize_t i = 0; i < block->multiTagCount(); i++) {
+            stats.features += static_cast<size_t>(block->getMultiTag(i)->featureCount());
+        }
+        for (ndsize_t i = 0; i < block->sourceCount(); i++) {
+            stats.sources += static_cast<size_t>(count_sources(block->getSource(i)));
+        }
+
+        stats.data_arrays = static_cast<size_t>(block->dataArrayCount());
+        stats.tags = static_cast<size_t>(block->tagCount());
+        stats.multi_tags = static_cast<size_t>(block->multiTagCount());
+        stats.groups = static_cast<size_t>(block->groupCount());
+        stats.objects = stats.data_arrays + stats.dimensions + stats.tags + stats.multi_tags +
+                        stats.features + stats.sources + stats.groups;
+
+        report.addGroup(path + "/data_arrays", stats.data_arrays);
+        report.addGroup(path + "/tags", stats.tags);
+        report.addGroup(path + "/multi_tags", stats.multi_tags);
+        report.addGroup(path + "/sources", static_cast<size_t>(block->sourceCount()));
+        report.addGroup(path + "/groups", stats.groups);
+        report.objects += stats.objects + 1;
+        report.blocks.push_back(std::move(stats));
+    }
+
+    MetadataSnapshot snapshot = loadMetadataSnapshot();
+    report.sections = snapshot.sectionCount();
+    report.properties = snapshot.propertyCount();
+    report.objects += report.sections + report.properties;
+    return report;
+}
+
+
 //--------------------------------------------------
 // Methods for file attribute access.
 //--------------------------------------------------
@@ -257,6 +451,21 @@ FileMode FileFS::fileMode() const {
     return mode;
 }
 
+
+void FileFS::startSWMRWrite() {
+    throw std::logic_error("FileFS::startSWMRWrite: SWMR is not supported by the file system backend!");
+}
+
+
+void FileFS::flushInterval(double seconds) {
+    // every change is written immediately
+}
+
+
+double FileFS::flushInterval() const {
+    return 0.0;
+}
+
 FileFS::~FileFS() {}
 
 } // namespace file
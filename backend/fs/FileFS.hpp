@@ -72,6 +72,15 @@ public:
 
     bool deleteSection(const std::string &name_or_id);
 
+
+    MetadataSnapshot loadMetadataSnapshot() const;
+
+
+    void storeMetadataSnapshot(const MetadataSnapshot &snapshot);
+
+
+    StorageReport storageReport() const;
+
     //--------------------------------------------------
     // Methods for file attribute access.
     //--------------------------------------------------
@@ -113,6 +122,15 @@ public:
     FileMode fileMode() const;
 
 
+    void startSWMRWrite();
+
+
+    void flushInterval(double seconds);
+
+
+    double flushInterval() const;
+
+
     bool operator==(const FileFS &other) const;
 
 
@@ -11,6 +11,7 @@
 #include <nix/NDArray.hpp>
 #include <nix/util/util.hpp>
 #include <nix/DataArray.hpp>
+#include <nix/IntervalIndex.hpp>
 #include "DataArrayFS.hpp"
 #include "BlockFS.hpp"
 #include "FeatureFS.hpp"
@@ -139,6 +140,12 @@ void MultiTagFS::units(const none_t t) {
     forceUpdatedAt();
 }
 
+
+std::shared_ptr<const IntervalIndex> MultiTagFS::intervalIndex() const {
+    // there is no way to tell whether the data changed, the index is not kept
+    return std::make_shared<IntervalIndex>(IntervalIndex::build(*positions(), extents()));
+}
+
 // these methods could go to the frontend...
 
 bool MultiTagFS::checkDimensions(const DataArray &a, const DataArray &b)const {
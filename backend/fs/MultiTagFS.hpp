@@ -72,6 +72,9 @@ public:
     void units(const none_t t);
 
 
+    std::shared_ptr<const IntervalIndex> intervalIndex() const;
+
+
     virtual ~MultiTagFS();
 
 private:
@@ -13,6 +13,8 @@
 #include "BlockHDF5.hpp"
 #include "FeatureHDF5.hpp"
 
+#include <set>
+
 using namespace nix::base;
 
 namespace nix {
@@ -22,8 +24,8 @@ namespace hdf5 {
 BaseTagHDF5::BaseTagHDF5(const std::shared_ptr<IFile> &file, const std::shared_ptr<IBlock> &block, const H5Group &group)
     : EntityWithSourcesHDF5(file, block, group)
 {
-    feature_group = this->group().openOptGroup("features");
-    refs_group = this->group().openOptGroup("references");
+    feature_group = this->group().openOptGroup("features", readOnly());
+    refs_group = this->group().openOptGroup("references", readOnly());
 }
 
 
@@ -38,8 +40,8 @@ BaseTagHDF5::BaseTagHDF5(const std::shared_ptr<IFile> &file, const std::shared_p
                          const std::string &id, const std::string &type, const std::string &name, time_t time)
     : EntityWithSourcesHDF5(file, block, group, id, type, name, time)
 {
-    feature_group = this->group().openOptGroup("features");
-    refs_group = this->group().openOptGroup("references");
+    feature_group = this->group().openOptGroup("features", readOnly());
+    refs_group = this->group().openOptGroup("references", readOnly());
 }
 
 //--------------------------------------------------
@@ -47,13 +49,7 @@ BaseTagHDF5::BaseTagHDF5(const std::shared_ptr<IFile> &file, const std::shared_p
 //--------------------------------------------------
 
 bool BaseTagHDF5::hasReference(const std::string &name_or_id) const {
-    std::string id = name_or_id;
-
-    if (!util::looksLikeUUID(name_or_id) && block()->hasDataArray(name_or_id)) {
-        id = block()->getDataArray(name_or_id)->id();
-    }
-
-    return refs_group(false) ? refs_group(false)->hasGroup(id) : false;
+    return !referenceId(name_or_id).empty();
 }
 
 
@@ -65,16 +61,10 @@ ndsize_t BaseTagHDF5::referenceCount() const {
 
 std::shared_ptr<IDataArray>  BaseTagHDF5::getReference(const std::string &name_or_id) const {
     std::shared_ptr<IDataArray> da;
-    boost::optional<H5Group> g = refs_group(false);
-
-    std::string id = name_or_id;
+    std::string id = referenceId(name_or_id);
 
-    if (!util::looksLikeUUID(name_or_id) && block()->hasDataArray(name_or_id)) {
-        id = block()->getDataArray(name_or_id)->id();
-    }
-
-    if (g && hasReference(id)) {
-        H5Group group = g->openGroup(id);
+    if (!id.empty()) {
+        H5Group group = refs_group(false)->openGroup(id, false);
         da = std::make_shared<DataArrayHDF5>(file(), block(), group);
     }
 
@@ -82,74 +72,140 @@ std::shared_ptr<IDataArray>  BaseTagHDF5::getReference(const std::string &name_o
 }
 
 std::shared_ptr<IDataArray>  BaseTagHDF5::getReference(ndsize_t index) const {
+    std::shared_ptr<IDataArray> da;
     boost::optional<H5Group> g = refs_group(false);
-    std::string id = g ? g->objectName(index) : "";
-    return getReference(id);
+
+    // the links are named after the id of the referenced array
+    if (g && index < g->objectCount()) {
+        H5Group group = g->openGroup(g->objectName(index), false);
+        da = std::make_shared<DataArrayHDF5>(file(), block(), group);
+    }
+
+    return da;
 }
 
 void BaseTagHDF5::addReference(const std::string &name_or_id) {
     boost::optional<H5Group> g = refs_group(true);
 
-    if (!block()->hasDataArray(name_or_id))
-        throw std::runtime_error("BaseTagHDF5::addReference: DataArray not found in block!");
-
     auto target = std::dynamic_pointer_cast<DataArrayHDF5>(block()->getDataArray(name_or_id));
+    if (!target)
+        throw std::runtime_error("BaseTagHDF5::addReference: DataArray not found in block!");
 
     g->createLink(target->group(), target->id());
 }
 
 
-bool BaseTagHDF5::removeReference(const std::string &name_or_id) {
-    boost::optional<H5Group> g = refs_group(false);
-    bool removed = false;
+void BaseTagHDF5::addReferences(const std::vector<DataArray> &refs) {
+    boost::optional<H5Group> arrays = blockDataArrays();
+
+    // validate all arrays before the first link is created
+    std::vector<std::pair<std::string, H5Group>> targets;
+    targets.reserve(refs.size());
+    for (const DataArray &ref : refs) {
+        auto target = std::dynamic_pointer_cast<DataArrayHDF5>(ref.impl());
+        if (!target) {
+            throw std::runtime_error("BaseTagHDF5::addReferences: DataArray is not stored in a HDF5 file!");
+        }
+
+        std::string name = target->name();
+        std::string id = target->id();
+        if (!arrays || !arrays->hasGroup(name)) {
+            throw std::runtime_error("BaseTagHDF5::addReferences: DataArray not found in block!");
+        }
+
+        // link the array of this block, the handle may belong to another
+        // file with an array of the same name and id
+        H5Group group = arrays->openGroup(name, false);
+        std::string block_id;
+        if (!group.getAttr("entity_id", block_id) || block_id != id) {
+            throw std::runtime_error("BaseTagHDF5::addReferences: DataArray not found in block!");
+        }
+
+        targets.emplace_back(id, group);
+    }
+
+    boost::optional<H5Group> g = refs_group(true);
+    for (const auto &target : targets) {
+        if (!g->hasGroup(target.first)) {
+            g->createLink(target.second, target.first);
+        }
+    }
+}
+
 
-    if (g && hasReference(name_or_id)) {
-        std::shared_ptr<IDataArray> reference = getReference(name_or_id);
+bool BaseTagHDF5::removeReference(const std::string &name_or_id) {
+    std::string id = referenceId(name_or_id);
 
-        g->removeGroup(reference->id());
-        removed = true;
+    if (id.empty()) {
+        return false;
     }
 
-    return removed;
+    refs_group(false)->removeGroup(id);
+    return true;
 }
 
 
 void BaseTagHDF5::references(const std::vector<DataArray> &refs_new) {
+    // the ids of the current references are the names of the links
+    std::set<std::string> ids_old;
+    boost::optional<H5Group> g = refs_group(false);
+    if (g) {
+        for (ndsize_t i = 0; i < g->objectCount(); i++) {
+            ids_old.insert(g->objectName(i));
+        }
+    }
 
-    // extract vectors of names from vectors of new & old references
-    std::vector<std::string> names_new(refs_new.size());
-    std::transform(refs_new.begin(), refs_new.end(), names_new.begin(), util::toName<DataArray>);
-
-    size_t ref_count = nix::check::fits_in_size_t(referenceCount(), "refrenceCount() failed; count > size_t.");
-    std::vector<DataArray> refs_old(ref_count);
-    for (size_t i = 0; i < refs_old.size(); i++) refs_old[i] = getReference(i);
-    std::vector<std::string> names_old(refs_old.size());
-    std::transform(refs_old.begin(), refs_old.end(), names_old.begin(), util::toName<DataArray>);
-
-    // sort them
-    std::sort(names_new.begin(), names_new.end());
-    std::sort(names_new.begin(), names_new.end());
-
-    // get names only in names_new (add), names only in names_old (remove) & ignore rest
-    std::vector<std::string> names_add;
-    std::vector<std::string> names_rem;
-    std::set_difference(names_new.begin(), names_new.end(), names_old.begin(), names_old.end(),
-            std::inserter(names_add, names_add.begin()));
-    std::set_difference(names_old.begin(), names_old.end(), names_new.begin(), names_new.end(),
-            std::inserter(names_rem, names_rem.begin()));
-
-    // check if all new references exist & add sources
-    auto blck = std::dynamic_pointer_cast<BlockHDF5>(block());
-    for (auto name : names_add) {
-        if (!blck->hasDataArray(name))
-            throw std::runtime_error("One or more data arrays do not exist in this block!");
-        addReference(blck->getDataArray(name)->id());
+    std::set<std::string> ids_new;
+    std::vector<DataArray> refs_add;
+    for (const DataArray &ref : refs_new) {
+        std::string id = ref.id();
+        if (ids_old.count(id) == 0 && ids_new.count(id) == 0) {
+            refs_add.push_back(ref);
+        }
+        ids_new.insert(id);
     }
+
+    // check if all new references exist & add them
+    addReferences(refs_add);
+
     // remove references
-    for (auto name : names_rem) {
-        if (!blck->hasDataArray(name))
-            removeReference(blck->getDataArray(name)->id());
+    for (const std::string &id : ids_old) {
+        if (ids_new.count(id) == 0) {
+            g->removeGroup(id);
+        }
+    }
+}
+
+
+std::string BaseTagHDF5::referenceId(const std::string &name_or_id) const {
+    boost::optional<H5Group> g = refs_group(false);
+
+    if (!g) {
+        return "";
+    }
+
+    if (g->hasGroup(name_or_id)) {
+        return name_or_id;
+    }
+
+    if (!util::looksLikeUUID(name_or_id)) {
+        std::shared_ptr<IDataArray> da = block()->getDataArray(name_or_id);
+        if (da && g->hasGroup(da->id())) {
+            return da->id();
+        }
+    }
+
+    return "";
+}
+
+
+boost::optional<H5Group> BaseTagHDF5::blockDataArrays() const {
+    H5Group g = std::dynamic_pointer_cast<BlockHDF5>(block())->group();
+    boost::optional<H5Group> arrays;
+    if (g.hasGroup("data_arrays")) {
+        arrays = g.openGroup("data_arrays", false);
     }
+    return arrays;
 }
 
 //--------------------------------------------------
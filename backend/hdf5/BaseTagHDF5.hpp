@@ -27,6 +27,11 @@ private:
     optGroup feature_group;
     optGroup refs_group;
 
+    // id of the referenced DataArray or an empty string if there is no such reference
+    std::string referenceId(const std::string &name_or_id) const;
+
+    boost::optional<H5Group> blockDataArrays() const;
+
 public:
 
     /**
@@ -65,6 +70,9 @@ public:
     virtual void addReference(const std::string &name_or_id);
 
 
+    virtual void addReferences(const std::vector<DataArray> &references);
+
+
     virtual bool removeReference(const std::string &name_or_id);
 
     // TODO evaluate if DataArray can be replaced by shared_ptr<IDataArray>
@@ -9,15 +9,24 @@
 #include "BlockHDF5.hpp"
 
 #include <nix/util/util.hpp>
+#include <nix/util/filter.hpp>
 #include <nix/Block.hpp>
+#include <nix/BlockBatch.hpp>
 #include "SourceHDF5.hpp"
 #include "DataArrayHDF5.hpp"
 #include "TagHDF5.hpp"
 #include "MultiTagHDF5.hpp"
 #include "GroupHDF5.hpp"
+#include "DimensionHDF5.hpp"
+#include "h5x/Attribute.hpp"
+#include "h5x/H5Lock.hpp"
 
 #include <boost/range/irange.hpp>
 
+#include <map>
+#include <set>
+#include <unordered_map>
+
 using namespace std;
 using namespace nix::base;
 
@@ -27,11 +36,11 @@ namespace hdf5 {
 
 BlockHDF5::BlockHDF5(const std::shared_ptr<base::IFile> &file, const H5Group &group)
         : EntityWithMetadataHDF5(file, group) {
-    data_array_group = this->group().openOptGroup("data_arrays");
-    tag_group = this->group().openOptGroup("tags");
-    multi_tag_group = this->group().openOptGroup("multi_tags");
-    source_group = this->group().openOptGroup("sources");
-    groups_group = this->group().openOptGroup("groups");
+    data_array_group = this->group().openOptGroup("data_arrays", readOnly());
+    tag_group = this->group().openOptGroup("tags", readOnly());
+    multi_tag_group = this->group().openOptGroup("multi_tags", readOnly());
+    source_group = this->group().openOptGroup("sources", readOnly());
+    groups_group = this->group().openOptGroup("groups", readOnly());
 }
 
 BlockHDF5::BlockHDF5(const shared_ptr<IFile> &file, const H5Group &group, const string &id, const string &type, const string &name)
@@ -41,11 +50,11 @@ BlockHDF5::BlockHDF5(const shared_ptr<IFile> &file, const H5Group &group, const
 
 BlockHDF5::BlockHDF5(const shared_ptr<IFile> &file, const H5Group &group, const string &id, const string &type, const string &name, time_t time)
         : EntityWithMetadataHDF5(file, group, id, type, name, time) {
-    data_array_group = this->group().openOptGroup("data_arrays");
-    tag_group = this->group().openOptGroup("tags");
-    multi_tag_group = this->group().openOptGroup("multi_tags");
-    source_group = this->group().openOptGroup("sources");
-    groups_group = this->group().openOptGroup("groups");
+    data_array_group = this->group().openOptGroup("data_arrays", readOnly());
+    tag_group = this->group().openOptGroup("tags", readOnly());
+    multi_tag_group = this->group().openOptGroup("multi_tags", readOnly());
+    source_group = this->group().openOptGroup("sources", readOnly());
+    groups_group = this->group().openOptGroup("groups", readOnly());
 }
 
 
@@ -230,6 +239,19 @@ shared_ptr<IDataArray> BlockHDF5::createDataArray(const std::string &name,
 }
 
 
+shared_ptr<IDataArray> BlockHDF5::createDataArray(const std::string &name, const std::string &type,
+                                                  nix::DataType data_type, const NDSize &shape,
+                                                  const NDSize &chunks, unsigned deflate, bool shuffle) {
+    string id = util::createId();
+    boost::optional<H5Group> g = data_array_group(true);
+
+    H5Group group = g->openGroup(name, true);
+    auto da = make_shared<DataArrayHDF5>(file(), block(), group, id, type, name);
+    da->createData(data_type, shape, chunks, deflate, shuffle);
+    return da;
+}
+
+
 bool BlockHDF5::deleteDataArray(const string &name_or_id) {
     bool deleted = false;
     boost::optional<H5Group> g = data_array_group();
@@ -243,6 +265,36 @@ bool BlockHDF5::deleteDataArray(const string &name_or_id) {
 }
 
 
+ndsize_t BlockHDF5::deleteDataArrays(const vector<string> &names_or_ids) {
+    ndsize_t deleted = 0;
+    boost::optional<H5Group> g = data_array_group();
+    if (!g) {
+        return deleted;
+    }
+
+    // resolve all ids with a single pass over the arrays
+    unordered_map<string, string> names;
+    for (const string &name : g->objectNames()) {
+        string id;
+        if (g->openGroup(name, false).getAttr("entity_id", id)) {
+            names.emplace(id, name);
+        }
+    }
+
+    // the first deletion builds the link index of the file, all
+    // following ones only remove the links of the respective array
+    for (const string &name_or_id : names_or_ids) {
+        auto it = names.find(name_or_id);
+        const string &name = it != names.end() ? it->second : name_or_id;
+        if (g->removeAllLinks(name)) {
+            deleted++;
+        }
+    }
+
+    return deleted;
+}
+
+
 //--------------------------------------------------
 // Methods related to MultiTag
 //--------------------------------------------------
@@ -357,6 +409,197 @@ bool BlockHDF5::deleteGroup(const std::string &name_or_id) {
 }
 
 
+//--------------------------------------------------
+// Batched creation
+//--------------------------------------------------
+
+namespace {
+
+/**
+ * State shared by all entities written by createBatch.
+ *
+ * The names of the entities were checked by the front-end, therefore
+ * groups and attributes are created right away, without looking for
+ * existing ones first and with a single group creation plist.
+ */
+struct BatchWriter {
+    string now;
+    H5Object gcpl;
+    DataSpace scalar;
+    // only entities that are linked by other entities of the batch stay open
+    set<string> linked;
+    map<string, H5Group> sources, arrays;
+
+    BatchWriter(const BlockBatch &batch) : now(util::timeToStr(util::getTime())), scalar(DataSpace::create(NDSize{})) {
+        for (size_t i = 0; i < batch.dataArrayCount(); i++) {
+            const BlockBatch::DataArraySpec &spec = batch.dataArray(i);
+            linked.insert(spec.sources.begin(), spec.sources.end());
+        }
+        for (size_t i = 0; i < batch.tagCount(); i++) {
+            const BlockBatch::TagSpec &spec = batch.tag(i);
+            linked.insert(spec.sources.begin(), spec.sources.end());
+            linked.insert(spec.references.begin(), spec.references.end());
+        }
+
+        gcpl = H5Pcreate(H5P_GROUP_CREATE);
+        gcpl.check("BlockHDF5::createBatch: Could not create group creation plist");
+
+        // the same creation order tracking as H5Group::openGroup
+        HErr res = H5Pset_link_creation_order(gcpl.h5id(), H5P_CRT_ORDER_TRACKED|H5P_CRT_ORDER_INDEXED);
+        res.check("BlockHDF5::createBatch: Could not set link creation order");
+    }
+
+    H5Group createGroup(const H5Group &parent, const string &name) const {
+        H5Group g = H5Gcreate2(parent.h5id(), name.c_str(), H5P_DEFAULT, gcpl.h5id(), H5P_DEFAULT);
+        g.check("BlockHDF5::createBatch: Could not create group " + name);
+        return g;
+    }
+
+    void setAttr(const H5Group &g, const char *name, const string &value) const {
+        Attribute attr = H5Acreate(g.h5id(), name, data_type_to_h5_filetype(DataType::String).h5id(),
+                                   scalar.h5id(), H5P_DEFAULT, H5P_DEFAULT);
+        attr.check(string("BlockHDF5::createBatch: Could not create attribute ") + name);
+        attr.write(data_type_to_h5_memtype(DataType::String), NDSize{}, &value);
+    }
+
+    void setAttr(const H5Group &g, const char *name, double value) const {
+        Attribute attr = H5Acreate(g.h5id(), name, data_type_to_h5_filetype(DataType::Double).h5id(),
+                                   scalar.h5id(), H5P_DEFAULT, H5P_DEFAULT);
+        attr.check(string("BlockHDF5::createBatch: Could not create attribute ") + name);
+        attr.write(data_type_to_h5_memtype(DataType::Double), NDSize{}, static_cast<const void *>(&value));
+    }
+
+    H5Group createEntity(const H5Group &parent, const string &id, const string &type, const string &name) const {
+        H5Group g = createGroup(parent, name);
+        setAttr(g, "entity_id", id);
+        setAttr(g, "created_at", now);
+        setAttr(g, "updated_at", now);
+        setAttr(g, "type", type);
+        setAttr(g, "name", name);
+        return g;
+    }
+
+    void createDimension(const H5Group &parent, ndsize_t index, const BlockBatch::DimensionSpec &spec) const {
+        H5Group g = createGroup(parent, util::numToStr(index));
+        setAttr(g, "dimension_type", dimensionTypeToStr(spec.type));
+
+        switch (spec.type) {
+            case DimensionType::Sample:
+                setAttr(g, "sampling_interval", spec.sampling_interval);
+                if (spec.offset) setAttr(g, "offset", *spec.offset);
+                break;
+            case DimensionType::Set:
+                if (!spec.labels.empty()) g.setData("labels", spec.labels);
+                break;
+            case DimensionType::Range:
+                g.setData("ticks", spec.ticks);
+                break;
+        }
+
+        if (spec.unit) setAttr(g, "unit", *spec.unit);
+        if (spec.label) setAttr(g, "label", *spec.label);
+    }
+
+    void linkSources(const H5Group &entity, const vector<string> &ids, const shared_ptr<IBlock> &block) const {
+        if (ids.empty()) {
+            return;
+        }
+
+        H5Group g = createGroup(entity, "sources");
+        for (const string &id : ids) {
+            auto it = sources.find(id);
+            if (it != sources.end()) {
+                g.createLink(it->second, id);
+            } else {
+                // an existing source, possibly nested (checked by the front-end)
+                auto found = Block(block).findSources(util::IdFilter<Source>(id));
+                auto target = dynamic_pointer_cast<SourceHDF5>(found.front().impl());
+                g.createLink(target->group(), id);
+            }
+        }
+    }
+
+    void linkReferences(const H5Group &tag, const vector<string> &ids, const shared_ptr<IBlock> &block) const {
+        if (ids.empty()) {
+            return;
+        }
+
+        H5Group g = createGroup(tag, "references");
+        for (const string &id : ids) {
+            auto it = arrays.find(id);
+            if (it != arrays.end()) {
+                g.createLink(it->second, id);
+            } else {
+                auto target = dynamic_pointer_cast<DataArrayHDF5>(block->getDataArray(id));
+                g.createLink(target->group(), id);
+            }
+        }
+    }
+};
+
+} // anonymous namespace
+
+
+void BlockHDF5::createBatch(const BlockBatch &batch) {
+    H5Lock lock;
+    group().checkStructureChange("BlockHDF5::createBatch");
+
+    BatchWriter writer(batch);
+    shared_ptr<IBlock> self = block();
+
+    if (batch.sourceCount() > 0) {
+        H5Group g = *source_group(true);
+        for (size_t i = 0; i < batch.sourceCount(); i++) {
+            const BlockBatch::SourceSpec &spec = batch.source(i);
+            H5Group source = writer.createEntity(g, spec.id, spec.type, spec.name);
+            if (writer.linked.count(spec.id) > 0) {
+                writer.sources[spec.id] = source;
+            }
+        }
+    }
+
+    if (batch.dataArrayCount() > 0) {
+        H5Group g = *data_array_group(true);
+        for (size_t i = 0; i < batch.dataArrayCount(); i++) {
+            const BlockBatch::DataArraySpec &spec = batch.dataArray(i);
+            H5Group da = writer.createEntity(g, spec.id, spec.type, spec.name);
+            da.createData("data", data_type_to_h5_filetype(spec.data_type), spec.shape);
+
+            if (spec.unit) writer.setAttr(da, "unit", *spec.unit);
+            if (spec.label) writer.setAttr(da, "label", *spec.label);
+
+            if (!spec.dimensions.empty()) {
+                H5Group dims = writer.createGroup(da, "dimensions");
+                for (size_t d = 0; d < spec.dimensions.size(); d++) {
+                    writer.createDimension(dims, d + 1, spec.dimensions[d]);
+                }
+            }
+
+            writer.linkSources(da, spec.sources, self);
+            if (writer.linked.count(spec.id) > 0) {
+                writer.arrays[spec.id] = da;
+            }
+        }
+        dimensionChanged();
+    }
+
+    if (batch.tagCount() > 0) {
+        H5Group g = *tag_group(true);
+        for (size_t i = 0; i < batch.tagCount(); i++) {
+            const BlockBatch::TagSpec &spec = batch.tag(i);
+            H5Group tag = writer.createEntity(g, spec.id, spec.type, spec.name);
+            tag.setData("position", spec.position);
+
+            if (!spec.extent.empty()) tag.setData("extent", spec.extent);
+            if (!spec.units.empty()) tag.setData("units", spec.units);
+
+            writer.linkReferences(tag, spec.references, self);
+            writer.linkSources(tag, spec.sources, self);
+        }
+    }
+}
+
+
 shared_ptr<IBlock> BlockHDF5::block() const {
     return const_pointer_cast<BlockHDF5>(shared_from_this());
 }
@@ -102,9 +102,20 @@ public:
     std::shared_ptr<base::IDataArray> createDataArray(const std::string &name, const std::string &type,
                                                       nix::DataType data_type, const NDSize &shape);
 
+    /**
+     * Create a DataArray whose data is stored with the given chunk shape
+     * and filters, see DataArrayHDF5::createData.
+     */
+    std::shared_ptr<base::IDataArray> createDataArray(const std::string &name, const std::string &type,
+                                                      nix::DataType data_type, const NDSize &shape,
+                                                      const NDSize &chunks, unsigned deflate, bool shuffle);
+
 
     bool deleteDataArray(const std::string &name_or_id);
 
+
+    ndsize_t deleteDataArrays(const std::vector<std::string> &names_or_ids);
+
     //--------------------------------------------------
     // Methods concerning tags.
     //--------------------------------------------------
@@ -170,6 +181,12 @@ public:
 
     bool deleteGroup(const std::string &name_or_id);
 
+    //--------------------------------------------------
+    // Batched creation
+    //--------------------------------------------------
+
+    void createBatch(const BlockBatch &batch);
+
     //--------------------------------------------------
     // Other methods and functions
     //--------------------------------------------------
@@ -11,6 +11,14 @@
 #include "DataArrayHDF5.hpp"
 #include "h5x/H5DataSet.hpp"
 #include "DimensionHDF5.hpp"
+#include "FileHDF5.hpp"
+#include "h5x/H5Lock.hpp"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
 
 using namespace std;
 using namespace nix::base;
@@ -20,8 +28,9 @@ namespace hdf5 {
 
 
 DataArrayHDF5::DataArrayHDF5(const std::shared_ptr<base::IFile> &file, const std::shared_ptr<base::IBlock> &block, const H5Group &group)
-        : EntityWithSourcesHDF5(file, block, group) {
-    dimension_group = this->group().openOptGroup("dimensions");
+        : EntityWithSourcesHDF5(file, block, group), dim_cache(make_shared<DimensionCache>()),
+          alias_generation(0), alias_valid(false), has_alias(false) {
+    dimension_group = this->group().openOptGroup("dimensions", readOnly());
 }
 
 
@@ -33,8 +42,9 @@ DataArrayHDF5::DataArrayHDF5(const shared_ptr<IFile> &file, const shared_ptr<IBl
 
 DataArrayHDF5::DataArrayHDF5(const shared_ptr<IFile> &file, const shared_ptr<IBlock> &block, const H5Group &group,
                              const string &id, const string &type, const string &name, time_t time)
-        : EntityWithSourcesHDF5(file, block, group, id, type, name, time) {
-    dimension_group = this->group().openOptGroup("dimensions");
+        : EntityWithSourcesHDF5(file, block, group, id, type, name, time), dim_cache(make_shared<DimensionCache>()),
+          alias_generation(0), alias_valid(false), has_alias(false) {
+    dimension_group = this->group().openOptGroup("dimensions", readOnly());
 }
 
 //--------------------------------------------------
@@ -107,6 +117,7 @@ boost::optional<double> DataArrayHDF5::expansionOrigin() const {
 
 void DataArrayHDF5::expansionOrigin(double expansion_origin) {
     group().setAttr("expansion_origin", expansion_origin);
+    dropDataVersion();
     forceUpdatedAt();
 }
 
@@ -115,6 +126,7 @@ void DataArrayHDF5::expansionOrigin(const none_t t) {
     if (group().hasAttr("expansion_origin")) {
         group().removeAttr("expansion_origin");
     }
+    dropDataVersion();
     forceUpdatedAt();
 }
 
@@ -140,6 +152,7 @@ void DataArrayHDF5::polynomCoefficients(const vector<double> &coefficients) {
         ds = group().createData("polynom_coefficients", H5T_NATIVE_DOUBLE, {coefficients.size()});
     }
     ds.write(coefficients);
+    dropDataVersion();
     forceUpdatedAt();
 }
 
@@ -148,6 +161,7 @@ void DataArrayHDF5::polynomCoefficients(const none_t t) {
     if (group().hasData("polynom_coefficients")) {
         group().removeData("polynom_coefficients");
     }
+    dropDataVersion();
     forceUpdatedAt();
 }
 
@@ -175,6 +189,10 @@ shared_ptr<IDimension> DataArrayHDF5::getDimension(ndsize_t index) const {
         if (g->hasGroup(str_id)) {
             H5Group group = g->openGroup(str_id, false);
             dim = openDimensionHDF5(group, index);
+            auto set = dynamic_pointer_cast<SetDimensionHDF5>(dim);
+            if (set) {
+                set->shareCache(dim_cache, *g);
+            }
         }
     }
 
@@ -184,7 +202,9 @@ shared_ptr<IDimension> DataArrayHDF5::getDimension(ndsize_t index) const {
 
 std::shared_ptr<base::ISetDimension> DataArrayHDF5::createSetDimension(ndsize_t index) {
     H5Group g = createDimensionGroup(index);
-    return make_shared<SetDimensionHDF5>(g, index);
+    auto set = make_shared<SetDimensionHDF5>(g, index);
+    set->shareCache(dim_cache, *dimension_group());
+    return set;
 }
 
 
@@ -218,6 +238,7 @@ H5Group DataArrayHDF5::createDimensionGroup(ndsize_t index) {
         g->removeGroup(str_id);
     }
 
+    dimensionChanged();
     return g->openGroup(str_id, true);
 }
 
@@ -231,10 +252,64 @@ bool DataArrayHDF5::deleteDimensions() {
             g->removeGroup(dim_id);
         }
     }
+    dimensionChanged();
     return true;
 }
 
 
+std::vector<DimensionDescriptor> DataArrayHDF5::dimensionDescriptors() const {
+    return dim_cache->descriptors(dimension_group());
+}
+
+
+std::vector<DimensionDescriptor> DimensionCache::descriptors(const boost::optional<H5Group> &dimensions) {
+    uint64_t current = dimensionGeneration();
+    {
+        lock_guard<std::mutex> lock(mutex);
+        if (valid && generation == current) {
+            return cache;
+        }
+    }
+
+    // read all dimensions in one go
+    vector<DimensionDescriptor> result;
+    bool has_alias = false;
+    {
+        H5Lock lock;
+        ndsize_t count = dimensions ? dimensions->objectCount() : 0;
+        for (ndsize_t i = 1; i <= count; i++) {
+            string str_id = util::numToStr(i);
+            if (!dimensions->hasGroup(str_id)) {
+                continue;
+            }
+            shared_ptr<IDimension> dim = openDimensionHDF5(dimensions->openGroup(str_id, false), i);
+            result.emplace_back(*dim);
+            has_alias = has_alias || result.back().alias();
+        }
+    }
+
+    // the ticks of alias dimensions change with the data, don't keep them
+    if (!has_alias) {
+        lock_guard<std::mutex> lock(mutex);
+        cache = result;
+        generation = current;
+        valid = true;
+    }
+
+    return result;
+}
+
+
+DimensionDescriptor DimensionCache::descriptor(const boost::optional<H5Group> &dimensions, ndsize_t index) {
+    for (const DimensionDescriptor &d : descriptors(dimensions)) {
+        if (d.index() == index) {
+            return d;
+        }
+    }
+    throw OutOfBounds("DimensionCache::descriptor: no dimension with this index", index);
+}
+
+
 //--------------------------------------------------
 // Other methods and functions
 //--------------------------------------------------
@@ -249,10 +324,21 @@ void DataArrayHDF5::createData(DataType dtype, const NDSize &size) {
         throw ConsistencyError("DataArray's hdf5 data group already exists!");
     }
 
-    h5x::DataType fileType = data_type_to_h5_filetype(dtype);
+    const h5x::DataType &fileType = data_type_to_h5_filetype(dtype);
     group().createData("data", fileType, size);
 }
 
+
+void DataArrayHDF5::createData(DataType dtype, const NDSize &size, const NDSize &chunks,
+                               unsigned deflate, bool shuffle) {
+    if (group().hasData("data")) {
+        throw ConsistencyError("DataArray's hdf5 data group already exists!");
+    }
+
+    const h5x::DataType &fileType = data_type_to_h5_filetype(dtype);
+    group().createData("data", fileType, size, {}, chunks, true, true, deflate, shuffle);
+}
+
 bool DataArrayHDF5::hasData() const {
     return group().hasData("data");
 }
@@ -264,8 +350,9 @@ void DataArrayHDF5::write(DataType dtype, const void *data, const NDSize &count,
     }
 
     DataSet ds = group().openData("data");
-    h5x::DataType memType = data_type_to_h5_memtype(dtype);
+    const h5x::DataType &memType = data_type_to_h5_memtype(dtype);
     ds.write(data, memType, count, offset);
+    dataWritten();
 }
 
 void DataArrayHDF5::read(DataType dtype, void *data, const NDSize &count, const NDSize &offset) const {
@@ -274,7 +361,7 @@ void DataArrayHDF5::read(DataType dtype, void *data, const NDSize &count, const
     }
 
     DataSet ds = group().openData("data");
-    h5x::DataType memType = data_type_to_h5_memtype(dtype);
+    const h5x::DataType &memType = data_type_to_h5_memtype(dtype);
     ds.read(data, memType, count, offset);
 }
 
@@ -284,6 +371,9 @@ NDSize DataArrayHDF5::dataExtent(void) const {
     }
 
     DataSet ds = group().openData("data");
+    if (file()->fileMode() == FileMode::SWMRRead) {
+        ds.refresh();
+    }
     return ds.size();
 }
 
@@ -293,7 +383,13 @@ void DataArrayHDF5::dataExtent(const NDSize &extent) {
     }
 
     DataSet ds = group().openData("data");
+    // not flushed: the new extent becomes visible to readers together
+    // with the data that is written into it
     ds.setExtent(extent);
+    if (!dynamic_pointer_cast<FileHDF5>(file())->swmrWriting()) {
+        dropDataVersion();
+    }
+    aliasTicksChanged();
 }
 
 DataType DataArrayHDF5::dataType(void) const {
@@ -306,5 +402,296 @@ DataType DataArrayHDF5::dataType(void) const {
     return data_type_from_h5(dtype);
 }
 
+
+boost::optional<MappedData> DataArrayHDF5::mapData() const {
+#ifdef _WIN32
+    return boost::none;
+#else
+    H5Lock lock;
+    if (!group().hasData("data")) {
+        return boost::none;
+    }
+
+    DataSet ds = group().openData("data");
+    boost::optional<haddr_t> offset = ds.contiguousOffset();
+    if (!offset) {
+        return boost::none;
+    }
+
+    // the bytes are only usable as-is if the stored type is the native one
+    const h5x::DataType ftype = ds.dataType();
+    const DataType dtype = data_type_from_h5(ftype);
+    if (dtype == DataType::Nothing || dtype == DataType::String || dtype == DataType::Bool ||
+        H5Tequal(ftype.h5id(), data_type_to_h5_memtype(dtype).h5id()) <= 0) {
+        return boost::none;
+    }
+
+    H5Object fid = H5Iget_file_id(ds.h5id());
+    fid.check("DataArrayHDF5::mapData: Could not get file id");
+    H5Object fapl = H5Fget_access_plist(fid.h5id());
+    fapl.check("DataArrayHDF5::mapData: Could not get file access plist");
+    if (H5Pget_driver(fapl.h5id()) != H5FD_SEC2) {
+        return boost::none;
+    }
+
+    const NDSize extent = ds.size();
+    const size_t nbytes = nix::check::fits_in_size_t(extent.nelms() * data_type_to_size(dtype),
+                                                     "DataArrayHDF5::mapData: data does not fit into memory");
+    if (nbytes == 0) {
+        return boost::none;
+    }
+
+    // make pending writes visible in the file before mapping it
+    const FileMode mode = file()->fileMode();
+    if (mode != FileMode::ReadOnly && mode != FileMode::SWMRRead) {
+        HErr res = H5Fflush(fid.h5id(), H5F_SCOPE_LOCAL);
+        res.check("DataArrayHDF5::mapData: Could not flush file");
+    }
+
+    int fd = ::open(file()->location().c_str(), O_RDONLY);
+    if (fd < 0) {
+        return boost::none;
+    }
+
+    const off_t page = static_cast<off_t>(sysconf(_SC_PAGESIZE));
+    const off_t start = static_cast<off_t>(*offset) / page * page;
+    const size_t delta = static_cast<size_t>(static_cast<off_t>(*offset) - start);
+    const size_t length = nbytes + delta;
+
+    void *base = ::mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, start);
+    ::close(fd);
+    if (base == MAP_FAILED) {
+        return boost::none;
+    }
+
+    std::shared_ptr<const void> storage(base, [length](const void *p) {
+        ::munmap(const_cast<void *>(p), length);
+    });
+    const char *data = static_cast<const char *>(base) + delta;
+    return MappedData(dtype, extent, storage, data, true);
+#endif
+}
+
+
+NDSize DataArrayHDF5::chunkExtent() const {
+    if (!group().hasData("data")) {
+        return NDSize{};
+    }
+
+    DataSet ds = group().openData("data");
+    return ds.chunking();
+}
+
+
+void DataArrayHDF5::deflateFilter(unsigned &deflate, bool &shuffle) const {
+    deflate = 0;
+    shuffle = false;
+    if (group().hasData("data")) {
+        DataSet ds = group().openData("data");
+        ds.deflateFilter(deflate, shuffle);
+    }
+}
+
+
+bool DataArrayHDF5::concurrentReads() const {
+    // all calls into the HDF5 library are serialized by H5Lock
+    return true;
+}
+
+
+/*
+ * Check the chunk coordinates against the data and return the offset
+ * of the first element of the chunk.
+ */
+static NDSize chunk_offset(const DataSet &ds, const NDSize &chunks, const NDSize &chunk, const char *where) {
+    if (!chunks) {
+        throw std::runtime_error(std::string(where) + ": data is not stored in chunks");
+    }
+    if (chunk.size() != chunks.size()) {
+        throw IncompatibleDimensions("Rank of chunk coordinates and data do not match", where);
+    }
+
+    const NDSize extent = ds.size();
+    NDSize offset(chunk.size());
+    for (size_t i = 0; i < chunk.size(); i++) {
+        offset[i] = chunk[i] * chunks[i];
+        if (offset[i] >= extent[i]) {
+            throw OutOfBounds(std::string(where) + ": chunk lies outside of the data extent", chunk[i]);
+        }
+    }
+    return offset;
+}
+
+
+void DataArrayHDF5::writeChunk(const NDSize &chunk, const void *data, size_t nbytes, uint32_t filter_mask) {
+    H5Lock lock;
+    if (!group().hasData("data")) {
+        throw ConsistencyError("DataArray with missing h5df DataSet");
+    }
+
+    DataSet ds = group().openData("data");
+    const NDSize chunks = ds.chunking();
+    const NDSize offset = chunk_offset(ds, chunks, chunk, "DataArray::writeChunk");
+
+    // without filters the bytes are stored as they are and must fill the chunk exactly
+    if (!ds.hasFilters() && nbytes != chunks.nelms() * ds.dataType().size()) {
+        throw std::invalid_argument("DataArray::writeChunk: size of data does not match the chunk size");
+    }
+
+    ds.writeChunk(offset, data, nbytes, filter_mask);
+    dataWritten();
+}
+
+
+bool DataArrayHDF5::readChunk(const NDSize &chunk, Buffer<char> &data, uint32_t &filter_mask) const {
+    H5Lock lock;
+    if (!group().hasData("data")) {
+        throw ConsistencyError("DataArray with missing h5df DataSet");
+    }
+
+    DataSet ds = group().openData("data");
+    const NDSize offset = chunk_offset(ds, ds.chunking(), chunk, "DataArray::readChunk");
+    return ds.readChunk(offset, data, filter_mask);
+}
+
+
+std::string DataArrayHDF5::dataVersion() const {
+    string version;
+    group().getAttr("data_version", version);
+    return version;
+}
+
+
+std::string DataArrayHDF5::stampDataVersion() {
+    string version = dataVersion();
+    if (version.empty()) {
+        version = util::createId();
+        group().setAttr("data_version", version);
+    }
+    return version;
+}
+
+
+NDSize DataArrayHDF5::derivedExtent(const std::string &name) const {
+    // not kept up to date while the structure of the file is fixed
+    if (file()->fileMode() == FileMode::SWMRWrite || !group().hasGroup("derived")) {
+        return NDSize{};
+    }
+
+    H5Group derived = group().openGroup("derived", false);
+    if (!derived.hasData(name)) {
+        return NDSize{};
+    }
+
+    DataSet ds = derived.openData(name);
+    const string current = dataVersion();
+    string version;
+    if (current.empty() || !ds.getAttr("data_version", version) || version != current) {
+        return NDSize{};
+    }
+    return ds.size();
+}
+
+
+void DataArrayHDF5::readDerived(const std::string &name, double *data, const NDSize &count,
+                                const NDSize &offset) const {
+    H5Lock lock;
+    H5Group derived = group().openGroup("derived", false);
+    DataSet ds = derived.openData(name);
+    ds.read(data, data_type_to_h5_memtype(DataType::Double), count, offset);
+}
+
+
+void DataArrayHDF5::writeDerived(const std::string &name, const NDSize &extent, const double *data,
+                                 const NDSize &count, const NDSize &offset) {
+    H5Lock lock;
+    H5Group derived = group().openGroup("derived", true);
+
+    DataSet ds;
+    if (derived.hasData(name)) {
+        ds = derived.openData(name);
+        const NDSize size = ds.size();
+        if (size.size() != extent.size()) {
+            derived.removeData(name);
+        } else if (size != extent) {
+            ds.setExtent(extent);
+        }
+    }
+    if (!derived.hasData(name)) {
+        ds = derived.createData(name, data_type_to_h5_filetype(DataType::Double), extent);
+    }
+
+    if (count.nelms() > 0) {
+        ds.write(data, data_type_to_h5_memtype(DataType::Double), count, offset);
+    }
+
+    const string current = stampDataVersion();
+    string version;
+    if (!ds.getAttr("data_version", version) || version != current) {
+        ds.setAttr("data_version", current);
+    }
+}
+
+
+void DataArrayHDF5::deleteDerived(const std::string &name) {
+    if (group().hasGroup("derived")) {
+        H5Group derived = group().openGroup("derived", false);
+        if (derived.hasData(name)) {
+            derived.removeData(name);
+        }
+    }
+}
+
+
+void DataArrayHDF5::dropDataVersion() const {
+    if (group().hasAttr("data_version")) {
+        group().removeAttr("data_version");
+    }
+}
+
+
+void DataArrayHDF5::dataWritten() const {
+    auto f = dynamic_pointer_cast<FileHDF5>(file());
+    if (f->swmrWriting()) {
+        // the structure is fixed, the file counts the writes instead
+        f->dataWritten();
+    } else {
+        dropDataVersion();
+    }
+    aliasTicksChanged();
+}
+
+
+void DataArrayHDF5::aliasTicksChanged() const {
+    uint64_t generation = dimensionGeneration();
+    bool alias = false, known = false;
+    {
+        lock_guard<mutex> lock(alias_mutex);
+        known = alias_valid && alias_generation == generation;
+        alias = has_alias;
+    }
+
+    if (!known) {
+        // alias range dimensions are only allowed as the dimension of 1D data
+        alias = false;
+        boost::optional<H5Group> g = dimension_group();
+        if (g && g->hasGroup("1")) {
+            shared_ptr<IDimension> dim = openDimensionHDF5(g->openGroup("1", false), 1);
+            alias = dim->dimensionType() == DimensionType::Range &&
+                    dynamic_pointer_cast<RangeDimensionHDF5>(dim)->alias();
+        }
+    }
+
+    if (alias) {
+        dimensionChanged();
+        generation = dimensionGeneration();
+    }
+
+    lock_guard<mutex> lock(alias_mutex);
+    alias_generation = generation;
+    alias_valid = true;
+    has_alias = alias;
+}
+
 } // ns nix::hdf5
 } // ns nix
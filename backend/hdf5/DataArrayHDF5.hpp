@@ -19,9 +19,40 @@
 
 #include <boost/multi_array.hpp>
 
+#include <mutex>
+
 namespace nix {
 namespace hdf5 {
 
+/**
+ * The resolved dimensions of a data array, valid as long as
+ * dimensionGeneration() did not change. It is shared by a DataArrayHDF5
+ * handle and the set dimensions opened through it, so that all label
+ * lookups use the labels hashed in the cached descriptors.
+ */
+class DimensionCache {
+
+public:
+
+    /**
+     * The descriptors of all dimensions in the dimension group of the
+     * array, read from the file only if the cache is out of date.
+     */
+    std::vector<DimensionDescriptor> descriptors(const boost::optional<H5Group> &dimensions);
+
+    /**
+     * The descriptor of the dimension with the given index, which must exist.
+     */
+    DimensionDescriptor descriptor(const boost::optional<H5Group> &dimensions, ndsize_t index);
+
+private:
+
+    std::mutex mutex;
+    std::vector<DimensionDescriptor> cache;
+    uint64_t generation = 0;
+    bool valid = false;
+};
+
 
 class DataArrayHDF5 : virtual public base::IDataArray,  public EntityWithSourcesHDF5 {
 
@@ -32,6 +63,14 @@ private:
 
     optGroup dimension_group;
 
+    std::shared_ptr<DimensionCache> dim_cache;
+    // whether the first dimension is an alias range dimension, valid as
+    // long as dimensionGeneration() equals alias_generation
+    mutable std::mutex alias_mutex;
+    mutable uint64_t alias_generation;
+    mutable bool alias_valid;
+    mutable bool has_alias;
+
 public:
 
     /**
@@ -116,6 +155,9 @@ public:
 
     bool deleteDimensions();
 
+
+    std::vector<DimensionDescriptor> dimensionDescriptors() const;
+
     //--------------------------------------------------
     // Other methods and functions
     //--------------------------------------------------
@@ -130,6 +172,12 @@ public:
 
     virtual void createData(DataType dtype, const NDSize &size);
 
+    /**
+     * Create the data with the given chunk shape and filters, see
+     * H5Group::createData. An empty chunk shape is chosen automatically.
+     */
+    void createData(DataType dtype, const NDSize &size, const NDSize &chunks, unsigned deflate, bool shuffle);
+
 
     bool hasData() const;
 
@@ -148,10 +196,68 @@ public:
 
     DataType dataType(void) const;
 
+
+    boost::optional<MappedData> mapData() const;
+
+
+    NDSize chunkExtent() const;
+
+    /**
+     * The deflate level and whether the values are shuffled before they
+     * are compressed, see DataSet::deflateFilter. Data that was not created
+     * yet is stored without filters.
+     */
+    void deflateFilter(unsigned &deflate, bool &shuffle) const;
+
+
+    bool concurrentReads() const;
+
+
+    void writeChunk(const NDSize &chunk, const void *data, size_t nbytes, uint32_t filter_mask);
+
+
+    bool readChunk(const NDSize &chunk, Buffer<char> &data, uint32_t &filter_mask) const;
+
+    NDSize derivedExtent(const std::string &name) const;
+
+
+    void readDerived(const std::string &name, double *data, const NDSize &count, const NDSize &offset) const;
+
+
+    void writeDerived(const std::string &name, const NDSize &extent, const double *data,
+                      const NDSize &count, const NDSize &offset);
+
+
+    void deleteDerived(const std::string &name);
+
+    /**
+     * Identifies the current content of the data, so that values derived
+     * from it can be stored in the file along with the version they belong
+     * to. Empty if no version was assigned since the data was last changed.
+     */
+    std::string dataVersion() const;
+
+    /**
+     * Assign a version to the current content of the data unless it
+     * already has one and return it.
+     */
+    std::string stampDataVersion();
+
 private:
 
     // small helper for handling dimension groups
     H5Group createDimensionGroup(ndsize_t index);
+
+    // forget the version of the data after it was changed
+    void dropDataVersion() const;
+
+    // flush data for SWMR readers if the file asks for it,
+    // otherwise drop the version of the previous data
+    void dataWritten() const;
+
+    // invalidate the dimension descriptors if the ticks of an alias range
+    // dimension, i.e. the data of this array, were changed
+    void aliasTicksChanged() const;
 };
 
 
@@ -9,6 +9,8 @@
 #include "DimensionHDF5.hpp"
 #include <nix/util/util.hpp>
 
+#include <atomic>
+
 using namespace std;
 using namespace nix::base;
 
@@ -84,6 +86,23 @@ shared_ptr<IDimension> openDimensionHDF5(const H5Group &group, ndsize_t index) {
 }
 
 
+namespace {
+
+std::atomic<uint64_t> dimension_generation(0);
+
+}
+
+
+uint64_t dimensionGeneration() {
+    return dimension_generation.load();
+}
+
+
+void dimensionChanged() {
+    dimension_generation++;
+}
+
+
 // Implementation of Dimension
 
 DimensionHDF5::DimensionHDF5(const H5Group &group, ndsize_t index)
@@ -145,6 +164,7 @@ boost::optional<std::string> SampledDimensionHDF5::label() const {
 
 void SampledDimensionHDF5::label(const string &label) {
     group.setAttr("label", label);
+    dimensionChanged();
     // NOTE: forceUpdatedAt() not possible since not reachable from here
 }
 
@@ -153,6 +173,7 @@ void SampledDimensionHDF5::label(const none_t t) {
     if (group.hasAttr("label")) {
         group.removeAttr("label");
     }
+    dimensionChanged();
     // NOTE: forceUpdatedAt() not possible since not reachable from here
 }
 
@@ -170,6 +191,7 @@ boost::optional<std::string> SampledDimensionHDF5::unit() const {
 
 void SampledDimensionHDF5::unit(const string &unit) {
     group.setAttr("unit", unit);
+    dimensionChanged();
     // NOTE: forceUpdatedAt() not possible since not reachable from here
 }
 
@@ -178,6 +200,7 @@ void SampledDimensionHDF5::unit(const none_t t) {
     if (group.hasAttr("unit")) {
         group.removeAttr("unit");
     }
+    dimensionChanged();
     // NOTE: forceUpdatedAt() not possible since not reachable from here
 }
 
@@ -196,6 +219,7 @@ double SampledDimensionHDF5::samplingInterval() const {
 
 void SampledDimensionHDF5::samplingInterval(double sampling_interval) {
     group.setAttr("sampling_interval", sampling_interval);
+    dimensionChanged();
 }
 
 
@@ -211,6 +235,7 @@ boost::optional<double> SampledDimensionHDF5::offset() const {
 
 void SampledDimensionHDF5::offset(double offset) {
     group.setAttr("offset", offset);
+    dimensionChanged();
 }
 
 
@@ -218,6 +243,7 @@ void SampledDimensionHDF5::offset(const none_t t) {
     if (group.hasAttr("offset")) {
         group.removeAttr("offset");
     }
+    dimensionChanged();
 }
 
 
@@ -230,7 +256,11 @@ SampledDimensionHDF5::~SampledDimensionHDF5() {}
 SetDimensionHDF5::SetDimensionHDF5(const H5Group &group, ndsize_t index)
     : DimensionHDF5(group, index)
 {
-    setType();
+    // only a new dimension changes the file, opening must not invalidate caches
+    if (!group.hasAttr("dimension_type")) {
+        setType();
+        dimensionChanged();
+    }
 }
 
 
@@ -249,12 +279,37 @@ vector<string> SetDimensionHDF5::labels() const {
 
 void SetDimensionHDF5::labels(const vector<string> &labels) {
    group.setData("labels", labels);
+    dimensionChanged();
 }
 
 void SetDimensionHDF5::labels(const none_t t) {
     if (group.hasData("labels")) {
         group.removeData("labels");
+        dimensionChanged();
+    }
+}
+
+
+ndsize_t SetDimensionHDF5::labelCount() const {
+    if (!group.hasData("labels")) {
+        return 0;
+    }
+    NDSize size = group.openData("labels").size();
+    return size.size() > 0 ? size[0] : 0;
+}
+
+
+vector<ndsize_t> SetDimensionHDF5::indicesOf(const vector<string> &labels) const {
+    if (cache) {
+        return cache->descriptor(dimensions, dim_index).indicesOf(labels);
     }
+    return DimensionDescriptor(*this).indicesOf(labels);
+}
+
+
+void SetDimensionHDF5::shareCache(const shared_ptr<DimensionCache> &cache, const H5Group &dimensions) {
+    this->cache = cache;
+    this->dimensions = dimensions;
 }
 
 SetDimensionHDF5::~SetDimensionHDF5() {}
@@ -282,6 +337,7 @@ RangeDimensionHDF5::RangeDimensionHDF5(const H5Group &group, ndsize_t index, con
 {
     setType();
     this->group.createLink(array.group(), array.id());
+    dimensionChanged();
 }
 
 
@@ -317,6 +373,7 @@ boost::optional<std::string> RangeDimensionHDF5::label() const {
 void RangeDimensionHDF5::label(const string &label) {
     H5Group g = redirectGroup();
     g.setAttr("label", label);
+    dimensionChanged();
     // NOTE: forceUpdatedAt() not possible since not reachable from here
 }
 
@@ -326,6 +383,7 @@ void RangeDimensionHDF5::label(const none_t t) {
     if (g.hasAttr("label")) {
         g.removeAttr("label");
     }
+    dimensionChanged();
     // NOTE: forceUpdatedAt() not possible since not reachable from here
 }
 
@@ -345,6 +403,7 @@ boost::optional<std::string> RangeDimensionHDF5::unit() const {
 void RangeDimensionHDF5::unit(const string &unit) {
     H5Group g = redirectGroup();
     g.setAttr("unit", unit);
+    dimensionChanged();
     // NOTE: forceUpdatedAt() not possible since not reachable from here
 }
 
@@ -354,6 +413,7 @@ void RangeDimensionHDF5::unit(const none_t t) {
     if (g.hasAttr("unit")) {
         g.removeAttr("unit");
     }
+    dimensionChanged();
     // NOTE: forceUpdatedAt() not possible since not reachable from here
 }
 
@@ -390,6 +450,7 @@ void RangeDimensionHDF5::ticks(const vector<double> &ticks) {
     } else {
         throw MissingAttr("ticks");
     }
+    dimensionChanged();
 }
 
 RangeDimensionHDF5::~RangeDimensionHDF5() {}
@@ -16,6 +16,7 @@
 #include <iostream>
 #include <ctime>
 #include <memory>
+#include <cstdint>
 
 namespace nix {
 namespace hdf5 {
@@ -29,6 +30,16 @@ std::string dimensionTypeToStr(DimensionType dim);
 
 std::shared_ptr<base::IDimension> openDimensionHDF5(const H5Group &group, ndsize_t index);
 
+/**
+ * Counter that is increased whenever a dimension is created, changed or
+ * removed. Cached dimension descriptors are valid as long as the counter
+ * did not change since they were loaded.
+ */
+uint64_t dimensionGeneration();
+
+
+void dimensionChanged();
+
 
 class DimensionHDF5 : virtual public base::IDimension {
 
@@ -130,8 +141,27 @@ public:
     void labels(const none_t t);
 
 
+    ndsize_t labelCount() const;
+
+
+    std::vector<ndsize_t> indicesOf(const std::vector<std::string> &labels) const;
+
+    /**
+     * Look up labels in the dimension cache of the array the dimension was
+     * opened through, which is kept in the given dimension group.
+     */
+    void shareCache(const std::shared_ptr<DimensionCache> &cache, const H5Group &dimensions);
+
+
     virtual ~SetDimensionHDF5();
 
+private:
+
+    // the cached descriptors hash the labels, shared by all handles to
+    // the dimension that were opened through the same array handle
+    std::shared_ptr<DimensionCache> cache;
+    boost::optional<H5Group> dimensions;
+
 };
 
 
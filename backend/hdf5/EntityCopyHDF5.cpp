@@ -0,0 +1,203 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "EntityCopyHDF5.hpp"
+#include "BlockHDF5.hpp"
+#include "SourceHDF5.hpp"
+#include "TagHDF5.hpp"
+#include "MultiTagHDF5.hpp"
+#include "GroupHDF5.hpp"
+#include "FeatureHDF5.hpp"
+
+#include <nix/DataArray.hpp>
+
+using namespace std;
+
+namespace nix {
+namespace hdf5 {
+
+static void copy_entity(const shared_ptr<base::IEntityWithMetadata> &src,
+                        const shared_ptr<base::IEntityWithMetadata> &dst) {
+    boost::optional<string> definition = src->definition();
+    if (definition) {
+        dst->definition(*definition);
+    }
+    shared_ptr<base::ISection> metadata = src->metadata();
+    if (metadata) {
+        dst->metadata(metadata->id());
+    }
+}
+
+
+static void copy_sources(const shared_ptr<base::IEntityWithSources> &src,
+                         const shared_ptr<base::IEntityWithSources> &dst) {
+    copy_entity(src, dst);
+    for (ndsize_t i = 0; i < src->sourceCount(); i++) {
+        dst->addSource(src->getSource(static_cast<size_t>(i))->id());
+    }
+}
+
+
+static void copy_source(const shared_ptr<base::IFile> &file, const shared_ptr<base::IBlock> &block,
+                        const H5Group &parent, const shared_ptr<base::ISource> &src) {
+    H5Group group = parent.openGroup("sources", true).openGroup(src->name(), true);
+    auto dst = make_shared<SourceHDF5>(file, block, group, src->id(), src->type(), src->name(),
+                                             src->createdAt());
+    copy_entity(src, dst);
+    for (ndsize_t i = 0; i < src->sourceCount(); i++) {
+        copy_source(file, block, group, src->getSource(i));
+    }
+}
+
+
+void copyData(const shared_ptr<base::IDataArray> &src, const shared_ptr<DataArrayHDF5> &dst) {
+    DataType dtype = src->dataType();
+    if (dtype == DataType::Nothing) {
+        return;
+    }
+
+    NDSize extent = src->dataExtent();
+    dst->createData(dtype, extent);
+    if (extent.size() == 0 || extent.nelms() == 0) {
+        return;
+    }
+
+    if (dtype == DataType::String) {
+        vector<string> values(extent.nelms());
+        src->read(dtype, values.data(), extent, {});
+        dst->write(dtype, values.data(), extent, {});
+        return;
+    }
+
+    boost::optional<MappedData> view = src->mapData();
+    if (view) {
+        dst->write(dtype, view->data(), extent, {});
+    } else {
+        vector<char> values(extent.nelms() * data_type_to_size(dtype));
+        src->read(dtype, values.data(), extent, {});
+        dst->write(dtype, values.data(), extent, {});
+    }
+}
+
+
+static void copy_dimensions(const shared_ptr<base::IDataArray> &src, const shared_ptr<base::IDataArray> &dst) {
+    for (ndsize_t i = 1; i <= src->dimensionCount(); i++) {
+        shared_ptr<base::IDimension> dim = src->getDimension(i);
+
+        if (dim->dimensionType() == DimensionType::Sample) {
+            auto sdim = dynamic_pointer_cast<base::ISampledDimension>(dim);
+            auto out = dst->createSampledDimension(i, sdim->samplingInterval());
+            if (sdim->label()) out->label(*sdim->label());
+            if (sdim->unit()) out->unit(*sdim->unit());
+            if (sdim->offset()) out->offset(*sdim->offset());
+        } else if (dim->dimensionType() == DimensionType::Set) {
+            auto sdim = dynamic_pointer_cast<base::ISetDimension>(dim);
+            auto out = dst->createSetDimension(i);
+            vector<string> labels = sdim->labels();
+            if (!labels.empty()) out->labels(labels);
+        } else {
+            auto rdim = dynamic_pointer_cast<base::IRangeDimension>(dim);
+            if (rdim->alias()) {
+                dst->createAliasRangeDimension();
+            } else {
+                auto out = dst->createRangeDimension(i, rdim->ticks());
+                if (rdim->label()) out->label(*rdim->label());
+                if (rdim->unit()) out->unit(*rdim->unit());
+            }
+        }
+    }
+}
+
+
+static void copy_tag(const shared_ptr<base::IFile> &file, const shared_ptr<base::IBlock> &block,
+                     const shared_ptr<base::IBaseTag> &src, const shared_ptr<base::IBaseTag> &dst,
+                     const H5Group &group) {
+    copy_sources(src, dst);
+    for (ndsize_t i = 0; i < src->referenceCount(); i++) {
+        dst->addReference(src->getReference(i)->id());
+    }
+    for (ndsize_t i = 0; i < src->featureCount(); i++) {
+        shared_ptr<base::IFeature> feature = src->getFeature(i);
+        DataArray data = block->getDataArray(feature->data()->id());
+        H5Group fgroup = group.openGroup("features", true).openGroup(feature->id(), true);
+        make_shared<FeatureHDF5>(file, block, fgroup, feature->id(), data, feature->linkType(),
+                                       feature->createdAt());
+    }
+}
+
+
+void copyBlock(const shared_ptr<FileHDF5> &file, const shared_ptr<base::IBlock> &src, const DataCopy &copy_data) {
+    H5Group root = H5Gopen(file->h5id(), "/", H5P_DEFAULT);
+    H5Group bgroup = root.openGroup("data", false).openGroup(src->name(), true);
+    auto block = make_shared<BlockHDF5>(file, bgroup, src->id(), src->type(), src->name(), src->createdAt());
+    copy_entity(src, block);
+
+    for (ndsize_t i = 0; i < src->sourceCount(); i++) {
+        copy_source(file, block, bgroup, src->getSource(i));
+    }
+
+    for (ndsize_t i = 0; i < src->dataArrayCount(); i++) {
+        shared_ptr<base::IDataArray> da = src->getDataArray(i);
+        H5Group group = bgroup.openGroup("data_arrays", true).openGroup(da->name(), true);
+        auto out = make_shared<DataArrayHDF5>(file, block, group, da->id(), da->type(), da->name(),
+                                                    da->createdAt());
+        copy_sources(da, out);
+        if (da->label()) out->label(*da->label());
+        if (da->unit()) out->unit(*da->unit());
+        if (da->expansionOrigin()) out->expansionOrigin(*da->expansionOrigin());
+        vector<double> coefficients = da->polynomCoefficients();
+        if (!coefficients.empty()) out->polynomCoefficients(coefficients);
+        copy_dimensions(da, out);
+        copy_data(da, out);
+    }
+
+    for (ndsize_t i = 0; i < src->tagCount(); i++) {
+        shared_ptr<base::ITag> tag = src->getTag(i);
+        H5Group group = bgroup.openGroup("tags", true).openGroup(tag->name(), true);
+        auto out = make_shared<TagHDF5>(file, block, group, tag->id(), tag->type(), tag->name(),
+                                              tag->position(), tag->createdAt());
+        vector<double> extent = tag->extent();
+        if (!extent.empty()) out->extent(extent);
+        vector<string> units = tag->units();
+        if (!units.empty()) out->units(units);
+        copy_tag(file, block, tag, out, group);
+    }
+
+    for (ndsize_t i = 0; i < src->multiTagCount(); i++) {
+        shared_ptr<base::IMultiTag> mtag = src->getMultiTag(i);
+        H5Group group = bgroup.openGroup("multi_tags", true).openGroup(mtag->name(), true);
+        DataArray positions = block->getDataArray(mtag->positions()->id());
+        auto out = make_shared<MultiTagHDF5>(file, block, group, mtag->id(), mtag->type(), mtag->name(),
+                                                   positions, mtag->createdAt());
+        shared_ptr<base::IDataArray> extents = mtag->extents();
+        if (extents) out->extents(extents->id());
+        vector<string> units = mtag->units();
+        if (!units.empty()) out->units(units);
+        copy_tag(file, block, mtag, out, group);
+    }
+
+    for (ndsize_t i = 0; i < src->groupCount(); i++) {
+        shared_ptr<base::IGroup> grp = src->getGroup(i);
+        H5Group group = bgroup.openGroup("groups", true).openGroup(grp->name(), true);
+        auto out = make_shared<GroupHDF5>(file, block, group, grp->id(), grp->type(), grp->name(),
+                                                grp->createdAt());
+        copy_sources(grp, out);
+        for (ndsize_t j = 0; j < grp->dataArrayCount(); j++) {
+            out->addDataArray(grp->getDataArray(j)->id());
+        }
+        for (ndsize_t j = 0; j < grp->tagCount(); j++) {
+            out->addTag(grp->getTag(j)->id());
+        }
+        for (ndsize_t j = 0; j < grp->multiTagCount(); j++) {
+            out->addMultiTag(grp->getMultiTag(j)->id());
+        }
+    }
+}
+
+} // namespace hdf5
+} // namespace nix
@@ -22,8 +22,11 @@ namespace hdf5 {
 EntityHDF5::EntityHDF5(const shared_ptr<IFile> &file, const H5Group &group)
     : entity_file(file), entity_group(group)
 {
-    setUpdatedAt();
-    setCreatedAt();
+    // opening an entity of a read-only file must not probe for writes
+    if (!readOnly()) {
+        setUpdatedAt();
+        setCreatedAt();
+    }
 }
 
 
@@ -101,6 +104,12 @@ H5Group EntityHDF5::group() const {
 }
 
 
+bool EntityHDF5::readOnly() const {
+    FileMode mode = entity_file->fileMode();
+    return mode == FileMode::ReadOnly || mode == FileMode::SWMRRead;
+}
+
+
 std::shared_ptr<base::IFile> EntityHDF5::file() const {
     return entity_file;
 }
@@ -78,6 +78,12 @@ protected:
 
     std::shared_ptr<base::IFile> file() const;
 
+    /**
+     * @brief Whether the file was opened for reading only, i.e. its
+     *        structure can not change while the entity is in use.
+     */
+    bool readOnly() const;
+
 };
 
 
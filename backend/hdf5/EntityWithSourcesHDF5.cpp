@@ -23,7 +23,7 @@ EntityWithSourcesHDF5::EntityWithSourcesHDF5(const std::shared_ptr<IFile> &file,
                                              const H5Group &group)
     : EntityWithMetadataHDF5(file, group), entity_block(block)
 {
-    sources_refs = this->group().openOptGroup("sources");
+    sources_refs = this->group().openOptGroup("sources", readOnly());
 }
 
 
@@ -40,7 +40,7 @@ EntityWithSourcesHDF5::EntityWithSourcesHDF5 (const std::shared_ptr<IFile> &file
                                               const std::string &name, time_t time)
     : EntityWithMetadataHDF5(file, group, id, type, name, time), entity_block(block)
 {
-    sources_refs = this->group().openOptGroup("sources");
+    sources_refs = this->group().openOptGroup("sources", readOnly());
 }
 
 
@@ -9,13 +9,19 @@
 #include "FileHDF5.hpp"
 
 #include <nix/util/util.hpp>
+#include <nix/util/filter.hpp>
+#include <nix/File.hpp>
 #include "BlockHDF5.hpp"
 #include "SectionHDF5.hpp"
+#include "PropertyHDF5.hpp"
 #include "h5x/H5Exception.hpp"
+#include "h5x/H5LinkIndex.hpp"
 
-
+#include <cstring>
+#include <exception>
 #include <fstream>
 #include <vector>
+#include <map>
 #include <ctime>
 
 using namespace std;
@@ -36,6 +42,14 @@ static unsigned int map_file_mode(FileMode mode) {
         case FileMode::Overwrite:
             return H5F_ACC_TRUNC;
 
+#if H5_VERSION_GE(1, 10, 0)
+        case FileMode::SWMRWrite:
+            return H5F_ACC_RDWR | H5F_ACC_SWMR_WRITE;
+
+        case FileMode::SWMRRead:
+            return H5F_ACC_RDONLY | H5F_ACC_SWMR_READ;
+#endif
+
         default:
             return H5F_ACC_DEFAULT;
     }
@@ -43,8 +57,15 @@ static unsigned int map_file_mode(FileMode mode) {
 
 
 FileHDF5::FileHDF5(const string &name, FileMode mode)
+    : swmr_writing(false), swmr_writes(0), flush_interval(0.0)
 {
-    if (!fileExists(name)) {
+    H5Lock lock;
+#if !H5_VERSION_GE(1, 10, 0)
+    if (mode == FileMode::SWMRWrite || mode == FileMode::SWMRRead) {
+        throw std::runtime_error("FileHDF5: SWMR file modes need HDF5 1.10 or newer");
+    }
+#endif
+    if (!fileExists(name) && mode != FileMode::SWMRWrite) {
         mode = FileMode::Overwrite;
     }
     this->mode = mode;
@@ -58,10 +79,19 @@ FileHDF5::FileHDF5(const string &name, FileMode mode)
 
     bool is_create = !fileExists(name) || h5mode == H5F_ACC_TRUNC;
 
+    // SWMR needs the latest file format
+    H5Object fapl = H5Pcreate(H5P_FILE_ACCESS);
+    fapl.check("Could not create file access plist");
+    if (mode == FileMode::SWMRWrite) {
+        res = H5Pset_libver_bounds(fapl.h5id(), H5F_LIBVER_LATEST, H5F_LIBVER_LATEST);
+        res.check("Unable to create file (H5Pset_libver_bounds failed.)");
+    }
+
     if (is_create) {
-        hid = H5Fcreate(name.c_str(), h5mode, fcpl.h5id(), H5P_DEFAULT);
+        // SWMR writing starts after the structure was created, see startSWMRWrite
+        hid = H5Fcreate(name.c_str(), H5F_ACC_TRUNC, fcpl.h5id(), fapl.h5id());
     } else {
-        hid = H5Fopen(name.c_str(), h5mode, H5P_DEFAULT);
+        hid = H5Fopen(name.c_str(), h5mode, fapl.h5id());
     }
 
     if (!H5Iis_valid(hid)) {
@@ -79,12 +109,160 @@ FileHDF5::FileHDF5(const string &name, FileMode mode)
     metadata = root.openGroup("metadata");
     data = root.openGroup("data");
 
-    setCreatedAt();
-    setUpdatedAt();
+    // an existing file is opened for SWMR writing right away
+    if (!is_create && mode == FileMode::SWMRWrite) {
+        swmr_writing = true;
+        LocID::swmrWriting(true);
+    }
+
+    if (mode != FileMode::ReadOnly && mode != FileMode::SWMRRead) {
+        setCreatedAt();
+        setUpdatedAt();
+    }
+}
+
+
+// H5Fstart_swmr_write and the SWMR file access flags came with HDF5 1.10
+#if H5_VERSION_GE(1, 10, 0)
+
+namespace {
+
+/*
+ * H5Fstart_swmr_write re-opens all objects under their ids, which fails
+ * for ids that are shared between several handles. The guard drops the
+ * references of all open objects of a file to one and restores them when
+ * it goes out of scope, also if an error is thrown in between.
+ */
+class SharedRefsGuard {
+public:
+
+    explicit SharedRefsGuard(hid_t file) {
+        ssize_t count = H5Fget_obj_count(file, H5F_OBJ_ALL | H5F_OBJ_LOCAL);
+        if (count < 0) {
+            throw H5Exception("FileHDF5::startSWMRWrite: could not count the open objects");
+        }
+        vector<hid_t> ids(static_cast<size_t>(count));
+        if (count > 0 && H5Fget_obj_ids(file, H5F_OBJ_ALL | H5F_OBJ_LOCAL, ids.size(), ids.data()) < 0) {
+            throw H5Exception("FileHDF5::startSWMRWrite: could not get the open objects");
+        }
+
+        // all counts are known before the first one is changed
+        vector<int> refs(ids.size());
+        for (size_t i = 0; i < ids.size(); i++) {
+            refs[i] = H5Iget_ref(ids[i]);
+            if (refs[i] < 0) {
+                throw H5Exception("FileHDF5::startSWMRWrite: could not get the references of an object");
+            }
+        }
+
+        dropped.reserve(ids.size());
+        for (size_t i = 0; i < ids.size(); i++) {
+            dropped.emplace_back(ids[i], 0);
+            for (int r = refs[i]; r > 1; r--) {
+                if (H5Idec_ref(ids[i]) < 0) {
+                    restore();
+                    throw H5Exception("FileHDF5::startSWMRWrite: could not release an object");
+                }
+                dropped.back().second++;
+            }
+        }
+    }
+
+    SharedRefsGuard(const SharedRefsGuard &other) = delete;
+    SharedRefsGuard &operator=(const SharedRefsGuard &other) = delete;
+
+    ~SharedRefsGuard() {
+        restore();
+    }
+
+private:
+
+    void restore() {
+        for (auto &id : dropped) {
+            for (; id.second > 0; id.second--) {
+                H5Iinc_ref(id.first);
+            }
+        }
+    }
+
+    vector<pair<hid_t, int>> dropped;
+};
+
+} // namespace
+
+
+void FileHDF5::startSWMRWrite() {
+    H5Lock lock;
+    if (mode != FileMode::SWMRWrite) {
+        throw std::logic_error("FileHDF5::startSWMRWrite: file was not opened in SWMRWrite mode");
+    }
+    if (swmr_writing) {
+        return;
+    }
+
+    herr_t started;
+    {
+        SharedRefsGuard guard(hid);
+        started = H5Fstart_swmr_write(hid);
+    }
+
+    HErr res = started;
+    res.check("FileHDF5::startSWMRWrite: H5Fstart_swmr_write failed");
+    swmr_writing = true;
+    LocID::swmrWriting(true);
+    last_flush = std::chrono::steady_clock::now();
+}
+
+#else
+
+void FileHDF5::startSWMRWrite() {
+    throw std::runtime_error("FileHDF5::startSWMRWrite: SWMR needs HDF5 1.10 or newer");
+}
+
+#endif
+
+
+void FileHDF5::flushInterval(double seconds) {
+    if (!(seconds >= 0.0)) {
+        throw std::invalid_argument("FileHDF5::flushInterval: interval must not be negative");
+    }
+    flush_interval = seconds;
+}
+
+
+double FileHDF5::flushInterval() const {
+    return flush_interval;
+}
+
+
+void FileHDF5::dataWritten() {
+    if (!swmr_writing) {
+        return;
+    }
+
+    swmr_writes++;
+    H5Lock lock;
+    auto now = std::chrono::steady_clock::now();
+    if (std::chrono::duration<double>(now - last_flush).count() >= flush_interval) {
+        HErr res = H5Fflush(hid, H5F_SCOPE_LOCAL);
+        res.check("FileHDF5::dataWritten: could not flush file");
+        last_flush = now;
+    }
+}
+
+
+bool FileHDF5::swmrWriting() const {
+    return swmr_writing;
+}
+
+
+uint64_t FileHDF5::swmrWrites() const {
+    return swmr_writes;
 }
 
 
 bool FileHDF5::flush() {
+    H5Lock lock;
     HErr err = H5Fflush(hid, H5F_SCOPE_GLOBAL);
     return !err.isError();
 }        
@@ -199,6 +377,408 @@ ndsize_t FileHDF5::sectionCount() const {
 }
 
 
+//--------------------------------------------------
+// Metadata snapshots
+//--------------------------------------------------
+
+static void read_opt_attr(const LocID &obj, const string &name, boost::optional<string> &target) {
+    string value;
+    if (obj.getAttr(name, value)) {
+        target = value;
+    }
+}
+
+
+static void read_time_attr(const LocID &obj, const string &name, time_t &target) {
+    string value;
+    if (obj.getAttr(name, value)) {
+        target = util::strToTime(value);
+    }
+}
+
+
+static void snapshot_properties(const shared_ptr<base::IFile> &file, const H5Group &container,
+                                size_t section, MetadataSnapshot &snapshot) {
+    for (const string &link_name : container.objectNames()) {
+        DataSet dset = container.openData(link_name);
+        PropertyHDF5 prop(file, dset);
+
+        vector<Value> values = prop.values();
+        size_t index = values.empty() ?
+                       snapshot.addProperty(section, prop.name(), prop.dataType(), prop.id()) :
+                       snapshot.addProperty(section, prop.name(), values, prop.id());
+
+        MetadataSnapshot::PropertyNode &node = snapshot.property(index);
+        read_opt_attr(dset, "definition", node.definition);
+        read_opt_attr(dset, "unit", node.unit);
+        read_opt_attr(dset, "mapping", node.mapping);
+        read_time_attr(dset, "created_at", node.created_at);
+        read_time_attr(dset, "updated_at", node.updated_at);
+    }
+}
+
+
+static void snapshot_sections(const shared_ptr<base::IFile> &file, const H5Group &container,
+                              size_t parent, MetadataSnapshot &snapshot) {
+    // the section groups are read directly: constructing SectionHDF5
+    // objects would probe (and possibly write) the time stamps and
+    // resolving links through ISection::link() searches the whole file
+    for (const string &link_name : container.objectNames()) {
+        H5Group group = container.openGroup(link_name, false);
+
+        string id, name, type;
+        group.getAttr("entity_id", id);
+        group.getAttr("name", name);
+        group.getAttr("type", type);
+
+        size_t index = snapshot.addSection(name, type, parent, id);
+
+        MetadataSnapshot::SectionNode &node = snapshot.section(index);
+        read_opt_attr(group, "definition", node.definition);
+        read_opt_attr(group, "repository", node.repository);
+        read_opt_attr(group, "mapping", node.mapping);
+        read_time_attr(group, "created_at", node.created_at);
+        read_time_attr(group, "updated_at", node.updated_at);
+
+        if (group.hasGroup("link")) {
+            string link_id;
+            group.openGroup("link", false).getAttr("entity_id", link_id);
+            node.link = link_id;
+        }
+
+        if (group.hasGroup("properties")) {
+            snapshot_properties(file, group.openGroup("properties", false), index, snapshot);
+        }
+
+        if (group.hasGroup("sections")) {
+            snapshot_sections(file, group.openGroup("sections", false), index, snapshot);
+        }
+    }
+}
+
+
+MetadataSnapshot FileHDF5::loadMetadataSnapshot() const {
+    MetadataSnapshot snapshot;
+    snapshot_sections(file(), metadata, MetadataSnapshot::npos, snapshot);
+    return snapshot;
+}
+
+
+namespace {
+
+/**
+ * State shared by all sections written by storeMetadataSnapshot.
+ */
+struct SnapshotWriter {
+    shared_ptr<base::IFile> file;
+    const MetadataSnapshot &snapshot;
+    string now;
+    map<DataType, h5x::DataType> file_types;
+    vector<H5Group> groups;
+    vector<bool> keep_group;
+
+    SnapshotWriter(const shared_ptr<base::IFile> &file, const MetadataSnapshot &snapshot)
+        : file(file), snapshot(snapshot), now(util::timeToStr(util::getTime())),
+          groups(snapshot.sectionCount()), keep_group(snapshot.sectionCount(), false)
+    {
+        // only groups that take part in links must stay open
+        for (size_t i = 0; i < snapshot.sectionCount(); i++) {
+            const boost::optional<string> &link = snapshot.section(i).link;
+            if (link) {
+                keep_group[i] = true;
+                size_t target = snapshot.findSectionById(*link);
+                if (target != MetadataSnapshot::npos) {
+                    keep_group[target] = true;
+                }
+            }
+        }
+    }
+
+    const h5x::DataType &fileType(DataType dtype) {
+        auto it = file_types.find(dtype);
+        if (it == file_types.end()) {
+            it = file_types.emplace(dtype, PropertyHDF5::fileTypeForValue(dtype)).first;
+        }
+        return it->second;
+    }
+
+    string timeStamp(time_t t) const {
+        return t > 0 ? util::timeToStr(t) : now;
+    }
+
+    void writeProperty(const H5Group &container, size_t index) {
+        const MetadataSnapshot::PropertyNode &node = snapshot.property(index);
+
+        DataSet dset = container.createData(node.name, fileType(node.data_type), {0});
+        dset.setAttr("name", node.name);
+        dset.setAttr("entity_id", node.id.empty() ? util::createId() : node.id);
+        dset.setAttr("created_at", timeStamp(node.created_at));
+        dset.setAttr("updated_at", now);
+
+        if (node.definition) dset.setAttr("definition", *node.definition);
+        if (node.unit) dset.setAttr("unit", *node.unit);
+        if (node.mapping) dset.setAttr("mapping", *node.mapping);
+
+        if (node.value_count > 0) {
+            MetadataSnapshot::ValueRange values = snapshot.values(index);
+            PropertyHDF5 prop(file, dset);
+            prop.values(vector<Value>(values.begin(), values.end()));
+        }
+    }
+
+    void writeSection(const H5Group &container, size_t index) {
+        const MetadataSnapshot::SectionNode &node = snapshot.section(index);
+
+        H5Group group = container.openGroup(node.name, true);
+        group.setAttr("entity_id", node.id.empty() ? util::createId() : node.id);
+        group.setAttr("created_at", timeStamp(node.created_at));
+        group.setAttr("updated_at", now);
+        group.setAttr("name", node.name);
+        group.setAttr("type", node.type);
+
+        if (node.definition) group.setAttr("definition", *node.definition);
+        if (node.repository) group.setAttr("repository", *node.repository);
+        if (node.mapping) group.setAttr("mapping", *node.mapping);
+
+        MetadataSnapshot::IndexRange props = snapshot.properties(index);
+        if (!props.empty()) {
+            H5Group prop_group = group.openGroup("properties", true);
+            for (size_t p : props) {
+                writeProperty(prop_group, p);
+            }
+        }
+
+        MetadataSnapshot::IndexRange children = snapshot.sections(index);
+        if (!children.empty()) {
+            H5Group sec_group = group.openGroup("sections", true);
+            for (size_t c : children) {
+                writeSection(sec_group, c);
+            }
+        }
+
+        if (keep_group[index]) {
+            groups[index] = group;
+        }
+    }
+
+    void writeLinks() {
+        for (size_t i = 0; i < snapshot.sectionCount(); i++) {
+            const boost::optional<string> &link = snapshot.section(i).link;
+            if (!link) {
+                continue;
+            }
+
+            size_t target = snapshot.findSectionById(*link);
+            if (target != MetadataSnapshot::npos) {
+                groups[i].createLink(groups[target], "link");
+            } else {
+                // link into the existing part of the file (checked by the front-end)
+                auto found = File(file).findSections(util::IdFilter<Section>(*link));
+                auto other = dynamic_pointer_cast<SectionHDF5>(found.front().impl());
+                groups[i].createLink(other->group(), "link");
+            }
+        }
+    }
+};
+
+} // anonymous namespace
+
+
+void FileHDF5::storeMetadataSnapshot(const MetadataSnapshot &snapshot) {
+    SnapshotWriter writer(file(), snapshot);
+
+    for (size_t root : snapshot.rootSections()) {
+        writer.writeSection(metadata, root);
+    }
+
+    writer.writeLinks();
+}
+
+
+//--------------------------------------------------
+// Storage report
+//--------------------------------------------------
+
+namespace {
+
+/**
+ * State of the single H5Ovisit pass of storageReport.
+ *
+ * Every object is visited once, under the first path it is found by when
+ * iterating by name. Entities are therefore recognized by the name of the
+ * group that contains them, which also holds for entities that are first
+ * reached through a link, e.g. sources of a DataArray.
+ */
+struct StorageVisitor {
+    StorageReport &report;
+    map<string, size_t> blocks;
+    map<string, size_t> arrays;
+    // path components of the current object, reused to avoid allocations
+    vector<string> parts;
+    const string empty;
+    exception_ptr error;
+
+    explicit StorageVisitor(StorageReport &report) : report(report) { }
+
+    void splitPath(const char *name) {
+        size_t n = 0;
+        if (strcmp(name, ".") != 0) {
+            for (const char *start = name;; n++) {
+                const char *end = strchr(start, '/');
+                if (n == parts.size()) {
+                    parts.emplace_back();
+                }
+                if (end == nullptr) {
+                    parts[n++].assign(start);
+                    break;
+                }
+                parts[n].assign(start, end);
+                start = end + 1;
+            }
+        }
+        parts.resize(n);
+    }
+
+    void visit(hid_t root, const char *name, const H5O_info_t *info) {
+        splitPath(name);
+        const size_t n = parts.size();
+        const string &parent = n >= 2 ? parts[n - 2] : empty;
+
+        report.objects++;
+        report.attributes += info->num_attrs;
+        report.metadata_bytes += info->hdr.space.total +
+                                 info->meta_size.obj.index_size + info->meta_size.obj.heap_size +
+                                 info->meta_size.attr.index_size + info->meta_size.attr.heap_size;
+
+        StorageReport::Block *block = nullptr;
+        if (n >= 2 && parts[0] == "data") {
+            auto it = blocks.find(parts[1]);
+            if (it == blocks.end()) {
+                it = blocks.emplace(parts[1], report.blocks.size()).first;
+                report.blocks.emplace_back();
+                report.blocks.back().name = parts[1];
+            }
+            block = &report.blocks[it->second];
+            if (n > 2) {
+                block->objects++;
+                block->attributes += info->num_attrs;
+            }
+        }
+
+        if (info->type == H5O_TYPE_GROUP) {
+            // opening by address skips the lookup of every path component
+            H5Object group = H5Oopen_by_addr(root, info->addr);
+            group.check("FileHDF5::storageReport(): Could not open group");
+            H5G_info_t ginfo;
+            HErr res = H5Gget_info(group.h5id(), &ginfo);
+            res.check("FileHDF5::storageReport(): Could not get group info");
+            report.addGroup(n > 0 ? "/" + string(name) : "/", static_cast<size_t>(ginfo.nlinks));
+
+            if (block && n > 3) {
+                if (parent == "data_arrays") block->data_arrays++;
+                else if (parent == "dimensions") block->dimensions++;
+                else if (parent == "tags") block->tags++;
+                else if (parent == "multi_tags") block->multi_tags++;
+                else if (parent == "features") block->features++;
+                else if (parent == "sources") block->sources++;
+                else if (parent == "groups") block->groups++;
+            }
+            // root sections, subsections and sections first reached through
+            // the metadata link of an entity or the link of another section
+            if ((n == 2 && parts[0] == "metadata") ||
+                (n > 2 && (parent == "sections" || parts[n - 1] == "metadata" || parts[n - 1] == "link"))) {
+                report.sections++;
+            }
+        } else if (info->type == H5O_TYPE_DATASET) {
+            if (parent == "properties") {
+                report.properties++;
+            } else if (block && n == 5 && parts[2] == "data_arrays" && parts[4] == "data") {
+                addArray(root, info->addr);
+            } else if (block && n == 6 && parts[2] == "data_arrays" && parts[4] == "derived") {
+                auto it = arrays.find(parts[1] + "/" + parts[3]);
+                if (it != arrays.end()) {
+                    DataSet ds = H5Oopen_by_addr(root, info->addr);
+                    ds.check("FileHDF5::storageReport(): Could not open derived data");
+                    report.arrays[it->second].derived_bytes += ds.storageSize();
+                }
+            }
+        }
+    }
+
+    void addArray(hid_t root, haddr_t addr) {
+        DataSet ds = H5Oopen_by_addr(root, addr);
+        ds.check("FileHDF5::storageReport(): Could not open data");
+
+        StorageReport::Array array;
+        array.block = parts[1];
+        array.name = parts[3];
+        array.path = "/data/" + parts[1] + "/data_arrays/" + parts[3];
+
+        const h5x::DataType ftype = ds.dataType();
+        array.data_type = data_type_from_h5(ftype);
+        array.extent = ds.size();
+        array.chunks = ds.chunking();
+        array.filters = ds.filterNames();
+        array.chunk_count = ds.allocatedChunks();
+        array.storage_bytes = ds.storageSize();
+
+        const ndsize_t esize = ftype.size();
+        array.logical_bytes = array.extent.nelms() * esize;
+        array.allocated_bytes = array.chunks.size() > 0 ?
+                                array.chunk_count * array.chunks.nelms() * esize :
+                                array.storage_bytes;
+
+        arrays.emplace(parts[1] + "/" + parts[3], report.arrays.size());
+        report.arrays.push_back(std::move(array));
+    }
+};
+
+
+herr_t visit_storage(hid_t root, const char *name, const H5O_info_t *info, void *op_data) {
+    StorageVisitor *visitor = static_cast<StorageVisitor *>(op_data);
+    // exceptions must not unwind through the HDF5 library
+    try {
+        visitor->visit(root, name, info);
+    } catch (...) {
+        visitor->error = current_exception();
+        return -1;
+    }
+    return 0;
+}
+
+} // anonymous namespace
+
+
+StorageReport FileHDF5::storageReport() const {
+    H5Lock lock;
+    StorageReport report;
+    report.format = format();
+    report.location = location();
+
+    hsize_t size = 0;
+    HErr res = H5Fget_filesize(hid, &size);
+    res.check("FileHDF5::storageReport(): Could not get file size");
+    report.file_size = size;
+
+    // by name in increasing order, so the arrays of a block are visited
+    // before the tags and groups that link to them
+    StorageVisitor visitor(report);
+#if H5_VERSION_GE(1, 10, 3)
+    herr_t status = H5Ovisit2(root.h5id(), H5_INDEX_NAME, H5_ITER_INC, visit_storage, &visitor,
+                              H5O_INFO_BASIC | H5O_INFO_NUM_ATTRS | H5O_INFO_HDR | H5O_INFO_META_SIZE);
+#else
+    herr_t status = H5Ovisit(root.h5id(), H5_INDEX_NAME, H5_ITER_INC, visit_storage, &visitor);
+#endif
+    if (visitor.error) {
+        rethrow_exception(visitor.error);
+    }
+    if (status < 0) {
+        throw H5Exception("FileHDF5::storageReport(): H5Ovisit failed");
+    }
+    return report;
+}
+
+
 //--------------------------------------------------
 // Local attributes
 //--------------------------------------------------
@@ -260,6 +840,7 @@ string FileHDF5::format() const {
 
 
 string FileHDF5::location() const {
+    H5Lock lock;
     ssize_t size = H5Fget_name(hid, nullptr, 0);
 
     if (size < 0) {
@@ -277,10 +858,18 @@ string FileHDF5::location() const {
 
 
 void FileHDF5::close() {
+    H5Lock lock;
 
     if (!isOpen())
         return;
 
+    H5LinkIndex::forget(*this);
+
+    if (swmr_writing) {
+        swmr_writing = false;
+        LocID::swmrWriting(false);
+    }
+
     data.close();
     metadata.close();
     root.close();
@@ -347,7 +936,7 @@ bool FileHDF5::checkHeader(FileMode mode) const {
         } else {
             FormatVersion ver = FormatVersion(vv);
 
-            if (mode == FileMode::ReadWrite) {
+            if (mode == FileMode::ReadWrite || mode == FileMode::SWMRWrite) {
                 check = my_version.canWrite(ver);
             } else {
                 check = my_version.canRead(ver);
@@ -370,6 +959,7 @@ void FileHDF5::createHeader() const {
 }
     
 void FileHDF5::openRoot() {
+    H5Lock lock;
     root = H5Group(H5Gopen2(hid, "/", H5P_DEFAULT));
     root.check("Could not open root group");
 }
@@ -14,6 +14,7 @@
 
 #include "h5x/H5Group.hpp"
 
+#include <chrono>
 #include <string>
 #include <memory>
 
@@ -33,6 +34,12 @@ private:
     H5Group root, metadata, data;
     FileMode mode;
 
+    /* state of SWMR writing */
+    bool swmr_writing;
+    uint64_t swmr_writes;
+    double flush_interval;
+    std::chrono::steady_clock::time_point last_flush;
+
 public:
 
     /**
@@ -89,6 +96,15 @@ public:
 
     bool deleteSection(const std::string &name_or_id);
 
+
+    MetadataSnapshot loadMetadataSnapshot() const;
+
+
+    void storeMetadataSnapshot(const MetadataSnapshot &snapshot);
+
+
+    StorageReport storageReport() const;
+
     //--------------------------------------------------
     // Methods for file attribute access.
     //--------------------------------------------------
@@ -130,6 +146,33 @@ public:
     FileMode fileMode() const;
 
 
+    void startSWMRWrite();
+
+
+    void flushInterval(double seconds);
+
+
+    double flushInterval() const;
+
+    /**
+     * Called after data was written; flushes the file during SWMR writing
+     * once the flush interval has passed since the last flush.
+     */
+    void dataWritten();
+
+
+    /**
+     * True once the structure of the file is fixed for SWMR writing.
+     */
+    bool swmrWriting() const;
+
+    /**
+     * Number of writes of data through this handle during SWMR writing,
+     * which do not change the data versions of the arrays.
+     */
+    uint64_t swmrWrites() const;
+
+
     bool operator==(const FileHDF5 &other) const;
 
 
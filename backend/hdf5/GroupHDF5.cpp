@@ -20,9 +20,9 @@ namespace hdf5 {
 
 GroupHDF5::GroupHDF5(const std::shared_ptr<base::IFile> &file, const std::shared_ptr<base::IBlock> &block,
                      const H5Group &h5group)  : EntityWithSourcesHDF5(file, block, h5group) {
-    data_array_group = this->group().openOptGroup("data_arrays");
-    tag_group = this->group().openOptGroup("tags");
-    multi_tag_group = this->group().openOptGroup("multi_tags");
+    data_array_group = this->group().openOptGroup("data_arrays", readOnly());
+    tag_group = this->group().openOptGroup("tags", readOnly());
+    multi_tag_group = this->group().openOptGroup("multi_tags", readOnly());
 }
 
 
@@ -36,9 +36,9 @@ GroupHDF5::GroupHDF5(const std::shared_ptr<base::IFile> &file, const std::shared
 GroupHDF5::GroupHDF5(const std::shared_ptr<base::IFile> &file, const std::shared_ptr<base::IBlock> &block,
                      const H5Group &h5group, const std::string &id, const std::string &type, const std::string &name,
                      time_t time): EntityWithSourcesHDF5(file, block, h5group, id, type, name, time) {
-    data_array_group = this->group().openOptGroup("data_arrays");
-    tag_group = this->group().openOptGroup("tags");
-    multi_tag_group = this->group().openOptGroup("multi_tags");
+    data_array_group = this->group().openOptGroup("data_arrays", readOnly());
+    tag_group = this->group().openOptGroup("tags", readOnly());
+    multi_tag_group = this->group().openOptGroup("multi_tags", readOnly());
 }
 
 
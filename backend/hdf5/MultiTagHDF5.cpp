@@ -12,13 +12,78 @@
 #include <nix/util/util.hpp>
 #include "DataArrayHDF5.hpp"
 #include "BlockHDF5.hpp"
+#include "FileHDF5.hpp"
 #include "FeatureHDF5.hpp"
+#include "h5x/H5Lock.hpp"
 
 using namespace nix::base;
 
 namespace nix {
 namespace hdf5 {
 
+namespace {
+
+/*
+ * The interval index is stored in the group "interval_index" of the tag
+ * together with the data versions of the positions and extents it was
+ * built from. Writing to either array drops its version and with it the
+ * stored index. Writes during SWMR writing keep the versions: the stored
+ * index is not used while the file is written in SWMR mode, and the number
+ * of positions is stored as well, so that later readers notice appends.
+ * Values that were overwritten in place during SWMR writing, or by other
+ * software that does not maintain the versions, are not noticed.
+ */
+std::shared_ptr<const IntervalIndex> load_index(const H5Group &group, const std::string &positions_version,
+                                                const std::string &extents_version, ndsize_t rows) {
+    std::string pv, ev;
+    group.getAttr("positions_version", pv);
+    group.getAttr("extents_version", ev);
+    if (pv != positions_version || ev != extents_version) {
+        return nullptr;
+    }
+
+    ndsize_t stored_rows = 0;
+    if (!group.getAttr("positions", stored_rows) || stored_rows != rows) {
+        return nullptr;
+    }
+
+    ndsize_t dims = 0;
+    std::vector<double> starts, ends;
+    std::vector<ndsize_t> order;
+    if (!group.getAttr("dimensions", dims) || !group.getData("start", starts) ||
+        !group.getData("end", ends) || !group.getData("row", order)) {
+        return nullptr;
+    }
+
+    return std::make_shared<IntervalIndex>(IntervalIndex::fromSorted(dims, rows, std::move(starts),
+                                                                     std::move(ends), std::move(order)));
+}
+
+
+void store_index(H5Group tag, const IntervalIndex &index, const std::string &positions_version,
+                 const std::string &extents_version) {
+    if (tag.hasGroup("interval_index")) {
+        tag.removeGroup("interval_index");
+    }
+    if (index.size() == 0) {
+        return;
+    }
+
+    H5Group group = tag.openGroup("interval_index", true);
+    group.setData("start", index.starts());
+    group.setData("end", index.ends());
+    group.setData("row", index.rows());
+    group.setAttr("dimensions", static_cast<ndsize_t>(index.dimensionCount()));
+    group.setAttr("positions", index.positionCount());
+    // the versions go last, a partially written index is never used
+    group.setAttr("positions_version", positions_version);
+    if (!extents_version.empty()) {
+        group.setAttr("extents_version", extents_version);
+    }
+}
+
+}
+
 
 MultiTagHDF5::MultiTagHDF5(const std::shared_ptr<IFile> &file, const std::shared_ptr<IBlock> &block, const H5Group &group)
     : BaseTagHDF5(file, block, group)
@@ -148,6 +213,53 @@ void MultiTagHDF5::units(const none_t t) {
 }
 
 
+std::shared_ptr<const IntervalIndex> MultiTagHDF5::intervalIndex() const {
+    H5Lock lock;
+    auto pos = std::dynamic_pointer_cast<DataArrayHDF5>(positions());
+    auto ext = std::dynamic_pointer_cast<DataArrayHDF5>(extents());
+
+    const FileMode mode = file()->fileMode();
+    const NDSize shape = pos->dataExtent();
+    const ndsize_t rows = shape.size() > 0 ? shape[0] : 0;
+
+    // writes during SWMR writing keep the versions, they are counted by the file instead
+    auto f = std::dynamic_pointer_cast<FileHDF5>(file());
+    const bool swmr = f->swmrWriting();
+
+    std::string pv = pos->dataVersion();
+    std::string ev = ext ? ext->dataVersion() : "";
+    std::vector<std::string> stamp = {pos->id(), pv, ext ? ext->id() : "", ev, util::numToStr(rows),
+                                      util::numToStr(f->swmrWrites())};
+
+    // without versions the data may have changed in place, unless nobody
+    // can write it or all writes are counted
+    const bool versioned = !pv.empty() && (!ext || !ev.empty());
+    if (index && index_stamp == stamp && (versioned || swmr || mode == FileMode::ReadOnly)) {
+        return index;
+    }
+
+    std::shared_ptr<const IntervalIndex> result;
+    if (versioned && !swmr && group().hasGroup("interval_index")) {
+        result = load_index(group().openGroup("interval_index", false), pv, ev, rows);
+    }
+
+    if (!result) {
+        result = std::make_shared<IntervalIndex>(IntervalIndex::build(*pos, ext));
+        if (mode == FileMode::ReadWrite || mode == FileMode::Overwrite) {
+            pv = pos->stampDataVersion();
+            ev = ext ? ext->stampDataVersion() : "";
+            store_index(group(), *result, pv, ev);
+            stamp[1] = pv;
+            stamp[3] = ev;
+        }
+    }
+
+    index = result;
+    index_stamp = stamp;
+    return index;
+}
+
+
 bool MultiTagHDF5::checkDimensions(const DataArray &a, const DataArray &b)const {
     return a.dataExtent() == b.dataExtent();
 }
@@ -12,6 +12,7 @@
 #define NIX_MULTI_TAG_HDF5_H
 
 #include <nix/base/IMultiTag.hpp>
+#include <nix/IntervalIndex.hpp>
 #include "BaseTagHDF5.hpp"
 
 #include <string>
@@ -73,10 +74,17 @@ public:
     void units(const none_t t);
 
 
+    std::shared_ptr<const IntervalIndex> intervalIndex() const;
+
+
     virtual ~MultiTagHDF5();
 
 private:
 
+    // the last index used by this handle and the state of the data it was built from
+    mutable std::shared_ptr<const IntervalIndex> index;
+    mutable std::vector<std::string> index_stamp;
+
     bool checkDimensions(const DataArray &a, const DataArray &b) const;
 
 };
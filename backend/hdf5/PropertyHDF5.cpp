@@ -250,15 +250,15 @@ struct PACKED FileValue  {
 //
 
 template<typename T>
-h5x::DataType h5_type_for_value(bool for_memory)
+h5x::DataType make_type_for_value(bool for_memory)
 {
     typedef FileValue<T> file_value_t;
 
     h5x::DataType ct = h5x::DataType::makeCompound(sizeof(file_value_t));
     h5x::DataType strType = h5x::DataType::makeStrType();
 
-    h5x::DataType value_type = data_type_to_h5(to_data_type<T>::value, for_memory);
-    h5x::DataType double_type = data_type_to_h5(DataType::Double, for_memory);
+    const h5x::DataType &value_type = data_type_to_h5(to_data_type<T>::value, for_memory);
+    const h5x::DataType &double_type = data_type_to_h5(DataType::Double, for_memory);
 
     ct.insert("value", HOFFSET(file_value_t, value), value_type);
     ct.insert("uncertainty", HOFFSET(file_value_t, uncertainty), double_type);
@@ -267,9 +267,19 @@ h5x::DataType h5_type_for_value(bool for_memory)
     ct.insert("encoder", HOFFSET(file_value_t, encoder), strType);
     ct.insert("checksum", HOFFSET(file_value_t, checksum), strType);
 
+    ct.lock();
     return ct;
 }
 
+// the compound types are built once per process and never closed
+template<typename T>
+const h5x::DataType &h5_type_for_value(bool for_memory)
+{
+    static const h5x::DataType *file_type = new h5x::DataType(make_type_for_value<T>(false));
+    static const h5x::DataType *mem_type = new h5x::DataType(make_type_for_value<T>(true));
+    return for_memory ? *mem_type : *file_type;
+}
+
 #if 0 //set to one to check that all supported DataTypes are handled
 #define CHECK_SUPOORTED_VALUES
 #endif
@@ -299,7 +309,7 @@ h5x::DataType PropertyHDF5::fileTypeForValue(DataType dtype)
 template<typename T>
 void do_read_value(const DataSet &h5ds, size_t size, std::vector<Value> &values)
 {
-    h5x::DataType memType = h5_type_for_value<T>(true);
+    const h5x::DataType &memType = h5_type_for_value<T>(true);
 
     typedef FileValue<T> file_value_t;
     std::vector<file_value_t> fileValues;
@@ -344,7 +354,7 @@ void do_write_value(DataSet &h5ds, const std::vector<Value> &values)
         return fileVal;
     });
 
-    h5x::DataType memType = h5_type_for_value<T>(true);
+    const h5x::DataType &memType = h5_type_for_value<T>(true);
     h5ds.write(fileValues.data(), memType, H5S_ALL, H5S_ALL);
 }
 
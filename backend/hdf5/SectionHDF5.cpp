@@ -31,8 +31,8 @@ SectionHDF5::SectionHDF5(const std::shared_ptr<base::IFile> &file, const H5Group
 SectionHDF5::SectionHDF5(const std::shared_ptr<base::IFile> &file, const std::shared_ptr<base::ISection> &parent, const H5Group &group)
     : NamedEntityHDF5(file, group), parent_section(parent)
 {
-    property_group = this->group().openOptGroup("properties");
-    section_group = this->group().openOptGroup("sections");
+    property_group = this->group().openOptGroup("properties", readOnly());
+    section_group = this->group().openOptGroup("sections", readOnly());
 }
 
 
@@ -61,8 +61,8 @@ SectionHDF5::SectionHDF5(const shared_ptr<IFile> &file, const shared_ptr<ISectio
                          const string &id, const string &type, const string &name, time_t time)
     : NamedEntityHDF5(file, group, id, type, name, time), parent_section(parent)
 {
-    property_group = this->group().openOptGroup("properties");
-    section_group = this->group().openOptGroup("sections");
+    property_group = this->group().openOptGroup("properties", readOnly());
+    section_group = this->group().openOptGroup("sections", readOnly());
 }
 
 //--------------------------------------------------
@@ -20,7 +20,7 @@ namespace hdf5 {
 SourceHDF5::SourceHDF5(const std::shared_ptr<IFile> &file,  const std::shared_ptr<IBlock> &block, const H5Group &group)
     : EntityWithMetadataHDF5(file, group), entity_block(block)
 {
-    source_group = this->group().openOptGroup("sources");
+    source_group = this->group().openOptGroup("sources", readOnly());
 }
     
     
@@ -33,7 +33,7 @@ SourceHDF5::SourceHDF5(const shared_ptr<IFile> &file,  const std::shared_ptr<IBl
 SourceHDF5::SourceHDF5(const shared_ptr<IFile> &file,  const std::shared_ptr<IBlock> &block, const H5Group &group, const std::string &id, const string &type, const string &name, time_t time)
     : EntityWithMetadataHDF5(file, group, id, type, name, time), entity_block(block)
 {
-    source_group = this->group().openOptGroup("sources");
+    source_group = this->group().openOptGroup("sources", readOnly());
 }
 
 
@@ -26,11 +26,13 @@ Attribute::Attribute(const Attribute &other) : H5Object(other) {
 
 
 void Attribute::read(h5x::DataType mem_type, const NDSize &size, void *data) {
+    H5Lock lock;
     HErr status = H5Aread(hid, mem_type.h5id(), data);
     status.check("Attribute::read(): Could not read data");
 }
 
 void Attribute::read(h5x::DataType mem_type, const NDSize &size, std::string *data) {
+    H5Lock lock;
     StringWriter writer(size, data);
     read(mem_type, size, *writer);
     writer.finish();
@@ -42,6 +44,7 @@ void Attribute::read(h5x::DataType mem_type, const NDSize &size, std::string *da
 }
 
 void Attribute::write(h5x::DataType mem_type, const NDSize &size, const void *data) {
+    H5Lock lock;
     HErr status = H5Awrite(hid, mem_type.h5id(), data);
     status.check("Attribute::write(): Could not write data");
 }
@@ -53,6 +56,7 @@ void Attribute::write(h5x::DataType mem_type, const NDSize &size, const std::str
 
 
 DataSpace Attribute::getSpace() const {
+    H5Lock lock;
 
     DataSpace space = H5Aget_space(hid);
     space.check("Attribute::getSpace(): Dould not get data space");
@@ -17,6 +17,7 @@ namespace hdf5 {
 
 DataSpace DataSpace::create(const NDSize &dims, const NDSize &maxdims)
 {
+    H5Lock lock;
     DataSpace space;
 
     hid_t spaceId;
@@ -50,6 +51,7 @@ DataSpace DataSpace::create(const NDSize &dims, bool maxdims_unlimited)
 }
 
 NDSize DataSpace::extent() const {
+    H5Lock lock;
 
     int ndims = H5Sget_simple_extent_ndims(hid);
     if (ndims < 0) {
@@ -68,6 +70,7 @@ NDSize DataSpace::extent() const {
 
 
 void DataSpace::hyperslab(const NDSize &count, const NDSize &start, H5S_seloper_t op) {
+    H5Lock lock;
     HErr status = H5Sselect_hyperslab(hid, op, start.data(), nullptr, count.data(), nullptr);
     status.check("DataSpace::hyperslab(): H5Sselect_hyperslab() failed!");
 }
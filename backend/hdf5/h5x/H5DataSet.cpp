@@ -27,12 +27,14 @@ DataSet::DataSet(const DataSet &other)
 
 void DataSet::read(void *data, const h5x::DataType &memType, const DataSpace &memSpace, const DataSpace &fileSpace) const
 {
+    H5Lock lock;
     HErr res = H5Dread(hid, memType.h5id(), memSpace.h5id(), fileSpace.h5id(), H5P_DEFAULT, data);
     res.check("DataSet::read() IO error");
 }
 
 void DataSet::write(const void *data, const h5x::DataType &memType, const DataSpace &memSpace, const DataSpace &fileSpace)
 {
+    H5Lock lock;
     HErr res = H5Dwrite(hid, memType.h5id(), memSpace.h5id(), fileSpace.h5id(), H5P_DEFAULT, data);
     res.check("DataSet::write() IOError");
 }
@@ -46,7 +48,7 @@ void DataSet::read(void *data, h5x::DataType memType, const NDSize &count, const
         StringWriter writer(count, static_cast<std::string *>(data));
         read(*writer, memType, memSpace, fileSpace);
         writer.finish();
-        vlenReclaim(memType.h5id(), *writer);
+        vlenReclaim(memType, *writer);
     } else {
         read(data, memType, memSpace, fileSpace);
     }
@@ -153,6 +155,7 @@ NDSize DataSet::guessChunking(NDSize chunks, size_t element_size)
 
 void DataSet::setExtent(const NDSize &dims)
 {
+    H5Lock lock;
     DataSpace space = getSpace();
 
     if (space.extent().size() != dims.size()) {
@@ -170,8 +173,20 @@ NDSize DataSet::size() const
     return getSpace().extent();
 }
 
+void DataSet::refresh()
+{
+#if H5_VERSION_GE(1, 10, 0)
+    H5Lock lock;
+    HErr res = H5Drefresh(hid);
+    res.check("DataSet::refresh(): H5Drefresh failed");
+#else
+    throw std::runtime_error("DataSet::refresh(): H5Drefresh needs HDF5 1.10 or newer");
+#endif
+}
+
 void DataSet::vlenReclaim(h5x::DataType mem_type, void *data, DataSpace *dspace) const
 {
+    H5Lock lock;
     HErr res;
     if (dspace != nullptr) {
         res = H5Dvlen_reclaim(mem_type.h5id(), dspace->h5id(), H5P_DEFAULT, data);
@@ -186,18 +201,194 @@ void DataSet::vlenReclaim(h5x::DataType mem_type, void *data, DataSpace *dspace)
 
 h5x::DataType DataSet::dataType(void) const
 {
+    H5Lock lock;
     h5x::DataType ftype = H5Dget_type(hid);
     ftype.check("DataSet::dataType(): H5Dget_type failed");
     return ftype;
 }
 
 DataSpace DataSet::getSpace() const {
+    H5Lock lock;
     DataSpace space = H5Dget_space(hid);
     space.check("DataSet::getSpace(): Could not obtain dataspace");
     return space;
 }
 
 
+boost::optional<haddr_t> DataSet::contiguousOffset() const {
+    H5Lock lock;
+    H5Object dcpl = H5Dget_create_plist(hid);
+    dcpl.check("DataSet::contiguousOffset(): Could not get creation plist");
+
+    if (H5Pget_layout(dcpl.h5id()) != H5D_CONTIGUOUS || H5Pget_nfilters(dcpl.h5id()) != 0) {
+        return boost::none;
+    }
+
+    haddr_t offset = H5Dget_offset(hid);
+    if (offset == HADDR_UNDEF) {
+        return boost::none;
+    }
+    return offset;
+}
+
+
+NDSize DataSet::chunking() const {
+    H5Lock lock;
+    H5Object dcpl = H5Dget_create_plist(hid);
+    dcpl.check("DataSet::chunking(): Could not get creation plist");
+
+    if (H5Pget_layout(dcpl.h5id()) != H5D_CHUNKED) {
+        return NDSize{};
+    }
+
+    NDSize chunks(getSpace().extent().size());
+    int rank = H5Pget_chunk(dcpl.h5id(), static_cast<int>(chunks.size()), chunks.data());
+    if (rank < 0) {
+        throw H5Exception("DataSet::chunking(): H5Pget_chunk failed");
+    }
+    return chunks;
+}
+
+
+bool DataSet::hasFilters() const {
+    H5Lock lock;
+    H5Object dcpl = H5Dget_create_plist(hid);
+    dcpl.check("DataSet::hasFilters(): Could not get creation plist");
+    return H5Pget_nfilters(dcpl.h5id()) > 0;
+}
+
+
+std::vector<std::string> DataSet::filterNames() const {
+    H5Lock lock;
+    H5Object dcpl = H5Dget_create_plist(hid);
+    dcpl.check("DataSet::filterNames(): Could not get creation plist");
+
+    int nfilters = H5Pget_nfilters(dcpl.h5id());
+    std::vector<std::string> names;
+    for (int i = 0; i < nfilters; i++) {
+        char name[256] = "";
+        unsigned int flags = 0, config = 0;
+        size_t nvalues = 0;
+        H5Z_filter_t filter = H5Pget_filter2(dcpl.h5id(), static_cast<unsigned>(i), &flags, &nvalues, nullptr,
+                                             sizeof(name), name, &config);
+        if (filter < 0) {
+            throw H5Exception("DataSet::filterNames(): H5Pget_filter2 failed");
+        }
+        names.emplace_back(name[0] != '\0' ? name : "filter " + std::to_string(filter));
+    }
+    return names;
+}
+
+
+void DataSet::deflateFilter(unsigned &deflate, bool &shuffle) const {
+    H5Lock lock;
+    H5Object dcpl = H5Dget_create_plist(hid);
+    dcpl.check("DataSet::deflateFilter(): Could not get creation plist");
+
+    deflate = 0;
+    shuffle = false;
+    int nfilters = H5Pget_nfilters(dcpl.h5id());
+    for (int i = 0; i < nfilters; i++) {
+        unsigned int flags = 0, config = 0;
+        unsigned int values[1] = {0};
+        size_t nvalues = 1;
+        H5Z_filter_t filter = H5Pget_filter2(dcpl.h5id(), static_cast<unsigned>(i), &flags, &nvalues, values,
+                                             0, nullptr, &config);
+        if (filter < 0) {
+            throw H5Exception("DataSet::deflateFilter(): H5Pget_filter2 failed");
+        }
+        if (filter == H5Z_FILTER_DEFLATE) {
+            deflate = values[0];
+        } else if (filter == H5Z_FILTER_SHUFFLE) {
+            shuffle = true;
+        }
+    }
+}
+
+
+ndsize_t DataSet::storageSize() const {
+    H5Lock lock;
+    return H5Dget_storage_size(hid);
+}
+
+
+ndsize_t DataSet::allocatedChunks() const {
+    H5Lock lock;
+    H5Object dcpl = H5Dget_create_plist(hid);
+    dcpl.check("DataSet::allocatedChunks(): Could not get creation plist");
+    if (H5Pget_layout(dcpl.h5id()) != H5D_CHUNKED) {
+        return 0;
+    }
+
+#if H5_VERSION_GE(1, 10, 5)
+    hsize_t nchunks = 0;
+    DataSpace space = getSpace();
+    HErr res = H5Dget_num_chunks(hid, space.h5id(), &nchunks);
+    res.check("DataSet::allocatedChunks(): H5Dget_num_chunks failed");
+    return nchunks;
+#else
+    // without H5Dget_num_chunks: unfiltered chunks take up their full size,
+    // filtered ones are assumed to be allocated for the whole extent
+    const ndsize_t storage = storageSize();
+    if (storage == 0) {
+        return 0;
+    }
+    const NDSize chunks = chunking();
+    if (H5Pget_nfilters(dcpl.h5id()) == 0) {
+        return storage / (chunks.nelms() * dataType().size());
+    }
+    const NDSize extent = size();
+    ndsize_t nchunks = 1;
+    for (size_t i = 0; i < extent.size(); i++) {
+        nchunks *= (extent[i] + chunks[i] - 1) / chunks[i];
+    }
+    return nchunks;
+#endif
+}
+
+
+// H5Dwrite_chunk, H5Dread_chunk and H5Dget_chunk_info_by_coord came with HDF5 1.10.5
+#if H5_VERSION_GE(1, 10, 5)
+
+void DataSet::writeChunk(const NDSize &offset, const void *data, size_t nbytes, uint32_t filter_mask) {
+    H5Lock lock;
+    HErr res = H5Dwrite_chunk(hid, H5P_DEFAULT, filter_mask, offset.data(), nbytes, data);
+    res.check("DataSet::writeChunk(): H5Dwrite_chunk failed");
+}
+
+
+bool DataSet::readChunk(const NDSize &offset, Buffer<char> &data, uint32_t &filter_mask) const {
+    H5Lock lock;
+    hsize_t nbytes = 0;
+    haddr_t addr = HADDR_UNDEF;
+    HErr res = H5Dget_chunk_info_by_coord(hid, offset.data(), &filter_mask, &addr, &nbytes);
+    res.check("DataSet::readChunk(): H5Dget_chunk_info_by_coord failed");
+
+    if (addr == HADDR_UNDEF || nbytes == 0) {
+        data.clear();
+        return false;
+    }
+
+    data.resize(nix::check::fits_in_size_t(nbytes, "DataSet::readChunk(): chunk does not fit into memory"));
+    res = H5Dread_chunk(hid, H5P_DEFAULT, offset.data(), &filter_mask, data.data());
+    res.check("DataSet::readChunk(): H5Dread_chunk failed");
+    return true;
+}
+
+#else
+
+void DataSet::writeChunk(const NDSize &offset, const void *data, size_t nbytes, uint32_t filter_mask) {
+    throw std::runtime_error("DataSet::writeChunk(): direct chunk I/O needs HDF5 1.10.5 or newer");
+}
+
+
+bool DataSet::readChunk(const NDSize &offset, Buffer<char> &data, uint32_t &filter_mask) const {
+    throw std::runtime_error("DataSet::readChunk(): direct chunk I/O needs HDF5 1.10.5 or newer");
+}
+
+#endif
+
+
 std::tuple<DataSpace, DataSpace> DataSet::offsetCount2DataSpaces(const NDSize &count,
                                                                  const NDSize &offset) const
 {
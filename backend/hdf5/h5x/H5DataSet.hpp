@@ -12,11 +12,14 @@
 #include "DataSpace.hpp"
 #include "H5DataType.hpp"
 #include "LocID.hpp"
+#include <nix/Buffer.hpp>
 #include <nix/Hydra.hpp>
 #include <nix/Value.hpp>
 
 #include <nix/Platform.hpp>
 
+#include <boost/optional.hpp>
+
 #include <tuple>
 
 namespace nix {
@@ -50,12 +53,70 @@ public:
     void setExtent(const NDSize &dims);
     NDSize size() const;
 
+    /**
+     * Reload the metadata of the data set, e.g. to see the current
+     * extent of a data set that is written in SWMR mode.
+     */
+    void refresh();
+
     void vlenReclaim(h5x::DataType mem_type, void *data, DataSpace *dspace = nullptr) const;
 
     h5x::DataType dataType(void) const;
 
     DataSpace getSpace() const;
 
+    /**
+     * Byte offset of the raw data within the file, if the data is stored
+     * contiguously, without filters, and its storage is allocated.
+     */
+    boost::optional<haddr_t> contiguousOffset() const;
+
+    /**
+     * The chunk shape of the data set, empty if it is not chunked.
+     */
+    NDSize chunking() const;
+
+    bool hasFilters() const;
+
+    /**
+     * The names of the filters in the filter pipeline, in order.
+     */
+    std::vector<std::string> filterNames() const;
+
+    /**
+     * The level of the deflate filter, 0 if the data set is not deflated,
+     * and whether the pipeline contains the shuffle filter.
+     */
+    void deflateFilter(unsigned &deflate, bool &shuffle) const;
+
+    /**
+     * Number of bytes allocated for the raw data in the file.
+     */
+    ndsize_t storageSize() const;
+
+    /**
+     * Number of chunks that have storage allocated, 0 if the data
+     * set is not chunked. With HDF5 older than 1.10.5 the number is
+     * derived from the storage size and is an upper bound for data
+     * sets with filters.
+     */
+    ndsize_t allocatedChunks() const;
+
+    /**
+     * Write the bytes of a whole chunk, bypassing type conversion and
+     * the filter pipeline. offset is the position of the first element
+     * of the chunk, filter_mask has a bit set for every filter that was
+     * not applied to the bytes. Throws std::runtime_error with HDF5
+     * older than 1.10.5.
+     */
+    void writeChunk(const NDSize &offset, const void *data, size_t nbytes, uint32_t filter_mask);
+
+    /**
+     * Read the stored bytes of a whole chunk, see writeChunk. Returns
+     * false if no storage has been allocated for the chunk yet.
+     */
+    bool readChunk(const NDSize &offset, Buffer<char> &data, uint32_t &filter_mask) const;
+
 private:
     std::tuple<DataSpace, DataSpace> offsetCount2DataSpaces(const NDSize &count, const NDSize &offset) const;
 };
@@ -78,7 +139,7 @@ template<typename T> void DataSet::read(T &value, bool resize) const
     }
 
     DataType dtype = hydra.element_data_type();
-    h5x::DataType memType = data_type_to_h5_memtype(dtype);
+    const h5x::DataType &memType = data_type_to_h5_memtype(dtype);
     read(hydra.data(), memType, hydra.shape());
 }
 
@@ -96,7 +157,7 @@ template<typename T> void DataSet::write(const T &value)
     const Hydra<const T> hydra(value);
 
     DataType dtype = hydra.element_data_type();
-    h5x::DataType memType = data_type_to_h5_memtype(dtype);
+    const h5x::DataType &memType = data_type_to_h5_memtype(dtype);
     NDSize size = hydra.shape();
     write(hydra.data(), memType, size);
 }
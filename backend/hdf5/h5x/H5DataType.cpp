@@ -18,18 +18,21 @@ namespace h5x {
 
 
 DataType DataType::copy(hid_t source) {
+    H5Lock lock;
     DataType hi_copy = H5Tcopy(source);
     hi_copy.check("Could not copy type");
     return hi_copy;
 }
 
 DataType DataType::make(H5T_class_t klass, size_t size) {
+    H5Lock lock;
     DataType dt = H5Tcreate(klass, size);
     dt.check("Could not create datatype");
     return dt;
 }
 
 DataType DataType::makeStrType(size_t size) {
+    H5Lock lock;
     DataType str_type = H5Tcopy(H5T_C_S1);
     str_type.check("Could not create string type");
     str_type.size(size);
@@ -37,41 +40,49 @@ DataType DataType::makeStrType(size_t size) {
 }
 
 DataType DataType::makeCompound(size_t size) {
+    H5Lock lock;
     DataType res = H5Tcreate(H5T_COMPOUND, size);
     res.check("Could not create compound type");
     return res;
 }
 
 DataType DataType::makeEnum(const DataType &base) {
+    H5Lock lock;
     DataType res = H5Tenum_create(base.h5id());
     res.check("Could not create enum type");
     return res;
 }
 
 H5T_class_t DataType::class_t() const {
+    H5Lock lock;
     return H5Tget_class(hid);
 }
 
 void DataType::size(size_t t) {
+    H5Lock lock;
     HErr res = H5Tset_size(hid, t);
     res.check("DataType::size: Could not set size");
 }
 
 size_t DataType::size() const {
+    H5Lock lock;
     return H5Tget_size(hid); //FIXME: throw on 0?
 }
 
 void DataType::sign(H5T_sign_t sign) {
+    H5Lock lock;
     HErr res = H5Tset_sign(hid, sign);
     res.check("DataType::sign(): H5Tset_sign failed");
 }
 
 H5T_sign_t DataType::sign() const {
+    H5Lock lock;
     H5T_sign_t res = H5Tget_sign(hid);
     return res;
 }
 
 bool DataType::isVariableString() const {
+    H5Lock lock;
     HTri res = H5Tis_variable_str(hid);
     res.check("DataType::isVariableString(): H5Tis_variable_str failed");
     return res.result();
@@ -82,6 +93,7 @@ bool DataType::isCompound() const {
 }
 
 unsigned int DataType::member_count() const {
+    H5Lock lock;
     int res = H5Tget_nmembers(hid);
     if (res < 0) {
         throw H5Exception("DataType::member_count(): H5Tget_nmembers faild");
@@ -90,10 +102,12 @@ unsigned int DataType::member_count() const {
 }
 
 H5T_class_t DataType::member_class(unsigned int index) const {
+    H5Lock lock;
     return H5Tget_member_class(hid, index);
 }
 
 std::string DataType::member_name(unsigned int index) const {
+    H5Lock lock;
     char *data = H5Tget_member_name(hid, index);
     std::string res(data);
     std::free(data);
@@ -112,10 +126,12 @@ std::vector<std::string> DataType::member_names() const {
 }
 
 size_t DataType::member_offset(unsigned int index) const {
+    H5Lock lock;
     return H5Tget_member_offset(hid, index);
 }
 
 DataType DataType::member_type(unsigned int index) const {
+    H5Lock lock;
     h5x::DataType res = H5Tget_member_type(hid, index);
     res.check("DataType::member_type(): H5Tget_member_type failed");
     return res;
@@ -123,20 +139,29 @@ DataType DataType::member_type(unsigned int index) const {
 
 
 void DataType::insert(const std::string &name, size_t offset, const DataType &dtype) {
+    H5Lock lock;
     HErr res = H5Tinsert(hid, name.c_str(), offset, dtype.hid);
     res.check("DataType::insert(): H5Tinsert failed.");
 }
 
 void DataType::insert(const std::string &name, void *value) {
+    H5Lock lock;
     HErr res = H5Tenum_insert(hid, name.c_str(), value);
     res.check("DataType::insert(): H5Tenum_insert failed.");
 }
 
 void DataType::enum_valueof(const std::string &name, void *value) {
+    H5Lock lock;
     HErr res = H5Tenum_valueof(hid, name.c_str(), value);
     res.check("DataType::enum_valueof(): H5Tenum_valueof failed");
 }
 
+void DataType::lock() {
+    H5Lock guard;
+    HErr res = H5Tlock(hid);
+    res.check("DataType::lock(): H5Tlock failed");
+}
+
 bool DataType::enum_equal(const DataType &other) const {
     if (class_t() != H5T_ENUM || other.class_t() != H5T_ENUM) {
         return false;
@@ -174,6 +199,7 @@ h5x::DataType make_file_booltype() {
 }
 
 h5x::DataType make_mem_booltype() {
+    H5Lock lock;
     h5x::DataType booltype = h5x::DataType::make(H5T_ENUM, sizeof(bool));
     booltype.insert("FALSE", false);
     booltype.insert("TRUE", true);
@@ -195,6 +221,7 @@ static herr_t bitfield2bool(hid_t src_id,
                             void *buf_i,
                             void *bkg_i,
                             hid_t dxpl) {
+    H5Lock lock;
 
     // document for what this function should to at:
     // https://support.hdfgroup.org/HDF5/doc/H5.user/Datatypes.html#Datatypes-DataConversion
@@ -229,7 +256,7 @@ static herr_t bitfield2bool(hid_t src_id,
     return 0;
 }
 
-h5x::DataType data_type_to_h5_filetype(DataType dtype) {
+static h5x::DataType make_h5_filetype(DataType dtype) {
 
    /* The switch is structured in a way in order to get
       warnings from the compiler when not all cases are
@@ -263,7 +290,7 @@ h5x::DataType data_type_to_h5_filetype(DataType dtype) {
 }
 
 
-h5x::DataType data_type_to_h5_memtype(DataType dtype) {
+static h5x::DataType make_h5_memtype(DataType dtype) {
 
     // See data_type_to_h5_filetype for the reason why the switch is structured
     // in the way it is.
@@ -291,12 +318,72 @@ h5x::DataType data_type_to_h5_memtype(DataType dtype) {
 }
 
 
-h5x::DataType data_type_to_h5(DataType dtype, bool for_memory) {
-    if (for_memory) {
-        return data_type_to_h5_memtype(dtype);
-    } else {
-        return data_type_to_h5_filetype(dtype);
+namespace {
+
+const DataType all_types[] = {
+    DataType::Bool, DataType::Float, DataType::Double,
+    DataType::Int8, DataType::Int16, DataType::Int32, DataType::Int64,
+    DataType::UInt8, DataType::UInt16, DataType::UInt32, DataType::UInt64,
+    DataType::String, DataType::Opaque
+};
+
+/*
+ * Locked file and memory types for all DataTypes, indexed by the
+ * value of the enum. The registry is never destroyed, locked types
+ * cannot be closed anyway.
+ */
+class TypeRegistry {
+
+public:
+
+    static const TypeRegistry &instance() {
+        static const TypeRegistry *registry = new TypeRegistry();
+        return *registry;
+    }
+
+    const h5x::DataType &get(DataType dtype, bool for_memory) const {
+        size_t index = static_cast<size_t>(dtype);
+        if (dtype == DataType::Nothing || index >= types.size() || !types[index].first.isValid()) {
+            throw std::invalid_argument("DataType not handled!");
+        }
+        return for_memory ? types[index].second : types[index].first;
+    }
+
+private:
+
+    std::vector<std::pair<h5x::DataType, h5x::DataType>> types;
+
+    TypeRegistry() {
+        H5Lock lock;
+        types.resize(static_cast<size_t>(DataType::Opaque) + 1);
+        for (DataType dtype : all_types) {
+            h5x::DataType file_type = make_h5_filetype(dtype);
+            h5x::DataType mem_type = make_h5_memtype(dtype);
+            file_type.lock();
+            mem_type.lock();
+            types[static_cast<size_t>(dtype)] = std::make_pair(file_type, mem_type);
+        }
     }
+};
+
+// create all types when the library is loaded
+const TypeRegistry &type_registry = TypeRegistry::instance();
+
+}
+
+
+const h5x::DataType &data_type_to_h5_filetype(DataType dtype) {
+    return TypeRegistry::instance().get(dtype, false);
+}
+
+
+const h5x::DataType &data_type_to_h5_memtype(DataType dtype) {
+    return TypeRegistry::instance().get(dtype, true);
+}
+
+
+const h5x::DataType &data_type_to_h5(DataType dtype, bool for_memory) {
+    return TypeRegistry::instance().get(dtype, for_memory);
 }
 
 #define NOT_IMPLEMENTED false
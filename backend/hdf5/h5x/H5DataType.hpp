@@ -71,14 +71,22 @@ public:
 
     void enum_valueof(const std::string &name, void *value);
     bool enum_equal(const DataType &other) const;
+
+    // make the type read-only; locked types cannot be modified or closed
+    void lock();
 };
 
 }
 
 
-NIXAPI h5x::DataType data_type_to_h5_filetype(DataType dtype);
-NIXAPI h5x::DataType data_type_to_h5_memtype(DataType dtype);
-NIXAPI h5x::DataType data_type_to_h5(DataType dtype, bool for_memory);
+/**
+ * The HDF5 types for the NIX data types. All types are created once per
+ * process, locked with H5Tlock and shared between all callers and threads;
+ * copy the returned type with DataType::copy before modifying it.
+ */
+NIXAPI const h5x::DataType &data_type_to_h5_filetype(DataType dtype);
+NIXAPI const h5x::DataType &data_type_to_h5_memtype(DataType dtype);
+NIXAPI const h5x::DataType &data_type_to_h5(DataType dtype, bool for_memory);
 
 
 NIXAPI DataType data_type_from_h5(H5T_class_t vclass, size_t vsize, H5T_sign_t vsign);
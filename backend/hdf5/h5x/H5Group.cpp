@@ -9,21 +9,30 @@
 #include "H5Group.hpp"
 #include <nix/util/util.hpp>
 #include "H5Exception.hpp"
+#include "H5LinkIndex.hpp"
 
 
 namespace nix {
 namespace hdf5 {
 
-optGroup::optGroup(const H5Group &parent, const std::string &g_name)
-    : parent(parent), g_name(g_name)
+optGroup::optGroup(const H5Group &parent, const std::string &g_name, bool cached)
+    : parent(parent.h5id()), g_name(g_name), cached(cached), probed(false)
 {}
 
 boost::optional<H5Group> optGroup::operator() (bool create) const {
-    if (parent.hasGroup(g_name)) {
-        g = boost::optional<H5Group>(parent.openGroup(g_name));
+    // g and probed are shared by all threads that use the owning handle
+    H5Lock lock;
+    if (cached && probed && (g || !create)) {
+        return g;
+    }
+
+    H5Group p(parent, true);
+    if (p.hasGroup(g_name)) {
+        g = boost::optional<H5Group>(p.openGroup(g_name));
     } else if (create) {
-        g = boost::optional<H5Group>(parent.openGroup(g_name, true));
+        g = boost::optional<H5Group>(p.openGroup(g_name, true));
     }
+    probed = true;
     return g;
 }
 
@@ -38,6 +47,7 @@ H5Group::H5Group(const H5Group &other) : LocID(other) {}
 
 
 bool H5Group::hasObject(const std::string &name) const {
+    H5Lock lock;
     // empty string should return false, not exception (which H5Lexists would)
     if (name.empty()) {
         return false;
@@ -48,6 +58,7 @@ bool H5Group::hasObject(const std::string &name) const {
 }
 
 bool H5Group::objectOfType(const std::string &name, H5O_type_t type) const {
+    H5Lock lock;
     H5O_info_t info;
 
     hid_t obj = H5Oopen(hid, name.c_str(), H5P_DEFAULT);
@@ -66,6 +77,7 @@ bool H5Group::objectOfType(const std::string &name, H5O_type_t type) const {
 }
 
 ndsize_t H5Group::objectCount() const {
+    H5Lock lock;
     hsize_t n_objs;
     HErr res = H5Gget_num_objs(hid, &n_objs);
     res.check("Could not get object count");
@@ -124,6 +136,7 @@ boost::optional<DataSet> H5Group::findDataByAttribute(const std::string &attribu
 
 
 std::string H5Group::objectName(ndsize_t index) const {
+    H5Lock lock;
     // check if index valid
     if(index > objectCount()) {
         throw OutOfBounds("No object at given index",
@@ -174,13 +187,46 @@ std::string H5Group::objectName(ndsize_t index) const {
 }
 
 
+static herr_t collect_link_names(hid_t, const char *name, const H5L_info_t *, void *op_data) {
+    std::vector<std::string> *names = static_cast<std::vector<std::string> *>(op_data);
+    names->emplace_back(name);
+    return 0;
+}
+
+
+std::vector<std::string> H5Group::objectNames() const {
+    H5Lock lock;
+    std::vector<std::string> names;
+
+    // same order as objectName(): creation order if the group tracks
+    // it, which is the case for all groups created by nix
+    unsigned crt_flags = 0;
+    H5Object gcpl = H5Gget_create_plist(hid);
+    gcpl.check("H5Group::objectNames(): Could not get group creation plist");
+    HErr res = H5Pget_link_creation_order(gcpl.h5id(), &crt_flags);
+    res.check("H5Group::objectNames(): Could not get link creation order");
+
+    bool crt_indexed = (crt_flags & H5P_CRT_ORDER_INDEXED) != 0;
+    H5_index_t index_type = crt_indexed ? H5_INDEX_CRT_ORDER : H5_INDEX_NAME;
+    H5_iter_order_t order = crt_indexed ? H5_ITER_INC : H5_ITER_NATIVE;
+
+    hsize_t idx = 0;
+    res = H5Literate(hid, index_type, order, &idx, collect_link_names, &names);
+    res.check("H5Group::objectNames(): H5Literate failed");
+
+    return names;
+}
+
+
 bool H5Group::hasData(const std::string &name) const {
     return hasObject(name) && objectOfType(name, H5O_TYPE_DATASET);
 }
 
 
 void H5Group::removeData(const std::string &name) {
+    H5Lock lock;
     if (hasData(name)) {
+        checkStructureChange("H5Group::removeData");
         HErr res = H5Gunlink(hid, name.c_str());
         res.check("H5Group::removeData(): Could not unlink DataSet");
     }
@@ -193,8 +239,12 @@ DataSet H5Group::createData(const std::string &name,
                             const NDSize &maxsize,
                             NDSize chunks,
                             bool max_size_unlimited,
-                            bool guess_chunks) const
+                            bool guess_chunks,
+                            unsigned deflate,
+                            bool shuffle) const
 {
+    H5Lock lock;
+    checkStructureChange("H5Group::createData");
     DataSpace space;
 
     if (size) {
@@ -218,6 +268,17 @@ DataSet H5Group::createData(const std::string &name,
         res.check("Could not set chunk size on data set creation plist");
     }
 
+    // the filters run in the order they are added
+    if (shuffle) {
+        HErr res = H5Pset_shuffle(dcpl.h5id());
+        res.check("Could not set shuffle filter on data set creation plist");
+    }
+
+    if (deflate > 0) {
+        HErr res = H5Pset_deflate(dcpl.h5id(), deflate);
+        res.check("Could not set deflate filter on data set creation plist");
+    }
+
     DataSet ds = H5Dcreate(hid, name.c_str(), fileType.h5id(), space.h5id(), H5P_DEFAULT, dcpl.h5id(), H5P_DEFAULT);
     ds.check("H5Group::createData: Could not create DataSet with name " + name);
 
@@ -226,6 +287,7 @@ DataSet H5Group::createData(const std::string &name,
 
 
 DataSet H5Group::openData(const std::string &name) const {
+    H5Lock lock;
     DataSet ds = H5Dopen(hid, name.c_str(), H5P_DEFAULT);
     ds.check("H5Group::openData(): Could not open DataSet");
     return ds;
@@ -238,6 +300,7 @@ bool H5Group::hasGroup(const std::string &name) const {
 
 
 H5Group H5Group::openGroup(const std::string &name, bool create) const {
+    H5Lock lock;
     check_h5_arg_name(name);
 
     H5Group g;
@@ -246,6 +309,7 @@ H5Group H5Group::openGroup(const std::string &name, bool create) const {
         g = H5Group(H5Gopen(hid, name.c_str(), H5P_DEFAULT));
         g.check("H5Group::openGroup(): Could not open group: " + name);
     } else if (create) {
+        checkStructureChange("H5Group::openGroup");
         H5Object gcpl = H5Pcreate(H5P_GROUP_CREATE);
         gcpl.check("Unable to create group with name '" + name + "'! (H5Pcreate)");
 
@@ -265,38 +329,47 @@ H5Group H5Group::openGroup(const std::string &name, bool create) const {
 }
 
 
-optGroup H5Group::openOptGroup(const std::string &name) {
+optGroup H5Group::openOptGroup(const std::string &name, bool cached) const {
     check_h5_arg_name(name);
-    return optGroup(*this, name);
+    return optGroup(*this, name, cached);
 }
 
 
 void H5Group::removeGroup(const std::string &name) {
-    if (hasGroup(name))
+    H5Lock lock;
+    if (hasGroup(name)) {
+        checkStructureChange("H5Group::removeGroup");
         H5Gunlink(hid, name.c_str());
+    }
 }
 
 
 void H5Group::renameGroup(const std::string &old_name, const std::string &new_name) {
+    H5Lock lock;
     check_h5_arg_name(new_name);
 
     if (hasGroup(old_name)) {
+        checkStructureChange("H5Group::renameGroup");
         H5Gmove(hid, old_name.c_str(), new_name.c_str()); //FIXME: H5Gmove is deprecated
     }
 }
 
 
 H5Group H5Group::createLink(const H5Group &target, const std::string &link_name) {
+    H5Lock lock;
     check_h5_arg_name(link_name);
+    checkStructureChange("H5Group::createLink");
 
     HErr res = H5Lcreate_hard(target.hid, ".", hid, link_name.c_str(),
                               H5L_SAME_LOC, H5L_SAME_LOC);
     res.check("Unable to create link " + link_name);
+    H5LinkIndex::linkCreated(*this, link_name, target);
     return openGroup(link_name, false);
 }
 
 // TODO implement some kind of roll-back in order to avoid half renamed links.
 bool H5Group::renameAllLinks(const std::string &old_name, const std::string &new_name) {
+    H5Lock lock;
     check_h5_arg_name(new_name);
 
     bool renamed = false;
@@ -332,16 +405,27 @@ bool H5Group::renameAllLinks(const std::string &old_name, const std::string &new
 
 // TODO implement some kind of roll-back in order to avoid half removed links.
 bool H5Group::removeAllLinks(const std::string &name) {
+    H5Lock lock;
     bool removed = false;
 
     if (hasGroup(name)) {
-        H5Group group      = openGroup(name, false);
+        H5Group group = openGroup(name, false);
+        deleteLink(name);
 
-        std::string gname = group.name();
+        // links from other entities, e.g. the references of tags
+        if (group.referenceCount() > 0) {
+            for (const std::string &path : H5LinkIndex::links(group)) {
+                deleteLink(path);
+            }
+        }
 
-        while (! gname.empty()) {
+        // links unknown to the index, group.name() searches the whole file
+        while (group.referenceCount() > 0) {
+            std::string gname = group.name();
+            if (gname.empty()) {
+                break;
+            }
             deleteLink(gname);
-            gname = group.name();
         }
 
         removed = true;
@@ -44,11 +44,29 @@ public:
     ndsize_t objectCount() const;
     std::string objectName(ndsize_t index) const;
 
+    /**
+     * @brief The names of all direct children of the group.
+     *
+     * The names are returned in creation order if the group tracks
+     * it and in name order otherwise, i.e. in the same order as used
+     * by {@link objectName}. All names are obtained by a single
+     * iteration over the links of the group.
+     *
+     * @return The names of all links in the group.
+     */
+    std::vector<std::string> objectNames() const;
+
     bool hasData(const std::string &name) const;
 
+    /**
+     * Create a data set. With deflate between 1 and 9 the chunks are
+     * compressed at that level, shuffle reorders the bytes of the values
+     * before compressing them.
+     */
     DataSet createData(const std::string &name, const h5x::DataType &fileType,
             const NDSize &size, const NDSize &maxsize = {}, NDSize chunks = {},
-            bool maxSizeUnlimited = true, bool guessChunks = true) const;
+            bool maxSizeUnlimited = true, bool guessChunks = true,
+            unsigned deflate = 0, bool shuffle = false) const;
 
     DataSet openData(const std::string &name) const;
     void removeData(const std::string &name);
@@ -78,11 +96,17 @@ public:
      *        open and eventually create an optional group inside this
      *        group.
      *
+     * The functor does not hold a reference to this group, it must
+     * not outlive the owner of the group.
+     *
      * @param name    The name of the group to create.
+     * @param cached  Whether the result of the first lookup is kept,
+     *                only valid if the file can not change, i.e. if it
+     *                was opened read-only.
      *
      * @return The opened group.
      */
-    optGroup openOptGroup(const std::string &name);
+    optGroup openOptGroup(const std::string &name, bool cached = false) const;
 
     void removeGroup(const std::string &name);
     void renameGroup(const std::string &old_name, const std::string &new_name);
@@ -192,14 +216,14 @@ void H5Group::setData(const std::string &name, const T &value)
 
     DataSet ds;
     if (!hasData(name)) {
-        h5x::DataType fileType = data_type_to_h5_filetype(dtype);
+        const h5x::DataType &fileType = data_type_to_h5_filetype(dtype);
         ds = createData(name, fileType, shape);
     } else {
         ds = openData(name);
         ds.setExtent(shape);
     }
 
-    h5x::DataType memType = data_type_to_h5_memtype(dtype);
+    const h5x::DataType &memType = data_type_to_h5_memtype(dtype);
     ds.write(hydra.data(), memType, shape);
 }
 
@@ -215,7 +239,7 @@ bool H5Group::getData(const std::string &name, T &value) const
     DataSet ds = openData(name);
 
     DataType dtype = hydra.element_data_type();
-    h5x::DataType memType = data_type_to_h5_memtype(dtype);
+    const h5x::DataType &memType = data_type_to_h5_memtype(dtype);
     NDSize shape = ds.size();
     hydra.resize(shape);
 
@@ -235,14 +259,18 @@ bool H5Group::getData(const std::string &name, T &value) const
  * unset optional is returned.
  */
 struct NIXAPI optGroup {
+    // filled on first use, under H5Lock as handles may be shared by threads
     mutable boost::optional<H5Group> g;
-    H5Group parent;
+    // not referenced, kept alive by the owner of the optGroup
+    hid_t parent;
     std::string g_name;
+    bool cached;
+    mutable bool probed;
 
 public:
-    optGroup(const H5Group &parent, const std::string &g_name);
+    optGroup(const H5Group &parent, const std::string &g_name, bool cached = false);
 
-    optGroup(){};
+    optGroup() : parent(H5I_INVALID_HID), cached(false), probed(false) {};
 
     /**
      * @brief Open and optionally create a group with the given name
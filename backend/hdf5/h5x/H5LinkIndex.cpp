@@ -0,0 +1,141 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "H5LinkIndex.hpp"
+#include "H5Exception.hpp"
+#include "H5Lock.hpp"
+
+#include <map>
+#include <unordered_map>
+
+namespace nix {
+namespace hdf5 {
+
+namespace {
+
+typedef std::unordered_map<haddr_t, std::vector<std::string>> link_map;
+
+// by file number, guarded by H5Lock
+std::map<unsigned long, link_map> &indices() {
+    // never destroyed, like the mutex of H5Lock
+    static std::map<unsigned long, link_map> *files = new std::map<unsigned long, link_map>();
+    return *files;
+}
+
+
+unsigned long file_number(const H5Object &obj) {
+    // the root group, obj might be the file itself
+    H5O_info_t info;
+    HErr res = H5Oget_info_by_name(obj.h5id(), "/", &info, H5P_DEFAULT);
+    res.check("H5LinkIndex: Could not get file number");
+    return info.fileno;
+}
+
+
+haddr_t object_address(hid_t loc, const std::string &path) {
+    H5O_info_t info;
+    herr_t res;
+
+    H5E_BEGIN_TRY {
+        res = H5Oget_info_by_name(loc, path.c_str(), &info, H5P_DEFAULT);
+    } H5E_END_TRY;
+
+    return res < 0 ? HADDR_UNDEF : info.addr;
+}
+
+
+herr_t collect_link(hid_t, const char *name, const H5L_info_t *info, void *op_data) {
+    if (info->type == H5L_TYPE_HARD) {
+        link_map *links = static_cast<link_map *>(op_data);
+        (*links)[info->u.address].emplace_back(std::string("/") + name);
+    }
+    return 0;
+}
+
+
+link_map &file_index(const H5Object &obj) {
+    unsigned long fileno = file_number(obj);
+    auto it = indices().find(fileno);
+    if (it != indices().end()) {
+        return it->second;
+    }
+
+    // all links of the file in one pass, every group is visited once
+    link_map links;
+    H5Object root = H5Oopen(obj.h5id(), "/", H5P_DEFAULT);
+    root.check("H5LinkIndex: Could not open root group");
+    HErr res = H5Lvisit(root.h5id(), H5_INDEX_NAME, H5_ITER_NATIVE, collect_link, &links);
+    res.check("H5LinkIndex: H5Lvisit failed");
+
+    // objects with a single link are only linked from their parent
+    for (auto i = links.begin(); i != links.end();) {
+        i = i->second.size() < 2 ? links.erase(i) : std::next(i);
+    }
+
+    return indices().emplace(fileno, std::move(links)).first->second;
+}
+
+}
+
+
+std::vector<std::string> H5LinkIndex::links(const H5Object &obj) {
+    H5Lock lock;
+    link_map &index = file_index(obj);
+
+    H5O_info_t info;
+    HErr res = H5Oget_info(obj.h5id(), &info);
+    res.check("H5LinkIndex::links: Could not get object info");
+
+    auto it = index.find(info.addr);
+    if (it == index.end()) {
+        return std::vector<std::string>();
+    }
+
+    std::vector<std::string> valid;
+    for (const std::string &path : it->second) {
+        if (object_address(obj.h5id(), path) == info.addr) {
+            valid.push_back(path);
+        }
+    }
+    it->second = valid;
+    return valid;
+}
+
+
+void H5LinkIndex::linkCreated(const H5Object &parent, const std::string &name, const H5Object &target) {
+    H5Lock lock;
+    auto it = indices().find(file_number(parent));
+    if (it == indices().end()) {
+        return;
+    }
+
+    ssize_t len = H5Iget_name(parent.h5id(), nullptr, 0);
+    if (len <= 0) {
+        return;
+    }
+    std::string path(static_cast<size_t>(len) + 1, '\0');
+    H5Iget_name(parent.h5id(), &path[0], path.size());
+    path.resize(static_cast<size_t>(len));
+    if (path.back() != '/') {
+        path += '/';
+    }
+
+    H5O_info_t info;
+    HErr res = H5Oget_info(target.h5id(), &info);
+    res.check("H5LinkIndex::linkCreated: Could not get object info");
+    it->second[info.addr].push_back(path + name);
+}
+
+
+void H5LinkIndex::forget(const H5Object &file) {
+    H5Lock lock;
+    indices().erase(file_number(file));
+}
+
+} // namespace hdf5
+} // namespace nix
@@ -0,0 +1,68 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_H5LINKINDEX_H
+#define NIX_H5LINKINDEX_H
+
+#include "H5Object.hpp"
+
+#include <nix/Platform.hpp>
+
+#include <string>
+#include <vector>
+
+namespace nix {
+namespace hdf5 {
+
+/**
+ * Reverse index of the hard links of the open files.
+ *
+ * For every object that is linked more than once the index keeps the
+ * paths of its links, so that all links of an entity can be removed
+ * without letting HDF5 search the whole file for another path of the
+ * object (H5Iget_name). The index of a file is built by a single
+ * traversal when it is first needed and afterwards extended by all
+ * links created with {@link H5Group::createLink}.
+ *
+ * Removed links are not tracked, the index may therefore hold paths
+ * that do not exist anymore or lead to another object; {@link links}
+ * only returns the paths that currently lead to the object. Links that
+ * were created by other means are not known to the index, callers have
+ * to check the reference count of the object afterwards.
+ */
+class NIXAPI H5LinkIndex {
+public:
+
+    /**
+     * @brief The absolute paths of all known links to the object.
+     *
+     * Builds the index of the file of the object if necessary.
+     */
+    static std::vector<std::string> links(const H5Object &obj);
+
+    /**
+     * @brief Record a new link to the target.
+     *
+     * Nothing is done if the index of the file was not built yet.
+     *
+     * @param parent    The group that contains the link.
+     * @param name      The name of the link in the group.
+     * @param target    The object the link points to.
+     */
+    static void linkCreated(const H5Object &parent, const std::string &name, const H5Object &target);
+
+    /**
+     * @brief Drop the index of a file, must be called before the file is closed.
+     */
+    static void forget(const H5Object &file);
+};
+
+} // namespace hdf5
+} // namespace nix
+
+#endif /* NIX_H5LINKINDEX_H */
@@ -0,0 +1,22 @@
+// Copyright © 2017 German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "H5Lock.hpp"
+
+namespace nix {
+namespace hdf5 {
+
+std::recursive_mutex &H5Lock::mutex() {
+    // intentionally never destroyed: H5Objects with static storage
+    // duration may still release their ids during program exit
+    static std::recursive_mutex *h5_mutex = new std::recursive_mutex();
+    return *h5_mutex;
+}
+
+} // namespace hdf5
+} // namespace nix
@@ -0,0 +1,46 @@
+// Copyright © 2017 German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_H5LOCK_H
+#define NIX_H5LOCK_H
+
+#include <nix/Platform.hpp>
+
+#include <mutex>
+
+namespace nix {
+namespace hdf5 {
+
+/**
+ * Scoped lock that serializes all calls into the HDF5 library.
+ *
+ * A stock build of HDF5 must not be entered by more than one thread
+ * at a time; this includes the reference counting of identifiers done
+ * by H5Object. Every wrapper function in h5x that calls into HDF5 holds
+ * an H5Lock for its whole duration. The underlying mutex is recursive,
+ * wrappers can therefore call each other freely.
+ */
+class NIXAPI H5Lock {
+public:
+
+    H5Lock() : guard(mutex()) { }
+
+    H5Lock(const H5Lock &other) = delete;
+    H5Lock &operator=(const H5Lock &other) = delete;
+
+    static std::recursive_mutex &mutex();
+
+private:
+
+    std::lock_guard<std::recursive_mutex> guard;
+};
+
+} // namespace hdf5
+} // namespace nix
+
+#endif /* NIX_H5LOCK_H */
@@ -44,6 +44,7 @@ H5Object &H5Object::operator=(H5Object &&other) {
 
 
 bool H5Object::operator==(const H5Object &other) const {
+    H5Lock lock;
     if (H5Iis_valid(hid) && H5Iis_valid(other.hid))
         return hid == other.hid;
     else
@@ -62,6 +63,7 @@ hid_t H5Object::h5id() const {
 
 
 int H5Object::refCount() const {
+    H5Lock lock;
     if (H5Iis_valid(hid)) {
         return H5Iget_ref(hid);
     } else {
@@ -70,12 +72,14 @@ int H5Object::refCount() const {
 }
 
 bool H5Object::isValid() const {
+    H5Lock lock;
     HTri res = H5Iis_valid(hid);
     res.check("H5Object::isValid() failed");
     return res.result();
 }
 
 std::string H5Object::name() const {
+    H5Lock lock;
     if (! H5Iis_valid(hid)) {
         //maybe throw an exception?
         return "";
@@ -100,6 +104,7 @@ std::string H5Object::name() const {
 
 
 H5I_type_t H5Object::type() const {
+    H5Lock lock;
     return H5Iget_type(hid);
 }
 
@@ -115,6 +120,7 @@ H5Object::~H5Object() {
 
 
 void H5Object::inc() const {
+    H5Lock lock;
     if (H5Iis_valid(hid)) {
         H5Iinc_ref(hid);
     }
@@ -122,6 +128,7 @@ void H5Object::inc() const {
 
 
 void H5Object::dec() const {
+    H5Lock lock;
     if (H5Iis_valid(hid)) {
         H5Idec_ref(hid);
     }
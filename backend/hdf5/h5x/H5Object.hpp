@@ -15,6 +15,7 @@
 #include <nix/Platform.hpp>
 #include <nix/Hydra.hpp>
 #include "H5Exception.hpp"
+#include "H5Lock.hpp"
 
 #include <string>
 #include <boost/optional.hpp>
@@ -10,10 +10,21 @@
 
 #include "LocID.hpp"
 
+#include <atomic>
+#include <stdexcept>
+
 namespace nix {
 
 namespace hdf5 {
 
+namespace {
+
+// number of open file handles that are in SWMR writing
+std::atomic<int> swmr_writers(0);
+
+}
+
+
 LocID::LocID() : H5Object() {}
 
 
@@ -24,18 +35,22 @@ LocID::LocID(const LocID &other) : H5Object(other) {}
 
 
 bool LocID::hasAttr(const std::string &name) const {
+    H5Lock lock;
     HTri res = H5Aexists(hid, name.c_str());
     return res.check("LocID.hasAttr() failed");
 }
 
 
 void LocID::removeAttr(const std::string &name) const {
+    H5Lock lock;
+    checkStructureChange("LocID::removeAttr");
     HErr res = H5Adelete(hid, name.c_str());
     res.check("LocID::removeAttr(): could not delete attribute");
 }
 
 
 Attribute LocID::openAttr(const std::string &name) const {
+    H5Lock lock;
     Attribute attr = H5Aopen(hid, name.c_str(), H5P_DEFAULT);
     attr.check("LocID::openAttr: Could not open attribute " + name);
     return attr;
@@ -43,6 +58,8 @@ Attribute LocID::openAttr(const std::string &name) const {
 
 
 Attribute LocID::createAttr(const std::string &name, h5x::DataType fileType, const DataSpace &fileSpace) const {
+    H5Lock lock;
+    checkStructureChange("LocID::createAttr");
     Attribute attr = H5Acreate(hid, name.c_str(), fileType.h5id(), fileSpace.h5id(), H5P_DEFAULT, H5P_DEFAULT);
     attr.check("LocID::openAttr: Could not create attribute " + name);
     return attr;
@@ -50,17 +67,52 @@ Attribute LocID::createAttr(const std::string &name, h5x::DataType fileType, con
 
 
 void LocID::deleteLink(std::string name, hid_t plist) {
+    H5Lock lock;
+    checkStructureChange("LocID::deleteLink");
     HErr res = H5Ldelete(hid, name.c_str(), plist);
     res.check("LocIDL::deleteLink: Could not delete link: " + name);
 }
 
 
 unsigned int LocID::referenceCount() const {
+    H5Lock lock;
     H5O_info_t oInfo;
     HErr res = H5Oget_info(hid, &oInfo);
     res.check("LocID:referenceCount: Coud not get object info");
     return oInfo.rc;
 }
+
+
+void LocID::checkStructureChange(const char *where) const {
+    // files can only be opened for SWMR writing since HDF5 1.10
+#if H5_VERSION_GE(1, 10, 0)
+    if (swmr_writers.load(std::memory_order_relaxed) == 0) {
+        return;
+    }
+
+    H5Lock lock;
+    H5Object fid = H5Iget_file_id(hid);
+    if (!fid.isValid()) {
+        throw H5Exception(std::string(where) + ": Could not get file id");
+    }
+
+    unsigned intent = 0;
+    HErr res = H5Fget_intent(fid.h5id(), &intent);
+    if (res.isError()) {
+        throw H5Exception(std::string(where) + ": Could not get file intent");
+    }
+
+    if (intent & H5F_ACC_SWMR_WRITE) {
+        throw std::logic_error(std::string(where) + ": the structure of a file cannot be changed during SWMR writing");
+    }
+#endif
+}
+
+
+void LocID::swmrWriting(bool started) {
+    swmr_writers.fetch_add(started ? 1 : -1, std::memory_order_relaxed);
+}
+
 } // nix::hdf5
 
 } // nix::
\ No newline at end of file
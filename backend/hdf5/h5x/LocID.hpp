@@ -41,6 +41,20 @@ public:
     void deleteLink(std::string name, hid_t plist = H5L_SAME_LOC);
 
     unsigned int referenceCount() const;
+
+    /**
+     * Throw std::logic_error if the structure of the file must not be
+     * changed, i.e. while it is written in SWMR mode. Returns at once
+     * as long as no file handle is in SWMR writing, see swmrWriting.
+     */
+    void checkStructureChange(const char *where) const;
+
+    /**
+     * Called by a file handle when it starts (true) or stops (false)
+     * SWMR writing.
+     */
+    static void swmrWriting(bool started);
+
 private:
 
     Attribute openAttr(const std::string &name) const;
@@ -59,10 +73,12 @@ template<typename T> void LocID::setAttr(const std::string &name, const T &value
 
     Attribute attr;
 
+    // overwriting an attribute is allowed during SWMR writing,
+    // createAttr checks whether a new one may be created
     if (hasAttr(name)) {
         attr = openAttr(name);
     } else {
-        h5x::DataType fileType = data_type_to_h5_filetype(dtype);
+        const h5x::DataType &fileType = data_type_to_h5_filetype(dtype);
         DataSpace fileSpace = DataSpace::create(shape, false);
         attr = createAttr(name, fileType, fileSpace);
     }
@@ -86,7 +102,7 @@ template<typename T> bool LocID::getAttr(const std::string &name, T &value) cons
     hydra.resize(dims);
 
     DataType dtype = hydra.element_data_type();
-    h5x::DataType mem_type = data_type_to_h5_memtype(dtype);
+    const h5x::DataType &mem_type = data_type_to_h5_memtype(dtype);
 
     attr.read(mem_type, dims, hydra.data());
 
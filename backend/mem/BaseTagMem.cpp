@@ -0,0 +1,178 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "BaseTagMem.hpp"
+#include "BlockMem.hpp"
+#include "DataArrayMem.hpp"
+#include "FeatureMem.hpp"
+
+#include <nix/util/util.hpp>
+#include <nix/DataArray.hpp>
+
+#include <unordered_set>
+
+using namespace std;
+
+namespace nix {
+namespace mem {
+
+
+BaseTagMem::BaseTagMem(const shared_ptr<FileMem> &file, const shared_ptr<BlockMem> &block,
+                       const string &id, const string &type, const string &name, time_t time)
+    : EntityWithSourcesMem(file, block, id, type, name, time)
+{
+}
+
+//--------------------------------------------------
+// Methods concerning references.
+//--------------------------------------------------
+
+shared_ptr<DataArrayMem> BaseTagMem::findReference(const string &name_or_id) const {
+    shared_ptr<DataArrayMem> da = references_list.get(name_or_id);
+    if (!da) {
+        shared_ptr<DataArrayMem> named = block()->findDataArray(name_or_id);
+        if (named) {
+            da = references_list.get(named->id());
+        }
+    }
+    return da;
+}
+
+
+bool BaseTagMem::hasReference(const string &name_or_id) const {
+    return findReference(name_or_id) != nullptr;
+}
+
+
+ndsize_t BaseTagMem::referenceCount() const {
+    return references_list.size();
+}
+
+
+shared_ptr<base::IDataArray> BaseTagMem::getReference(const string &name_or_id) const {
+    return findReference(name_or_id);
+}
+
+
+shared_ptr<base::IDataArray> BaseTagMem::getReference(ndsize_t index) const {
+    return references_list.at(index);
+}
+
+
+void BaseTagMem::addReference(const string &name_or_id) {
+    shared_ptr<DataArrayMem> target = block()->findDataArray(name_or_id);
+    if (!target)
+        throw runtime_error("BaseTagMem::addReference: DataArray not found in block!");
+
+    references_list.add(target);
+}
+
+
+void BaseTagMem::addReferences(const vector<DataArray> &refs) {
+    shared_ptr<BlockMem> b = block();
+
+    // validate all arrays before the first link is created
+    vector<shared_ptr<DataArrayMem>> targets;
+    targets.reserve(refs.size());
+    for (const DataArray &ref : refs) {
+        shared_ptr<DataArrayMem> target = b->findDataArray(ref.id());
+        if (!target) {
+            throw runtime_error("BaseTagMem::addReferences: DataArray not found in block!");
+        }
+        targets.push_back(target);
+    }
+
+    for (const auto &target : targets) {
+        references_list.add(target);
+    }
+}
+
+
+bool BaseTagMem::removeReference(const string &name_or_id) {
+    shared_ptr<DataArrayMem> da = findReference(name_or_id);
+    return da ? references_list.remove(da->id()) : false;
+}
+
+
+void BaseTagMem::references(const vector<DataArray> &refs_new) {
+    unordered_set<string> ids_new;
+    vector<DataArray> refs_add;
+    for (const DataArray &ref : refs_new) {
+        if (!references_list.has(ref.id())) {
+            refs_add.push_back(ref);
+        }
+        ids_new.insert(ref.id());
+    }
+
+    // check if all new references exist & add them
+    addReferences(refs_add);
+
+    for (const auto &old : references_list.all()) {
+        if (ids_new.count(old->id()) == 0) {
+            references_list.remove(old->id());
+        }
+    }
+}
+
+//--------------------------------------------------
+// Methods concerning features.
+//--------------------------------------------------
+
+bool BaseTagMem::hasFeature(const string &name_or_id) const {
+    return features.has(name_or_id);
+}
+
+
+ndsize_t BaseTagMem::featureCount() const {
+    return features.size();
+}
+
+
+shared_ptr<base::IFeature> BaseTagMem::getFeature(const string &name_or_id) const {
+    return features.get(name_or_id);
+}
+
+
+shared_ptr<base::IFeature> BaseTagMem::getFeature(ndsize_t index) const {
+    return features.at(index, "feature");
+}
+
+
+shared_ptr<base::IFeature> BaseTagMem::createFeature(const string &name_or_id, LinkType link_type) {
+    if (!block()->hasDataArray(name_or_id)) {
+        throw runtime_error("DataArray not found in Block!");
+    }
+
+    string id = util::createId();
+    auto feature = make_shared<FeatureMem>(fileMem(), block(), id, name_or_id, link_type, util::getTime());
+    features.add(id, feature);
+    return feature;
+}
+
+
+bool BaseTagMem::deleteFeature(const string &name_or_id) {
+    shared_ptr<FeatureMem> feature = features.remove(name_or_id);
+    if (feature) {
+        feature->markDeleted();
+    }
+    return feature != nullptr;
+}
+
+
+void BaseTagMem::markDeleted() {
+    for (const auto &feature : features.all()) {
+        feature->markDeleted();
+    }
+    EntityWithSourcesMem::markDeleted();
+}
+
+
+BaseTagMem::~BaseTagMem() {}
+
+} // ns nix::mem
+} // ns nix
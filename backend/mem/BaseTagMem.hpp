@@ -0,0 +1,105 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_BASETAG_MEM_H
+#define NIX_BASETAG_MEM_H
+
+#include <nix/base/IBaseTag.hpp>
+#include "EntityWithSourcesMem.hpp"
+#include "Containers.hpp"
+
+#include <string>
+#include <vector>
+#include <memory>
+
+namespace nix {
+namespace mem {
+
+class DataArrayMem;
+class FeatureMem;
+
+/**
+ * Base class for tags that are kept in memory.
+ */
+class BaseTagMem : virtual public base::IBaseTag, public EntityWithSourcesMem {
+
+private:
+
+    RefList<DataArrayMem> references_list;
+    EntityList<FeatureMem> features;
+
+public:
+
+    BaseTagMem(const std::shared_ptr<FileMem> &file, const std::shared_ptr<BlockMem> &block,
+               const std::string &id, const std::string &type, const std::string &name, time_t time);
+
+    //--------------------------------------------------
+    // Methods concerning references.
+    //--------------------------------------------------
+
+    bool hasReference(const std::string &name_or_id) const;
+
+
+    ndsize_t referenceCount() const;
+
+
+    std::shared_ptr<base::IDataArray> getReference(const std::string &name_or_id) const;
+
+
+    std::shared_ptr<base::IDataArray> getReference(ndsize_t index) const;
+
+
+    void addReference(const std::string &name_or_id);
+
+
+    void addReferences(const std::vector<DataArray> &references);
+
+
+    bool removeReference(const std::string &name_or_id);
+
+
+    void references(const std::vector<DataArray> &references);
+
+    //--------------------------------------------------
+    // Methods concerning features.
+    //--------------------------------------------------
+
+    bool hasFeature(const std::string &name_or_id) const;
+
+
+    ndsize_t featureCount() const;
+
+
+    std::shared_ptr<base::IFeature> getFeature(const std::string &name_or_id) const;
+
+
+    std::shared_ptr<base::IFeature> getFeature(ndsize_t index) const;
+
+
+    std::shared_ptr<base::IFeature> createFeature(const std::string &name_or_id, LinkType link_type);
+
+
+    bool deleteFeature(const std::string &name_or_id);
+
+
+    void markDeleted();
+
+
+    virtual ~BaseTagMem();
+
+private:
+
+    std::shared_ptr<DataArrayMem> findReference(const std::string &name_or_id) const;
+
+};
+
+
+} // namespace mem
+} // namespace nix
+
+#endif // NIX_BASETAG_MEM_H
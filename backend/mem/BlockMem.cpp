@@ -0,0 +1,409 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "BlockMem.hpp"
+#include "SourceMem.hpp"
+#include "DataArrayMem.hpp"
+#include "TagMem.hpp"
+#include "MultiTagMem.hpp"
+#include "GroupMem.hpp"
+
+#include <nix/util/util.hpp>
+#include <nix/DataArray.hpp>
+#include <nix/BlockBatch.hpp>
+
+using namespace std;
+
+namespace nix {
+namespace mem {
+
+namespace {
+
+void create_dimension(base::IDataArray &da, ndsize_t index, const BlockBatch::DimensionSpec &spec) {
+    switch (spec.type) {
+        case DimensionType::Sample: {
+            auto dim = da.createSampledDimension(index, spec.sampling_interval);
+            if (spec.offset) dim->offset(*spec.offset);
+            if (spec.unit) dim->unit(*spec.unit);
+            if (spec.label) dim->label(*spec.label);
+            break;
+        }
+        case DimensionType::Set: {
+            auto dim = da.createSetDimension(index);
+            if (!spec.labels.empty()) dim->labels(spec.labels);
+            break;
+        }
+        case DimensionType::Range: {
+            auto dim = da.createRangeDimension(index, spec.ticks);
+            if (spec.unit) dim->unit(*spec.unit);
+            if (spec.label) dim->label(*spec.label);
+            break;
+        }
+    }
+}
+
+}
+
+
+BlockMem::BlockMem(const shared_ptr<FileMem> &file, const string &id, const string &type,
+                   const string &name, time_t time)
+    : EntityWithMetadataMem(file, id, type, name, time)
+{
+}
+
+//--------------------------------------------------
+// Methods concerning sources
+//--------------------------------------------------
+
+bool BlockMem::hasSource(const string &name_or_id) const {
+    return sources.has(name_or_id);
+}
+
+
+shared_ptr<base::ISource> BlockMem::getSource(const string &name_or_id) const {
+    return sources.get(name_or_id);
+}
+
+
+shared_ptr<base::ISource> BlockMem::getSource(ndsize_t index) const {
+    return sources.at(index, "block.source");
+}
+
+
+ndsize_t BlockMem::sourceCount() const {
+    return sources.size();
+}
+
+
+shared_ptr<base::ISource> BlockMem::createSource(const string &name, const string &type) {
+    if (name.empty()) {
+        throw EmptyString("name");
+    }
+    if (hasSource(name)) {
+        throw DuplicateName("createSource");
+    }
+
+    auto source = make_shared<SourceMem>(fileMem(), block(), util::createId(), type, name, util::getTime());
+    sources.add(name, source);
+    indexSource(source);
+    return source;
+}
+
+
+bool BlockMem::deleteSource(const string &name_or_id) {
+    shared_ptr<SourceMem> source = sources.remove(name_or_id);
+    if (source) {
+        source->markDeleted();
+    }
+    return source != nullptr;
+}
+
+
+shared_ptr<SourceMem> BlockMem::findSource(const string &id) const {
+    auto it = source_index.find(id);
+    return it == source_index.end() ? shared_ptr<SourceMem>() : lockValid(it->second);
+}
+
+
+void BlockMem::indexSource(const shared_ptr<SourceMem> &source) {
+    // entries of deleted sources are replaced or ignored by findSource
+    source_index[source->id()] = source;
+}
+
+//--------------------------------------------------
+// Methods concerning data arrays
+//--------------------------------------------------
+
+bool BlockMem::hasDataArray(const string &name_or_id) const {
+    return data_arrays.has(name_or_id);
+}
+
+
+shared_ptr<base::IDataArray> BlockMem::getDataArray(const string &name_or_id) const {
+    return data_arrays.get(name_or_id);
+}
+
+
+shared_ptr<base::IDataArray> BlockMem::getDataArray(ndsize_t index) const {
+    return data_arrays.at(index, "block.dataArray");
+}
+
+
+ndsize_t BlockMem::dataArrayCount() const {
+    return data_arrays.size();
+}
+
+
+shared_ptr<base::IDataArray> BlockMem::createDataArray(const string &name, const string &type,
+                                                       nix::DataType data_type, const NDSize &shape) {
+    if (name.empty()) {
+        throw EmptyString("name");
+    }
+    if (hasDataArray(name)) {
+        throw DuplicateName("createDataArray");
+    }
+
+    auto da = make_shared<DataArrayMem>(fileMem(), block(), util::createId(), type, name, util::getTime());
+    da->createData(data_type, shape);
+    data_arrays.add(name, da);
+    return da;
+}
+
+
+bool BlockMem::deleteDataArray(const string &name_or_id) {
+    shared_ptr<DataArrayMem> da = data_arrays.remove(name_or_id);
+    if (da) {
+        da->markDeleted();
+    }
+    return da != nullptr;
+}
+
+
+ndsize_t BlockMem::deleteDataArrays(const vector<string> &names_or_ids) {
+    ndsize_t deleted = 0;
+    for (const string &name_or_id : names_or_ids) {
+        if (deleteDataArray(name_or_id)) {
+            deleted++;
+        }
+    }
+    return deleted;
+}
+
+
+shared_ptr<DataArrayMem> BlockMem::findDataArray(const string &name_or_id) const {
+    return data_arrays.get(name_or_id);
+}
+
+//--------------------------------------------------
+// Methods concerning tags.
+//--------------------------------------------------
+
+bool BlockMem::hasTag(const string &name_or_id) const {
+    return tags.has(name_or_id);
+}
+
+
+shared_ptr<base::ITag> BlockMem::getTag(const string &name_or_id) const {
+    return tags.get(name_or_id);
+}
+
+
+shared_ptr<base::ITag> BlockMem::getTag(ndsize_t index) const {
+    return tags.at(index, "block.tag");
+}
+
+
+ndsize_t BlockMem::tagCount() const {
+    return tags.size();
+}
+
+
+shared_ptr<base::ITag> BlockMem::createTag(const string &name, const string &type,
+                                           const vector<double> &position) {
+    if (name.empty()) {
+        throw EmptyString("name");
+    }
+    if (hasTag(name)) {
+        throw DuplicateName("createTag");
+    }
+
+    auto tag = make_shared<TagMem>(fileMem(), block(), util::createId(), type, name, position, util::getTime());
+    tags.add(name, tag);
+    return tag;
+}
+
+
+bool BlockMem::deleteTag(const string &name_or_id) {
+    shared_ptr<TagMem> tag = tags.remove(name_or_id);
+    if (tag) {
+        tag->markDeleted();
+    }
+    return tag != nullptr;
+}
+
+
+shared_ptr<TagMem> BlockMem::findTag(const string &name_or_id) const {
+    return tags.get(name_or_id);
+}
+
+//--------------------------------------------------
+// Methods concerning multi tags.
+//--------------------------------------------------
+
+bool BlockMem::hasMultiTag(const string &name_or_id) const {
+    return multi_tags.has(name_or_id);
+}
+
+
+shared_ptr<base::IMultiTag> BlockMem::getMultiTag(const string &name_or_id) const {
+    return multi_tags.get(name_or_id);
+}
+
+
+shared_ptr<base::IMultiTag> BlockMem::getMultiTag(ndsize_t index) const {
+    return multi_tags.at(index, "block.multiTag");
+}
+
+
+ndsize_t BlockMem::multiTagCount() const {
+    return multi_tags.size();
+}
+
+
+shared_ptr<base::IMultiTag> BlockMem::createMultiTag(const string &name, const string &type,
+                                                     const DataArray &positions) {
+    if (name.empty()) {
+        throw EmptyString("name");
+    }
+    if (hasMultiTag(name)) {
+        throw DuplicateName("createMultiTag");
+    }
+
+    auto mtag = make_shared<MultiTagMem>(fileMem(), block(), util::createId(), type, name, util::getTime());
+    mtag->positions(positions.id());
+    multi_tags.add(name, mtag);
+    return mtag;
+}
+
+
+bool BlockMem::deleteMultiTag(const string &name_or_id) {
+    shared_ptr<MultiTagMem> mtag = multi_tags.remove(name_or_id);
+    if (mtag) {
+        mtag->markDeleted();
+    }
+    return mtag != nullptr;
+}
+
+
+shared_ptr<MultiTagMem> BlockMem::findMultiTag(const string &name_or_id) const {
+    return multi_tags.get(name_or_id);
+}
+
+//--------------------------------------------------
+// Methods concerning groups.
+//--------------------------------------------------
+
+bool BlockMem::hasGroup(const string &name_or_id) const {
+    return groups.has(name_or_id);
+}
+
+
+shared_ptr<base::IGroup> BlockMem::getGroup(const string &name_or_id) const {
+    return groups.get(name_or_id);
+}
+
+
+shared_ptr<base::IGroup> BlockMem::getGroup(ndsize_t index) const {
+    return groups.at(index, "block.group");
+}
+
+
+ndsize_t BlockMem::groupCount() const {
+    return groups.size();
+}
+
+
+shared_ptr<base::IGroup> BlockMem::createGroup(const string &name, const string &type) {
+    if (name.empty()) {
+        throw EmptyString("name");
+    }
+    if (hasGroup(name)) {
+        throw DuplicateName("createGroup");
+    }
+
+    auto group = make_shared<GroupMem>(fileMem(), block(), util::createId(), type, name, util::getTime());
+    groups.add(name, group);
+    return group;
+}
+
+
+bool BlockMem::deleteGroup(const string &name_or_id) {
+    shared_ptr<GroupMem> group = groups.remove(name_or_id);
+    if (group) {
+        group->markDeleted();
+    }
+    return group != nullptr;
+}
+
+//--------------------------------------------------
+// Batched creation
+//--------------------------------------------------
+
+void BlockMem::createBatch(const BlockBatch &batch) {
+    time_t now = util::getTime();
+
+    for (size_t i = 0; i < batch.sourceCount(); i++) {
+        const BlockBatch::SourceSpec &spec = batch.source(i);
+        auto source = make_shared<SourceMem>(fileMem(), block(), spec.id, spec.type, spec.name, now);
+        sources.add(spec.name, source);
+        indexSource(source);
+    }
+
+    for (size_t i = 0; i < batch.dataArrayCount(); i++) {
+        const BlockBatch::DataArraySpec &spec = batch.dataArray(i);
+        auto da = make_shared<DataArrayMem>(fileMem(), block(), spec.id, spec.type, spec.name, now);
+        da->createData(spec.data_type, spec.shape);
+        if (spec.unit) da->unit(*spec.unit);
+        if (spec.label) da->label(*spec.label);
+        for (size_t d = 0; d < spec.dimensions.size(); d++) {
+            create_dimension(*da, d + 1, spec.dimensions[d]);
+        }
+        for (const string &id : spec.sources) {
+            da->addSource(id);
+        }
+        data_arrays.add(spec.name, da);
+    }
+
+    for (size_t i = 0; i < batch.tagCount(); i++) {
+        const BlockBatch::TagSpec &spec = batch.tag(i);
+        auto tag = make_shared<TagMem>(fileMem(), block(), spec.id, spec.type, spec.name, spec.position, now);
+        if (!spec.extent.empty()) tag->extent(spec.extent);
+        if (!spec.units.empty()) tag->units(spec.units);
+        for (const string &id : spec.references) {
+            tag->addReference(id);
+        }
+        for (const string &id : spec.sources) {
+            tag->addSource(id);
+        }
+        tags.add(spec.name, tag);
+    }
+}
+
+//--------------------------------------------------
+// Other methods and functions
+//--------------------------------------------------
+
+shared_ptr<BlockMem> BlockMem::block() const {
+    return const_pointer_cast<BlockMem>(shared_from_this());
+}
+
+
+void BlockMem::markDeleted() {
+    for (const auto &source : sources.all()) {
+        source->markDeleted();
+    }
+    for (const auto &da : data_arrays.all()) {
+        da->markDeleted();
+    }
+    for (const auto &tag : tags.all()) {
+        tag->markDeleted();
+    }
+    for (const auto &mtag : multi_tags.all()) {
+        mtag->markDeleted();
+    }
+    for (const auto &group : groups.all()) {
+        group->markDeleted();
+    }
+    EntityWithMetadataMem::markDeleted();
+}
+
+
+BlockMem::~BlockMem() {}
+
+} // ns nix::mem
+} // ns nix
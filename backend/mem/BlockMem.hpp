@@ -0,0 +1,204 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_BLOCK_MEM_H
+#define NIX_BLOCK_MEM_H
+
+#include <nix/base/IBlock.hpp>
+#include "EntityWithMetadataMem.hpp"
+#include "Containers.hpp"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <memory>
+
+namespace nix {
+namespace mem {
+
+class SourceMem;
+class DataArrayMem;
+class TagMem;
+class MultiTagMem;
+class GroupMem;
+
+/**
+ * Class that represents a NIX Block entity that is kept in memory.
+ */
+class BlockMem : virtual public base::IBlock, public EntityWithMetadataMem,
+                 public std::enable_shared_from_this<BlockMem> {
+
+private:
+
+    EntityList<SourceMem> sources;
+    EntityList<DataArrayMem> data_arrays;
+    EntityList<TagMem> tags;
+    EntityList<MultiTagMem> multi_tags;
+    EntityList<GroupMem> groups;
+
+    // all sources of the block, including nested ones, by id
+    std::unordered_map<std::string, std::weak_ptr<SourceMem>> source_index;
+
+public:
+
+    BlockMem(const std::shared_ptr<FileMem> &file, const std::string &id, const std::string &type,
+             const std::string &name, time_t time);
+
+    //--------------------------------------------------
+    // Methods concerning sources
+    //--------------------------------------------------
+
+    bool hasSource(const std::string &name_or_id) const;
+
+
+    std::shared_ptr<base::ISource> getSource(const std::string &name_or_id) const;
+
+
+    std::shared_ptr<base::ISource> getSource(ndsize_t index) const;
+
+
+    ndsize_t sourceCount() const;
+
+
+    std::shared_ptr<base::ISource> createSource(const std::string &name, const std::string &type);
+
+
+    bool deleteSource(const std::string &name_or_id);
+
+    /**
+     * @brief Find a source of this block at any depth by its id.
+     */
+    std::shared_ptr<SourceMem> findSource(const std::string &id) const;
+
+
+    void indexSource(const std::shared_ptr<SourceMem> &source);
+
+    //--------------------------------------------------
+    // Methods concerning data arrays
+    //--------------------------------------------------
+
+    bool hasDataArray(const std::string &name_or_id) const;
+
+
+    std::shared_ptr<base::IDataArray> getDataArray(const std::string &name_or_id) const;
+
+
+    std::shared_ptr<base::IDataArray> getDataArray(ndsize_t index) const;
+
+
+    ndsize_t dataArrayCount() const;
+
+
+    std::shared_ptr<base::IDataArray> createDataArray(const std::string &name, const std::string &type,
+                                                      nix::DataType data_type, const NDSize &shape);
+
+
+    bool deleteDataArray(const std::string &name_or_id);
+
+
+    ndsize_t deleteDataArrays(const std::vector<std::string> &names_or_ids);
+
+
+    std::shared_ptr<DataArrayMem> findDataArray(const std::string &name_or_id) const;
+
+    //--------------------------------------------------
+    // Methods concerning tags.
+    //--------------------------------------------------
+
+    bool hasTag(const std::string &name_or_id) const;
+
+
+    std::shared_ptr<base::ITag> getTag(const std::string &name_or_id) const;
+
+
+    std::shared_ptr<base::ITag> getTag(ndsize_t index) const;
+
+
+    ndsize_t tagCount() const;
+
+
+    std::shared_ptr<base::ITag> createTag(const std::string &name, const std::string &type,
+                                          const std::vector<double> &position);
+
+
+    bool deleteTag(const std::string &name_or_id);
+
+
+    std::shared_ptr<TagMem> findTag(const std::string &name_or_id) const;
+
+    //--------------------------------------------------
+    // Methods concerning multi tags.
+    //--------------------------------------------------
+
+    bool hasMultiTag(const std::string &name_or_id) const;
+
+
+    std::shared_ptr<base::IMultiTag> getMultiTag(const std::string &name_or_id) const;
+
+
+    std::shared_ptr<base::IMultiTag> getMultiTag(ndsize_t index) const;
+
+
+    ndsize_t multiTagCount() const;
+
+
+    std::shared_ptr<base::IMultiTag> createMultiTag(const std::string &name, const std::string &type,
+                                                    const DataArray &positions);
+
+
+    bool deleteMultiTag(const std::string &name_or_id);
+
+
+    std::shared_ptr<MultiTagMem> findMultiTag(const std::string &name_or_id) const;
+
+    //--------------------------------------------------
+    // Methods concerning groups.
+    //--------------------------------------------------
+
+    bool hasGroup(const std::string &name_or_id) const;
+
+
+    std::shared_ptr<base::IGroup> getGroup(const std::string &name_or_id) const;
+
+
+    std::shared_ptr<base::IGroup> getGroup(ndsize_t index) const;
+
+
+    ndsize_t groupCount() const;
+
+
+    std::shared_ptr<base::IGroup> createGroup(const std::string &name, const std::string &type);
+
+
+    bool deleteGroup(const std::string &name_or_id);
+
+    //--------------------------------------------------
+    // Batched creation
+    //--------------------------------------------------
+
+    void createBatch(const BlockBatch &batch);
+
+    //--------------------------------------------------
+    // Other methods and functions
+    //--------------------------------------------------
+
+    std::shared_ptr<BlockMem> block() const;
+
+
+    void markDeleted();
+
+
+    virtual ~BlockMem();
+
+};
+
+
+} // namespace mem
+} // namespace nix
+
+#endif // NIX_BLOCK_MEM_H
@@ -0,0 +1,239 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_CONTAINERS_MEM_H
+#define NIX_CONTAINERS_MEM_H
+
+#include <nix/Exception.hpp>
+#include <nix/NDSize.hpp>
+
+#include "EntityMem.hpp"
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace nix {
+namespace mem {
+
+/**
+ * @brief Returns the target of a reference or null if it is gone or was deleted.
+ */
+template<typename T>
+std::shared_ptr<T> lockValid(const std::weak_ptr<T> &ref) {
+    std::shared_ptr<T> target = ref.lock();
+    if (target && !target->isValidEntity()) {
+        target.reset();
+    }
+    return target;
+}
+
+
+/**
+ * @brief Entities owned by a parent, kept in creation order and
+ *        indexed by name and by id.
+ */
+template<typename T>
+class EntityList {
+
+private:
+
+    std::vector<std::shared_ptr<T>> items;
+    std::vector<std::string> names;
+    std::unordered_map<std::string, size_t> by_name, by_id;
+
+    void reindex() {
+        by_name.clear();
+        by_id.clear();
+        for (size_t i = 0; i < items.size(); i++) {
+            by_name.emplace(names[i], i);
+            by_id.emplace(items[i]->id(), i);
+        }
+    }
+
+public:
+
+    size_t size() const {
+        return items.size();
+    }
+
+
+    bool has(const std::string &name_or_id) const {
+        return by_name.count(name_or_id) > 0 || by_id.count(name_or_id) > 0;
+    }
+
+    /**
+     * @brief Look up an entity by name first and by id second.
+     *
+     * @return The entity or null if there is none.
+     */
+    std::shared_ptr<T> get(const std::string &name_or_id) const {
+        auto it = by_name.find(name_or_id);
+        if (it == by_name.end()) {
+            it = by_id.find(name_or_id);
+            if (it == by_id.end()) {
+                return std::shared_ptr<T>();
+            }
+        }
+        return items[it->second];
+    }
+
+
+    std::shared_ptr<T> at(ndsize_t index, const std::string &what) const {
+        if (index >= items.size()) {
+            throw OutOfBounds("Trying to access " + what + " with invalid index.", index);
+        }
+        return items[index];
+    }
+
+
+    void add(const std::string &name, const std::shared_ptr<T> &item) {
+        by_name.emplace(name, items.size());
+        by_id.emplace(item->id(), items.size());
+        names.push_back(name);
+        items.push_back(item);
+    }
+
+    /**
+     * @brief Remove an entity from the list.
+     *
+     * @return The removed entity or null if there is none.
+     */
+    std::shared_ptr<T> remove(const std::string &name_or_id) {
+        std::shared_ptr<T> item = get(name_or_id);
+        if (item) {
+            size_t index = by_id[item->id()];
+            items.erase(items.begin() + index);
+            names.erase(names.begin() + index);
+            reindex();
+        }
+        return item;
+    }
+
+
+    const std::vector<std::shared_ptr<T>> &all() const {
+        return items;
+    }
+
+
+    void clear() {
+        items.clear();
+        names.clear();
+        by_name.clear();
+        by_id.clear();
+    }
+};
+
+
+/**
+ * @brief Links to entities owned by someone else, indexed by id.
+ *
+ * Targets that were deleted are dropped lazily, the next time the
+ * list is accessed after some entity was deleted.
+ */
+template<typename T>
+class RefList {
+
+private:
+
+    mutable std::vector<std::weak_ptr<T>> items;
+    mutable std::unordered_map<std::string, size_t> by_id;
+    mutable uint64_t epoch = 0;
+
+    void prune() const {
+        uint64_t current = deletionEpoch();
+        if (epoch == current) {
+            return;
+        }
+        epoch = current;
+
+        std::vector<std::weak_ptr<T>> valid;
+        by_id.clear();
+        for (const auto &ref : items) {
+            std::shared_ptr<T> target = lockValid(ref);
+            if (target) {
+                by_id.emplace(target->id(), valid.size());
+                valid.push_back(ref);
+            }
+        }
+        items.swap(valid);
+    }
+
+public:
+
+    size_t size() const {
+        prune();
+        return items.size();
+    }
+
+
+    bool has(const std::string &id) const {
+        prune();
+        return by_id.count(id) > 0;
+    }
+
+
+    std::shared_ptr<T> get(const std::string &id) const {
+        prune();
+        auto it = by_id.find(id);
+        return it == by_id.end() ? std::shared_ptr<T>() : lockValid(items[it->second]);
+    }
+
+    /**
+     * @brief The target at the given index or null if the index is out of range.
+     */
+    std::shared_ptr<T> at(ndsize_t index) const {
+        prune();
+        return index < items.size() ? lockValid(items[index]) : std::shared_ptr<T>();
+    }
+
+    /**
+     * @brief Add a link, links that already exist are ignored.
+     */
+    void add(const std::shared_ptr<T> &target) {
+        prune();
+        if (by_id.emplace(target->id(), items.size()).second) {
+            items.push_back(target);
+        }
+    }
+
+
+    bool remove(const std::string &id) {
+        prune();
+        auto it = by_id.find(id);
+        if (it == by_id.end()) {
+            return false;
+        }
+        items.erase(items.begin() + it->second);
+        by_id.clear();
+        for (size_t i = 0; i < items.size(); i++) {
+            std::shared_ptr<T> target = items[i].lock();
+            by_id.emplace(target ? target->id() : std::string(), i);
+        }
+        return true;
+    }
+
+
+    std::vector<std::shared_ptr<T>> all() const {
+        prune();
+        std::vector<std::shared_ptr<T>> targets;
+        for (const auto &ref : items) {
+            std::shared_ptr<T> target = lockValid(ref);
+            if (target) {
+                targets.push_back(target);
+            }
+        }
+        return targets;
+    }
+};
+
+} // namespace mem
+} // namespace nix
+
+#endif // NIX_CONTAINERS_MEM_H
@@ -0,0 +1,443 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "DataArrayMem.hpp"
+#include "DimensionMem.hpp"
+#include "ValueConversion.hpp"
+
+#include <nix/util/util.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+using namespace std;
+using namespace nix::conversion;
+
+namespace nix {
+namespace mem {
+
+
+DataArrayMem::DataArrayMem(const shared_ptr<FileMem> &file, const shared_ptr<BlockMem> &block,
+                           const string &id, const string &type, const string &name, time_t time)
+    : EntityWithSourcesMem(file, block, id, type, name, time), dtype(DataType::Nothing)
+{
+    dataChanged();
+}
+
+
+void DataArrayMem::dataChanged() {
+    static atomic<uint64_t> versions(0);
+    data_version = ++versions;
+}
+
+//--------------------------------------------------
+// Element getters and setters
+//--------------------------------------------------
+
+boost::optional<string> DataArrayMem::label() const {
+    return data_label;
+}
+
+
+void DataArrayMem::label(const string &label) {
+    data_label = label;
+    forceUpdatedAt();
+}
+
+
+void DataArrayMem::label(const none_t t) {
+    data_label = boost::none;
+    forceUpdatedAt();
+}
+
+
+boost::optional<string> DataArrayMem::unit() const {
+    return data_unit;
+}
+
+
+void DataArrayMem::unit(const string &unit) {
+    data_unit = unit;
+    forceUpdatedAt();
+}
+
+
+void DataArrayMem::unit(const none_t t) {
+    data_unit = boost::none;
+    forceUpdatedAt();
+}
+
+
+boost::optional<double> DataArrayMem::expansionOrigin() const {
+    return expansion_origin;
+}
+
+
+void DataArrayMem::expansionOrigin(double expansion_origin) {
+    this->expansion_origin = expansion_origin;
+    dataChanged();
+    forceUpdatedAt();
+}
+
+
+void DataArrayMem::expansionOrigin(const none_t t) {
+    expansion_origin = boost::none;
+    dataChanged();
+    forceUpdatedAt();
+}
+
+
+vector<double> DataArrayMem::polynomCoefficients() const {
+    return polynom_coefficients;
+}
+
+
+void DataArrayMem::polynomCoefficients(const vector<double> &coefficients) {
+    polynom_coefficients = coefficients;
+    dataChanged();
+    forceUpdatedAt();
+}
+
+
+void DataArrayMem::polynomCoefficients(const none_t t) {
+    polynom_coefficients.clear();
+    dataChanged();
+    forceUpdatedAt();
+}
+
+//--------------------------------------------------
+// Methods concerning dimensions
+//--------------------------------------------------
+
+ndsize_t DataArrayMem::dimensionCount() const {
+    return dimensions.size();
+}
+
+
+shared_ptr<base::IDimension> DataArrayMem::getDimension(ndsize_t index) const {
+    if (index == 0 || index > dimensions.size()) {
+        return shared_ptr<base::IDimension>();
+    }
+    // a new handle every time, like the handles of the other back-ends
+    return dimensions[index - 1]->handle();
+}
+
+
+void DataArrayMem::setDimension(ndsize_t index, const shared_ptr<DimensionMem> &dim) {
+    ndsize_t dim_max = dimensions.size() + 1;
+    if (index > dim_max || index <= 0)
+        throw runtime_error("Invalid dimension index: has to be 0 < index <= " + util::numToStr(dim_max));
+
+    if (index == dim_max) {
+        dimensions.push_back(dim);
+    } else {
+        dimensions[index - 1] = dim;
+    }
+}
+
+
+shared_ptr<base::ISetDimension> DataArrayMem::createSetDimension(ndsize_t index) {
+    auto dim = make_shared<SetDimensionMem>(index);
+    setDimension(index, dim);
+    return dim;
+}
+
+
+shared_ptr<base::IRangeDimension> DataArrayMem::createRangeDimension(ndsize_t index, const vector<double> &ticks) {
+    auto dim = make_shared<RangeDimensionMem>(index, ticks);
+    setDimension(index, dim);
+    return dim;
+}
+
+
+shared_ptr<base::IRangeDimension> DataArrayMem::createAliasRangeDimension() {
+    auto dim = make_shared<RangeDimensionMem>(1, shared_from_this());
+    setDimension(1, dim);
+    return dim;
+}
+
+
+shared_ptr<base::ISampledDimension> DataArrayMem::createSampledDimension(ndsize_t index, double sampling_interval) {
+    auto dim = make_shared<SampledDimensionMem>(index, sampling_interval);
+    setDimension(index, dim);
+    return dim;
+}
+
+
+bool DataArrayMem::deleteDimensions() {
+    dimensions.clear();
+    return true;
+}
+
+
+vector<DimensionDescriptor> DataArrayMem::dimensionDescriptors() const {
+    vector<DimensionDescriptor> descriptors;
+    descriptors.reserve(dimensions.size());
+    for (const auto &dim : dimensions) {
+        descriptors.emplace_back(*dim);
+    }
+    return descriptors;
+}
+
+//--------------------------------------------------
+// Methods concerning data access.
+//--------------------------------------------------
+
+void DataArrayMem::createData(DataType dtype, const NDSize &size) {
+    if (hasData()) {
+        throw ConsistencyError("DataArray's data already exists!");
+    }
+    if (dtype == DataType::Nothing) {
+        throw invalid_argument("DataArrayMem::createData: invalid data type");
+    }
+
+    this->dtype = dtype;
+    extent = size;
+    if (dtype == DataType::String) {
+        strings.resize(size.nelms());
+    } else {
+        data = make_shared<Buffer<char>>(size.nelms() * element_size(dtype), 0);
+    }
+    dataChanged();
+}
+
+
+bool DataArrayMem::hasData() const {
+    return dtype != DataType::Nothing;
+}
+
+
+void DataArrayMem::write(DataType dtype, const void *data, const NDSize &count, const NDSize &offset) {
+    if (!hasData()) {
+        throw ConsistencyError("DataArray with missing data");
+    }
+
+    NDSize sel_count, sel_offset;
+    resolve_selection(extent, count, offset, sel_count, sel_offset, "DataArray::write");
+
+    if (dtype == DataType::String || this->dtype == DataType::String) {
+        if (dtype != this->dtype) {
+            throw invalid_argument("DataArrayMem::write: strings cannot be converted to other types");
+        }
+        const string *src = static_cast<const string *>(data);
+        for_each_run(extent, sel_count, sel_offset, [&](ndsize_t pos, ndsize_t flat, ndsize_t n) {
+            copy(src + pos, src + pos + n, strings.begin() + flat);
+        });
+        dataChanged();
+        return;
+    }
+
+    const char *src = static_cast<const char *>(data);
+    char *dst = this->data->data();
+    const size_t src_size = element_size(dtype), dst_size = element_size(this->dtype);
+    for_each_run(extent, sel_count, sel_offset, [&](ndsize_t pos, ndsize_t flat, ndsize_t n) {
+        convert(dtype, src + pos * src_size, this->dtype, dst + flat * dst_size, n);
+    });
+    dataChanged();
+}
+
+
+void DataArrayMem::read(DataType dtype, void *data, const NDSize &count, const NDSize &offset) const {
+    if (!hasData()) {
+        throw ConsistencyError("DataArray with missing data");
+    }
+
+    NDSize sel_count, sel_offset;
+    resolve_selection(extent, count, offset, sel_count, sel_offset, "DataArray::read");
+
+    if (dtype == DataType::String || this->dtype == DataType::String) {
+        if (dtype != this->dtype) {
+            throw invalid_argument("DataArrayMem::read: strings cannot be converted to other types");
+        }
+        string *dst = static_cast<string *>(data);
+        for_each_run(extent, sel_count, sel_offset, [&](ndsize_t pos, ndsize_t flat, ndsize_t n) {
+            copy(strings.begin() + flat, strings.begin() + flat + n, dst + pos);
+        });
+        return;
+    }
+
+    const char *src = this->data->data();
+    char *dst = static_cast<char *>(data);
+    const size_t src_size = element_size(this->dtype), dst_size = element_size(dtype);
+    for_each_run(extent, sel_count, sel_offset, [&](ndsize_t pos, ndsize_t flat, ndsize_t n) {
+        convert(this->dtype, src + flat * src_size, dtype, dst + pos * dst_size, n);
+    });
+}
+
+
+NDSize DataArrayMem::dataExtent() const {
+    return hasData() ? extent : NDSize{};
+}
+
+
+void DataArrayMem::dataExtent(const NDSize &new_extent) {
+    if (!hasData()) {
+        throw runtime_error("Data field not found in DataArray!");
+    }
+    if (new_extent.size() != extent.size()) {
+        throw IncompatibleDimensions("Cannot change the rank of the data", "DataArray::dataExtent");
+    }
+    if (new_extent == extent) {
+        return;
+    }
+
+    const size_t rank = extent.size();
+    bool same_layout = true;
+    for (size_t i = 1; i < rank; i++) {
+        same_layout = same_layout && extent[i] == new_extent[i];
+    }
+
+    const size_t es = element_size(dtype);
+    const ndsize_t old_nelms = extent.nelms(), new_nelms = new_extent.nelms();
+
+    // growing or shrinking along the first dimension keeps the layout: resize in place
+    // unless the buffer is shared with a view, which would be left dangling
+    if (same_layout && dtype == DataType::String) {
+        strings.resize(new_nelms);
+    } else if (same_layout && data.use_count() == 1) {
+        data->resize(new_nelms * es);
+        if (new_nelms > old_nelms) {
+            memset(data->data() + old_nelms * es, 0, (new_nelms - old_nelms) * es);
+        }
+    } else if (dtype == DataType::String) {
+        vector<string> resized(new_nelms);
+        NDSize overlap(rank);
+        for (size_t i = 0; i < rank; i++) {
+            overlap[i] = min(extent[i], new_extent[i]);
+        }
+        NDSize origin(rank, 0);
+        vector<string> tmp(overlap.nelms());
+        read(DataType::String, tmp.data(), overlap, origin);
+        for_each_run(new_extent, overlap, origin, [&](ndsize_t pos, ndsize_t flat, ndsize_t n) {
+            move(tmp.begin() + pos, tmp.begin() + pos + n, resized.begin() + flat);
+        });
+        strings.swap(resized);
+    } else {
+        auto resized = make_shared<Buffer<char>>(new_nelms * es, 0);
+        NDSize overlap(rank);
+        for (size_t i = 0; i < rank; i++) {
+            overlap[i] = min(extent[i], new_extent[i]);
+        }
+        NDSize origin(rank, 0);
+        Buffer<char> tmp(overlap.nelms() * es);
+        read(dtype, tmp.data(), overlap, origin);
+        for_each_run(new_extent, overlap, origin, [&](ndsize_t pos, ndsize_t flat, ndsize_t n) {
+            memcpy(resized->data() + flat * es, tmp.data() + pos * es, n * es);
+        });
+        data = resized;
+    }
+
+    extent = new_extent;
+    dataChanged();
+}
+
+
+DataType DataArrayMem::dataType() const {
+    return dtype;
+}
+
+
+boost::optional<MappedData> DataArrayMem::mapData() const {
+    if (!hasData() || dtype == DataType::String || extent.nelms() == 0) {
+        return boost::none;
+    }
+
+    // the aliasing pointer keeps the buffer alive as long as the view exists
+    shared_ptr<const void> storage(data, data->data());
+    return MappedData(dtype, extent, storage, data->data(), true);
+}
+
+
+NDSize DataArrayMem::chunkExtent() const {
+    return NDSize{};
+}
+
+
+bool DataArrayMem::concurrentReads() const {
+    return false;
+}
+
+
+void DataArrayMem::writeChunk(const NDSize &chunk, const void *data, size_t nbytes, uint32_t filter_mask) {
+    throw runtime_error("DataArray::writeChunk: data is not stored in chunks");
+}
+
+
+bool DataArrayMem::readChunk(const NDSize &chunk, Buffer<char> &data, uint32_t &filter_mask) const {
+    throw runtime_error("DataArray::readChunk: data is not stored in chunks");
+}
+
+
+NDSize DataArrayMem::derivedExtent(const string &name) const {
+    auto it = derived.find(name);
+    if (it == derived.end() || it->second.version != data_version) {
+        return NDSize{};
+    }
+    return it->second.extent;
+}
+
+
+void DataArrayMem::readDerived(const string &name, double *data, const NDSize &count, const NDSize &offset) const {
+    auto it = derived.find(name);
+    if (it == derived.end()) {
+        throw runtime_error("DataArrayMem::readDerived: no derived array " + name);
+    }
+
+    const Derived &d = it->second;
+    NDSize sel_count, sel_offset;
+    resolve_selection(d.extent, count, offset, sel_count, sel_offset, "DataArrayMem::readDerived");
+    for_each_run(d.extent, sel_count, sel_offset, [&](ndsize_t pos, ndsize_t flat, ndsize_t n) {
+        copy(d.values.begin() + flat, d.values.begin() + flat + n, data + pos);
+    });
+}
+
+
+void DataArrayMem::writeDerived(const string &name, const NDSize &extent, const double *data,
+                                const NDSize &count, const NDSize &offset) {
+    Derived &d = derived[name];
+
+    if (d.extent != extent) {
+        // keep the values that lie within both extents
+        vector<double> resized(extent.nelms(), 0.0);
+        if (d.extent.size() == extent.size()) {
+            const size_t rank = extent.size();
+            NDSize overlap(rank), origin(rank, 0);
+            for (size_t i = 0; i < rank; i++) {
+                overlap[i] = min(d.extent[i], extent[i]);
+            }
+            vector<double> tmp(overlap.nelms());
+            for_each_run(d.extent, overlap, origin, [&](ndsize_t pos, ndsize_t flat, ndsize_t n) {
+                copy(d.values.begin() + flat, d.values.begin() + flat + n, tmp.begin() + pos);
+            });
+            for_each_run(extent, overlap, origin, [&](ndsize_t pos, ndsize_t flat, ndsize_t n) {
+                copy(tmp.begin() + pos, tmp.begin() + pos + n, resized.begin() + flat);
+            });
+        }
+        d.values.swap(resized);
+        d.extent = extent;
+    }
+
+    NDSize sel_count, sel_offset;
+    resolve_selection(d.extent, count, offset, sel_count, sel_offset, "DataArrayMem::writeDerived");
+    for_each_run(d.extent, sel_count, sel_offset, [&](ndsize_t pos, ndsize_t flat, ndsize_t n) {
+        copy(data + pos, data + pos + n, d.values.begin() + flat);
+    });
+    d.version = data_version;
+}
+
+
+void DataArrayMem::deleteDerived(const string &name) {
+    derived.erase(name);
+}
+
+
+DataArrayMem::~DataArrayMem() {}
+
+} // ns nix::mem
+} // ns nix
@@ -0,0 +1,205 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_DATA_ARRAY_MEM_H
+#define NIX_DATA_ARRAY_MEM_H
+
+#include <nix/base/IDataArray.hpp>
+#include <nix/Buffer.hpp>
+#include "EntityWithSourcesMem.hpp"
+
+#include <map>
+#include <string>
+#include <vector>
+#include <memory>
+
+namespace nix {
+namespace mem {
+
+class DimensionMem;
+
+/**
+ * Class that represents a NIX DataArray entity that is kept in memory.
+ *
+ * Numeric and opaque data is stored in one contiguous, row-major buffer
+ * of the stored data type, strings are kept in a vector.
+ */
+class DataArrayMem : virtual public base::IDataArray, public EntityWithSourcesMem,
+                     public std::enable_shared_from_this<DataArrayMem> {
+
+private:
+
+    boost::optional<std::string> data_label, data_unit;
+    boost::optional<double> expansion_origin;
+    std::vector<double> polynom_coefficients;
+    std::vector<std::shared_ptr<DimensionMem>> dimensions;
+
+    DataType dtype;
+    NDSize extent;
+    // replaced when the extent changes, views keep the old one alive
+    std::shared_ptr<Buffer<char>> data;
+    std::vector<std::string> strings;
+    // unique among all arrays, renewed on every change of the data
+    uint64_t data_version;
+
+    struct Derived {
+        NDSize extent;
+        std::vector<double> values;
+        // the data version the values belong to
+        uint64_t version = 0;
+    };
+    std::map<std::string, Derived> derived;
+
+    void dataChanged();
+
+public:
+
+    DataArrayMem(const std::shared_ptr<FileMem> &file, const std::shared_ptr<BlockMem> &block,
+                 const std::string &id, const std::string &type, const std::string &name, time_t time);
+
+    //--------------------------------------------------
+    // Element getters and setters
+    //--------------------------------------------------
+
+    boost::optional<std::string> label() const;
+
+
+    void label(const std::string &label);
+
+
+    void label(const none_t t);
+
+
+    boost::optional<std::string> unit() const;
+
+
+    void unit(const std::string &unit);
+
+
+    void unit(const none_t t);
+
+
+    boost::optional<double> expansionOrigin() const;
+
+
+    void expansionOrigin(double expansion_origin);
+
+
+    void expansionOrigin(const none_t t);
+
+
+    std::vector<double> polynomCoefficients() const;
+
+
+    void polynomCoefficients(const std::vector<double> &polynom_coefficients);
+
+
+    void polynomCoefficients(const none_t t);
+
+    //--------------------------------------------------
+    // Methods concerning dimensions
+    //--------------------------------------------------
+
+    ndsize_t dimensionCount() const;
+
+
+    std::shared_ptr<base::IDimension> getDimension(ndsize_t index) const;
+
+
+    std::shared_ptr<base::ISetDimension> createSetDimension(ndsize_t index);
+
+
+    std::shared_ptr<base::IRangeDimension> createRangeDimension(ndsize_t index, const std::vector<double> &ticks);
+
+
+    std::shared_ptr<base::IRangeDimension> createAliasRangeDimension();
+
+
+    std::shared_ptr<base::ISampledDimension> createSampledDimension(ndsize_t index, double sampling_interval);
+
+
+    bool deleteDimensions();
+
+
+    std::vector<DimensionDescriptor> dimensionDescriptors() const;
+
+    //--------------------------------------------------
+    // Methods concerning data access.
+    //--------------------------------------------------
+
+    void createData(DataType dtype, const NDSize &size);
+
+
+    bool hasData() const;
+
+
+    void write(DataType dtype, const void *data, const NDSize &count, const NDSize &offset);
+
+
+    void read(DataType dtype, void *data, const NDSize &count, const NDSize &offset) const;
+
+
+    NDSize dataExtent() const;
+
+
+    void dataExtent(const NDSize &extent);
+
+
+    DataType dataType() const;
+
+    /**
+     * @brief A view of the stored data, without copying it.
+     *
+     * The view reflects all later writes until the extent changes.
+     */
+    boost::optional<MappedData> mapData() const;
+
+
+    NDSize chunkExtent() const;
+
+
+    bool concurrentReads() const;
+
+
+    void writeChunk(const NDSize &chunk, const void *data, size_t nbytes, uint32_t filter_mask);
+
+
+    bool readChunk(const NDSize &chunk, Buffer<char> &data, uint32_t &filter_mask) const;
+
+    NDSize derivedExtent(const std::string &name) const;
+
+
+    void readDerived(const std::string &name, double *data, const NDSize &count, const NDSize &offset) const;
+
+
+    void writeDerived(const std::string &name, const NDSize &extent, const double *data,
+                      const NDSize &count, const NDSize &offset);
+
+
+    void deleteDerived(const std::string &name);
+
+    /**
+     * Identifies the current content of the data; values derived from the
+     * data remain valid as long as the version does not change.
+     */
+    uint64_t dataVersion() const { return data_version; }
+
+
+    virtual ~DataArrayMem();
+
+private:
+
+    void setDimension(ndsize_t index, const std::shared_ptr<DimensionMem> &dim);
+
+};
+
+
+} // namespace mem
+} // namespace nix
+
+#endif // NIX_DATA_ARRAY_MEM_H
@@ -0,0 +1,280 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "DimensionMem.hpp"
+#include "DataArrayMem.hpp"
+
+#include <nix/Exception.hpp>
+
+using namespace std;
+
+namespace nix {
+namespace mem {
+
+
+DimensionMem::DimensionMem(ndsize_t index)
+    : dim_index(index)
+{
+}
+
+
+DimensionMem::~DimensionMem() {}
+
+//--------------------------------------------------------------
+// Implementation of SampledDimension
+//--------------------------------------------------------------
+
+SampledDimensionMem::SampledDimensionMem(ndsize_t index, double sampling_interval)
+    : DimensionMem(index), state(make_shared<State>())
+{
+    state->sampling_interval = sampling_interval;
+}
+
+
+shared_ptr<base::IDimension> SampledDimensionMem::handle() const {
+    return make_shared<SampledDimensionMem>(*this);
+}
+
+
+DimensionType SampledDimensionMem::dimensionType() const {
+    return DimensionType::Sample;
+}
+
+
+boost::optional<string> SampledDimensionMem::label() const {
+    return state->label;
+}
+
+
+void SampledDimensionMem::label(const string &label) {
+    state->label = label;
+}
+
+
+void SampledDimensionMem::label(const none_t t) {
+    state->label = boost::none;
+}
+
+
+boost::optional<string> SampledDimensionMem::unit() const {
+    return state->unit;
+}
+
+
+void SampledDimensionMem::unit(const string &unit) {
+    state->unit = unit;
+}
+
+
+void SampledDimensionMem::unit(const none_t t) {
+    state->unit = boost::none;
+}
+
+
+double SampledDimensionMem::samplingInterval() const {
+    return state->sampling_interval;
+}
+
+
+void SampledDimensionMem::samplingInterval(double sampling_interval) {
+    state->sampling_interval = sampling_interval;
+}
+
+
+boost::optional<double> SampledDimensionMem::offset() const {
+    return state->offset;
+}
+
+
+void SampledDimensionMem::offset(double offset) {
+    state->offset = offset;
+}
+
+
+void SampledDimensionMem::offset(const none_t t) {
+    state->offset = boost::none;
+}
+
+
+SampledDimensionMem::~SampledDimensionMem() {}
+
+//--------------------------------------------------------------
+// Implementation of SetDimensionMem
+//--------------------------------------------------------------
+
+SetDimensionMem::SetDimensionMem(ndsize_t index)
+    : DimensionMem(index), state(make_shared<State>())
+{
+}
+
+
+shared_ptr<base::IDimension> SetDimensionMem::handle() const {
+    return make_shared<SetDimensionMem>(*this);
+}
+
+
+DimensionType SetDimensionMem::dimensionType() const {
+    return DimensionType::Set;
+}
+
+
+vector<string> SetDimensionMem::labels() const {
+    return state->labels;
+}
+
+
+void SetDimensionMem::labels(const vector<string> &labels) {
+    state->labels = labels;
+    state->descriptor.reset();
+}
+
+
+void SetDimensionMem::labels(const none_t t) {
+    state->labels.clear();
+    state->descriptor.reset();
+}
+
+
+ndsize_t SetDimensionMem::labelCount() const {
+    return state->labels.size();
+}
+
+
+vector<ndsize_t> SetDimensionMem::indicesOf(const vector<string> &labels) const {
+    if (!state->descriptor) {
+        state->descriptor = make_shared<const DimensionDescriptor>(*this);
+    }
+    return state->descriptor->indicesOf(labels);
+}
+
+
+SetDimensionMem::~SetDimensionMem() {}
+
+//--------------------------------------------------------------
+// Implementation of RangeDimensionMem
+//--------------------------------------------------------------
+
+RangeDimensionMem::RangeDimensionMem(ndsize_t index, const vector<double> &ticks)
+    : DimensionMem(index), state(make_shared<State>()), is_alias(false)
+{
+    state->ticks = ticks;
+}
+
+
+RangeDimensionMem::RangeDimensionMem(ndsize_t index, const shared_ptr<DataArrayMem> &array)
+    : DimensionMem(index), state(make_shared<State>()), alias_array(array), is_alias(true)
+{
+}
+
+
+shared_ptr<base::IDimension> RangeDimensionMem::handle() const {
+    return make_shared<RangeDimensionMem>(*this);
+}
+
+
+DimensionType RangeDimensionMem::dimensionType() const {
+    return DimensionType::Range;
+}
+
+
+bool RangeDimensionMem::alias() const {
+    return is_alias;
+}
+
+
+shared_ptr<DataArrayMem> RangeDimensionMem::array() const {
+    shared_ptr<DataArrayMem> da = alias_array.lock();
+    if (!da) {
+        throw runtime_error("RangeDimensionMem: the DataArray of this alias dimension does not exist anymore!");
+    }
+    return da;
+}
+
+
+boost::optional<string> RangeDimensionMem::label() const {
+    return is_alias ? array()->label() : state->label;
+}
+
+
+void RangeDimensionMem::label(const string &label) {
+    if (is_alias) {
+        array()->label(label);
+    } else {
+        state->label = label;
+    }
+}
+
+
+void RangeDimensionMem::label(const none_t t) {
+    if (is_alias) {
+        array()->label(t);
+    } else {
+        state->label = boost::none;
+    }
+}
+
+
+boost::optional<string> RangeDimensionMem::unit() const {
+    return is_alias ? array()->unit() : state->unit;
+}
+
+
+void RangeDimensionMem::unit(const string &unit) {
+    if (is_alias) {
+        array()->unit(unit);
+    } else {
+        state->unit = unit;
+    }
+}
+
+
+void RangeDimensionMem::unit(const none_t t) {
+    if (is_alias) {
+        array()->unit(t);
+    } else {
+        state->unit = boost::none;
+    }
+}
+
+
+vector<double> RangeDimensionMem::ticks() const {
+    if (!is_alias) {
+        return state->ticks;
+    }
+
+    shared_ptr<DataArrayMem> da = array();
+    if (!da->hasData()) {
+        throw MissingAttr("ticks");
+    }
+    NDSize extent = da->dataExtent();
+    vector<double> ticks(extent.nelms());
+    da->read(DataType::Double, ticks.data(), extent, NDSize(extent.size(), 0));
+    return ticks;
+}
+
+
+void RangeDimensionMem::ticks(const vector<double> &ticks) {
+    if (!is_alias) {
+        state->ticks = ticks;
+        return;
+    }
+
+    shared_ptr<DataArrayMem> da = array();
+    if (!da->hasData()) {
+        throw MissingAttr("ticks");
+    }
+    NDSize extent(1, ticks.size());
+    da->dataExtent(extent);
+    da->write(DataType::Double, ticks.data(), extent, NDSize(1, 0));
+}
+
+
+RangeDimensionMem::~RangeDimensionMem() {}
+
+} // ns nix::mem
+} // ns nix
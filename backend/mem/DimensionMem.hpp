@@ -0,0 +1,216 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_DIMENSION_MEM_H
+#define NIX_DIMENSION_MEM_H
+
+#include <nix/base/IDimensions.hpp>
+#include <nix/DimensionDescriptor.hpp>
+
+#include <string>
+#include <vector>
+#include <memory>
+
+namespace nix {
+namespace mem {
+
+class DataArrayMem;
+
+
+class DimensionMem : virtual public base::IDimension {
+
+protected:
+
+    ndsize_t dim_index;
+
+public:
+
+    DimensionMem(ndsize_t index);
+
+    /**
+     * @brief A new handle that shares the state of this dimension.
+     */
+    virtual std::shared_ptr<base::IDimension> handle() const = 0;
+
+
+    ndsize_t index() const { return dim_index; }
+
+
+    virtual ~DimensionMem();
+};
+
+
+class SampledDimensionMem : virtual public base::ISampledDimension, public DimensionMem {
+
+private:
+
+    struct State {
+        boost::optional<std::string> label, unit;
+        double sampling_interval;
+        boost::optional<double> offset;
+    };
+
+    std::shared_ptr<State> state;
+
+public:
+
+    SampledDimensionMem(ndsize_t index, double sampling_interval);
+
+
+    DimensionType dimensionType() const;
+
+
+    std::shared_ptr<base::IDimension> handle() const;
+
+
+    boost::optional<std::string> label() const;
+
+
+    void label(const std::string &label);
+
+
+    void label(const none_t t);
+
+
+    boost::optional<std::string> unit() const;
+
+
+    void unit(const std::string &unit);
+
+
+    void unit(const none_t t);
+
+
+    double samplingInterval() const;
+
+
+    void samplingInterval(double sampling_interval);
+
+
+    boost::optional<double> offset() const;
+
+
+    void offset(double offset);
+
+
+    void offset(const none_t t);
+
+
+    virtual ~SampledDimensionMem();
+};
+
+
+class SetDimensionMem : virtual public base::ISetDimension, public DimensionMem {
+
+private:
+
+    struct State {
+        std::vector<std::string> labels;
+        // hashed labels, dropped whenever the labels change
+        std::shared_ptr<const DimensionDescriptor> descriptor;
+    };
+
+    std::shared_ptr<State> state;
+
+public:
+
+    SetDimensionMem(ndsize_t index);
+
+
+    DimensionType dimensionType() const;
+
+
+    std::shared_ptr<base::IDimension> handle() const;
+
+
+    std::vector<std::string> labels() const;
+
+
+    void labels(const std::vector<std::string> &labels);
+
+
+    void labels(const none_t t);
+
+
+    ndsize_t labelCount() const;
+
+
+    std::vector<ndsize_t> indicesOf(const std::vector<std::string> &labels) const;
+
+
+    virtual ~SetDimensionMem();
+};
+
+
+class RangeDimensionMem : virtual public base::IRangeDimension, public DimensionMem {
+
+private:
+
+    struct State {
+        boost::optional<std::string> label, unit;
+        std::vector<double> ticks;
+    };
+
+    std::shared_ptr<State> state;
+    // the array whose data are the ticks of an alias dimension
+    std::weak_ptr<DataArrayMem> alias_array;
+    bool is_alias;
+
+public:
+
+    RangeDimensionMem(ndsize_t index, const std::vector<double> &ticks);
+
+
+    RangeDimensionMem(ndsize_t index, const std::shared_ptr<DataArrayMem> &array);
+
+
+    DimensionType dimensionType() const;
+
+
+    std::shared_ptr<base::IDimension> handle() const;
+
+
+    bool alias() const;
+
+
+    boost::optional<std::string> label() const;
+
+
+    void label(const std::string &label);
+
+
+    void label(const none_t t);
+
+
+    boost::optional<std::string> unit() const;
+
+
+    void unit(const std::string &unit);
+
+
+    void unit(const none_t t);
+
+
+    std::vector<double> ticks() const;
+
+
+    void ticks(const std::vector<double> &ticks);
+
+
+    virtual ~RangeDimensionMem();
+
+private:
+
+    std::shared_ptr<DataArrayMem> array() const;
+};
+
+
+} // namespace mem
+} // namespace nix
+
+#endif // NIX_DIMENSION_MEM_H
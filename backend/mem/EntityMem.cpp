@@ -0,0 +1,108 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "EntityMem.hpp"
+#include "FileMem.hpp"
+
+#include <nix/util/util.hpp>
+
+#include <atomic>
+
+using namespace std;
+
+namespace nix {
+namespace mem {
+
+static atomic<uint64_t> deletion_epoch(0);
+
+
+uint64_t deletionEpoch() {
+    return deletion_epoch.load();
+}
+
+
+EntityMem::EntityMem(const shared_ptr<FileMem> &file, const string &id, time_t time)
+    : entity_file(file), entity_id(id), created_at(time), updated_at(util::getTime()), deleted(false)
+{
+}
+
+
+string EntityMem::id() const {
+    return entity_id;
+}
+
+
+time_t EntityMem::updatedAt() const {
+    return updated_at;
+}
+
+
+time_t EntityMem::createdAt() const {
+    return created_at;
+}
+
+
+void EntityMem::setUpdatedAt() {
+    // always set on construction
+}
+
+
+void EntityMem::forceUpdatedAt() {
+    updated_at = util::getTime();
+}
+
+
+void EntityMem::setCreatedAt() {
+    // always set on construction
+}
+
+
+void EntityMem::forceCreatedAt(time_t t) {
+    created_at = t;
+}
+
+
+bool EntityMem::isValidEntity() const {
+    return !deleted;
+}
+
+
+void EntityMem::markDeleted() {
+    deleted = true;
+    deletion_epoch++;
+}
+
+
+bool EntityMem::operator==(const EntityMem &other) const {
+    return entity_id == other.entity_id;
+}
+
+
+bool EntityMem::operator!=(const EntityMem &other) const {
+    return !(*this == other);
+}
+
+
+shared_ptr<base::IFile> EntityMem::file() const {
+    return fileMem();
+}
+
+
+shared_ptr<FileMem> EntityMem::fileMem() const {
+    shared_ptr<FileMem> file = entity_file.lock();
+    if (!file) {
+        throw runtime_error("EntityMem::file: the file of this entity does not exist anymore!");
+    }
+    return file;
+}
+
+
+EntityMem::~EntityMem() {}
+
+} // ns nix::mem
+} // ns nix
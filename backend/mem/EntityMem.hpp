@@ -0,0 +1,103 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_ENTITY_MEM_H
+#define NIX_ENTITY_MEM_H
+
+#include <nix/base/IFile.hpp>
+#include <nix/base/IEntity.hpp>
+
+#include <cstdint>
+#include <string>
+#include <memory>
+
+namespace nix {
+namespace mem {
+
+class FileMem;
+
+/**
+ * @brief Counter that is incremented every time an entity is deleted.
+ *
+ * Reference lists use it to notice that some of their targets may
+ * have been removed.
+ */
+uint64_t deletionEpoch();
+
+
+/**
+ * In-memory implementation of IEntity
+ */
+class EntityMem : virtual public base::IEntity {
+
+private:
+
+    std::weak_ptr<FileMem> entity_file;
+    std::string entity_id;
+    time_t created_at, updated_at;
+    bool deleted;
+
+public:
+
+    EntityMem(const std::shared_ptr<FileMem> &file, const std::string &id, time_t time);
+
+
+    std::string id() const;
+
+
+    time_t updatedAt() const;
+
+
+    time_t createdAt() const;
+
+
+    void setUpdatedAt();
+
+
+    void forceUpdatedAt();
+
+
+    void setCreatedAt();
+
+
+    void forceCreatedAt(time_t t);
+
+
+    bool isValidEntity() const;
+
+    /**
+     * @brief Mark the entity and everything it owns as deleted.
+     *
+     * Deleted entities are no longer returned by references that
+     * still point to them.
+     */
+    virtual void markDeleted();
+
+
+    bool operator==(const EntityMem &other) const;
+
+
+    bool operator!=(const EntityMem &other) const;
+
+
+    virtual ~EntityMem();
+
+protected:
+
+    std::shared_ptr<base::IFile> file() const;
+
+
+    std::shared_ptr<FileMem> fileMem() const;
+
+};
+
+
+} // namespace mem
+} // namespace nix
+
+#endif // NIX_ENTITY_MEM_H
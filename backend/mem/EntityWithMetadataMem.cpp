@@ -0,0 +1,53 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "EntityWithMetadataMem.hpp"
+#include "Containers.hpp"
+#include "FileMem.hpp"
+#include "SectionMem.hpp"
+
+using namespace std;
+
+namespace nix {
+namespace mem {
+
+
+EntityWithMetadataMem::EntityWithMetadataMem(const shared_ptr<FileMem> &file, const string &id, const string &type,
+                                             const string &name, time_t time)
+    : NamedEntityMem(file, id, type, name, time)
+{
+}
+
+
+void EntityWithMetadataMem::metadata(const string &id) {
+    if (id.empty())
+        throw EmptyString("metadata");
+
+    shared_ptr<SectionMem> section = fileMem()->findSection(id);
+    if (!section)
+        throw runtime_error("EntityWithMetadataMem::metadata: Section not found in file!");
+
+    metadata_ref = section;
+}
+
+
+shared_ptr<base::ISection> EntityWithMetadataMem::metadata() const {
+    return lockValid(metadata_ref);
+}
+
+
+void EntityWithMetadataMem::metadata(const none_t t) {
+    metadata_ref.reset();
+    forceUpdatedAt();
+}
+
+
+EntityWithMetadataMem::~EntityWithMetadataMem() {}
+
+} // ns nix::mem
+} // ns nix
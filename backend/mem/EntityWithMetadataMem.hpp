@@ -0,0 +1,55 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_ENTITY_WITH_METADATA_MEM_H
+#define NIX_ENTITY_WITH_METADATA_MEM_H
+
+#include <nix/base/IEntityWithMetadata.hpp>
+#include "NamedEntityMem.hpp"
+
+#include <string>
+#include <memory>
+
+namespace nix {
+namespace mem {
+
+class SectionMem;
+
+/**
+ * In-memory implementation of IEntityWithMetadata
+ */
+class EntityWithMetadataMem : virtual public base::IEntityWithMetadata, public NamedEntityMem {
+
+private:
+
+    std::weak_ptr<SectionMem> metadata_ref;
+
+public:
+
+    EntityWithMetadataMem(const std::shared_ptr<FileMem> &file, const std::string &id, const std::string &type,
+                          const std::string &name, time_t time);
+
+
+    void metadata(const std::string &id);
+
+
+    std::shared_ptr<base::ISection> metadata() const;
+
+
+    void metadata(const none_t t);
+
+
+    virtual ~EntityWithMetadataMem();
+
+};
+
+
+} // namespace mem
+} // namespace nix
+
+#endif // NIX_ENTITY_WITH_METADATA_MEM_H
@@ -0,0 +1,112 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "EntityWithSourcesMem.hpp"
+#include "BlockMem.hpp"
+#include "SourceMem.hpp"
+
+#include <nix/Source.hpp>
+
+#include <unordered_set>
+
+using namespace std;
+
+namespace nix {
+namespace mem {
+
+
+EntityWithSourcesMem::EntityWithSourcesMem(const shared_ptr<FileMem> &file, const shared_ptr<BlockMem> &block,
+                                           const string &id, const string &type, const string &name, time_t time)
+    : EntityWithMetadataMem(file, id, type, name, time), entity_block(block)
+{
+}
+
+
+ndsize_t EntityWithSourcesMem::sourceCount() const {
+    return source_refs.size();
+}
+
+
+bool EntityWithSourcesMem::hasSource(const string &id) const {
+    return source_refs.has(id);
+}
+
+
+shared_ptr<base::ISource> EntityWithSourcesMem::getSource(const string &name_or_id) const {
+    shared_ptr<SourceMem> source = source_refs.get(name_or_id);
+    if (!source) {
+        for (const auto &s : source_refs.all()) {
+            if (s->name() == name_or_id) {
+                return s;
+            }
+        }
+    }
+    return source;
+}
+
+
+shared_ptr<base::ISource> EntityWithSourcesMem::getSource(const size_t index) const {
+    return source_refs.at(index);
+}
+
+
+void EntityWithSourcesMem::sources(const vector<Source> &sources) {
+    shared_ptr<BlockMem> b = block();
+
+    // check if all new sources exist before changing anything
+    vector<shared_ptr<SourceMem>> targets;
+    unordered_set<string> ids_new;
+    for (const auto &s : sources) {
+        shared_ptr<SourceMem> target = b->findSource(s.id());
+        if (!target)
+            throw runtime_error("One or more sources do not exist in this block!");
+        targets.push_back(target);
+        ids_new.insert(s.id());
+    }
+
+    for (const auto &old : source_refs.all()) {
+        if (ids_new.count(old->id()) == 0) {
+            source_refs.remove(old->id());
+        }
+    }
+    for (const auto &target : targets) {
+        source_refs.add(target);
+    }
+}
+
+
+void EntityWithSourcesMem::addSource(const string &id) {
+    if (id.empty())
+        throw EmptyString("addSource");
+
+    shared_ptr<SourceMem> target = block()->findSource(id);
+    if (!target)
+        throw runtime_error("EntityWithSourcesMem::addSource: Given source does not exist in this block!");
+
+    source_refs.add(target);
+}
+
+
+bool EntityWithSourcesMem::removeSource(const string &id) {
+    return source_refs.remove(id);
+}
+
+
+shared_ptr<BlockMem> EntityWithSourcesMem::block() const {
+    shared_ptr<BlockMem> b = entity_block.lock();
+    if (!b) {
+        throw runtime_error("EntityWithSourcesMem::block: the block of this entity does not exist anymore!");
+    }
+    return b;
+}
+
+
+EntityWithSourcesMem::~EntityWithSourcesMem() {}
+
+} // ns nix::mem
+} // ns nix
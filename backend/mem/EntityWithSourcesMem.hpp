@@ -0,0 +1,75 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_ENTITY_WITH_SOURCES_MEM_H
+#define NIX_ENTITY_WITH_SOURCES_MEM_H
+
+#include <nix/base/IEntityWithSources.hpp>
+#include "EntityWithMetadataMem.hpp"
+#include "Containers.hpp"
+
+#include <string>
+#include <vector>
+#include <memory>
+
+namespace nix {
+namespace mem {
+
+class BlockMem;
+class SourceMem;
+
+/**
+ * In-memory implementation of IEntityWithSources
+ */
+class EntityWithSourcesMem : virtual public base::IEntityWithSources, public EntityWithMetadataMem {
+
+private:
+
+    std::weak_ptr<BlockMem> entity_block;
+    RefList<SourceMem> source_refs;
+
+public:
+
+    EntityWithSourcesMem(const std::shared_ptr<FileMem> &file, const std::shared_ptr<BlockMem> &block,
+                         const std::string &id, const std::string &type, const std::string &name, time_t time);
+
+
+    ndsize_t sourceCount() const;
+
+
+    bool hasSource(const std::string &id) const;
+
+
+    std::shared_ptr<base::ISource> getSource(const std::string &name_or_id) const;
+
+
+    std::shared_ptr<base::ISource> getSource(const size_t index) const;
+
+
+    void sources(const std::vector<Source> &sources);
+
+
+    void addSource(const std::string &id);
+
+
+    bool removeSource(const std::string &id);
+
+
+    virtual ~EntityWithSourcesMem();
+
+protected:
+
+    std::shared_ptr<BlockMem> block() const;
+
+};
+
+
+} // namespace mem
+} // namespace nix
+
+#endif // NIX_ENTITY_WITH_SOURCES_MEM_H
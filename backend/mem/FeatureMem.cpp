@@ -0,0 +1,62 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "FeatureMem.hpp"
+#include "BlockMem.hpp"
+#include "DataArrayMem.hpp"
+
+using namespace std;
+
+namespace nix {
+namespace mem {
+
+
+FeatureMem::FeatureMem(const shared_ptr<FileMem> &file, const shared_ptr<BlockMem> &block,
+                       const string &id, const string &data, LinkType link_type, time_t time)
+    : EntityMem(file, id, time), block(block)
+{
+    linkType(link_type);
+    this->data(data);
+}
+
+
+void FeatureMem::linkType(LinkType link_type) {
+    if (link_type != LinkType::Tagged && link_type != LinkType::Untagged && link_type != LinkType::Indexed) {
+        throw runtime_error("FeatureMem::linkType: invalid link type");
+    }
+    this->link_type = link_type;
+    forceUpdatedAt();
+}
+
+
+LinkType FeatureMem::linkType() const {
+    return link_type;
+}
+
+
+void FeatureMem::data(const string &name_or_id) {
+    shared_ptr<BlockMem> b = block.lock();
+    shared_ptr<DataArrayMem> target = b ? b->findDataArray(name_or_id) : nullptr;
+    if (!target) {
+        throw runtime_error("FeatureMem::data: DataArray not found in block!");
+    }
+    data_ref = target;
+    forceUpdatedAt();
+}
+
+
+shared_ptr<base::IDataArray> FeatureMem::data() const {
+    // the link is gone once the data array was deleted
+    return lockValid(data_ref);
+}
+
+
+FeatureMem::~FeatureMem() {}
+
+} // ns nix::mem
+} // ns nix
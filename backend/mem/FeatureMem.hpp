@@ -0,0 +1,61 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_FEATURE_MEM_H
+#define NIX_FEATURE_MEM_H
+
+#include <nix/base/IFeature.hpp>
+#include "EntityMem.hpp"
+
+#include <string>
+#include <memory>
+
+namespace nix {
+namespace mem {
+
+class BlockMem;
+class DataArrayMem;
+
+/**
+ * Class that represents a NIX feature entity that is kept in memory.
+ */
+class FeatureMem : virtual public base::IFeature, public EntityMem {
+
+private:
+
+    std::weak_ptr<BlockMem> block;
+    std::weak_ptr<DataArrayMem> data_ref;
+    LinkType link_type;
+
+public:
+
+    FeatureMem(const std::shared_ptr<FileMem> &file, const std::shared_ptr<BlockMem> &block,
+               const std::string &id, const std::string &data, LinkType link_type, time_t time);
+
+
+    void linkType(LinkType type);
+
+
+    LinkType linkType() const;
+
+
+    void data(const std::string &name_or_id);
+
+
+    std::shared_ptr<base::IDataArray> data() const;
+
+
+    virtual ~FeatureMem();
+
+};
+
+
+} // namespace mem
+} // namespace nix
+
+#endif // NIX_FEATURE_MEM_H
@@ -0,0 +1,441 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "FileMem.hpp"
+#include "BlockMem.hpp"
+#include "SectionMem.hpp"
+#include "PropertyMem.hpp"
+
+#include "hdf5/FileHDF5.hpp"
+#include "hdf5/EntityCopyHDF5.hpp"
+
+#include <nix/DataArray.hpp>
+#include <nix/util/util.hpp>
+
+using namespace std;
+
+namespace nix {
+namespace mem {
+
+
+FileMem::FileMem(const string &name, FileMode mode)
+    : name(name), mode(mode), is_open(true)
+{
+    if (mode != FileMode::ReadWrite && mode != FileMode::Overwrite) {
+        throw invalid_argument("FileMem: in-memory files can only be opened in ReadWrite or Overwrite mode!");
+    }
+    created_at = updated_at = util::getTime();
+}
+
+
+bool FileMem::flush() {
+    return true;
+}
+
+
+ndsize_t FileMem::blockCount() const {
+    return blocks.size();
+}
+
+
+bool FileMem::hasBlock(const string &name_or_id) const {
+    return blocks.has(name_or_id);
+}
+
+
+shared_ptr<base::IBlock> FileMem::getBlock(const string &name_or_id) const {
+    return blocks.get(name_or_id);
+}
+
+
+shared_ptr<base::IBlock> FileMem::getBlock(ndsize_t index) const {
+    return blocks.at(index, "file.block");
+}
+
+
+shared_ptr<base::IBlock> FileMem::createBlock(const string &name, const string &type) {
+    if (name.empty()) {
+        throw EmptyString("Trying to create Block with empty name!");
+    }
+    if (hasBlock(name)) {
+        throw DuplicateName("Block with the given name already exists!");
+    }
+
+    auto block = make_shared<BlockMem>(shared_from_this(), util::createId(), type, name, util::getTime());
+    blocks.add(name, block);
+    return block;
+}
+
+
+bool FileMem::deleteBlock(const string &name_or_id) {
+    shared_ptr<BlockMem> block = blocks.remove(name_or_id);
+    if (block) {
+        block->markDeleted();
+    }
+    return block != nullptr;
+}
+
+//--------------------------------------------------
+// Methods concerning sections
+//--------------------------------------------------
+
+bool FileMem::hasSection(const string &name_or_id) const {
+    return sections.has(name_or_id);
+}
+
+
+shared_ptr<base::ISection> FileMem::getSection(const string &name_or_id) const {
+    return sections.get(name_or_id);
+}
+
+
+shared_ptr<base::ISection> FileMem::getSection(ndsize_t index) const {
+    return sections.at(index, "file.section");
+}
+
+
+ndsize_t FileMem::sectionCount() const {
+    return sections.size();
+}
+
+
+shared_ptr<base::ISection> FileMem::createSection(const string &name, const string &type) {
+    if (name.empty()) {
+        throw EmptyString("Trying to create a Section with an empty name!");
+    }
+    if (hasSection(name)) {
+        throw DuplicateName("Section with the specified name altready exists!");
+    }
+
+    auto section = make_shared<SectionMem>(shared_from_this(), nullptr, util::createId(), type, name,
+                                           util::getTime());
+    sections.add(name, section);
+    indexSection(section);
+    return section;
+}
+
+
+bool FileMem::deleteSection(const string &name_or_id) {
+    shared_ptr<SectionMem> section = sections.remove(name_or_id);
+    if (section) {
+        section->markDeleted();
+    }
+    return section != nullptr;
+}
+
+
+shared_ptr<SectionMem> FileMem::findSection(const string &id) const {
+    auto it = section_index.find(id);
+    return it == section_index.end() ? shared_ptr<SectionMem>() : lockValid(it->second);
+}
+
+
+void FileMem::indexSection(const shared_ptr<SectionMem> &section) {
+    // entries of deleted sections are replaced or ignored by findSection
+    section_index[section->id()] = section;
+}
+
+//--------------------------------------------------
+// Metadata snapshots
+//--------------------------------------------------
+
+static void snapshot_sections(const shared_ptr<base::ISection> &section, size_t parent,
+                              MetadataSnapshot &snapshot) {
+    size_t index = snapshot.addSection(section->name(), section->type(), parent, section->id());
+
+    MetadataSnapshot::SectionNode &node = snapshot.section(index);
+    node.definition = section->definition();
+    node.repository = section->repository();
+    node.mapping = section->mapping();
+    node.created_at = section->createdAt();
+    node.updated_at = section->updatedAt();
+
+    shared_ptr<base::ISection> link = section->link();
+    if (link) {
+        node.link = link->id();
+    }
+
+    for (ndsize_t i = 0; i < section->propertyCount(); i++) {
+        shared_ptr<base::IProperty> prop = section->getProperty(i);
+        vector<Value> values = prop->values();
+        size_t pi = values.empty() ?
+                    snapshot.addProperty(index, prop->name(), prop->dataType(), prop->id()) :
+                    snapshot.addProperty(index, prop->name(), values, prop->id());
+
+        MetadataSnapshot::PropertyNode &pnode = snapshot.property(pi);
+        pnode.definition = prop->definition();
+        pnode.unit = prop->unit();
+        pnode.mapping = prop->mapping();
+        pnode.created_at = prop->createdAt();
+        pnode.updated_at = prop->updatedAt();
+    }
+
+    for (ndsize_t i = 0; i < section->sectionCount(); i++) {
+        snapshot_sections(section->getSection(i), index, snapshot);
+    }
+}
+
+
+MetadataSnapshot FileMem::loadMetadataSnapshot() const {
+    MetadataSnapshot snapshot;
+    for (ndsize_t i = 0; i < sectionCount(); i++) {
+        snapshot_sections(getSection(i), MetadataSnapshot::npos, snapshot);
+    }
+    return snapshot;
+}
+
+
+static void store_section(const MetadataSnapshot &snapshot, size_t index, const shared_ptr<SectionMem> &section,
+                          vector<shared_ptr<SectionMem>> &sections) {
+    sections[index] = section;
+
+    const MetadataSnapshot::SectionNode &node = snapshot.section(index);
+    if (node.definition) section->definition(*node.definition);
+    if (node.repository) section->repository(*node.repository);
+    if (node.mapping) section->mapping(*node.mapping);
+
+    time_t now = util::getTime();
+    for (size_t p : snapshot.properties(index)) {
+        const MetadataSnapshot::PropertyNode &pnode = snapshot.property(p);
+        string pid = pnode.id.empty() ? util::createId() : pnode.id;
+        time_t created = pnode.created_at > 0 ? pnode.created_at : now;
+
+        shared_ptr<PropertyMem> prop = section->createProperty(pnode.name, pnode.data_type, pid, created);
+        if (pnode.definition) prop->definition(*pnode.definition);
+        if (pnode.unit) prop->unit(*pnode.unit);
+        if (pnode.mapping) prop->mapping(*pnode.mapping);
+
+        MetadataSnapshot::ValueRange values = snapshot.values(p);
+        if (!values.empty()) {
+            prop->values(vector<Value>(values.begin(), values.end()));
+        }
+    }
+
+    for (size_t c : snapshot.sections(index)) {
+        const MetadataSnapshot::SectionNode &child = snapshot.section(c);
+        string id = child.id.empty() ? util::createId() : child.id;
+        time_t created = child.created_at > 0 ? child.created_at : now;
+        store_section(snapshot, c, section->createSection(child.name, child.type, id, created), sections);
+    }
+}
+
+
+void FileMem::storeMetadataSnapshot(const MetadataSnapshot &snapshot) {
+    vector<shared_ptr<SectionMem>> stored(snapshot.sectionCount());
+    time_t now = util::getTime();
+
+    for (size_t root : snapshot.rootSections()) {
+        const MetadataSnapshot::SectionNode &node = snapshot.section(root);
+        string id = node.id.empty() ? util::createId() : node.id;
+        time_t created = node.created_at > 0 ? node.created_at : now;
+
+        auto section = make_shared<SectionMem>(shared_from_this(), nullptr, id, node.type, node.name, created);
+        sections.add(node.name, section);
+        indexSection(section);
+        store_section(snapshot, root, section, stored);
+    }
+
+    // all sections are indexed now, links within the snapshot can be resolved by id
+    for (size_t i = 0; i < snapshot.sectionCount(); i++) {
+        const boost::optional<string> &link = snapshot.section(i).link;
+        if (link) {
+            stored[i]->link(*link);
+        }
+    }
+}
+
+//--------------------------------------------------
+// Storage report
+//--------------------------------------------------
+
+static ndsize_t count_sources(const shared_ptr<base::ISource> &source) {
+    ndsize_t count = 1;
+    for (ndsize_t i = 0; i < source->sourceCount(); i++) {
+        count += count_sources(source->getSource(i));
+    }
+    return count;
+}
+
+
+StorageReport FileMem::storageReport() const {
+    StorageReport report;
+    report.format = format();
+    report.location = location();
+    report.addGroup("/data", static_cast<size_t>(blockCount()));
+    report.addGroup("/metadata", static_cast<size_t>(sectionCount()));
+
+    for (ndsize_t b = 0; b < blockCount(); b++) {
+        shared_ptr<base::IBlock> block = getBlock(b);
+        StorageReport::Block stats;
+        stats.name = block->name();
+        const string path = "/data/" + stats.name;
+
+        for (ndsize_t i = 0; i < block->dataArrayCount(); i++) {
+            shared_ptr<base::IDataArray> da = block->getDataArray(i);
+            StorageReport::Array array;
+            array.block = stats.name;
+            array.name = da->name();
+            array.path = path + "/data_arrays/" + array.name;
+            array.data_type = da->dataType();
+            array.extent = da->dataExtent();
+            array.chunks = da->chunkExtent();
+            if (array.data_type != DataType::Nothing) {
+                array.logical_bytes = array.extent.nelms() * data_type_to_size(array.data_type);
+            }
+            // the values are stored as they are
+            array.allocated_bytes = array.storage_bytes = array.logical_bytes;
+            stats.dimensions += static_cast<size_t>(da->dimensionCount());
+            report.arrays.push_back(move(array));
+        }
+
+        for (ndsize_t i = 0; i < block->tagCount(); i++) {
+            stats.features += static_cast<size_t>(block->getTag(i)->featureCount());
+        }
+        for (ndsize_t i = 0; i < block->multiTagCount(); i++) {
+            stats.features += static_cast<size_t>(block->getMultiTag(i)->featureCount());
+        }
+        for (ndsize_t i = 0; i < block->sourceCount(); i++) {
+            stats.sources += static_cast<size_t>(count_sources(block->getSource(i)));
+        }
+
+        stats.data_arrays = static_cast<size_t>(block->dataArrayCount());
+        stats.tags = static_cast<size_t>(block->tagCount());
+        stats.multi_tags = static_cast<size_t>(block->multiTagCount());
+        stats.groups = static_cast<size_t>(block->groupCount());
+        stats.objects = stats.data_arrays + stats.dimensions + stats.tags + stats.multi_tags +
+                        stats.features + stats.sources + stats.groups;
+
+        report.addGroup(path + "/data_arrays", stats.data_arrays);
+        report.addGroup(path + "/tags", stats.tags);
+        report.addGroup(path + "/multi_tags", stats.multi_tags);
+        report.addGroup(path + "/sources", static_cast<size_t>(block->sourceCount()));
+        report.addGroup(path + "/groups", stats.groups);
+        report.objects += stats.objects + 1;
+        report.blocks.push_back(move(stats));
+    }
+
+    MetadataSnapshot snapshot = loadMetadataSnapshot();
+    report.sections = snapshot.sectionCount();
+    report.properties = snapshot.propertyCount();
+    report.objects += report.sections + report.properties;
+    return report;
+}
+
+//--------------------------------------------------
+// Methods for file attribute access.
+//--------------------------------------------------
+
+vector<int> FileMem::version() const {
+    return FILE_VERSION;
+}
+
+
+string FileMem::format() const {
+    return FILE_FORMAT;
+}
+
+
+string FileMem::location() const {
+    return name;
+}
+
+
+time_t FileMem::createdAt() const {
+    return created_at;
+}
+
+
+time_t FileMem::updatedAt() const {
+    return updated_at;
+}
+
+
+void FileMem::setUpdatedAt() {
+    // always set on construction
+}
+
+
+void FileMem::forceUpdatedAt() {
+    updated_at = util::getTime();
+}
+
+
+void FileMem::setCreatedAt() {
+    // always set on construction
+}
+
+
+void FileMem::forceCreatedAt(time_t t) {
+    created_at = t;
+}
+
+
+void FileMem::close() {
+    if (!is_open) {
+        return;
+    }
+
+    for (const auto &block : blocks.all()) {
+        block->markDeleted();
+    }
+    for (const auto &section : sections.all()) {
+        section->markDeleted();
+    }
+    blocks.clear();
+    sections.clear();
+    section_index.clear();
+    is_open = false;
+}
+
+
+bool FileMem::isOpen() const {
+    return is_open;
+}
+
+
+FileMode FileMem::fileMode() const {
+    return mode;
+}
+
+
+void FileMem::startSWMRWrite() {
+    throw logic_error("FileMem::startSWMRWrite: SWMR is not supported by the in-memory backend!");
+}
+
+
+void FileMem::flushInterval(double seconds) {
+    // there is nothing to flush
+}
+
+
+double FileMem::flushInterval() const {
+    return 0.0;
+}
+
+//--------------------------------------------------
+// Writing HDF5 files
+//--------------------------------------------------
+
+void FileMem::saveAs(const string &location) const {
+    auto out = make_shared<hdf5::FileHDF5>(location, FileMode::Overwrite);
+    out->storeMetadataSnapshot(loadMetadataSnapshot());
+
+    for (const auto &block : blocks.all()) {
+        hdf5::copyBlock(out, block);
+    }
+
+    out->close();
+}
+
+
+FileMem::~FileMem() {
+    close();
+}
+
+} // ns nix::mem
+} // ns nix
@@ -0,0 +1,187 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_FILE_MEM_H
+#define NIX_FILE_MEM_H
+
+#include <nix/base/IFile.hpp>
+#include "Containers.hpp"
+
+#include <string>
+#include <memory>
+#include <unordered_map>
+
+namespace nix {
+namespace mem {
+
+class BlockMem;
+class SectionMem;
+
+/**
+ * Class that represents a NIX file that only exists in memory.
+ *
+ * All entities are owned by the file and released when it is closed.
+ * The contents can be written to a HDF5 file with {@link saveAs}.
+ */
+class FileMem : public base::IFile, public std::enable_shared_from_this<FileMem> {
+
+private:
+
+    std::string name;
+    FileMode mode;
+    time_t created_at, updated_at;
+    bool is_open;
+
+    EntityList<BlockMem> blocks;
+    EntityList<SectionMem> sections;
+    std::unordered_map<std::string, std::weak_ptr<SectionMem>> section_index;
+
+public:
+
+    /**
+     * Constructor that creates a new, empty file.
+     *
+     * @param name    The name of the file, returned as its location.
+     * @param mode    The file mode, ReadWrite or Overwrite.
+     */
+    FileMem(const std::string &name, const FileMode mode = FileMode::ReadWrite);
+
+    //--------------------------------------------------
+    // Methods concerning blocks
+    //--------------------------------------------------
+
+    bool flush();
+
+
+    ndsize_t blockCount() const;
+
+
+    bool hasBlock(const std::string &name_or_id) const;
+
+
+    std::shared_ptr<base::IBlock> getBlock(const std::string &name_or_id) const;
+
+
+    std::shared_ptr<base::IBlock> getBlock(ndsize_t index) const;
+
+
+    std::shared_ptr<base::IBlock> createBlock(const std::string &name, const std::string &type);
+
+
+    bool deleteBlock(const std::string &name_or_id);
+
+    //--------------------------------------------------
+    // Methods concerning sections
+    //--------------------------------------------------
+
+    bool hasSection(const std::string &name_or_id) const;
+
+
+    std::shared_ptr<base::ISection> getSection(const std::string &name_or_id) const;
+
+
+    std::shared_ptr<base::ISection> getSection(ndsize_t index) const;
+
+
+    ndsize_t sectionCount() const;
+
+
+    std::shared_ptr<base::ISection> createSection(const std::string &name, const std::string &type);
+
+
+    bool deleteSection(const std::string &name_or_id);
+
+
+    MetadataSnapshot loadMetadataSnapshot() const;
+
+
+    void storeMetadataSnapshot(const MetadataSnapshot &snapshot);
+
+
+    StorageReport storageReport() const;
+
+    /**
+     * @brief Find a section anywhere in the file by its id.
+     *
+     * @return The section or null if there is none.
+     */
+    std::shared_ptr<SectionMem> findSection(const std::string &id) const;
+
+    /**
+     * @brief Register a section so that it can be found by {@link findSection}.
+     */
+    void indexSection(const std::shared_ptr<SectionMem> &section);
+
+    //--------------------------------------------------
+    // Methods for file attribute access.
+    //--------------------------------------------------
+
+    std::vector<int> version() const;
+
+
+    std::string format() const;
+
+
+    std::string location() const;
+
+
+    time_t createdAt() const;
+
+
+    time_t updatedAt() const;
+
+
+    void setUpdatedAt();
+
+
+    void forceUpdatedAt();
+
+
+    void setCreatedAt();
+
+
+    void forceCreatedAt(time_t t);
+
+
+    void close();
+
+
+    bool isOpen() const;
+
+
+    FileMode fileMode() const;
+
+
+    void startSWMRWrite();
+
+
+    void flushInterval(double seconds);
+
+
+    double flushInterval() const;
+
+    /**
+     * @brief Write the contents of the file to a new HDF5 file.
+     *
+     * An existing file at the location is overwritten. The ids and
+     * creation times of all entities are preserved.
+     *
+     * @param location    The path of the HDF5 file.
+     */
+    void saveAs(const std::string &location) const;
+
+
+    virtual ~FileMem();
+
+};
+
+
+} // namespace mem
+} // namespace nix
+
+#endif // NIX_FILE_MEM_H
@@ -0,0 +1,209 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "GroupMem.hpp"
+#include "BlockMem.hpp"
+#include "DataArrayMem.hpp"
+#include "TagMem.hpp"
+#include "MultiTagMem.hpp"
+
+#include <nix/DataArray.hpp>
+#include <nix/Tag.hpp>
+#include <nix/MultiTag.hpp>
+
+#include <unordered_set>
+
+using namespace std;
+
+namespace nix {
+namespace mem {
+
+/*
+ * Look up a linked entity by id or, via the block, by name.
+ */
+template<typename T, typename F>
+static shared_ptr<T> find_ref(const RefList<T> &refs, const string &name_or_id, F find_in_block) {
+    shared_ptr<T> target = refs.get(name_or_id);
+    if (!target) {
+        shared_ptr<T> named = find_in_block(name_or_id);
+        if (named) {
+            target = refs.get(named->id());
+        }
+    }
+    return target;
+}
+
+/*
+ * Replace the linked entities, all new ones are checked before anything is changed.
+ */
+template<typename T, typename E, typename F>
+static void set_refs(RefList<T> &refs, const vector<E> &entities, F find_in_block, const string &what) {
+    vector<shared_ptr<T>> targets;
+    unordered_set<string> ids_new;
+    for (const E &entity : entities) {
+        shared_ptr<T> target = find_in_block(entity.id());
+        if (!target)
+            throw runtime_error("One or more " + what + " do not exist in this block!");
+        targets.push_back(target);
+        ids_new.insert(entity.id());
+    }
+
+    for (const auto &old : refs.all()) {
+        if (ids_new.count(old->id()) == 0) {
+            refs.remove(old->id());
+        }
+    }
+    for (const auto &target : targets) {
+        refs.add(target);
+    }
+}
+
+
+GroupMem::GroupMem(const shared_ptr<FileMem> &file, const shared_ptr<BlockMem> &block,
+                   const string &id, const string &type, const string &name, time_t time)
+    : EntityWithSourcesMem(file, block, id, type, name, time)
+{
+}
+
+//--------------------------------------------------
+// Methods concerning data arrays.
+//--------------------------------------------------
+
+bool GroupMem::hasDataArray(const string &name_or_id) const {
+    return getDataArray(name_or_id) != nullptr;
+}
+
+
+ndsize_t GroupMem::dataArrayCount() const {
+    return data_arrays.size();
+}
+
+
+shared_ptr<base::IDataArray> GroupMem::getDataArray(const string &name_or_id) const {
+    shared_ptr<BlockMem> b = block();
+    return find_ref(data_arrays, name_or_id, [&b](const string &n) { return b->findDataArray(n); });
+}
+
+
+shared_ptr<base::IDataArray> GroupMem::getDataArray(ndsize_t index) const {
+    return data_arrays.at(index);
+}
+
+
+void GroupMem::addDataArray(const string &name_or_id) {
+    shared_ptr<DataArrayMem> target = block()->findDataArray(name_or_id);
+    if (!target)
+        throw runtime_error("GroupMem::addDataArray: DataArray not found in block!");
+    data_arrays.add(target);
+}
+
+
+bool GroupMem::removeDataArray(const string &name_or_id) {
+    shared_ptr<base::IDataArray> da = getDataArray(name_or_id);
+    return da ? data_arrays.remove(da->id()) : false;
+}
+
+
+void GroupMem::dataArrays(const vector<DataArray> &arrays) {
+    shared_ptr<BlockMem> b = block();
+    set_refs(data_arrays, arrays, [&b](const string &id) { return b->findDataArray(id); }, "data arrays");
+}
+
+//--------------------------------------------------
+// Methods concerning tags.
+//--------------------------------------------------
+
+bool GroupMem::hasTag(const string &name_or_id) const {
+    return getTag(name_or_id) != nullptr;
+}
+
+
+ndsize_t GroupMem::tagCount() const {
+    return tags_list.size();
+}
+
+
+shared_ptr<base::ITag> GroupMem::getTag(const string &name_or_id) const {
+    shared_ptr<BlockMem> b = block();
+    return find_ref(tags_list, name_or_id, [&b](const string &n) { return b->findTag(n); });
+}
+
+
+shared_ptr<base::ITag> GroupMem::getTag(ndsize_t index) const {
+    return tags_list.at(index);
+}
+
+
+void GroupMem::addTag(const string &name_or_id) {
+    shared_ptr<TagMem> target = block()->findTag(name_or_id);
+    if (!target)
+        throw runtime_error("GroupMem::addTag: Tag not found in block!");
+    tags_list.add(target);
+}
+
+
+bool GroupMem::removeTag(const string &name_or_id) {
+    shared_ptr<base::ITag> tag = getTag(name_or_id);
+    return tag ? tags_list.remove(tag->id()) : false;
+}
+
+
+void GroupMem::tags(const vector<Tag> &tags) {
+    shared_ptr<BlockMem> b = block();
+    set_refs(tags_list, tags, [&b](const string &id) { return b->findTag(id); }, "tags");
+}
+
+//--------------------------------------------------
+// Methods concerning multi tags.
+//--------------------------------------------------
+
+bool GroupMem::hasMultiTag(const string &name_or_id) const {
+    return getMultiTag(name_or_id) != nullptr;
+}
+
+
+ndsize_t GroupMem::multiTagCount() const {
+    return multi_tags.size();
+}
+
+
+shared_ptr<base::IMultiTag> GroupMem::getMultiTag(const string &name_or_id) const {
+    shared_ptr<BlockMem> b = block();
+    return find_ref(multi_tags, name_or_id, [&b](const string &n) { return b->findMultiTag(n); });
+}
+
+
+shared_ptr<base::IMultiTag> GroupMem::getMultiTag(ndsize_t index) const {
+    return multi_tags.at(index);
+}
+
+
+void GroupMem::addMultiTag(const string &name_or_id) {
+    shared_ptr<MultiTagMem> target = block()->findMultiTag(name_or_id);
+    if (!target)
+        throw runtime_error("GroupMem::addMultiTag: MultiTag not found in block!");
+    multi_tags.add(target);
+}
+
+
+bool GroupMem::removeMultiTag(const string &name_or_id) {
+    shared_ptr<base::IMultiTag> mtag = getMultiTag(name_or_id);
+    return mtag ? multi_tags.remove(mtag->id()) : false;
+}
+
+
+void GroupMem::multiTags(const vector<MultiTag> &mtags) {
+    shared_ptr<BlockMem> b = block();
+    set_refs(multi_tags, mtags, [&b](const string &id) { return b->findMultiTag(id); }, "multi tags");
+}
+
+
+GroupMem::~GroupMem() {}
+
+} // ns nix::mem
+} // ns nix
@@ -0,0 +1,124 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_GROUP_MEM_H
+#define NIX_GROUP_MEM_H
+
+#include <nix/base/IGroup.hpp>
+#include "EntityWithSourcesMem.hpp"
+#include "Containers.hpp"
+
+#include <string>
+#include <vector>
+#include <memory>
+
+namespace nix {
+namespace mem {
+
+class DataArrayMem;
+class TagMem;
+class MultiTagMem;
+
+/**
+ * Class that represents a NIX group that is kept in memory.
+ */
+class GroupMem : virtual public base::IGroup, public EntityWithSourcesMem {
+
+private:
+
+    RefList<DataArrayMem> data_arrays;
+    RefList<TagMem> tags_list;
+    RefList<MultiTagMem> multi_tags;
+
+public:
+
+    GroupMem(const std::shared_ptr<FileMem> &file, const std::shared_ptr<BlockMem> &block,
+             const std::string &id, const std::string &type, const std::string &name, time_t time);
+
+    //--------------------------------------------------
+    // Methods concerning data arrays.
+    //--------------------------------------------------
+
+    bool hasDataArray(const std::string &name_or_id) const;
+
+
+    ndsize_t dataArrayCount() const;
+
+
+    std::shared_ptr<base::IDataArray> getDataArray(const std::string &name_or_id) const;
+
+
+    std::shared_ptr<base::IDataArray> getDataArray(ndsize_t index) const;
+
+
+    void addDataArray(const std::string &name_or_id);
+
+
+    bool removeDataArray(const std::string &name_or_id);
+
+
+    void dataArrays(const std::vector<DataArray> &data_arrays);
+
+    //--------------------------------------------------
+    // Methods concerning tags.
+    //--------------------------------------------------
+
+    bool hasTag(const std::string &name_or_id) const;
+
+
+    ndsize_t tagCount() const;
+
+
+    std::shared_ptr<base::ITag> getTag(const std::string &name_or_id) const;
+
+
+    std::shared_ptr<base::ITag> getTag(ndsize_t index) const;
+
+
+    void addTag(const std::string &name_or_id);
+
+
+    bool removeTag(const std::string &name_or_id);
+
+
+    void tags(const std::vector<Tag> &tags);
+
+    //--------------------------------------------------
+    // Methods concerning multi tags.
+    //--------------------------------------------------
+
+    bool hasMultiTag(const std::string &name_or_id) const;
+
+
+    ndsize_t multiTagCount() const;
+
+
+    std::shared_ptr<base::IMultiTag> getMultiTag(const std::string &name_or_id) const;
+
+
+    std::shared_ptr<base::IMultiTag> getMultiTag(ndsize_t index) const;
+
+
+    void addMultiTag(const std::string &name_or_id);
+
+
+    bool removeMultiTag(const std::string &name_or_id);
+
+
+    void multiTags(const std::vector<MultiTag> &multi_tags);
+
+
+    virtual ~GroupMem();
+
+};
+
+
+} // namespace mem
+} // namespace nix
+
+#endif // NIX_GROUP_MEM_H
@@ -0,0 +1,108 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "MultiTagMem.hpp"
+#include "BlockMem.hpp"
+#include "DataArrayMem.hpp"
+
+using namespace std;
+
+namespace nix {
+namespace mem {
+
+
+MultiTagMem::MultiTagMem(const shared_ptr<FileMem> &file, const shared_ptr<BlockMem> &block, const string &id,
+                         const string &type, const string &name, time_t time)
+    : BaseTagMem(file, block, id, type, name, time)
+{
+}
+
+
+shared_ptr<base::IDataArray> MultiTagMem::positions() const {
+    shared_ptr<DataArrayMem> da = lockValid(positions_ref);
+    if (!da)
+        throw runtime_error("MultiTagMem::positions: DataArray not found!");
+    return da;
+}
+
+
+void MultiTagMem::positions(const string &name_or_id) {
+    shared_ptr<DataArrayMem> target = block()->findDataArray(name_or_id);
+    if (!target)
+        throw runtime_error("MultiTagMem::positions: DataArray not found in block!");
+
+    positions_ref = target;
+    forceUpdatedAt();
+}
+
+
+bool MultiTagMem::hasPositions() const {
+    return lockValid(positions_ref) != nullptr;
+}
+
+
+shared_ptr<base::IDataArray> MultiTagMem::extents() const {
+    // the link is gone once the data array was deleted
+    return lockValid(extents_ref);
+}
+
+
+void MultiTagMem::extents(const string &name_or_id) {
+    shared_ptr<DataArrayMem> target = block()->findDataArray(name_or_id);
+    if (!target)
+        throw runtime_error("MultiTagMem::extents: DataArray not found in block!");
+    if (target->dataExtent() != positions()->dataExtent())
+        throw runtime_error("MultiTagMem::extents: cannot set Extent because dimensionality of extent and position data do not match!");
+
+    extents_ref = target;
+    forceUpdatedAt();
+}
+
+
+void MultiTagMem::extents(const none_t t) {
+    extents_ref.reset();
+    forceUpdatedAt();
+}
+
+
+vector<string> MultiTagMem::units() const {
+    return tag_units;
+}
+
+
+void MultiTagMem::units(const vector<string> &units) {
+    tag_units = units;
+    forceUpdatedAt();
+}
+
+
+void MultiTagMem::units(const none_t t) {
+    tag_units.clear();
+    forceUpdatedAt();
+}
+
+
+shared_ptr<const IntervalIndex> MultiTagMem::intervalIndex() const {
+    shared_ptr<DataArrayMem> pos = dynamic_pointer_cast<DataArrayMem>(positions());
+    shared_ptr<DataArrayMem> ext = lockValid(extents_ref);
+
+    // versions are unique among all arrays, they also tell a relinked array apart
+    const uint64_t pv = pos->dataVersion(), ev = ext ? ext->dataVersion() : 0;
+    if (!index || index_positions != pv || index_extents != ev) {
+        index = make_shared<IntervalIndex>(IntervalIndex::build(*pos, ext));
+        index_positions = pv;
+        index_extents = ev;
+    }
+    return index;
+}
+
+
+MultiTagMem::~MultiTagMem() {}
+
+} // ns nix::mem
+} // ns nix
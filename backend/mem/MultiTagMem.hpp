@@ -0,0 +1,84 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_MULTI_TAG_MEM_H
+#define NIX_MULTI_TAG_MEM_H
+
+#include <nix/base/IMultiTag.hpp>
+#include <nix/IntervalIndex.hpp>
+#include "BaseTagMem.hpp"
+
+#include <string>
+#include <vector>
+#include <memory>
+
+namespace nix {
+namespace mem {
+
+/**
+ * Class that represents a NIX multi tag that is kept in memory.
+ */
+class MultiTagMem : virtual public base::IMultiTag, public BaseTagMem {
+
+private:
+
+    std::weak_ptr<DataArrayMem> positions_ref, extents_ref;
+    std::vector<std::string> tag_units;
+
+    // the last index and the data versions of positions and extents it was built from
+    mutable std::shared_ptr<const IntervalIndex> index;
+    mutable uint64_t index_positions = 0, index_extents = 0;
+
+public:
+
+    /**
+     * Standard constructor for a new MultiTag, the positions have to be set right after.
+     */
+    MultiTagMem(const std::shared_ptr<FileMem> &file, const std::shared_ptr<BlockMem> &block, const std::string &id,
+                const std::string &type, const std::string &name, time_t time);
+
+
+    std::shared_ptr<base::IDataArray> positions() const;
+
+
+    void positions(const std::string &name_or_id);
+
+
+    bool hasPositions() const;
+
+
+    std::shared_ptr<base::IDataArray> extents() const;
+
+
+    void extents(const std::string &name_or_id);
+
+
+    void extents(const none_t t);
+
+
+    std::vector<std::string> units() const;
+
+
+    void units(const std::vector<std::string> &units);
+
+
+    void units(const none_t t);
+
+
+    std::shared_ptr<const IntervalIndex> intervalIndex() const;
+
+
+    virtual ~MultiTagMem();
+
+};
+
+
+} // namespace mem
+} // namespace nix
+
+#endif // NIX_MULTI_TAG_MEM_H
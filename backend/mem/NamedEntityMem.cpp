@@ -0,0 +1,85 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "NamedEntityMem.hpp"
+
+#include <nix/Exception.hpp>
+
+using namespace std;
+
+namespace nix {
+namespace mem {
+
+
+NamedEntityMem::NamedEntityMem(const shared_ptr<FileMem> &file, const string &id, const string &type,
+                               const string &name, time_t time)
+    : EntityMem(file, id, time)
+{
+    this->type(type);
+    if (name.empty()) {
+        throw EmptyString("name");
+    }
+    entity_name = name;
+}
+
+
+void NamedEntityMem::type(const string &type) {
+    if (type.empty()) {
+        throw EmptyString("type");
+    }
+    entity_type = type;
+    forceUpdatedAt();
+}
+
+
+string NamedEntityMem::type() const {
+    return entity_type;
+}
+
+
+string NamedEntityMem::name() const {
+    return entity_name;
+}
+
+
+void NamedEntityMem::definition(const string &definition) {
+    if (definition.empty()) {
+        throw EmptyString("definition");
+    }
+    entity_definition = definition;
+    forceUpdatedAt();
+}
+
+
+boost::optional<string> NamedEntityMem::definition() const {
+    return entity_definition;
+}
+
+
+void NamedEntityMem::definition(const none_t t) {
+    entity_definition = boost::none;
+    forceUpdatedAt();
+}
+
+
+int NamedEntityMem::compare(const shared_ptr<INamedEntity> &other) const {
+    int cmp = 0;
+    if (!name().empty() && !other->name().empty()) {
+        cmp = (name()).compare(other->name());
+    }
+    if (cmp == 0) {
+        cmp = id().compare(other->id());
+    }
+    return cmp;
+}
+
+
+NamedEntityMem::~NamedEntityMem() {}
+
+} // ns nix::mem
+} // ns nix
@@ -0,0 +1,67 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_NAMED_ENTITY_MEM_H
+#define NIX_NAMED_ENTITY_MEM_H
+
+#include <nix/base/INamedEntity.hpp>
+#include "EntityMem.hpp"
+
+#include <string>
+#include <memory>
+
+namespace nix {
+namespace mem {
+
+
+/**
+ * In-memory implementation of INamedEntity
+ */
+class NamedEntityMem : virtual public base::INamedEntity, public EntityMem {
+
+private:
+
+    std::string entity_name, entity_type;
+    boost::optional<std::string> entity_definition;
+
+public:
+
+    NamedEntityMem(const std::shared_ptr<FileMem> &file, const std::string &id, const std::string &type,
+                   const std::string &name, time_t time);
+
+
+    void type(const std::string &type);
+
+
+    std::string type() const;
+
+
+    std::string name() const;
+
+
+    void definition(const std::string &definition);
+
+
+    boost::optional<std::string> definition() const;
+
+
+    void definition(const none_t t);
+
+
+    int compare(const std::shared_ptr<INamedEntity> &other) const;
+
+
+    virtual ~NamedEntityMem();
+
+};
+
+
+} // namespace mem
+} // namespace nix
+
+#endif // NIX_NAMED_ENTITY_MEM_H
@@ -0,0 +1,171 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "PropertyMem.hpp"
+
+#include <nix/Exception.hpp>
+
+using namespace std;
+
+namespace nix {
+namespace mem {
+
+
+template<typename T>
+static T numeric_value(const Value &value) {
+    switch (value.type()) {
+        case DataType::Bool:   return static_cast<T>(value.get<bool>());
+        case DataType::Int32:  return static_cast<T>(value.get<int32_t>());
+        case DataType::UInt32: return static_cast<T>(value.get<uint32_t>());
+        case DataType::Int64:  return static_cast<T>(value.get<int64_t>());
+        case DataType::UInt64: return static_cast<T>(value.get<uint64_t>());
+        case DataType::Double: return static_cast<T>(value.get<double>());
+        default:
+            throw invalid_argument("PropertyMem::values: cannot convert " + data_type_to_string(value.type()) +
+                                   " to a number");
+    }
+}
+
+/*
+ * Convert a value to the data type of the property, like the hdf5 back-end does on write.
+ */
+static Value convert_value(const Value &value, DataType dtype) {
+    if (value.type() == dtype) {
+        return value;
+    }
+
+    Value converted;
+    switch (dtype) {
+        case DataType::Bool:   converted.set(numeric_value<bool>(value)); break;
+        case DataType::Int32:  converted.set(numeric_value<int32_t>(value)); break;
+        case DataType::UInt32: converted.set(numeric_value<uint32_t>(value)); break;
+        case DataType::Int64:  converted.set(numeric_value<int64_t>(value)); break;
+        case DataType::UInt64: converted.set(numeric_value<uint64_t>(value)); break;
+        case DataType::Double: converted.set(numeric_value<double>(value)); break;
+        default:
+            throw invalid_argument("PropertyMem::values: cannot convert " + data_type_to_string(value.type()) +
+                                   " to " + data_type_to_string(dtype));
+    }
+
+    converted.uncertainty = value.uncertainty;
+    converted.reference = value.reference;
+    converted.filename = value.filename;
+    converted.encoder = value.encoder;
+    converted.checksum = value.checksum;
+    return converted;
+}
+
+
+PropertyMem::PropertyMem(const shared_ptr<FileMem> &file, const string &id, const string &name,
+                         DataType dtype, time_t time)
+    : EntityMem(file, id, time), dtype(dtype)
+{
+    if (name.empty()) {
+        throw EmptyString("name");
+    }
+    entity_name = name;
+}
+
+
+string PropertyMem::name() const {
+    return entity_name;
+}
+
+
+void PropertyMem::definition(const string &definition) {
+    entity_definition = definition;
+    forceUpdatedAt();
+}
+
+
+boost::optional<string> PropertyMem::definition() const {
+    return entity_definition;
+}
+
+
+void PropertyMem::definition(const none_t t) {
+    entity_definition = boost::none;
+    forceUpdatedAt();
+}
+
+
+void PropertyMem::mapping(const string &mapping) {
+    entity_mapping = mapping;
+    forceUpdatedAt();
+}
+
+
+boost::optional<string> PropertyMem::mapping() const {
+    return entity_mapping;
+}
+
+
+void PropertyMem::mapping(const none_t t) {
+    if (entity_mapping) {
+        entity_mapping = boost::none;
+        forceUpdatedAt();
+    }
+}
+
+
+DataType PropertyMem::dataType() const {
+    return dtype;
+}
+
+
+void PropertyMem::unit(const string &unit) {
+    entity_unit = unit;
+    forceUpdatedAt();
+}
+
+
+boost::optional<string> PropertyMem::unit() const {
+    return entity_unit;
+}
+
+
+void PropertyMem::unit(const none_t t) {
+    entity_unit = boost::none;
+    forceUpdatedAt();
+}
+
+
+void PropertyMem::deleteValues() {
+    entity_values.clear();
+}
+
+
+ndsize_t PropertyMem::valueCount() const {
+    return entity_values.size();
+}
+
+
+void PropertyMem::values(const vector<Value> &values) {
+    vector<Value> converted;
+    converted.reserve(values.size());
+    for (const Value &value : values) {
+        converted.push_back(convert_value(value, dtype));
+    }
+    entity_values.swap(converted);
+}
+
+
+vector<Value> PropertyMem::values(void) const {
+    return entity_values;
+}
+
+
+void PropertyMem::values(const boost::none_t t) {
+    deleteValues();
+}
+
+
+PropertyMem::~PropertyMem() {}
+
+} // ns nix::mem
+} // ns nix
@@ -0,0 +1,98 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_PROPERTY_MEM_H
+#define NIX_PROPERTY_MEM_H
+
+#include <nix/base/IProperty.hpp>
+#include "EntityMem.hpp"
+
+#include <string>
+#include <vector>
+#include <memory>
+
+namespace nix {
+namespace mem {
+
+/**
+ * Class that represents a NIX Property that is kept in memory.
+ */
+class PropertyMem : virtual public base::IProperty, public EntityMem {
+
+private:
+
+    std::string entity_name;
+    boost::optional<std::string> entity_definition, entity_mapping, entity_unit;
+    DataType dtype;
+    std::vector<Value> entity_values;
+
+public:
+
+    PropertyMem(const std::shared_ptr<FileMem> &file, const std::string &id, const std::string &name,
+                DataType dtype, time_t time);
+
+
+    std::string name() const;
+
+
+    void definition(const std::string &definition);
+
+
+    boost::optional<std::string> definition() const;
+
+
+    void definition(const none_t t);
+
+
+    void mapping(const std::string &mapping);
+
+
+    boost::optional<std::string> mapping() const;
+
+
+    void mapping(const none_t t);
+
+
+    DataType dataType() const;
+
+
+    void unit(const std::string &unit);
+
+
+    boost::optional<std::string> unit() const;
+
+
+    void unit(const none_t t);
+
+
+    void deleteValues();
+
+
+    ndsize_t valueCount() const;
+
+    /**
+     * @brief Set the values, numeric values are converted to the type of the property.
+     */
+    void values(const std::vector<Value> &values);
+
+
+    std::vector<Value> values(void) const;
+
+
+    void values(const boost::none_t t);
+
+
+    virtual ~PropertyMem();
+
+};
+
+
+} // namespace mem
+} // namespace nix
+
+#endif // NIX_PROPERTY_MEM_H
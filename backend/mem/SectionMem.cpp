@@ -0,0 +1,229 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "SectionMem.hpp"
+#include "PropertyMem.hpp"
+#include "FileMem.hpp"
+
+#include <nix/util/util.hpp>
+
+using namespace std;
+
+namespace nix {
+namespace mem {
+
+
+SectionMem::SectionMem(const shared_ptr<FileMem> &file, const shared_ptr<SectionMem> &parent,
+                       const string &id, const string &type, const string &name, time_t time)
+    : NamedEntityMem(file, id, type, name, time), parent_section(parent)
+{
+}
+
+//--------------------------------------------------
+// Attribute getter and setter
+//--------------------------------------------------
+
+void SectionMem::repository(const string &repository) {
+    section_repository = repository;
+    forceUpdatedAt();
+}
+
+
+boost::optional<string> SectionMem::repository() const {
+    return section_repository;
+}
+
+
+void SectionMem::repository(const none_t t) {
+    section_repository = boost::none;
+    forceUpdatedAt();
+}
+
+
+void SectionMem::link(const string &id) {
+    shared_ptr<SectionMem> target = fileMem()->findSection(id);
+    if (!target)
+        throw runtime_error("SectionMem::link: Section not found in file!");
+
+    link_ref = target;
+}
+
+
+shared_ptr<base::ISection> SectionMem::link() const {
+    return lockValid(link_ref);
+}
+
+
+void SectionMem::link(const none_t t) {
+    link_ref.reset();
+    forceUpdatedAt();
+}
+
+
+void SectionMem::mapping(const string &mapping) {
+    section_mapping = mapping;
+    forceUpdatedAt();
+}
+
+
+boost::optional<string> SectionMem::mapping() const {
+    return section_mapping;
+}
+
+
+void SectionMem::mapping(const none_t t) {
+    section_mapping = boost::none;
+    forceUpdatedAt();
+}
+
+//--------------------------------------------------
+// Methods for parent access
+//--------------------------------------------------
+
+shared_ptr<base::ISection> SectionMem::parent() const {
+    return parent_section.lock();
+}
+
+//--------------------------------------------------
+// Methods for child section access
+//--------------------------------------------------
+
+ndsize_t SectionMem::sectionCount() const {
+    return sections.size();
+}
+
+
+bool SectionMem::hasSection(const string &name_or_id) const {
+    return sections.has(name_or_id);
+}
+
+
+shared_ptr<base::ISection> SectionMem::getSection(const string &name_or_id) const {
+    return sections.get(name_or_id);
+}
+
+
+shared_ptr<base::ISection> SectionMem::getSection(ndsize_t index) const {
+    return sections.at(index, "section.section");
+}
+
+
+shared_ptr<base::ISection> SectionMem::createSection(const string &name, const string &type) {
+    if (hasSection(name)) {
+        throw DuplicateName("createSection");
+    }
+    return createSection(name, type, util::createId(), util::getTime());
+}
+
+
+shared_ptr<SectionMem> SectionMem::createSection(const string &name, const string &type,
+                                                 const string &id, time_t time) {
+    shared_ptr<FileMem> file = fileMem();
+    auto self = shared_from_this();
+    auto section = make_shared<SectionMem>(file, self, id, type, name, time);
+    sections.add(name, section);
+    file->indexSection(section);
+    return section;
+}
+
+
+bool SectionMem::deleteSection(const string &name_or_id) {
+    shared_ptr<SectionMem> section = sections.remove(name_or_id);
+    if (section) {
+        section->markDeleted();
+    }
+    return section != nullptr;
+}
+
+//--------------------------------------------------
+// Methods for property access
+//--------------------------------------------------
+
+ndsize_t SectionMem::propertyCount() const {
+    return properties.size();
+}
+
+
+bool SectionMem::hasProperty(const string &name_or_id) const {
+    return properties.has(name_or_id);
+}
+
+
+shared_ptr<base::IProperty> SectionMem::getProperty(const string &name_or_id) const {
+    return properties.get(name_or_id);
+}
+
+
+shared_ptr<base::IProperty> SectionMem::getProperty(ndsize_t index) const {
+    return properties.at(index, "section.property");
+}
+
+
+shared_ptr<base::IProperty> SectionMem::createProperty(const string &name, const DataType &dtype) {
+    if (hasProperty(name)) {
+        throw DuplicateName("hasProperty");
+    }
+    return createProperty(name, dtype, util::createId(), util::getTime());
+}
+
+
+shared_ptr<PropertyMem> SectionMem::createProperty(const string &name, const DataType &dtype,
+                                                   const string &id, time_t time) {
+    auto prop = make_shared<PropertyMem>(fileMem(), id, name, dtype, time);
+    properties.add(name, prop);
+    return prop;
+}
+
+
+shared_ptr<base::IProperty> SectionMem::createProperty(const string &name, const Value &value) {
+    shared_ptr<base::IProperty> p = createProperty(name, value.type());
+    vector<Value> val{value};
+    p->values(val);
+    return p;
+}
+
+
+shared_ptr<base::IProperty> SectionMem::createProperty(const string &name, const vector<Value> &values) {
+    shared_ptr<base::IProperty> p = createProperty(name, values[0].type());
+    p->values(values);
+    return p;
+}
+
+
+bool SectionMem::deleteProperty(const string &name_or_id) {
+    shared_ptr<PropertyMem> prop = properties.remove(name_or_id);
+    if (prop) {
+        prop->markDeleted();
+    }
+    return prop != nullptr;
+}
+
+//--------------------------------------------------
+// Other methods and functions
+//--------------------------------------------------
+
+shared_ptr<base::IFile> SectionMem::parentFile() const {
+    return file();
+}
+
+
+void SectionMem::markDeleted() {
+    for (const auto &section : sections.all()) {
+        section->markDeleted();
+    }
+    for (const auto &prop : properties.all()) {
+        prop->markDeleted();
+    }
+    NamedEntityMem::markDeleted();
+}
+
+
+SectionMem::~SectionMem() {}
+
+} // ns nix::mem
+} // ns nix
@@ -0,0 +1,158 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_SECTION_MEM_H
+#define NIX_SECTION_MEM_H
+
+#include <nix/base/ISection.hpp>
+#include "NamedEntityMem.hpp"
+#include "Containers.hpp"
+
+#include <string>
+#include <vector>
+#include <memory>
+
+namespace nix {
+namespace mem {
+
+class PropertyMem;
+
+/**
+ * Class that represents a NIX Section that is kept in memory.
+ */
+class SectionMem : virtual public base::ISection, public NamedEntityMem,
+                   public std::enable_shared_from_this<SectionMem> {
+
+private:
+
+    std::weak_ptr<SectionMem> parent_section;
+    std::weak_ptr<SectionMem> link_ref;
+    boost::optional<std::string> section_repository, section_mapping;
+    EntityList<SectionMem> sections;
+    EntityList<PropertyMem> properties;
+
+public:
+
+    SectionMem(const std::shared_ptr<FileMem> &file, const std::shared_ptr<SectionMem> &parent,
+               const std::string &id, const std::string &type, const std::string &name, time_t time);
+
+    //--------------------------------------------------
+    // Attribute getter and setter
+    //--------------------------------------------------
+
+    void repository(const std::string &repository);
+
+
+    boost::optional<std::string> repository() const;
+
+
+    void repository(const none_t t);
+
+
+    void link(const std::string &id);
+
+
+    std::shared_ptr<base::ISection> link() const;
+
+
+    void link(const none_t t);
+
+
+    void mapping(const std::string &mapping);
+
+
+    boost::optional<std::string> mapping() const;
+
+
+    void mapping(const none_t t);
+
+    //--------------------------------------------------
+    // Methods for parent access
+    //--------------------------------------------------
+
+    std::shared_ptr<base::ISection> parent() const;
+
+    //--------------------------------------------------
+    // Methods for child section access
+    //--------------------------------------------------
+
+    ndsize_t sectionCount() const;
+
+
+    bool hasSection(const std::string &name_or_id) const;
+
+
+    std::shared_ptr<base::ISection> getSection(const std::string &name_or_id) const;
+
+
+    std::shared_ptr<base::ISection> getSection(ndsize_t index) const;
+
+
+    std::shared_ptr<base::ISection> createSection(const std::string &name, const std::string &type);
+
+    /**
+     * @brief Create a child section with the given id and creation time.
+     */
+    std::shared_ptr<SectionMem> createSection(const std::string &name, const std::string &type,
+                                              const std::string &id, time_t time);
+
+
+    bool deleteSection(const std::string &name_or_id);
+
+    //--------------------------------------------------
+    // Methods for property access
+    //--------------------------------------------------
+
+    ndsize_t propertyCount() const;
+
+
+    bool hasProperty(const std::string &name_or_id) const;
+
+
+    std::shared_ptr<base::IProperty> getProperty(const std::string &name_or_id) const;
+
+
+    std::shared_ptr<base::IProperty> getProperty(ndsize_t index) const;
+
+
+    std::shared_ptr<base::IProperty> createProperty(const std::string &name, const DataType &dtype);
+
+    /**
+     * @brief Create a property with the given id and creation time.
+     */
+    std::shared_ptr<PropertyMem> createProperty(const std::string &name, const DataType &dtype,
+                                                const std::string &id, time_t time);
+
+
+    std::shared_ptr<base::IProperty> createProperty(const std::string &name, const Value &value);
+
+
+    std::shared_ptr<base::IProperty> createProperty(const std::string &name, const std::vector<Value> &values);
+
+
+    bool deleteProperty(const std::string &name_or_id);
+
+    //--------------------------------------------------
+    // Other methods and functions
+    //--------------------------------------------------
+
+    std::shared_ptr<base::IFile> parentFile() const;
+
+
+    void markDeleted();
+
+
+    virtual ~SectionMem();
+
+};
+
+
+} // namespace mem
+} // namespace nix
+
+#endif // NIX_SECTION_MEM_H
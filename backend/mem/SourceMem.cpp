@@ -0,0 +1,98 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "SourceMem.hpp"
+#include "BlockMem.hpp"
+
+#include <nix/util/util.hpp>
+
+using namespace std;
+
+namespace nix {
+namespace mem {
+
+
+SourceMem::SourceMem(const shared_ptr<FileMem> &file, const shared_ptr<BlockMem> &block,
+                     const string &id, const string &type, const string &name, time_t time)
+    : EntityWithMetadataMem(file, id, type, name, time), entity_block(block)
+{
+}
+
+//--------------------------------------------------
+// Methods concerning child sources
+//--------------------------------------------------
+
+bool SourceMem::hasSource(const string &name_or_id) const {
+    return sources.has(name_or_id);
+}
+
+
+shared_ptr<base::ISource> SourceMem::getSource(const string &name_or_id) const {
+    return sources.get(name_or_id);
+}
+
+
+shared_ptr<base::ISource> SourceMem::getSource(ndsize_t index) const {
+    return sources.at(index, "source");
+}
+
+
+ndsize_t SourceMem::sourceCount() const {
+    return sources.size();
+}
+
+
+shared_ptr<base::ISource> SourceMem::createSource(const string &name, const string &type) {
+    if (name.empty()) {
+        throw EmptyString("name");
+    }
+    if (hasSource(name)) {
+        throw DuplicateName("createSource");
+    }
+
+    shared_ptr<BlockMem> block = entity_block.lock();
+    auto source = make_shared<SourceMem>(fileMem(), block, util::createId(), type, name, util::getTime());
+    sources.add(name, source);
+    if (block) {
+        block->indexSource(source);
+    }
+    return source;
+}
+
+
+bool SourceMem::deleteSource(const string &name_or_id) {
+    shared_ptr<SourceMem> source = sources.remove(name_or_id);
+    if (source) {
+        source->markDeleted();
+    }
+    return source != nullptr;
+}
+
+
+shared_ptr<base::IFile> SourceMem::parentFile() const {
+    return file();
+}
+
+
+shared_ptr<base::IBlock> SourceMem::parentBlock() const {
+    return entity_block.lock();
+}
+
+
+void SourceMem::markDeleted() {
+    for (const auto &source : sources.all()) {
+        source->markDeleted();
+    }
+    EntityWithMetadataMem::markDeleted();
+}
+
+
+SourceMem::~SourceMem() {}
+
+} // ns nix::mem
+} // ns nix
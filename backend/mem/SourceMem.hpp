@@ -0,0 +1,78 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_SOURCE_MEM_H
+#define NIX_SOURCE_MEM_H
+
+#include <nix/base/ISource.hpp>
+#include "EntityWithMetadataMem.hpp"
+#include "Containers.hpp"
+
+#include <string>
+#include <memory>
+
+namespace nix {
+namespace mem {
+
+class BlockMem;
+
+/**
+ * Class that represents a NIX Source entity that is kept in memory.
+ */
+class SourceMem : virtual public base::ISource, public EntityWithMetadataMem {
+
+private:
+
+    std::weak_ptr<BlockMem> entity_block;
+    EntityList<SourceMem> sources;
+
+public:
+
+    SourceMem(const std::shared_ptr<FileMem> &file, const std::shared_ptr<BlockMem> &block,
+              const std::string &id, const std::string &type, const std::string &name, time_t time);
+
+    //--------------------------------------------------
+    // Methods concerning child sources
+    //--------------------------------------------------
+
+    bool hasSource(const std::string &name_or_id) const;
+
+
+    std::shared_ptr<base::ISource> getSource(const std::string &name_or_id) const;
+
+
+    std::shared_ptr<base::ISource> getSource(ndsize_t index) const;
+
+
+    ndsize_t sourceCount() const;
+
+
+    std::shared_ptr<base::ISource> createSource(const std::string &name, const std::string &type);
+
+
+    bool deleteSource(const std::string &name_or_id);
+
+
+    std::shared_ptr<base::IFile> parentFile() const;
+
+
+    std::shared_ptr<base::IBlock> parentBlock() const;
+
+
+    void markDeleted();
+
+
+    virtual ~SourceMem();
+
+};
+
+
+} // namespace mem
+} // namespace nix
+
+#endif // NIX_SOURCE_MEM_H
@@ -0,0 +1,70 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "TagMem.hpp"
+
+using namespace std;
+
+namespace nix {
+namespace mem {
+
+
+TagMem::TagMem(const shared_ptr<FileMem> &file, const shared_ptr<BlockMem> &block, const string &id,
+               const string &type, const string &name, const vector<double> &position, time_t time)
+    : BaseTagMem(file, block, id, type, name, time), tag_position(position)
+{
+}
+
+
+vector<string> TagMem::units() const {
+    return tag_units;
+}
+
+
+void TagMem::units(const vector<string> &units) {
+    tag_units = units;
+    forceUpdatedAt();
+}
+
+
+void TagMem::units(const none_t t) {
+    tag_units.clear();
+    forceUpdatedAt();
+}
+
+
+vector<double> TagMem::position() const {
+    return tag_position;
+}
+
+
+void TagMem::position(const vector<double> &position) {
+    tag_position = position;
+}
+
+
+vector<double> TagMem::extent() const {
+    return tag_extent;
+}
+
+
+void TagMem::extent(const vector<double> &extent) {
+    tag_extent = extent;
+}
+
+
+void TagMem::extent(const none_t t) {
+    tag_extent.clear();
+    forceUpdatedAt();
+}
+
+
+TagMem::~TagMem() {}
+
+} // ns nix::mem
+} // ns nix
@@ -0,0 +1,70 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_TAG_MEM_H
+#define NIX_TAG_MEM_H
+
+#include <nix/base/ITag.hpp>
+#include "BaseTagMem.hpp"
+
+#include <string>
+#include <vector>
+#include <memory>
+
+namespace nix {
+namespace mem {
+
+/**
+ * Class that represents a NIX tag that is kept in memory.
+ */
+class TagMem : virtual public base::ITag, public BaseTagMem {
+
+private:
+
+    std::vector<std::string> tag_units;
+    std::vector<double> tag_position, tag_extent;
+
+public:
+
+    TagMem(const std::shared_ptr<FileMem> &file, const std::shared_ptr<BlockMem> &block, const std::string &id,
+           const std::string &type, const std::string &name, const std::vector<double> &position, time_t time);
+
+
+    std::vector<std::string> units() const;
+
+
+    void units(const std::vector<std::string> &units);
+
+
+    void units(const none_t t);
+
+
+    std::vector<double> position() const;
+
+
+    void position(const std::vector<double> &position);
+
+
+    std::vector<double> extent() const;
+
+
+    void extent(const std::vector<double> &extent);
+
+
+    void extent(const none_t t);
+
+
+    virtual ~TagMem();
+
+};
+
+
+} // namespace mem
+} // namespace nix
+
+#endif // NIX_TAG_MEM_H
@@ -27,6 +27,11 @@ namespace po = boost::program_options;
 #include <modules/IModule.hpp>
 #include <modules/Validate.hpp>
 #include <modules/Dump.hpp>
+#include <modules/Export.hpp>
+#include <modules/Import.hpp>
+#include <modules/Stat.hpp>
+#include <modules/Repack.hpp>
+#include <modules/Convert.hpp>
 
 namespace cli {
 
@@ -41,7 +46,12 @@ std::ostream& operator<<(std::ostream& os, const std::vector<T>& v)
 // define all module types
 std::unordered_map<std::string, std::shared_ptr<cli::module::IModule>> modules = {
     {std::string(cli::module::Validate::module_name), std::shared_ptr<cli::module::IModule>(new cli::module::Validate())},
-    {std::string(cli::module::Dump::module_name), std::shared_ptr<cli::module::IModule>(new cli::module::Dump())}
+    {std::string(cli::module::Dump::module_name), std::shared_ptr<cli::module::IModule>(new cli::module::Dump())},
+    {std::string(cli::module::Export::module_name), std::shared_ptr<cli::module::IModule>(new cli::module::Export())},
+    {std::string(cli::module::Import::module_name), std::shared_ptr<cli::module::IModule>(new cli::module::Import())},
+    {std::string(cli::module::Stat::module_name), std::shared_ptr<cli::module::IModule>(new cli::module::Stat())},
+    {std::string(cli::module::Repack::module_name), std::shared_ptr<cli::module::IModule>(new cli::module::Repack())},
+    {std::string(cli::module::Convert::module_name), std::shared_ptr<cli::module::IModule>(new cli::module::Convert())}
 };
 
 } // namespace cli
@@ -87,16 +97,18 @@ int main(int argc, char* argv[]) {
                   .run(), vm);
         po::notify(vm);
         
-        // parse input again (with pos-options) to get MODULE_OPTION & INPFILE_OPTIONs
+        // parse input again (with pos-options) to get MODULE_OPTION; the values of
+        // module options are not known yet and would be taken for INPFILE_OPTIONs
+        po::variables_map module_vm;
         po::store(parser2.options(desc)
                   .positional(pdesc)
                   //.style(po::command_line_style::case_insensitive)
                   .allow_unregistered()
-                  .run(), vm);
-        po::notify(vm);
+                  .run(), module_vm);
+        po::notify(module_vm);
         // get name
-        name = !vm.count(cli::MODULE_OPTION) ? "" :
-                         vm[cli::MODULE_OPTION].as<std::string>();
+        name = !module_vm.count(cli::MODULE_OPTION) ? "" :
+                         module_vm[cli::MODULE_OPTION].as<std::string>();
         
         // load & call module
         auto it = cli::modules.find(name);
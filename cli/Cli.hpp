@@ -25,6 +25,11 @@ namespace cli {
     const char *const HELP_OPTION = "help";
     const char *const MODULE_OPTION = "module";
     const char *const INPFILE_OPTION = "input-file";
+    const char *const BLOCK_OPTION = "block";
+    const char *const ARRAY_OPTION = "array";
+    const char *const JOBS_OPTION = "jobs";
+    const char *const COMPRESSION_OPTION = "compression";
+    const char *const SHUFFLE_OPTION = "shuffle";
 
 class NoInputFile : public std::invalid_argument {
 public:
@@ -43,6 +48,12 @@ public:
             std::invalid_argument("File '" + file_name + "' could not be opened - wrong format?") { }
 };
 
+class InvalidOptionValue : public std::invalid_argument {
+public:
+    InvalidOptionValue(std::string option, std::string value) :
+            std::invalid_argument("Invalid value '" + value + "' for option --" + option) { }
+};
+
 } // namespace cli
 
 #endif
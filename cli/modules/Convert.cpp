@@ -0,0 +1,107 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <Cli.hpp>
+#include <modules/Convert.hpp>
+#include <modules/DataFile.hpp>
+#include <nix.hpp>
+#include <nix/util/copy.hpp>
+
+#include <iomanip>
+#include <sstream>
+
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+namespace po = boost::program_options;
+
+namespace cli {
+namespace module {
+
+const char* Convert::module_name = "convert";
+
+const char *const TO_OPTION = "to";
+const char *const NO_VERIFY_OPTION = "no-verify";
+
+void Convert::load(po::options_description &desc) const {
+    desc.add(po::options_description("nix-tool " + std::string(module_name) + ":\n\n\t" +
+                                     "Converts a HDF5 file into a file of the file system back-end or vice versa.\n\t" +
+                                     "All entities keep their ids; the data of the arrays is copied by a pool\n\t" +
+                                     "of threads. Usage: nix-tool convert [options] SOURCE TARGET\n\nSupported options"));
+    po::options_description opt;
+    opt.add_options()
+        (TO_OPTION, po::value<std::string>(), "back-end of the target, 'hdf5' or 'file'; by default the one the source does not use")
+        (JOBS_OPTION, po::value<size_t>(), "number of threads that copy data, by default one per core")
+        (NO_VERIFY_OPTION, "do not compare the new file with the source")
+    ;
+    desc.add(opt);
+}
+
+std::string Convert::call(const po::variables_map &vm, const po::options_description &desc) {
+    std::stringstream out;
+
+    // --help
+    if (vm.count(HELP_OPTION)) {
+        po::options_description temp;
+        load(temp);
+        out << temp << std::endl;
+        return out.str();
+    }
+    if (!vm.count(INPFILE_OPTION)) {
+        throw NoInputFile();
+    }
+
+    const std::vector<std::string> &paths = vm[INPFILE_OPTION].as< std::vector<std::string> >();
+    if (paths.size() != 2) {
+        throw std::invalid_argument("convert needs exactly two files, the source and the target");
+    }
+    const std::string &source_path = paths[0];
+    const std::string &target_path = paths[1];
+    if (!boost::filesystem::exists(source_path)) {
+        throw FileNotFound(source_path);
+    }
+    if (boost::filesystem::exists(target_path) && boost::filesystem::equivalent(source_path, target_path)) {
+        throw std::invalid_argument("The target must not be the source file");
+    }
+
+    // files of the file system back-end are directories
+    const std::string source_backend = boost::filesystem::is_directory(source_path) ? "file" : "hdf5";
+    nix::util::CopyOptions options;
+    options.backend = source_backend == "hdf5" ? "file" : "hdf5";
+    if (vm.count(TO_OPTION)) {
+        options.backend = vm[TO_OPTION].as<std::string>();
+        if (options.backend != "hdf5" && options.backend != "file") {
+            throw InvalidOptionValue(TO_OPTION, options.backend);
+        }
+    }
+    if (vm.count(JOBS_OPTION)) {
+        options.jobs = vm[JOBS_OPTION].as<size_t>();
+    }
+    options.verify = !vm.count(NO_VERIFY_OPTION);
+
+    nix::File source = nix::File::open(source_path, nix::FileMode::ReadOnly, source_backend);
+    if (!source.isOpen()) {
+        throw FileNotOpen(source_path);
+    }
+    const nix::util::CopyReport report = nix::util::copyFile(source, target_path, options);
+    source.close();
+
+    out << "converted " << source_path << " (" << source_backend << ") into " << target_path
+        << " (" << options.backend << "): " << report.blocks << " blocks, "
+        << report.data_arrays << " data arrays\n"
+        << "  copied " << report.bytes << " bytes in " << report.seconds << " s ("
+        << std::fixed << std::setprecision(1) << mb_per_second(report.bytes, report.seconds) << " MB/s)\n"
+        << "  size   " << path_size(source_path) << " -> " << path_size(target_path) << " bytes\n";
+    if (options.verify) {
+        out << "  verified, read " << mb_per_second(report.bytes, report.source_read_seconds) << " -> "
+            << mb_per_second(report.bytes, report.target_read_seconds) << " MB/s\n";
+    }
+    return out.str();
+}
+
+} // namespace module
+} // namespace cli
@@ -0,0 +1,40 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef CLI_CONVERT_H
+#define CLI_CONVERT_H
+
+#include <Cli.hpp>
+#include <modules/IModule.hpp>
+
+#include <boost/program_options.hpp>
+namespace po = boost::program_options;
+
+namespace cli {
+namespace module {
+
+class Convert : virtual public IModule {
+
+public:
+
+    static const char* module_name;
+
+    std::string name() const {
+        return std::string(module_name);
+    }
+
+    void load(po::options_description &desc) const;
+
+    std::string call(const po::variables_map &vm, const po::options_description &desc);
+
+};
+
+} // namespace module
+} // namespace cli
+
+#endif
@@ -0,0 +1,258 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <Cli.hpp>
+#include <modules/DataFile.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <regex>
+#include <stdexcept>
+
+#include <boost/filesystem.hpp>
+
+namespace cli {
+namespace module {
+
+namespace {
+
+const char NPY_MAGIC[] = "\x93NUMPY";
+const size_t NPY_MAGIC_LEN = 6;
+
+// type code of numpy's descr, without byte order and size
+char npy_kind(nix::DataType dtype) {
+    switch (dtype) {
+        case nix::DataType::Bool:   return 'b';
+        case nix::DataType::Int8:
+        case nix::DataType::Int16:
+        case nix::DataType::Int32:
+        case nix::DataType::Int64:  return 'i';
+        case nix::DataType::UInt8:
+        case nix::DataType::UInt16:
+        case nix::DataType::UInt32:
+        case nix::DataType::UInt64: return 'u';
+        case nix::DataType::Float:
+        case nix::DataType::Double: return 'f';
+        default:
+            throw std::invalid_argument("Data type " + nix::data_type_to_string(dtype) +
+                                        " cannot be stored in a .npy file");
+    }
+}
+
+
+nix::DataType npy_type(char kind, size_t size) {
+    const nix::DataType types[] = {
+        nix::DataType::Bool, nix::DataType::Int8, nix::DataType::Int16, nix::DataType::Int32,
+        nix::DataType::Int64, nix::DataType::UInt8, nix::DataType::UInt16, nix::DataType::UInt32,
+        nix::DataType::UInt64, nix::DataType::Float, nix::DataType::Double
+    };
+    for (nix::DataType dtype : types) {
+        if (npy_kind(dtype) == kind && nix::data_type_to_size(dtype) == size) {
+            return dtype;
+        }
+    }
+    return nix::DataType::Nothing;
+}
+
+} // anonymous namespace
+
+
+bool is_npy_file(const std::string &path, const std::string &format) {
+    if (format == "npy") {
+        return true;
+    } else if (format == "raw") {
+        return false;
+    } else if (!format.empty()) {
+        throw InvalidOptionValue(FORMAT_OPTION, format);
+    }
+    return path.size() >= 4 && path.compare(path.size() - 4, 4, ".npy") == 0;
+}
+
+
+std::string npy_header(const DataFileLayout &layout) {
+    const size_t esize = nix::data_type_to_size(layout.dtype);
+    const char order = esize == 1 ? '|' : (layout.big_endian ? '>' : '<');
+
+    std::string dict = "{'descr': '";
+    dict += order;
+    dict += npy_kind(layout.dtype) + nix::util::numToStr(esize);
+    dict += "', 'fortran_order': False, 'shape': (";
+    for (size_t i = 0; i < layout.shape.size(); i++) {
+        dict += (i > 0 ? ", " : "") + nix::util::numToStr(layout.shape[i]);
+    }
+    // a tuple with one element needs a trailing comma
+    dict += layout.shape.size() == 1 ? ",), }" : "), }";
+
+    // the values start at a multiple of 64 bytes, the header ends with a newline;
+    // version 1.0 has a 16 bit header length, 2.0 a 32 bit one
+    size_t prefix = NPY_MAGIC_LEN + 2 + 2;
+    size_t total = (prefix + dict.size() + 1 + 63) / 64 * 64;
+    const bool v2 = total - prefix > 65535;
+    if (v2) {
+        prefix = NPY_MAGIC_LEN + 2 + 4;
+        total = (prefix + dict.size() + 1 + 63) / 64 * 64;
+    }
+    dict.append(total - prefix - dict.size() - 1, ' ');
+    dict += '\n';
+
+    std::string header(NPY_MAGIC, NPY_MAGIC_LEN);
+    header += static_cast<char>(v2 ? 2 : 1);
+    header += '\0';
+    const uint32_t len = static_cast<uint32_t>(dict.size());
+    for (size_t i = 0; i < (v2 ? 4u : 2u); i++) {
+        header += static_cast<char>((len >> (8 * i)) & 0xff);
+    }
+    return header + dict;
+}
+
+
+DataFileLayout parse_npy_header(const char *data, size_t size) {
+    if (size < NPY_MAGIC_LEN + 4 || std::memcmp(data, NPY_MAGIC, NPY_MAGIC_LEN) != 0) {
+        throw std::invalid_argument("Not a .npy file");
+    }
+
+    const unsigned char major = static_cast<unsigned char>(data[NPY_MAGIC_LEN]);
+    const size_t len_bytes = major == 1 ? 2 : 4;
+    if (major < 1 || major > 3 || size < NPY_MAGIC_LEN + 2 + len_bytes) {
+        throw std::invalid_argument("Unsupported .npy version " + nix::util::numToStr(static_cast<int>(major)));
+    }
+    size_t len = 0;
+    for (size_t i = 0; i < len_bytes; i++) {
+        len |= static_cast<size_t>(static_cast<unsigned char>(data[NPY_MAGIC_LEN + 2 + i])) << (8 * i);
+    }
+
+    DataFileLayout layout;
+    layout.data_offset = NPY_MAGIC_LEN + 2 + len_bytes + len;
+    if (layout.data_offset > size) {
+        throw std::invalid_argument("Truncated .npy header");
+    }
+    const std::string dict(data + NPY_MAGIC_LEN + 2 + len_bytes, len);
+
+    std::smatch m;
+    if (!std::regex_search(dict, m, std::regex("'descr'\\s*:\\s*'([<>|=])([biuf])(\\d+)'"))) {
+        throw std::invalid_argument("Unsupported .npy data type in header: " + dict);
+    }
+    layout.big_endian = m[1] == ">" || (m[1] == "=" && host_big_endian());
+    layout.dtype = npy_type(m.str(2)[0], std::stoul(m.str(3)));
+    if (layout.dtype == nix::DataType::Nothing) {
+        throw std::invalid_argument("Unsupported .npy data type " + m.str(2) + m.str(3));
+    }
+
+    if (std::regex_search(dict, m, std::regex("'fortran_order'\\s*:\\s*True"))) {
+        throw std::invalid_argument("Arrays in Fortran order are not supported");
+    }
+
+    if (!std::regex_search(dict, m, std::regex("'shape'\\s*:\\s*\\(([^)]*)\\)"))) {
+        throw std::invalid_argument("No shape in .npy header");
+    }
+    std::string shape = m.str(1);
+    shape.erase(std::remove_if(shape.begin(), shape.end(), ::isspace), shape.end());
+    if (!shape.empty() && shape.back() == ',') {
+        shape.pop_back();
+    }
+    layout.shape = parse_shape(shape);
+    return layout;
+}
+
+
+nix::DataType parse_data_type(const std::string &name) {
+    const nix::DataType types[] = {
+        nix::DataType::Bool, nix::DataType::Int8, nix::DataType::Int16, nix::DataType::Int32,
+        nix::DataType::Int64, nix::DataType::UInt8, nix::DataType::UInt16, nix::DataType::UInt32,
+        nix::DataType::UInt64, nix::DataType::Float, nix::DataType::Double
+    };
+    std::string lower = name;
+    std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+    for (nix::DataType dtype : types) {
+        std::string type_name = nix::data_type_to_string(dtype);
+        std::transform(type_name.begin(), type_name.end(), type_name.begin(), ::tolower);
+        if (type_name == lower) {
+            return dtype;
+        }
+    }
+    return nix::DataType::Nothing;
+}
+
+
+nix::NDSize parse_shape(const std::string &shape) {
+    std::vector<nix::ndsize_t> extents;
+    size_t start = 0;
+    while (start < shape.size()) {
+        size_t end = shape.find(',', start);
+        if (end == std::string::npos) {
+            end = shape.size();
+        }
+        const std::string item = shape.substr(start, end - start);
+        if (item.empty() || item.find_first_not_of("0123456789") != std::string::npos) {
+            throw std::invalid_argument("Invalid shape '" + shape + "'");
+        }
+        extents.push_back(std::stoull(item));
+        start = end + 1;
+    }
+    return nix::NDSize(extents);
+}
+
+
+bool is_numeric_type(nix::DataType dtype) {
+    switch (dtype) {
+        case nix::DataType::String:
+        case nix::DataType::Char:
+        case nix::DataType::Opaque:
+        case nix::DataType::Nothing:
+            return false;
+        default:
+            return true;
+    }
+}
+
+
+std::string format_shape(const nix::NDSize &shape) {
+    std::string str;
+    for (size_t i = 0; i < shape.size(); i++) {
+        str += (i > 0 ? "x" : "") + nix::util::numToStr(shape[i]);
+    }
+    return str;
+}
+
+
+bool host_big_endian() {
+    const uint16_t one = 1;
+    return *reinterpret_cast<const unsigned char *>(&one) == 0;
+}
+
+
+void swap_bytes(char *data, size_t n, size_t esize) {
+    for (size_t i = 0; i < n; i++, data += esize) {
+        std::reverse(data, data + esize);
+    }
+}
+
+
+uintmax_t path_size(const std::string &path) {
+    namespace bfs = boost::filesystem;
+    if (!bfs::is_directory(path)) {
+        return bfs::file_size(path);
+    }
+    uintmax_t size = 0;
+    for (bfs::recursive_directory_iterator it(path), end; it != end; ++it) {
+        if (bfs::is_regular_file(it->status())) {
+            size += bfs::file_size(it->path());
+        }
+    }
+    return size;
+}
+
+
+double mb_per_second(nix::ndsize_t bytes, double seconds) {
+    return seconds > 0 ? bytes / seconds / (1 << 20) : 0.0;
+}
+
+} // namespace module
+} // namespace cli
@@ -0,0 +1,96 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef CLI_DATAFILE_H
+#define CLI_DATAFILE_H
+
+#include <nix.hpp>
+
+#include <cstdint>
+#include <string>
+
+namespace cli {
+namespace module {
+
+const char *const DATAFILE_OPTION = "file";
+const char *const FORMAT_OPTION = "format";
+
+/**
+ * @brief Layout of the values in a .npy or raw binary file.
+ *
+ * Values are stored in row-major order; raw files have no header and
+ * little-endian values.
+ */
+struct DataFileLayout {
+    nix::DataType dtype = nix::DataType::Nothing;
+    nix::NDSize shape;
+    bool big_endian = false;
+    // number of header bytes before the first value
+    size_t data_offset = 0;
+};
+
+/**
+ * @brief Whether a data file is a .npy file, by --format or else by its extension.
+ */
+bool is_npy_file(const std::string &path, const std::string &format);
+
+/**
+ * @brief The complete .npy header, including magic string and padding.
+ */
+std::string npy_header(const DataFileLayout &layout);
+
+/**
+ * @brief Parse the header at the start of a .npy file.
+ *
+ * @throws std::invalid_argument If the header is malformed or describes
+ *         values that cannot be stored in a DataArray.
+ */
+DataFileLayout parse_npy_header(const char *data, size_t size);
+
+/**
+ * @brief Parse a data type name like "int16" or "Double".
+ */
+nix::DataType parse_data_type(const std::string &name);
+
+/**
+ * @brief Parse a shape like "100,4".
+ */
+nix::NDSize parse_shape(const std::string &shape);
+
+/**
+ * @brief Whether values of a type can be exchanged with data files.
+ */
+bool is_numeric_type(nix::DataType dtype);
+
+/**
+ * @brief Format a shape like "1000x4".
+ */
+std::string format_shape(const nix::NDSize &shape);
+
+bool host_big_endian();
+
+/**
+ * @brief Reverse the bytes of n values of esize bytes each.
+ */
+void swap_bytes(char *data, size_t n, size_t esize);
+
+/**
+ * @brief Size of a file, or of all files below a directory, e.g. of a file
+ *        of the file system back-end.
+ */
+uintmax_t path_size(const std::string &path);
+
+/**
+ * @brief Throughput in MB/s, 0 if no time was taken.
+ */
+double mb_per_second(nix::ndsize_t bytes, double seconds);
+
+} // namespace module
+} // namespace cli
+
+#endif
@@ -38,17 +38,25 @@ const char* yamlstream::scalar_end = "\n";
 const char* yamlstream::item_str = "- ";
 const char* plot_script::plot_file = "dump_plot.gnu";
 
+void yamlstream::put(const std::string &s) {
+    if (s.empty()) {
+        return;
+    }
+    ostream << s;
+    line_start = (*s.rbegin() == '\n');
+}
+
 void yamlstream::indent_if() {
     // if endl
-    if (!strcmp(&*sstream.str().rbegin(), "\n")) {
+    if (line_start) {
         (*this)[level];
     }
 }
 
 void yamlstream::endl_if() {
     // if _not_ endl
-    if (strcmp(&*sstream.str().rbegin(), "\n")) {
-        sstream << "\n";
+    if (!line_start) {
+        put("\n");
     }
 }
 
@@ -57,7 +65,7 @@ std::string yamlstream::item() {
 }
 
 yamlstream& yamlstream::operator++() {
-    sstream << sequ_start;
+    put(sequ_start);
     level++;
     return *this;
 }
@@ -82,9 +90,12 @@ yamlstream yamlstream::operator--(int) {
 
 yamlstream& yamlstream::operator[](const size_t n_indent) {
     endl_if();
+    std::string indent;
     for (size_t i = 0; i < n_indent; i++) {
-        sstream << indent_str;
+        indent += indent_str;
     }
+    ostream << indent;
+    line_start = (n_indent == 0);
     return *this;
 }
 
@@ -109,8 +120,8 @@ std::string yamlstream::t(const time_t &tm) {
     return std::string(tbuff);
 }
 
-std::string yamlstream::str() {
-    return sstream.str();
+void yamlstream::flush() {
+    ostream.flush();
 }
 
 yamlstream& yamlstream::operator<<(const nix::NDSize &t)
@@ -501,6 +512,89 @@ yamlstream& yamlstream::operator<<(const nix::File &file) {
 }
 
 
+namespace {
+
+// upper bound for the number of elements read into memory at once
+const size_t SLAB_ELEMENTS = 1 << 20;
+
+/**
+ * @brief parse a slice string like "10:20,:5" into offset & count
+ *
+ * Every comma separated item is a half open range "start:stop" of one
+ * dimension, either bound may be omitted. Items for trailing dimensions
+ * may be omitted as well. Ranges are clipped to the extent.
+ */
+void parseSlice(const std::string &slice, const nix::NDSize &extent,
+                nix::NDSize &offset, nix::NDSize &count) {
+    offset = nix::NDSize(extent.size(), 0);
+    count = extent;
+
+    std::stringstream items(slice);
+    std::string item;
+    size_t dim = 0;
+    while (std::getline(items, item, ',')) {
+        if (dim >= extent.size()) {
+            throw InvalidOptionValue(SLICE_OPTION, slice + " (too many dimensions)");
+        }
+        size_t colon = item.find(':');
+        std::string first = item.substr(0, colon);
+        std::string last = colon == std::string::npos ? "" : item.substr(colon + 1);
+        nix::ndsize_t start = 0, stop = extent[dim];
+        try {
+            if (!first.empty()) start = static_cast<nix::ndsize_t>(std::stoull(first));
+            if (!last.empty()) stop = static_cast<nix::ndsize_t>(std::stoull(last));
+            else if (colon == std::string::npos) stop = start + 1;
+        } catch (const std::logic_error &) {
+            throw InvalidOptionValue(SLICE_OPTION, slice);
+        }
+        stop = std::min(stop, extent[dim]);
+        start = std::min(start, stop);
+        offset[dim] = start;
+        count[dim] = stop - start;
+        dim++;
+    }
+}
+
+} // namespace
+
+
+void Dump::dumpData(const nix::DataArray &data_array, const std::string &file_name,
+                    const nix::NDSize &offset, const nix::NDSize &count,
+                    double &vmin, double &vmax) const {
+    std::ofstream fout(file_name);
+    const nix::ndsize_t rows = count[0];
+    const nix::ndsize_t cols = count[1];
+    vmin = std::numeric_limits<double>::max();
+    vmax = std::numeric_limits<double>::lowest();
+
+    if (rows == 0 || cols == 0) {
+        return;
+    }
+
+    // read whole rows only: in the row-major data layout every slab is
+    // then a single contiguous block of the selection
+    const nix::ndsize_t slab_rows = std::max<nix::ndsize_t>(1, SLAB_ELEMENTS / cols);
+    std::vector<double> slab;
+
+    for (nix::ndsize_t row = 0; row < rows; row += slab_rows) {
+        nix::ndsize_t n = std::min(slab_rows, rows - row);
+        slab.resize(static_cast<size_t>(n * cols));
+        data_array.getData(nix::DataType::Double, slab.data(), {n, cols}, {offset[0] + row, offset[1]});
+
+        std::ostringstream buf;
+        for (nix::ndsize_t i = 0; i < n; i++) {
+            for (nix::ndsize_t j = 0; j < cols; j++) {
+                double val = slab[static_cast<size_t>(i * cols + j)];
+                buf << val << ((j != cols-1) ? " " : "");
+                if (val < vmin) vmin = val;
+                if (val > vmax) vmax = val;
+            }
+            buf << ((row + i != rows-1) ? "\n" : "");
+        }
+        fout << buf.str();
+    }
+}
+
 void Dump::load(po::options_description &desc) const {
     // declare purpose
     desc.add(po::options_description("nix-tool " + std::string(module_name) + ":\n\n\t" + 
@@ -510,27 +604,25 @@ void Dump::load(po::options_description &desc) const {
     opt.add_options()
         (DATA_OPTION, "dump data from all 2D DataArrays")
         (PLOT_OPTION, ("dump & plot (only) data from all 2D DataArrays (linux only, invokes --" + std::string(DATA_OPTION) + ")").c_str())
+        (MAXELEM_OPTION, po::value<size_t>(), "dump at most this many elements per DataArray (whole rows, if possible)")
+        (SLICE_OPTION, po::value<std::string>(), "dump only the given rows & columns, e.g. \"100:200,:10\"")
     ;
     desc.add(opt);
 }
 
 std::string Dump::call(const po::variables_map &vm, const po::options_description &desc) {
     std::vector<nix::File> files; // opened nix files
-    std::stringstream out;
-    std::ofstream fout;
+    std::stringstream help;
     nix::File tmp_file;
     std::string file_name;
-    double A_min = std::numeric_limits<double>::max();
-    double A_max = std::numeric_limits<double>::min();
-    typedef boost::multi_array<double, 2> array_type;
-    typedef array_type::index index;
+    double A_min, A_max;
     
     // --help
     if (vm.count(HELP_OPTION)) {
         po::options_description temp;
         load(temp);
-        out << temp << std::endl;
-        return out.str();
+        help << temp << std::endl;
+        return help.str();
     }
     // --input-file
     if (vm.count(INPFILE_OPTION)) {
@@ -553,7 +645,7 @@ std::string Dump::call(const po::variables_map &vm, const po::options_descriptio
         for (auto &file : files) {
             if ( ! (vm.count(DATA_OPTION) || vm.count(PLOT_OPTION)) ) {
                 yaml << file;
-                out << yaml.str();
+                yaml.flush();
             }
             else {
                 // loop through all data_arrays
@@ -562,30 +654,30 @@ std::string Dump::call(const po::variables_map &vm, const po::options_descriptio
                     auto data_arrays = block.dataArrays();
                     for (auto &data_array : data_arrays) {
                         // if we have a 2D data_array, output data & plot script
-                        if (data_array.dataExtent().size() == 2) {
-                            file_name = "data_array_" + data_array.id();
-                            fout.open(file_name + ".txt");
-                            index dim1 = static_cast<index>(data_array.dataExtent()[0]);
-                            index dim2 = static_cast<index>(data_array.dataExtent()[1]);
-                            array_type A(boost::extents[ dim1 ]
-                                                       [ dim2 ]);
-                            data_array.getData(A);
-                            // loop through data_array values
-                            for (index i = 0; i < dim1; i++) {
-                                for (index j = 0; j < dim2; j++) {
-                                    fout << A[i][j] << ((j != dim2-1) ? " " : "");
-                                    if (A[i][j] < A_min) A_min = A[i][j];
-                                    if (A[i][j] > A_max) A_max = A[i][j];
+                        nix::NDSize extent = data_array.dataExtent();
+                        if (extent.size() == 2) {
+                            nix::NDSize offset, count;
+                            parseSlice(vm.count(SLICE_OPTION) ? vm[SLICE_OPTION].as<std::string>() : "",
+                                       extent, offset, count);
+                            if (vm.count(MAXELEM_OPTION)) {
+                                nix::ndsize_t max_elem = vm[MAXELEM_OPTION].as<size_t>();
+                                if (count[1] > max_elem) {
+                                    count[1] = max_elem;
+                                }
+                                if (count[1] > 0) {
+                                    count[0] = std::min(count[0], std::max<nix::ndsize_t>(1, max_elem / count[1]));
                                 }
-                                fout << ((i != dim1-1) ? "\n" : "");
                             }
-                            fout.close();
+                            file_name = "data_array_" + data_array.id();
+                            dumpData(data_array, file_name + ".txt", offset, count, A_min, A_max);
+                            size_t dim1 = static_cast<size_t>(count[0]);
+                            size_t dim2 = static_cast<size_t>(count[1]);
 
                             #ifndef _WIN32
-                            if (vm.count(PLOT_OPTION)) {
+                            if (vm.count(PLOT_OPTION) && dim1 > 0 && dim2 > 0) {
                                 std::cout << "press ctrl+c for next plot" << std::endl;
-                                plot_script script(A_min, A_max, static_cast<size_t>(dim1), static_cast<size_t>(dim2), file_name + ".txt");
-                                fout.open(file_name + ".gnu");
+                                plot_script script(A_min, A_max, dim1, dim2, file_name + ".txt");
+                                std::ofstream fout(file_name + ".gnu");
                                 fout << script.str();
                                 fout.close();
                                 std::system(("chmod 755 " + file_name + ".gnu").c_str());
@@ -602,7 +694,8 @@ std::string Dump::call(const po::variables_map &vm, const po::options_descriptio
         throw NoInputFile();
     }
     
-    return out.str();
+    // everything has been written to the output stream already
+    return std::string();
 }
 
 } // namespace module
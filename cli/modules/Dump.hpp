@@ -22,6 +22,7 @@
 #include <modules/IModule.hpp>
 
 #include <string>
+#include <sstream>
 #include <fstream>
 #include <iostream>
 #include <cstdlib>
@@ -36,6 +37,8 @@ namespace module {
 
 const char *const DATA_OPTION = "data";
 const char *const PLOT_OPTION = "plot";
+const char *const MAXELEM_OPTION = "max-elements";
+const char *const SLICE_OPTION = "slice";
 
 class plot_script {
 private:
@@ -101,21 +104,33 @@ class yamlstream {
     static const char* item_str;
     
     size_t level;
-    std::stringstream &sstream;
-    
+    std::ostream &ostream;
+    bool line_start;
+
+    /**
+     * @brief write string to ostream & remember if it ended a line
+     *
+     * Write the given string to the underlying ostream and keep track of
+     * whether the last char written was "\n", so that the output never
+     * has to be read back.
+     *
+     * @return void
+     */
+    void put(const std::string &s);
+
     /**
-     * @brief apply indentation on sstream if last char is "\n"
+     * @brief apply indentation on ostream if last char is "\n"
      *
-     * Apply indentation on sstream if last char is "\n"
+     * Apply indentation on ostream if last char is "\n"
      *
      * @return void
      */
     void indent_if();
     
     /**
-     * @brief apply indentation on sstream if last char is "\n"
+     * @brief put "\n" into ostream if last char is not "\n"
      *
-     * Apply indentation on sstream if last char is "\n"
+     * Put "\n" into ostream if last char is not "\n"
      *
      * @return void
      */
@@ -193,23 +208,24 @@ public:
     /**
      * @brief default ctor
      *
-     * The default constructor.
+     * The default constructor. All output is written to the given
+     * ostream as soon as it is produced.
      */
-    yamlstream(std::stringstream &sstream) : level(0), sstream(sstream) {};
+    yamlstream(std::ostream &ostream) : level(0), ostream(ostream), line_start(true) {};
 
     /**
-     * @brief return stringstream as string
+     * @brief flush the underlying ostream
      *
-     * Return string from stringstream
+     * Flush the underlying ostream.
      *
-     * @return string string content of the stream
+     * @return void
      */
-    std::string str();
+    void flush();
 
     /**
-     * @brief default output into stringstream
+     * @brief default output into ostream
      *
-     * Use the default stringstream output.
+     * Use the default ostream output.
      *
      * @param t parameter of any given type T
      * @return self
@@ -217,12 +233,14 @@ public:
     template<typename T>
     yamlstream& operator<<(const T &t) {
         indent_if();
-        sstream << t;
+        std::ostringstream tmp;
+        tmp << t;
+        put(tmp.str());
         return *this;
     }
     
     /**
-     * @brief vector output into stringstream
+     * @brief vector output into ostream
      *
      * Output vector elements in inline yaml sequence style.
      *
@@ -233,17 +251,19 @@ public:
     yamlstream& operator<<(const std::vector<T> &t) {
         indent_if();
         if (t.size()) {
-            sstream << "[";
+            std::ostringstream tmp;
+            tmp << "[";
             for (auto &el : t) {
-                sstream << el << ((*t.rbegin()) != el ? ", " : "");            
+                tmp << el << ((*t.rbegin()) != el ? ", " : "");
             }
-            sstream << "]";
+            tmp << "]";
+            put(tmp.str());
         }
         return *this;
     }
     
     /**
-     * @brief NDSize output into stringstream
+     * @brief NDSize output into ostream
      *
      * Build vector of sizes and output them as vector.
      *
@@ -253,7 +273,7 @@ public:
     yamlstream& operator<<(const nix::NDSize &t);
     
     /**
-     * @brief boost::optional output into stringstream
+     * @brief boost::optional output into ostream
      *
      * De-referene boost::optional if and only if it is set and output
      * content (or empty string if not set) to stream.
@@ -263,31 +283,14 @@ public:
      */
     template<typename T>
     yamlstream& operator<<(const boost::optional<T> &t) {
-        indent_if();
         auto opt = nix::util::deRef(t);
-        sstream << opt;
-        return *this;
+        return (*this) << opt;
     }
     
     /**
-     * @brief pointer to stringstream output into stringstream
-     *
-     * Output via pointer to stringstream.
-     *
-     * @param ps pointer to stringstream
-     * @return self
-     */
-	yamlstream& operator<<(std::stringstream& (*ps)(std::stringstream&))
-	{
-        indent_if();
-		sstream << ps;
-		return *this;
-	}
-    
-    /**
-     * @brief Entity output into stringstream
+     * @brief Entity output into ostream
      *
-     * Output base Entity to stringstream.
+     * Output base Entity to ostream.
      *
      * @param entity nix base Entity
      * @return self
@@ -303,9 +306,9 @@ public:
     }
 
     /**
-     * @brief NamedEntity output into stringstream
+     * @brief NamedEntity output into ostream
      *
-     * Output base NamedEntity to stringstream.
+     * Output base NamedEntity to ostream.
      *
      * @param entity nix base NamedEntity
      * @return self
@@ -322,9 +325,9 @@ public:
     }
 
     /**
-     * @brief EntityWithMetadata output into stringstream
+     * @brief EntityWithMetadata output into ostream
      *
-     * Output base EntityWithMetadata to stringstream.
+     * Output base EntityWithMetadata to ostream.
      *
      * @param entity nix base EntityWithMetadata
      * @return self
@@ -339,9 +342,9 @@ public:
     }
     
     /**
-     * @brief EntityWithSources output into stringstream
+     * @brief EntityWithSources output into ostream
      *
-     * Output base EntityWithSources to stringstream.
+     * Output base EntityWithSources to ostream.
      *
      * @param entity nix base EntityWithSources
      * @return self
@@ -357,9 +360,9 @@ public:
     }
 
     /**
-     * @brief Value output into stringstream
+     * @brief Value output into ostream
      *
-     * Output Value to stringstream.
+     * Output Value to ostream.
      *
      * @param entity nix value
      * @return self
@@ -367,9 +370,9 @@ public:
     yamlstream& operator<<(const nix::Value &value);
 
     /**
-     * @brief Property output into stringstream
+     * @brief Property output into ostream
      *
-     * Output Property to stringstream.
+     * Output Property to ostream.
      *
      * @param entity nix Property
      * @return self
@@ -377,9 +380,9 @@ public:
     yamlstream& operator<<(const nix::Property &property);
     
     /**
-     * @brief Source output into stringstream
+     * @brief Source output into ostream
      *
-     * Output Source to stringstream.
+     * Output Source to ostream.
      *
      * @param entity nix Source
      * @return self
@@ -387,9 +390,9 @@ public:
     yamlstream& operator<<(const nix::Source &source);
     
     /**
-     * @brief Section output into stringstream
+     * @brief Section output into ostream
      *
-     * Output Section to stringstream.
+     * Output Section to ostream.
      *
      * @param entity nix Section
      * @return self
@@ -397,9 +400,9 @@ public:
     yamlstream& operator<<(const nix::Section &section);
 
     /**
-     * @brief SetDimension output into stringstream
+     * @brief SetDimension output into ostream
      *
-     * Output SetDimension to stringstream.
+     * Output SetDimension to ostream.
      *
      * @param entity nix SetDimension
      * @return self
@@ -407,9 +410,9 @@ public:
     yamlstream& operator<<(const nix::SetDimension &dim);
 
     /**
-     * @brief SampledDimension output into stringstream
+     * @brief SampledDimension output into ostream
      *
-     * Output SampledDimension to stringstream.
+     * Output SampledDimension to ostream.
      *
      * @param entity nix SampledDimension
      * @return self
@@ -417,9 +420,9 @@ public:
     yamlstream& operator<<(const nix::SampledDimension &dim);
 
     /**
-     * @brief RangeDimension output into stringstream
+     * @brief RangeDimension output into ostream
      *
-     * Output RangeDimension to stringstream.
+     * Output RangeDimension to ostream.
      *
      * @param entity nix RangeDimension
      * @return self
@@ -427,9 +430,9 @@ public:
     yamlstream& operator<<(const nix::RangeDimension &dim);
 
     /**
-     * @brief Dimension output into stringstream
+     * @brief Dimension output into ostream
      *
-     * Output Dimension to stringstream.
+     * Output Dimension to ostream.
      *
      * @param entity nix Dimension
      * @return self
@@ -437,9 +440,9 @@ public:
     yamlstream& operator<<(const nix::Dimension &dim);
 
     /**
-     * @brief DataArray output into stringstream
+     * @brief DataArray output into ostream
      *
-     * Output DataArray to stringstream.
+     * Output DataArray to ostream.
      *
      * @param entity nix DataArray
      * @return self
@@ -447,9 +450,9 @@ public:
     yamlstream& operator<<(const nix::DataArray &data_array);
 
     /**
-     * @brief Feature output into stringstream
+     * @brief Feature output into ostream
      *
-     * Output Feature to stringstream.
+     * Output Feature to ostream.
      *
      * @param entity nix Feature
      * @return self
@@ -457,9 +460,9 @@ public:
     yamlstream& operator<<(const nix::Feature &feature);
 
     /**
-     * @brief Tag output into stringstream
+     * @brief Tag output into ostream
      *
-     * Output Tag to stringstream.
+     * Output Tag to ostream.
      *
      * @param entity nix Tag
      * @return self
@@ -467,9 +470,9 @@ public:
     yamlstream& operator<<(const nix::Tag &tag);
 
     /**
-     * @brief MultiTag output into stringstream
+     * @brief MultiTag output into ostream
      *
-     * Output MultiTag to stringstream.
+     * Output MultiTag to ostream.
      *
      * @param entity nix MultiTag
      * @return self
@@ -477,9 +480,9 @@ public:
     yamlstream& operator<<(const nix::MultiTag &multi_tag);
 
     /**
-     * @brief Block output into stringstream
+     * @brief Block output into ostream
      *
-     * Output Block to stringstream.
+     * Output Block to ostream.
      *
      * @param entity nix Block
      * @return self
@@ -487,9 +490,9 @@ public:
     yamlstream& operator<<(const nix::Block &block);
 
     /**
-     * @brief File output into stringstream
+     * @brief File output into ostream
      *
-     * Output File to stringstream.
+     * Output File to ostream.
      *
      * @param entity nix File
      * @return self
@@ -500,11 +503,37 @@ public:
 
 class Dump : virtual public IModule {
     
+    std::ostream &out;
     yamlstream yaml;
-    std::stringstream sstream;
-    
+
+    /**
+     * @brief write the data of a 2D DataArray to a text file
+     *
+     * Read the data in slabs of whole rows and append every slab to the
+     * file right away, so that only a bounded number of elements is held
+     * in memory at any time. Only the part of the data selected by offset
+     * and count is written.
+     *
+     * @param data_array the DataArray to write
+     * @param file_name path of the text file
+     * @param offset first row & column to write
+     * @param count number of rows & columns to write
+     * @param vmin set to the smallest value written
+     * @param vmax set to the largest value written
+     * @return void
+     */
+    void dumpData(const nix::DataArray &data_array, const std::string &file_name,
+                  const nix::NDSize &offset, const nix::NDSize &count,
+                  double &vmin, double &vmax) const;
+
 public:
-    Dump() : yaml(yamlstream(sstream)) {}
+    /**
+     * @brief default ctor
+     *
+     * All yaml output is written to the given ostream while the
+     * entities are visited, i.e. it is not buffered until the end.
+     */
+    Dump(std::ostream &out = std::cout) : out(out), yaml(out) {}
 
     static const char* module_name;
 
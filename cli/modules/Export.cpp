@@ -0,0 +1,192 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <Cli.hpp>
+#include <modules/Export.hpp>
+#include <modules/DataFile.hpp>
+#include <nix/DataArrayReader.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+namespace po = boost::program_options;
+
+namespace cli {
+namespace module {
+
+const char* Export::module_name = "export";
+
+// upper bound for the size of the slabs that are read at once
+static const size_t SLAB_BYTES = 16 << 20;
+
+void Export::load(po::options_description &desc) const {
+    desc.add(po::options_description("nix-tool " + std::string(module_name) + ":\n\n\t" +
+                                     "Writes the data of a DataArray to a .npy or raw binary file.\n\t" +
+                                     "Calibrated data (polynomial or expansion origin) is written as Double.\n\nSupported options"));
+    po::options_description opt;
+    opt.add_options()
+        (BLOCK_OPTION, po::value<std::string>(), "name or id of the block")
+        (ARRAY_OPTION, po::value<std::string>(), "name or id of the DataArray")
+        (DATAFILE_OPTION, po::value<std::string>(), "the file to write")
+        (FORMAT_OPTION, po::value<std::string>(), "\"npy\" or \"raw\" (little-endian values without header); "
+                                                  "by default npy for files ending in .npy")
+    ;
+    desc.add(opt);
+}
+
+std::string Export::call(const po::variables_map &vm, const po::options_description &desc) {
+    std::stringstream out;
+
+    // --help
+    if (vm.count(HELP_OPTION)) {
+        po::options_description temp;
+        load(temp);
+        out << temp << std::endl;
+        return out.str();
+    }
+    if (!vm.count(INPFILE_OPTION)) {
+        throw NoInputFile();
+    }
+    for (const char *option : {BLOCK_OPTION, ARRAY_OPTION, DATAFILE_OPTION}) {
+        if (!vm.count(option)) {
+            throw std::invalid_argument(std::string("Option --") + option + " is required");
+        }
+    }
+
+    const std::string file_path = vm[INPFILE_OPTION].as< std::vector<std::string> >().front();
+    if (!boost::filesystem::exists(file_path)) {
+        throw FileNotFound(file_path);
+    }
+    nix::File file = nix::File::open(file_path, nix::FileMode::ReadOnly);
+    if (!file.isOpen()) {
+        throw FileNotOpen(file_path);
+    }
+
+    const std::string block_name = vm[BLOCK_OPTION].as<std::string>();
+    const std::string array_name = vm[ARRAY_OPTION].as<std::string>();
+    nix::Block block = file.getBlock(block_name);
+    if (!block) {
+        throw InvalidOptionValue(BLOCK_OPTION, block_name);
+    }
+    nix::DataArray array = block.getDataArray(array_name);
+    if (!array) {
+        throw InvalidOptionValue(ARRAY_OPTION, array_name);
+    }
+
+    DataFileLayout layout;
+    layout.dtype = array.dataType();
+    if (!array.polynomCoefficients().empty() || array.expansionOrigin()) {
+        layout.dtype = nix::DataType::Double;
+    }
+    if (!is_numeric_type(layout.dtype)) {
+        throw std::invalid_argument("Data of type " + nix::data_type_to_string(layout.dtype) + " cannot be exported");
+    }
+    layout.shape = array.dataExtent();
+    layout.big_endian = host_big_endian();
+
+    const std::string data_path = vm[DATAFILE_OPTION].as<std::string>();
+    const bool npy = is_npy_file(data_path, vm.count(FORMAT_OPTION) ? vm[FORMAT_OPTION].as<std::string>() : "");
+
+    std::ofstream data_file(data_path, std::ios::binary | std::ios::trunc);
+    if (!data_file) {
+        throw std::runtime_error("Could not open '" + data_path + "' for writing");
+    }
+    if (npy) {
+        data_file << npy_header(layout);
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    const size_t esize = nix::data_type_to_size(layout.dtype);
+    const bool swap = !npy && layout.big_endian;
+    size_t bytes = 0;
+
+    std::vector<char> swapped;
+    auto write_slabs = [&](nix::DataArrayReader &reader) {
+        nix::DataArrayReader::Slab s;
+        while (reader.next(s)) {
+            const size_t n = s.count().nelms();
+            const char *data = static_cast<const char *>(s.data());
+            if (swap) {
+                swapped.assign(data, data + n * esize);
+                swap_bytes(swapped.data(), n, esize);
+                data = swapped.data();
+            }
+            data_file.write(data, n * esize);
+            bytes += n * esize;
+        }
+    };
+
+    const nix::NDSize &shape = layout.shape;
+    const nix::ndsize_t budget = std::max<nix::ndsize_t>(SLAB_BYTES / esize, 1);
+    const nix::ndsize_t row_elms = shape.size() > 0 && shape[0] > 0 ? shape.nelms() / shape[0] : 0;
+
+    if (row_elms > 0 && row_elms <= budget) {
+        // whole rows along the first axis, in rows of chunks if they fit,
+        // read ahead in the background
+        const nix::NDSize chunks = array.chunkExtent();
+        const nix::ndsize_t chunk_rows = chunks.size() > 0 ? chunks[0] : 1;
+        nix::ndsize_t rows = budget / row_elms;
+        if (chunk_rows <= rows) {
+            rows = rows / chunk_rows * chunk_rows;
+        }
+        nix::NDSize slab = shape;
+        slab[0] = std::min(rows, shape[0]);
+
+        nix::DataArrayReader reader(array, layout.dtype, slab, 0);
+        write_slabs(reader);
+    } else if (row_elms > 0) {
+        // rows larger than a slab: the trailing axes that fit into a slab are
+        // read whole, the axis before them in pieces, all axes in front of it
+        // one index at a time; every line of pieces is read ahead
+        size_t split = shape.size() - 1;
+        nix::ndsize_t trailing = 1;
+        while (trailing * shape[split] <= budget) {
+            trailing *= shape[split--];
+        }
+
+        nix::NDSize slab = shape, line(shape.size(), 0);
+        for (size_t i = 0; i < split; i++) {
+            slab[i] = 1;
+        }
+        slab[split] = std::min(std::max<nix::ndsize_t>(budget / trailing, 1), shape[split]);
+
+        while (line[0] < shape[0]) {
+            nix::DataArrayReader reader(array, layout.dtype, slab, split, 0, 4, line);
+            write_slabs(reader);
+
+            // next line, in storage order
+            size_t i = split - 1;
+            line[i]++;
+            while (i > 0 && line[i] == shape[i]) {
+                line[i] = 0;
+                line[--i]++;
+            }
+        }
+    }
+
+    data_file.close();
+    if (!data_file) {
+        throw std::runtime_error("Could not write '" + data_path + "'");
+    }
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    out << "exported " << array.name() << " " << format_shape(layout.shape) << " " << nix::data_type_to_string(layout.dtype)
+        << " to " << data_path << ": " << bytes << " bytes in " << seconds << " s";
+    if (seconds > 0) {
+        out << " (" << bytes / seconds / (1 << 20) << " MB/s)";
+    }
+    out << std::endl;
+    return out.str();
+}
+
+} // namespace module
+} // namespace cli
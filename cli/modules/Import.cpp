@@ -0,0 +1,366 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <Cli.hpp>
+#include <modules/Import.hpp>
+#include <modules/DataFile.hpp>
+#include <nix/util/copy.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#include <boost/filesystem.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/program_options.hpp>
+namespace po = boost::program_options;
+
+namespace cli {
+namespace module {
+
+const char* Import::module_name = "import";
+
+const char *const DTYPE_OPTION = "dtype";
+const char *const SHAPE_OPTION = "shape";
+const char *const TYPE_OPTION = "type";
+
+// size of the slabs of data that is not stored in chunks
+static const size_t SLAB_BYTES = 16 << 20;
+
+namespace {
+
+/*
+ * Copies tiles of the data file into buffers of the tile shape. Tiles are
+ * numbered in row-major order of the tile grid; tiles at the end of the
+ * data are padded with zeros if padded is set and cut otherwise.
+ */
+class TileGatherer {
+
+public:
+
+    TileGatherer(const char *values, const DataFileLayout &layout, const nix::NDSize &tile, bool padded, bool swap)
+        : values(values), shape(layout.shape), tile(tile), grid(shape.size()),
+          esize(nix::data_type_to_size(layout.dtype)), padded(padded), swap(swap)
+    {
+        for (size_t i = 0; i < shape.size(); i++) {
+            grid[i] = (shape[i] + tile[i] - 1) / tile[i];
+        }
+    }
+
+    nix::ndsize_t count() const {
+        return grid.nelms();
+    }
+
+    // the position of a tile in the grid
+    nix::NDSize coordinates(nix::ndsize_t index) const {
+        nix::NDSize coord(grid.size());
+        for (size_t i = grid.size(); i-- > 0;) {
+            coord[i] = index % grid[i];
+            index /= grid[i];
+        }
+        return coord;
+    }
+
+    void gather(nix::ndsize_t index, std::vector<char> &buffer, nix::NDSize &offset, nix::NDSize &count) const {
+        const size_t rank = shape.size();
+        offset = coordinates(index) * tile;
+        count = nix::NDSize(rank);
+        for (size_t i = 0; i < rank; i++) {
+            count[i] = std::min(tile[i], shape[i] - offset[i]);
+        }
+        const nix::NDSize layout = padded ? tile : count;
+        const size_t row = static_cast<size_t>(count[rank - 1]) * esize;
+
+        if (padded && layout != count) {
+            buffer.assign(layout.nelms() * esize, 0);
+        } else {
+            buffer.resize(layout.nelms() * esize);
+        }
+
+        // copy row by row, the rows run along the last dimension
+        const nix::ndsize_t rows = count.nelms() / count[rank - 1];
+        nix::NDSize pos(rank, 0);
+        for (nix::ndsize_t r = 0; r < rows; r++) {
+            nix::ndsize_t src = 0, dst = 0;
+            for (size_t i = 0; i < rank; i++) {
+                src = src * shape[i] + offset[i] + pos[i];
+                dst = dst * layout[i] + pos[i];
+            }
+            char *target = buffer.data() + dst * esize;
+            std::memcpy(target, values + src * esize, row);
+            if (swap) {
+                swap_bytes(target, row / esize, esize);
+            }
+            // next row
+            for (size_t i = rank - 1; i-- > 0;) {
+                if (++pos[i] < count[i]) {
+                    break;
+                }
+                pos[i] = 0;
+            }
+        }
+    }
+
+private:
+
+    const char *values;
+    nix::NDSize shape, tile, grid;
+    size_t esize;
+    bool padded, swap;
+};
+
+} // anonymous namespace
+
+
+void Import::load(po::options_description &desc) const {
+    desc.add(po::options_description("nix-tool " + std::string(module_name) + ":\n\n\t" +
+                                     "Stores the values of a .npy or raw binary file in a new DataArray.\n\t" +
+                                     "The nix file is created if it does not exist, the block if it is missing.\n\nSupported options"));
+    po::options_description opt;
+    opt.add_options()
+        (BLOCK_OPTION, po::value<std::string>(), "name or id of the block")
+        (ARRAY_OPTION, po::value<std::string>(), "name of the new DataArray")
+        (TYPE_OPTION, po::value<std::string>()->default_value("nix.import"), "type of the new DataArray (and block)")
+        (DATAFILE_OPTION, po::value<std::string>(), "the file to read")
+        (FORMAT_OPTION, po::value<std::string>(), "\"npy\" or \"raw\" (little-endian values without header); "
+                                                  "by default npy for files ending in .npy")
+        (DTYPE_OPTION, po::value<std::string>(), "data type of raw files, e.g. \"Int16\" or \"Double\"")
+        (SHAPE_OPTION, po::value<std::string>(), "shape of raw files, e.g. \"1000,4\"; by default one-dimensional")
+        (COMPRESSION_OPTION, po::value<unsigned>()->default_value(0), "deflate level from 1 to 9, 0 to store the data uncompressed")
+        (SHUFFLE_OPTION, "shuffle the bytes of the values before compressing them")
+        (JOBS_OPTION, po::value<size_t>(), "number of threads that prepare chunks, by default one per core")
+    ;
+    desc.add(opt);
+}
+
+std::string Import::call(const po::variables_map &vm, const po::options_description &desc) {
+    namespace ipc = boost::interprocess;
+    std::stringstream out;
+
+    // --help
+    if (vm.count(HELP_OPTION)) {
+        po::options_description temp;
+        load(temp);
+        out << temp << std::endl;
+        return out.str();
+    }
+    if (!vm.count(INPFILE_OPTION)) {
+        throw NoInputFile();
+    }
+    for (const char *option : {BLOCK_OPTION, ARRAY_OPTION, DATAFILE_OPTION}) {
+        if (!vm.count(option)) {
+            throw std::invalid_argument(std::string("Option --") + option + " is required");
+        }
+    }
+    const unsigned compression = vm[COMPRESSION_OPTION].as<unsigned>();
+    if (compression > 9) {
+        throw InvalidOptionValue(COMPRESSION_OPTION, nix::util::numToStr(compression));
+    }
+    const bool shuffle = vm.count(SHUFFLE_OPTION) > 0;
+
+    // map the data file and find its layout
+    const std::string data_path = vm[DATAFILE_OPTION].as<std::string>();
+    if (!boost::filesystem::exists(data_path)) {
+        throw FileNotFound(data_path);
+    }
+    const size_t file_size = static_cast<size_t>(boost::filesystem::file_size(data_path));
+    ipc::file_mapping mapping;
+    ipc::mapped_region region;
+    const char *mapped = nullptr;
+    if (file_size > 0) {
+        mapping = ipc::file_mapping(data_path.c_str(), ipc::read_only);
+        region = ipc::mapped_region(mapping, ipc::read_only);
+        region.advise(ipc::mapped_region::advice_sequential);
+        mapped = static_cast<const char *>(region.get_address());
+    }
+
+    DataFileLayout layout;
+    if (is_npy_file(data_path, vm.count(FORMAT_OPTION) ? vm[FORMAT_OPTION].as<std::string>() : "")) {
+        layout = parse_npy_header(mapped, file_size);
+    } else {
+        if (!vm.count(DTYPE_OPTION)) {
+            throw std::invalid_argument(std::string("Option --") + DTYPE_OPTION + " is required for raw files");
+        }
+        const std::string dtype = vm[DTYPE_OPTION].as<std::string>();
+        layout.dtype = parse_data_type(dtype);
+        if (layout.dtype == nix::DataType::Nothing) {
+            throw InvalidOptionValue(DTYPE_OPTION, dtype);
+        }
+        if (vm.count(SHAPE_OPTION)) {
+            layout.shape = parse_shape(vm[SHAPE_OPTION].as<std::string>());
+        } else {
+            layout.shape = nix::NDSize({static_cast<nix::ndsize_t>(file_size / nix::data_type_to_size(layout.dtype))});
+        }
+    }
+    if (layout.shape.size() == 0) {
+        throw std::invalid_argument("Scalars cannot be imported, the data needs at least one dimension");
+    }
+    const size_t esize = nix::data_type_to_size(layout.dtype);
+    const size_t bytes = static_cast<size_t>(layout.shape.nelms()) * esize;
+    if (file_size < layout.data_offset + bytes) {
+        throw std::invalid_argument("'" + data_path + "' is too small for " +
+                                    nix::util::numToStr(layout.shape.nelms()) + " values");
+    }
+
+    // the target
+    const std::string file_path = vm[INPFILE_OPTION].as< std::vector<std::string> >().front();
+    nix::File file = nix::File::open(file_path, boost::filesystem::exists(file_path) ?
+                                                nix::FileMode::ReadWrite : nix::FileMode::Overwrite);
+    if (!file.isOpen()) {
+        throw FileNotOpen(file_path);
+    }
+    const std::string type = vm[TYPE_OPTION].as<std::string>();
+    const std::string block_name = vm[BLOCK_OPTION].as<std::string>();
+    nix::Block block = file.getBlock(block_name);
+    if (!block) {
+        block = file.createBlock(block_name, type);
+    }
+    const std::string array_name = vm[ARRAY_OPTION].as<std::string>();
+    if (block.hasDataArray(array_name)) {
+        throw std::invalid_argument("DataArray '" + array_name + "' exists already");
+    }
+    const bool filtered = compression > 0 || shuffle;
+    nix::DataArray array = filtered ?
+                           nix::util::createCompressedDataArray(block, array_name, type, layout.dtype, layout.shape,
+                                                                compression, shuffle) :
+                           block.createDataArray(array_name, type, layout.dtype, layout.shape);
+
+    /*
+     * Chunked data is written chunk by chunk, bypassing the type conversion
+     * and the chunk cache; the chunks are gathered from the mapped file in
+     * little-endian order and filtered by the workers, like in copyFile.
+     * Other data, and chunks that cannot be written directly, are written in
+     * slabs through setData, in the byte order of the host; the HDF5 library
+     * runs the filters then.
+     */
+    const nix::NDSize chunks = array.chunkExtent();
+    const bool direct = chunks.size() == layout.shape.size() && layout.dtype != nix::DataType::Bool &&
+                        nix::util::canWriteChunks(compression);
+    nix::NDSize tile = direct ? chunks : layout.shape;
+    if (!direct) {
+        const nix::ndsize_t row_bytes = layout.shape.nelms() / std::max<nix::ndsize_t>(layout.shape[0], 1) * esize;
+        tile[0] = std::max<nix::ndsize_t>(SLAB_BYTES / std::max<nix::ndsize_t>(row_bytes, 1), 1);
+        // whole rows of chunks, so the filters run once for every chunk
+        if (chunks.size() == layout.shape.size() && chunks[0] > 0) {
+            tile[0] = std::max<nix::ndsize_t>(tile[0] / chunks[0], 1) * chunks[0];
+        }
+    }
+    for (size_t i = 0; i < tile.size(); i++) {
+        tile[i] = std::max<nix::ndsize_t>(tile[i], 1);
+    }
+    const bool swap = esize > 1 && layout.big_endian != (direct ? false : host_big_endian());
+    const TileGatherer gatherer(mapped + layout.data_offset, layout, tile, direct, swap);
+    const nix::ndsize_t total = layout.shape.nelms() > 0 ? gatherer.count() : 0;
+
+    size_t jobs = vm.count(JOBS_OPTION) ? vm[JOBS_OPTION].as<size_t>() : std::thread::hardware_concurrency();
+    jobs = std::max<size_t>(std::min<nix::ndsize_t>(jobs, total), 1);
+
+    // workers fill a ring of tiles, this thread writes them in order
+    struct Slot {
+        std::vector<char> data;
+        nix::NDSize offset, count;
+        bool ready = false;
+    };
+    const size_t depth = 2 * jobs;
+    std::vector<Slot> slots(depth);
+    std::mutex mutex;
+    std::condition_variable cond;
+    std::atomic<nix::ndsize_t> next(0);
+    nix::ndsize_t written = 0;
+    bool failed = false;
+    std::exception_ptr error;
+
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (size_t j = 0; j < jobs; j++) {
+        workers.emplace_back([&] {
+            try {
+                for (nix::ndsize_t i = next++; i < total; i = next++) {
+                    Slot &slot = slots[i % depth];
+                    {
+                        std::unique_lock<std::mutex> lock(mutex);
+                        cond.wait(lock, [&] { return failed || i < written + depth; });
+                        if (failed) {
+                            return;
+                        }
+                    }
+                    gatherer.gather(i, slot.data, slot.offset, slot.count);
+                    if (direct && filtered) {
+                        nix::util::encodeChunk(slot.data, esize, compression, shuffle);
+                    }
+                    std::lock_guard<std::mutex> lock(mutex);
+                    slot.ready = true;
+                    cond.notify_all();
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!failed) {
+                    failed = true;
+                    error = std::current_exception();
+                }
+                cond.notify_all();
+            }
+        });
+    }
+
+    try {
+        for (nix::ndsize_t i = 0; i < total; i++) {
+            Slot &slot = slots[i % depth];
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                cond.wait(lock, [&] { return failed || slot.ready; });
+                if (failed) {
+                    break;
+                }
+            }
+            if (direct) {
+                array.writeChunk(gatherer.coordinates(i), slot.data.data(), slot.data.size());
+            } else {
+                array.setData(layout.dtype, slot.data.data(), slot.count, slot.offset);
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            slot.ready = false;
+            written++;
+            cond.notify_all();
+        }
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!failed) {
+            failed = true;
+            error = std::current_exception();
+        }
+        cond.notify_all();
+    }
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    file.close();
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    out << "imported " << data_path << " as " << array_name << " " << format_shape(layout.shape) << " "
+        << nix::data_type_to_string(layout.dtype) << ": " << bytes << " bytes in " << total
+        << (direct ? " chunks" : " slabs") << " in " << seconds << " s";
+    if (seconds > 0) {
+        out << " (" << bytes / seconds / (1 << 20) << " MB/s)";
+    }
+    out << std::endl;
+    return out.str();
+}
+
+} // namespace module
+} // namespace cli
@@ -0,0 +1,133 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <Cli.hpp>
+#include <modules/Repack.hpp>
+#include <modules/DataFile.hpp>
+#include <nix.hpp>
+#include <nix/util/copy.hpp>
+
+#include <iomanip>
+#include <sstream>
+
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+namespace po = boost::program_options;
+
+namespace cli {
+namespace module {
+
+const char* Repack::module_name = "repack";
+
+const char *const CHUNK_BYTES_OPTION = "chunk-bytes";
+const char *const NO_COMPRESSION_OPTION = "no-compression";
+const char *const NO_VERIFY_OPTION = "no-verify";
+
+void Repack::load(po::options_description &desc) const {
+    desc.add(po::options_description("nix-tool " + std::string(module_name) + ":\n\n\t" +
+                                     "Copies a file into a new HDF5 file with the given chunking and compression;\n\t" +
+                                     "by default the chunks and filters of every data array are kept.\n\t" +
+                                     "All entities keep their ids; free space and stale index entries of the\n\t" +
+                                     "source are dropped. Usage: nix-tool repack [options] SOURCE TARGET\n\nSupported options"));
+    po::options_description opt;
+    opt.add_options()
+        (CHUNK_BYTES_OPTION, po::value<size_t>(), "target size of a chunk in bytes; by default the chunks of the source are kept")
+        (COMPRESSION_OPTION, po::value<unsigned>(), "deflate level from 1 to 9, 0 to store the data uncompressed; by default the level of the source is kept")
+        (NO_COMPRESSION_OPTION, "store the data uncompressed and unshuffled, the same as --compression 0")
+        (SHUFFLE_OPTION, "shuffle the bytes of the values before compressing them")
+        (JOBS_OPTION, po::value<size_t>(), "number of threads that compress chunks, by default one per core")
+        (NO_VERIFY_OPTION, "do not compare the new file with the source")
+    ;
+    desc.add(opt);
+}
+
+std::string Repack::call(const po::variables_map &vm, const po::options_description &desc) {
+    std::stringstream out;
+
+    // --help
+    if (vm.count(HELP_OPTION)) {
+        po::options_description temp;
+        load(temp);
+        out << temp << std::endl;
+        return out.str();
+    }
+    if (!vm.count(INPFILE_OPTION)) {
+        throw NoInputFile();
+    }
+
+    const std::vector<std::string> &paths = vm[INPFILE_OPTION].as< std::vector<std::string> >();
+    if (paths.size() != 2) {
+        throw std::invalid_argument("repack needs exactly two files, the source and the target");
+    }
+    const std::string &source_path = paths[0];
+    const std::string &target_path = paths[1];
+    if (!boost::filesystem::exists(source_path)) {
+        throw FileNotFound(source_path);
+    }
+    if (boost::filesystem::exists(target_path) && boost::filesystem::equivalent(source_path, target_path)) {
+        throw std::invalid_argument("The target must not be the source file");
+    }
+
+    nix::util::CopyOptions options;
+    if (vm.count(CHUNK_BYTES_OPTION)) {
+        options.chunk_bytes = vm[CHUNK_BYTES_OPTION].as<size_t>();
+    }
+    if (vm.count(COMPRESSION_OPTION) && vm.count(NO_COMPRESSION_OPTION)) {
+        throw std::invalid_argument("--compression and --no-compression exclude each other");
+    }
+    if (vm.count(COMPRESSION_OPTION)) {
+        const unsigned compression = vm[COMPRESSION_OPTION].as<unsigned>();
+        if (compression > 9) {
+            throw InvalidOptionValue(COMPRESSION_OPTION, nix::util::numToStr(compression));
+        }
+        options.compression = compression;
+    } else if (vm.count(NO_COMPRESSION_OPTION)) {
+        options.compression = 0u;
+    }
+    if (vm.count(SHUFFLE_OPTION)) {
+        options.shuffle = true;
+    }
+    if (vm.count(JOBS_OPTION)) {
+        options.jobs = vm[JOBS_OPTION].as<size_t>();
+    }
+    options.verify = !vm.count(NO_VERIFY_OPTION);
+
+    nix::File source = nix::File::open(source_path, nix::FileMode::ReadOnly);
+    if (!source.isOpen()) {
+        throw FileNotOpen(source_path);
+    }
+    const nix::util::CopyReport report = nix::util::copyFile(source, target_path, options);
+    source.close();
+
+    const uintmax_t before = path_size(source_path);
+    const uintmax_t after = path_size(target_path);
+    out << "repacked " << source_path << " into " << target_path << ": "
+        << report.blocks << " blocks, " << report.data_arrays << " data arrays, "
+        << report.chunks << " chunks\n"
+        << "  copied " << report.bytes << " bytes in " << report.seconds << " s ("
+        << std::fixed << std::setprecision(1) << mb_per_second(report.bytes, report.seconds) << " MB/s)\n"
+        << "  size   " << before << " -> " << after << " bytes";
+    if (before > 0) {
+        out << " (" << std::showpos << 100.0 * (static_cast<double>(after) - before) / before
+            << std::noshowpos << " %)";
+    }
+    out << "\n";
+    if (options.verify) {
+        const double read_before = mb_per_second(report.bytes, report.source_read_seconds);
+        const double read_after = mb_per_second(report.bytes, report.target_read_seconds);
+        out << "  verified, read " << read_before << " -> " << read_after << " MB/s";
+        if (read_before > 0) {
+            out << " (" << std::showpos << 100.0 * (read_after - read_before) / read_before << std::noshowpos << " %)";
+        }
+        out << "\n";
+    }
+    return out.str();
+}
+
+} // namespace module
+} // namespace cli
@@ -0,0 +1,240 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <Cli.hpp>
+#include <modules/Stat.hpp>
+#include <modules/DataFile.hpp>
+#include <nix.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+#include <sstream>
+
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+namespace po = boost::program_options;
+
+namespace cli {
+namespace module {
+
+const char* Stat::module_name = "stat";
+
+const char *const JSON_OPTION = "json";
+
+namespace {
+
+std::string json_string(const std::string &str) {
+    std::string out = "\"";
+    for (char c : str) {
+        switch (c) {
+            case '"':  out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char buf[8];
+                    std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+                    out += buf;
+                } else {
+                    out += c;
+                }
+        }
+    }
+    return out + "\"";
+}
+
+
+std::string json_array(const nix::NDSize &size) {
+    std::string out = "[";
+    for (size_t i = 0; i < size.size(); i++) {
+        out += (i > 0 ? ", " : "") + nix::util::numToStr(size[i]);
+    }
+    return out + "]";
+}
+
+
+std::string json_array(const std::vector<std::string> &items) {
+    std::string out = "[";
+    for (size_t i = 0; i < items.size(); i++) {
+        out += (i > 0 ? ", " : "") + json_string(items[i]);
+    }
+    return out + "]";
+}
+
+
+void write_json(std::ostream &out, const nix::StorageReport &report, double seconds) {
+    out << "{\n"
+        << "  \"location\": " << json_string(report.location) << ",\n"
+        << "  \"format\": " << json_string(report.format) << ",\n"
+        << "  \"file_size\": " << report.file_size << ",\n"
+        << "  \"data_bytes\": " << report.storageBytes() << ",\n"
+        << "  \"metadata_bytes\": " << report.metadata_bytes << ",\n"
+        << "  \"objects\": " << report.objects << ",\n"
+        << "  \"attributes\": " << report.attributes << ",\n"
+        << "  \"sections\": " << report.sections << ",\n"
+        << "  \"properties\": " << report.properties << ",\n"
+        << "  \"scan_seconds\": " << seconds << ",\n";
+
+    out << "  \"arrays\": [";
+    for (size_t i = 0; i < report.arrays.size(); i++) {
+        const nix::StorageReport::Array &a = report.arrays[i];
+        out << (i > 0 ? "," : "") << "\n    {"
+            << "\"block\": " << json_string(a.block)
+            << ", \"name\": " << json_string(a.name)
+            << ", \"path\": " << json_string(a.path)
+            << ", \"dtype\": " << json_string(nix::data_type_to_string(a.data_type))
+            << ", \"shape\": " << json_array(a.extent)
+            << ", \"chunks\": " << json_array(a.chunks)
+            << ", \"chunk_count\": " << a.chunk_count
+            << ", \"filters\": " << json_array(a.filters)
+            << ", \"logical_bytes\": " << a.logical_bytes
+            << ", \"allocated_bytes\": " << a.allocated_bytes
+            << ", \"storage_bytes\": " << a.storage_bytes
+            << ", \"derived_bytes\": " << a.derived_bytes
+            << ", \"compression_ratio\": " << a.compressionRatio()
+            << ", \"read_amplification\": {"
+            << "\"full\": " << a.readAmplification(a.extent)
+            << ", \"row\": " << a.readAmplification(a.rowSlab())
+            << ", \"column\": " << a.readAmplification(a.columnSlab()) << "}}";
+    }
+    out << (report.arrays.empty() ? "],\n" : "\n  ],\n");
+
+    out << "  \"blocks\": [";
+    for (size_t i = 0; i < report.blocks.size(); i++) {
+        const nix::StorageReport::Block &b = report.blocks[i];
+        out << (i > 0 ? "," : "") << "\n    {"
+            << "\"name\": " << json_string(b.name)
+            << ", \"data_arrays\": " << b.data_arrays
+            << ", \"dimensions\": " << b.dimensions
+            << ", \"tags\": " << b.tags
+            << ", \"multi_tags\": " << b.multi_tags
+            << ", \"features\": " << b.features
+            << ", \"sources\": " << b.sources
+            << ", \"groups\": " << b.groups
+            << ", \"objects\": " << b.objects
+            << ", \"attributes\": " << b.attributes << "}";
+    }
+    out << (report.blocks.empty() ? "],\n" : "\n  ],\n");
+
+    out << "  \"largest_groups\": [";
+    for (size_t i = 0; i < report.largest_groups.size(); i++) {
+        const nix::StorageReport::Group &g = report.largest_groups[i];
+        out << (i > 0 ? "," : "") << "\n    {"
+            << "\"path\": " << json_string(g.path)
+            << ", \"children\": " << g.children << "}";
+    }
+    out << (report.largest_groups.empty() ? "]\n" : "\n  ]\n");
+    out << "}" << std::endl;
+}
+
+
+void write_text(std::ostream &out, const nix::StorageReport &report, double seconds) {
+    out << report.location << " (" << report.format << ")\n"
+        << "  file size:      " << report.file_size << " bytes\n"
+        << "  data:           " << report.storageBytes() << " bytes\n"
+        << "  metadata:       " << report.metadata_bytes << " bytes\n"
+        << "  objects:        " << report.objects << " (" << report.attributes << " attributes)\n"
+        << "  sections:       " << report.sections << " (" << report.properties << " properties)\n"
+        << "  scanned in " << seconds << " s\n";
+
+    for (const nix::StorageReport::Block &b : report.blocks) {
+        out << "\nblock " << b.name << ": " << b.data_arrays << " data arrays, " << b.dimensions << " dimensions, "
+            << b.tags << " tags, " << b.multi_tags << " multi tags, " << b.features << " features, "
+            << b.sources << " sources, " << b.groups << " groups; " << b.objects << " objects, "
+            << b.attributes << " attributes\n";
+
+        for (const nix::StorageReport::Array &a : report.arrays) {
+            if (a.block != b.name) {
+                continue;
+            }
+            out << "  " << a.name << ": " << format_shape(a.extent) << " " << nix::data_type_to_string(a.data_type)
+                << ", chunks " << (a.chunks.size() > 0 ? format_shape(a.chunks) : "none");
+            if (a.chunks.size() > 0) {
+                out << " (" << a.chunk_count << " allocated)";
+            }
+            if (!a.filters.empty()) {
+                out << ", filters";
+                for (const std::string &filter : a.filters) {
+                    out << " " << filter;
+                }
+            }
+            out << "\n    " << a.logical_bytes << " logical, " << a.allocated_bytes << " allocated, "
+                << a.storage_bytes << " stored bytes";
+            if (a.derived_bytes > 0) {
+                out << " + " << a.derived_bytes << " derived";
+            }
+            out << std::setprecision(3) << "; compression " << a.compressionRatio()
+                << ", read amplification full " << a.readAmplification(a.extent)
+                << " row " << a.readAmplification(a.rowSlab())
+                << " column " << a.readAmplification(a.columnSlab()) << std::setprecision(6) << "\n";
+        }
+    }
+
+    if (!report.largest_groups.empty()) {
+        out << "\nlargest groups:\n";
+        for (const nix::StorageReport::Group &g : report.largest_groups) {
+            out << "  " << std::setw(8) << g.children << "  " << g.path << "\n";
+        }
+    }
+}
+
+} // anonymous namespace
+
+
+void Stat::load(po::options_description &desc) const {
+    desc.add(po::options_description("nix-tool " + std::string(module_name) + ":\n\n\t" +
+                                     "Reports the storage size and layout of the data arrays, the number of\n\t" +
+                                     "entities per block and the groups with the most children.\n\nSupported options"));
+    po::options_description opt;
+    opt.add_options()
+        (JSON_OPTION, "write the report as JSON")
+    ;
+    desc.add(opt);
+}
+
+std::string Stat::call(const po::variables_map &vm, const po::options_description &desc) {
+    std::stringstream out;
+
+    // --help
+    if (vm.count(HELP_OPTION)) {
+        po::options_description temp;
+        load(temp);
+        out << temp << std::endl;
+        return out.str();
+    }
+    if (!vm.count(INPFILE_OPTION)) {
+        throw NoInputFile();
+    }
+
+    for (const std::string &file_path : vm[INPFILE_OPTION].as< std::vector<std::string> >()) {
+        if (!boost::filesystem::exists(file_path)) {
+            throw FileNotFound(file_path);
+        }
+        nix::File file = nix::File::open(file_path, nix::FileMode::ReadOnly);
+        if (!file.isOpen()) {
+            throw FileNotOpen(file_path);
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        const nix::StorageReport report = file.storageReport();
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        if (vm.count(JSON_OPTION)) {
+            write_json(out, report, seconds);
+        } else {
+            write_text(out, report, seconds);
+        }
+        file.close();
+    }
+    return out.str();
+}
+
+} // namespace module
+} // namespace cli
@@ -11,14 +11,22 @@
 #include <nix/Platform.hpp>
 #include <nix/Version.hpp>
 #include <nix/NDSize.hpp>
+#include <nix/Buffer.hpp>
 #include <nix/Block.hpp>
+#include <nix/BlockBatch.hpp>
 #include <nix/DataArray.hpp>
+#include <nix/Overview.hpp>
+#include <nix/MappedData.hpp>
 #include <nix/MultiTag.hpp>
+#include <nix/IntervalIndex.hpp>
 #include <nix/Dimensions.hpp>
+#include <nix/DimensionDescriptor.hpp>
 #include <nix/File.hpp>
 #include <nix/Property.hpp>
 #include <nix/Feature.hpp>
 #include <nix/Section.hpp>
+#include <nix/MetadataSnapshot.hpp>
+#include <nix/StorageReport.hpp>
 #include <nix/Tag.hpp>
 #include <nix/Source.hpp>
 #include <nix/Value.hpp>
@@ -23,6 +23,8 @@
 
 namespace nix {
 
+class BlockBatch;
+
 /**
  * @brief Class for grouping further data entities.
  *
@@ -397,6 +399,19 @@ public:
     */
     bool deleteDataArray(const DataArray &data_array);
 
+    /**
+     * @brief Deletes several data arrays from this block.
+     *
+     * Like {@link deleteDataArray}, but removes all links to the data arrays,
+     * e.g. the references of tags, in one go. Data arrays that are not
+     * part of the block are ignored.
+     *
+     * @param data_arrays       The data arrays to delete.
+     *
+     * @return The number of deleted data arrays.
+     */
+    ndsize_t deleteDataArrays(const std::vector<DataArray> &data_arrays);
+
     //--------------------------------------------------
     // Methods concerning tags.
     //--------------------------------------------------
@@ -711,6 +726,21 @@ public:
     */
     bool deleteGroup(const Group &multi_tag);
 
+    //--------------------------------------------------
+    // Batched creation
+    //--------------------------------------------------
+
+    /**
+     * @brief Start a batch of new entities for this block.
+     *
+     * Sources, data arrays and tags collected in the returned
+     * {@link nix::BlockBatch} are created together once the batch
+     * is committed.
+     *
+     * @return An empty batch bound to this block.
+     */
+    BlockBatch batch() const;
+
     //------------------------------------------------------
     // Operators and other functions
     //------------------------------------------------------
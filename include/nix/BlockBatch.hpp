@@ -0,0 +1,225 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_BLOCK_BATCH_H
+#define NIX_BLOCK_BATCH_H
+
+#include <nix/Platform.hpp>
+#include <nix/Block.hpp>
+#include <nix/DataType.hpp>
+#include <nix/NDSize.hpp>
+#include <nix/base/IDimensions.hpp>
+
+#include <boost/optional.hpp>
+
+#include <string>
+#include <vector>
+
+namespace nix {
+
+/**
+ * @brief Collects new entities of a block and creates them in one go.
+ *
+ * A batch holds plain descriptions of sources, data arrays (including
+ * their dimensions) and tags. Nothing is written until {@link commit}
+ * is called, which validates all entities in a single pass and then
+ * lets the back-end create them in a tight loop. This is considerably
+ * faster than creating many small entities one by one.
+ *
+ * Sources of data arrays and tags as well as the references of tags are
+ * given by name or id and may either denote entities of the same batch
+ * or entities that already exist in the block.
+ *
+ * ~~~
+ * nix::BlockBatch batch = block.batch();
+ * batch.addSource("cell", "neuron");
+ * for (int i = 0; i < 100; i++) {
+ *     std::string name = "trial " + std::to_string(i);
+ *     size_t da = batch.addDataArray(name, "voltage", nix::DataType::Double, {1000});
+ *     batch.dataArray(da).unit = "mV";
+ *     batch.dataArray(da).dimensions.push_back(nix::BlockBatch::DimensionSpec::sampled(0.1));
+ *     batch.dataArray(da).sources.push_back("cell");
+ * }
+ * batch.commit();
+ * ~~~
+ */
+class NIXAPI BlockBatch {
+
+public:
+
+    /**
+     * @brief A dimension of a data array in the batch.
+     */
+    struct DimensionSpec {
+        DimensionType type = DimensionType::Set;
+        /// The sampling interval of a sampled dimension.
+        double sampling_interval = 0.0;
+        /// The offset of a sampled dimension.
+        boost::optional<double> offset;
+        /// The ticks of a range dimension.
+        std::vector<double> ticks;
+        /// The labels of a set dimension.
+        std::vector<std::string> labels;
+        /// Unit and label of a sampled or range dimension.
+        boost::optional<std::string> unit, label;
+
+        static DimensionSpec sampled(double sampling_interval);
+
+        static DimensionSpec set(const std::vector<std::string> &labels = {});
+
+        static DimensionSpec range(const std::vector<double> &ticks);
+    };
+
+    /**
+     * @brief A source in the batch.
+     */
+    struct SourceSpec {
+        std::string id;
+        std::string name;
+        std::string type;
+    };
+
+    /**
+     * @brief A data array in the batch.
+     */
+    struct DataArraySpec {
+        std::string id;
+        std::string name;
+        std::string type;
+        DataType data_type = DataType::Double;
+        NDSize shape;
+        boost::optional<std::string> unit, label;
+        std::vector<DimensionSpec> dimensions;
+        /// Names or ids of the sources of the array.
+        std::vector<std::string> sources;
+    };
+
+    /**
+     * @brief A tag in the batch.
+     */
+    struct TagSpec {
+        std::string id;
+        std::string name;
+        std::string type;
+        std::vector<double> position, extent;
+        std::vector<std::string> units;
+        /// Names or ids of the data arrays referenced by the tag.
+        std::vector<std::string> references;
+        /// Names or ids of the sources of the tag.
+        std::vector<std::string> sources;
+    };
+
+    /**
+     * @brief Creates an empty batch for the given block.
+     *
+     * Use {@link nix::Block::batch} instead.
+     */
+    explicit BlockBatch(const Block &block);
+
+    //--------------------------------------------------
+    // Building the batch
+    //--------------------------------------------------
+
+    /**
+     * @brief Append a source to the batch.
+     *
+     * @param name      The name of the source.
+     * @param type      The type of the source.
+     * @param id        The id of the source; if empty an id is generated
+     *                  once the batch is committed.
+     *
+     * @return The index of the new source.
+     */
+    size_t addSource(const std::string &name, const std::string &type, const std::string &id = "");
+
+    /**
+     * @brief Append a data array to the batch.
+     *
+     * @param name      The name of the data array.
+     * @param type      The type of the data array.
+     * @param data_type The data type of the stored data.
+     * @param shape     The initial shape of the data.
+     * @param id        The id of the data array; if empty an id is
+     *                  generated once the batch is committed.
+     *
+     * @return The index of the new data array.
+     */
+    size_t addDataArray(const std::string &name, const std::string &type, DataType data_type,
+                        const NDSize &shape, const std::string &id = "");
+
+    /**
+     * @brief Append a tag to the batch.
+     *
+     * @param name      The name of the tag.
+     * @param type      The type of the tag.
+     * @param position  The position of the tag.
+     * @param id        The id of the tag; if empty an id is generated
+     *                  once the batch is committed.
+     *
+     * @return The index of the new tag.
+     */
+    size_t addTag(const std::string &name, const std::string &type, const std::vector<double> &position,
+                  const std::string &id = "");
+
+    /**
+     * @brief Remove all entities from the batch.
+     */
+    void clear();
+
+    //--------------------------------------------------
+    // Entity access
+    //--------------------------------------------------
+
+    size_t sourceCount() const { return source_specs.size(); }
+
+    size_t dataArrayCount() const { return data_array_specs.size(); }
+
+    size_t tagCount() const { return tag_specs.size(); }
+
+    bool empty() const { return source_specs.empty() && data_array_specs.empty() && tag_specs.empty(); }
+
+    SourceSpec &source(size_t index);
+
+    const SourceSpec &source(size_t index) const;
+
+    DataArraySpec &dataArray(size_t index);
+
+    const DataArraySpec &dataArray(size_t index) const;
+
+    TagSpec &tag(size_t index);
+
+    const TagSpec &tag(size_t index) const;
+
+    //--------------------------------------------------
+    // Writing the batch
+    //--------------------------------------------------
+
+    /**
+     * @brief Validate all entities of the batch and create them in the block.
+     *
+     * Names, types, ids, positions, units and ticks are checked before
+     * anything is written, given ids must not be used by any entity of the
+     * block yet and every tag needs a position; if a check fails an
+     * exception is thrown and the block is left untouched. Afterwards the
+     * specs of the batch hold the ids of the created entities, sources and
+     * references are given by id and units are sanitized.
+     */
+    void commit();
+
+private:
+
+    Block blk;
+    std::vector<SourceSpec> source_specs;
+    std::vector<DataArraySpec> data_array_specs;
+    std::vector<TagSpec> tag_specs;
+};
+
+
+} // namespace nix
+
+#endif // NIX_BLOCK_BATCH_H
@@ -0,0 +1,119 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_BUFFER_H
+#define NIX_BUFFER_H
+
+#include <nix/Hydra.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace nix {
+
+/**
+ * @brief Allocator that returns aligned memory and does not initialize
+ *        the elements.
+ *
+ * Memory is aligned to Alignment bytes, which must be a power of two.
+ * Elements that are added by resizing a container are default-initialized,
+ * i.e. for arithmetic types they are left uninitialized instead of being
+ * set to zero. Freshly allocated pages are therefore only touched when the
+ * data is actually written, e.g. by reading from a file.
+ */
+template<typename T, size_t Alignment = 64>
+class AlignedAllocator {
+
+    static_assert(Alignment >= alignof(void *) && (Alignment & (Alignment - 1)) == 0,
+                  "Alignment must be a power of two and at least the alignment of a pointer");
+
+public:
+
+    typedef T value_type;
+
+    template<typename U>
+    struct rebind {
+        typedef AlignedAllocator<U, Alignment> other;
+    };
+
+    AlignedAllocator() noexcept { }
+
+    template<typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment> &) noexcept { }
+
+    T *allocate(size_t n) {
+        if (n > (std::numeric_limits<size_t>::max() - Alignment - sizeof(void *)) / sizeof(T)) {
+            throw std::bad_alloc();
+        }
+
+        // over-allocate and keep the original pointer right before the aligned block
+        void *raw = std::malloc(n * sizeof(T) + Alignment + sizeof(void *));
+        if (raw == nullptr) {
+            throw std::bad_alloc();
+        }
+
+        uintptr_t start = reinterpret_cast<uintptr_t>(raw) + sizeof(void *);
+        uintptr_t aligned = (start + Alignment - 1) & ~static_cast<uintptr_t>(Alignment - 1);
+        reinterpret_cast<void **>(aligned)[-1] = raw;
+        return reinterpret_cast<T *>(aligned);
+    }
+
+    void deallocate(T *p, size_t) noexcept {
+        if (p != nullptr) {
+            std::free(reinterpret_cast<void **>(p)[-1]);
+        }
+    }
+
+    // default-initialization instead of value-initialization
+    template<typename U>
+    void construct(U *p) {
+        ::new(static_cast<void *>(p)) U;
+    }
+
+    template<typename U, typename... Args>
+    void construct(U *p, Args&&... args) {
+        ::new(static_cast<void *>(p)) U(std::forward<Args>(args)...);
+    }
+};
+
+
+template<typename T, typename U, size_t Alignment>
+bool operator==(const AlignedAllocator<T, Alignment> &, const AlignedAllocator<U, Alignment> &) {
+    return true;
+}
+
+
+template<typename T, typename U, size_t Alignment>
+bool operator!=(const AlignedAllocator<T, Alignment> &, const AlignedAllocator<U, Alignment> &) {
+    return false;
+}
+
+/**
+ * @brief Vector with 64-byte aligned, uninitialized storage.
+ *
+ * A Buffer can be used wherever a std::vector is accepted for reading and
+ * writing data, e.g. with {@link DataSet::getData}. Resizing it does not
+ * zero the new elements, so reading large amounts of data into a Buffer
+ * touches the memory only once.
+ *
+ * ~~~
+ * nix::Buffer<double> values;
+ * array.getData(values);
+ * ~~~
+ */
+template<typename T>
+using Buffer = std::vector<T, AlignedAllocator<T>>;
+
+} // namespace nix
+
+#endif // NIX_BUFFER_H
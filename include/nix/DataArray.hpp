@@ -15,12 +15,15 @@
 #include <nix/base/IDataArray.hpp>
 #include <nix/Dimensions.hpp>
 #include <nix/Hydra.hpp>
+#include <nix/Overview.hpp>
 
 #include <nix/Platform.hpp>
 
 
 namespace nix {
 
+class DataView;
+
 // TODO add documentation for undocumented methods.
 
 /**
@@ -288,6 +291,21 @@ public:
         return backend()->getDimension(id);
     }
 
+    /**
+     * @brief Get resolved descriptors of all dimensions.
+     *
+     * The properties of all dimensions are read at once. The result is
+     * cached by the DataArray and returned without accessing the file
+     * again until a dimension is created, changed or deleted; prefer this
+     * over {@link getDimension} when many positions have to be mapped to
+     * indices.
+     *
+     * @return One descriptor per dimension, ordered by index.
+     */
+    std::vector<DimensionDescriptor> dimensionDescriptors() const {
+        return backend()->dimensionDescriptors();
+    }
+
     /**
      * @brief Append a new SetDimension to the list of existing dimension descriptors.
      *
@@ -462,6 +480,202 @@ public:
 
     void appendData(DataType dtype, const void *data, const NDSize &count, size_t axis);
 
+    /**
+     * @brief Get a read-only view of all data of the DataArray.
+     *
+     * If the data is stored contiguously and unfiltered in a local file
+     * and its stored type matches the native one, the view maps the bytes
+     * of the file directly into memory: accessing it involves no copy and
+     * repeated scans are served from the page cache. Otherwise, e.g. for
+     * chunked or compressed data, the data is read into a buffer once.
+     * {@link MappedData::isMapped} tells which case applies.
+     *
+     * Like {@link getDataDirect} the view contains the stored values,
+     * polynomial coefficients and expansion origin are not applied.
+     * A mapped view reflects changes to the data only after they were
+     * flushed to the file and must not be used across changes of the
+     * data extent.
+     *
+     * @return The view of the data.
+     *
+     * @throws std::invalid_argument If the data is not numeric.
+     */
+    MappedData mapData() const;
+
+    /**
+     * @brief Get the shape of the chunks in which the data is stored.
+     *
+     * @return The chunk extent, empty if the data is not stored in chunks.
+     */
+    NDSize chunkExtent() const {
+        return backend()->chunkExtent();
+    }
+
+    /**
+     * @brief Whether the data may be read by several threads at once.
+     *
+     * Only the HDF5 back-end serializes concurrent reads, see {@link File}.
+     *
+     * @return True if the data can be read on several threads.
+     */
+    bool concurrentReads() const {
+        return backend()->concurrentReads();
+    }
+
+    /**
+     * @brief Store one complete chunk without any conversion.
+     *
+     * The bytes are written to the file as they are: there is no type
+     * conversion and the filter pipeline is skipped. This is the fastest
+     * way to store data that already comes in blocks of the size of a
+     * chunk, e.g. from an acquisition system. The data must be in the
+     * stored representation, i.e. in the byte order of the file type and,
+     * if the data set has filters, already processed by all filters that
+     * are not masked out. Without filters, nbytes must be exactly the size
+     * of a chunk; chunks at the border of the data are still stored whole.
+     * The data extent is not changed and must already cover the chunk.
+     *
+     * @param chunk         The coordinates of the chunk in the chunk grid,
+     *                      i.e. the first element of the chunk is at
+     *                      chunk * chunkExtent().
+     * @param data          The bytes of the chunk.
+     * @param nbytes        The number of bytes in data.
+     * @param filter_mask   Bit i is set if filter i was not applied to data.
+     *
+     * @throws nix::OutOfBounds If the chunk lies outside of the data extent.
+     * @throws std::invalid_argument If nbytes does not match the size of a chunk.
+     * @throws std::runtime_error If the data is not stored in chunks or
+     *                            if the HDF5 library is older than 1.10.5.
+     */
+    void writeChunk(const NDSize &chunk, const void *data, size_t nbytes, uint32_t filter_mask = 0) {
+        backend()->writeChunk(chunk, data, nbytes, filter_mask);
+    }
+
+    /**
+     * @brief Read the stored bytes of one complete chunk.
+     *
+     * The counterpart of {@link writeChunk}: the bytes are returned as they
+     * are stored, without type conversion and without running the filters.
+     *
+     * @param chunk         The coordinates of the chunk in the chunk grid.
+     * @param data          Receives the bytes of the chunk.
+     * @param filter_mask   If not null, receives the filter mask of the chunk.
+     *
+     * @return false if the chunk was never written, data is empty then.
+     *
+     * @throws std::runtime_error If the data is not stored in chunks or
+     *                            if the HDF5 library is older than 1.10.5.
+     */
+    bool readChunk(const NDSize &chunk, Buffer<char> &data, uint32_t *filter_mask = nullptr) const {
+        uint32_t mask = 0;
+        bool found = backend()->readChunk(chunk, data, mask);
+        if (filter_mask != nullptr) {
+            *filter_mask = mask;
+        }
+        return found;
+    }
+
+    //--------------------------------------------------
+    // Positions
+    //--------------------------------------------------
+
+    /**
+     * @brief Convert many positions along a dimension into indices.
+     *
+     * Works like {@link util::positionToIndex} for every position, but reads
+     * the dimension from the cached {@link dimensionDescriptors} and resolves
+     * the unit only once.
+     *
+     * @param dim       The index of the dimension, starting at 1.
+     * @param positions The positions.
+     * @param n         The number of positions.
+     * @param unit      The unit of the positions, may be "none".
+     *
+     * @return The index of every position.
+     *
+     * @throws nix::OutOfBounds If there is no such dimension or a position
+     *                          is out of the range of the dimension.
+     * @throws nix::IncompatibleDimensions If the unit does not fit the dimension.
+     */
+    std::vector<ndsize_t> positionsToIndices(size_t dim, const double *positions, size_t n,
+                                             const std::string &unit = "none") const;
+
+    /**
+     * @brief Get a view of the data within ranges of positions.
+     *
+     * Each range [start, end) selects the data along one dimension like a
+     * {@link Tag} with the position start and the extent end - start does:
+     * from the index of start up to the index of end, at least one element.
+     * Dimensions without a range are selected completely.
+     *
+     * @param ranges    The ranges of the first dimensions.
+     * @param units     The units of the ranges, "none" for missing ones.
+     *
+     * @return The view of the selected data.
+     *
+     * @throws nix::IncompatibleDimensions If there are more ranges than
+     *                                     dimensions or a unit does not fit.
+     * @throws nix::OutOfBounds If a range is out of the bounds of the data.
+     * @throws std::invalid_argument If a range ends before it starts.
+     */
+    DataView sliceByPosition(const std::vector<std::pair<double, double>> &ranges,
+                             const std::vector<std::string> &units = {}) const;
+
+    //--------------------------------------------------
+    // Overviews
+    //--------------------------------------------------
+
+    /**
+     * @brief Store a min/max/mean overview pyramid along an axis.
+     *
+     * Level l of the pyramid combines factor^l consecutive samples along
+     * the axis into one point; levels are added until a single point covers
+     * all samples. The pyramid is built from the calibrated values, level by
+     * level from the one below, reading the data once in bounded slabs.
+     * {@link appendData} along the axis updates the pyramid from the new
+     * samples only; any other change of the data or its calibration makes
+     * the pyramid outdated until it is created again. A previous pyramid is
+     * replaced.
+     *
+     * @param axis      The axis, usually the one of a sampled dimension.
+     * @param factor    The number of points of a level that form one point
+     *                  of the next level, at least 2.
+     *
+     * @throws std::runtime_error If the back-end cannot store derived data.
+     */
+    void createOverview(size_t axis, size_t factor = 16);
+
+    /**
+     * @brief Whether an up to date overview pyramid is stored.
+     */
+    bool hasOverview() const;
+
+    /**
+     * @brief Remove a stored overview pyramid.
+     */
+    void deleteOverview();
+
+    /**
+     * @brief Get a summary of the data in a window for display.
+     *
+     * The window is given in the unit of the sampled dimension of the axis.
+     * The finest level of the pyramid that yields no more than max_points
+     * points in the window is read; the effort therefore depends on
+     * max_points, not on the size of the window. The
+     * first and last point may cover samples outside of the window. Without
+     * a stored pyramid the points are computed from the data in the window.
+     *
+     * @param axis          The axis, its dimension must be a sampled dimension.
+     * @param lo            Start of the window.
+     * @param hi            End of the window.
+     * @param max_points    The maximal number of points.
+     *
+     * @return The overview, the samples themselves if they are few enough.
+     *
+     * @throws nix::IncompatibleDimensions If the dimension of the axis is not sampled.
+     */
+    Overview overview(size_t axis, double lo, double hi, size_t max_points) const;
+
     //--------------------------------------------------
     // Other methods and functions
     //--------------------------------------------------
@@ -491,6 +705,13 @@ protected:
                  const void *data,
                  const NDSize &count,
                  const NDSize &offset);
+
+private:
+    // axis and factor of an up to date overview pyramid, factor 0 if there is none
+    std::pair<size_t, size_t> overviewLayout() const;
+
+    // bring the levels of an overview pyramid up to date, starting after old_count samples
+    void updateOverview(size_t axis, size_t factor, ndsize_t old_count);
 };
 
 } // namespace nix
@@ -0,0 +1,162 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_DATA_ARRAY_READER_H
+#define NIX_DATA_ARRAY_READER_H
+
+#include <nix/Buffer.hpp>
+#include <nix/DataArray.hpp>
+#include <nix/Platform.hpp>
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+
+namespace nix {
+
+/**
+ * @brief Sequential reader that prefetches the data of a {@link DataArray}
+ *        on a background thread.
+ *
+ * The reader walks the data of a DataArray along one axis. Every step
+ * yields one slab of the given shape; consecutive slabs are stride
+ * elements apart along the axis, the last slab is cut at the end of the
+ * data. A background thread reads up to depth slabs ahead into a ring of
+ * buffers that are allocated once, so the I/O for the next slabs overlaps
+ * with whatever the caller does with the current one.
+ *
+ * Slabs are handed out without copying: the {@link Slab} returned by
+ * {@link next} points directly into the ring and stays valid until the
+ * following call to next() or until the reader is destroyed.
+ *
+ * ~~~
+ * nix::DataArrayReader reader(array, nix::DataType::Double, {1, 2048}, 0);
+ * nix::DataArrayReader::Slab slab;
+ * while (reader.next(slab)) {
+ *     const double *values = slab.data<double>();
+ *     ...
+ * }
+ * ~~~
+ *
+ * The background thread reads from the file while the caller continues,
+ * therefore the file must not be modified while the reader is alive (see
+ * the thread safety notes of {@link File}).
+ */
+class NIXAPI DataArrayReader {
+
+public:
+
+    /**
+     * @brief A slab of data handed out by the reader.
+     */
+    class Slab {
+        friend class DataArrayReader;
+
+        const void *ptr = nullptr;
+        NDSize slab_offset, slab_count;
+        ndsize_t slab_index = 0;
+
+    public:
+
+        /**
+         * @brief Pointer to the data of the slab, in row-major order.
+         */
+        const void *data() const { return ptr; }
+
+        template<typename T>
+        const T *data() const { return static_cast<const T *>(ptr); }
+
+        /**
+         * @brief Position of the slab within the data of the DataArray.
+         */
+        const NDSize &offset() const { return slab_offset; }
+
+        /**
+         * @brief Shape of the slab; only the last slab can be smaller
+         *        than the shape passed to the reader.
+         */
+        const NDSize &count() const { return slab_count; }
+
+        /**
+         * @brief Zero based number of the slab.
+         */
+        ndsize_t index() const { return slab_index; }
+    };
+
+    /**
+     * @brief Start reading.
+     *
+     * @param array     The DataArray to read.
+     * @param dtype     The data type the values are converted to.
+     * @param shape     The shape of one slab, must have the rank of the data.
+     * @param axis      The axis along which the reader moves.
+     * @param stride    The step between two slabs along axis; 0 means
+     *                  shape[axis], i.e. adjacent slabs.
+     * @param depth     The number of slabs that are read ahead.
+     * @param start     Position of the first slab; defaults to the origin.
+     */
+    DataArrayReader(const DataArray &array, DataType dtype, const NDSize &shape, size_t axis,
+                    ndsize_t stride = 0, size_t depth = 4, const NDSize &start = {});
+
+    DataArrayReader(const DataArrayReader &other) = delete;
+    DataArrayReader &operator=(const DataArrayReader &other) = delete;
+
+    /**
+     * @brief Get the next slab.
+     *
+     * Blocks until the slab has been read. The slab obtained by the
+     * previous call is given back to the reader.
+     *
+     * @param slab      Set to the next slab.
+     *
+     * @return False if all slabs have been read.
+     */
+    bool next(Slab &slab);
+
+    /**
+     * @brief The total number of slabs.
+     */
+    ndsize_t slabCount() const { return slab_total; }
+
+    /**
+     * @brief Stop reading ahead and wait for the background thread.
+     */
+    ~DataArrayReader();
+
+private:
+
+    DataArray array;
+    DataType dtype;
+    NDSize shape, start;
+    size_t axis;
+    ndsize_t stride, slab_total;
+
+    struct Slot {
+        Buffer<char> buffer;
+        NDSize offset, count;
+    };
+
+    std::vector<Slot> ring;
+
+    // produced: slabs read so far, consumed: slabs handed out,
+    // released: slabs given back by the caller
+    std::mutex mutex;
+    std::condition_variable cond_filled, cond_free;
+    ndsize_t produced, consumed, released;
+    bool stopped;
+    std::exception_ptr error;
+    std::thread worker;
+
+    void run();
+};
+
+} // namespace nix
+
+#endif // NIX_DATA_ARRAY_READER_H
@@ -0,0 +1,178 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_DIMENSION_DESCRIPTOR_H
+#define NIX_DIMENSION_DESCRIPTOR_H
+
+#include <nix/base/IDimensions.hpp>
+#include <nix/Platform.hpp>
+
+#include <boost/optional.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace nix {
+
+/**
+ * @brief Resolved, immutable copy of the properties of a dimension.
+ *
+ * A descriptor holds everything needed to map between positions and
+ * indices of one dimension of a {@link DataArray}: the type, sampling
+ * interval and offset, unit, label as well as the ticks or labels. All
+ * values are read from the back-end once when the descriptor is created;
+ * afterwards no method touches the file anymore. Ticks and labels are
+ * shared between copies of a descriptor, copying is therefore cheap.
+ *
+ * Descriptors are obtained with {@link DataArray::dimensionDescriptors}.
+ * They do not follow later changes of the dimension they were created from.
+ */
+class NIXAPI DimensionDescriptor {
+
+public:
+
+    /**
+     * @brief Constructor that creates an empty descriptor of a set
+     *        dimension with index 0.
+     */
+    DimensionDescriptor();
+
+    /**
+     * @brief Read all properties of a dimension.
+     *
+     * @param dimension     The back-end implementation of the dimension.
+     */
+    explicit DimensionDescriptor(const base::IDimension &dimension);
+
+
+    DimensionType dimensionType() const { return dim_type; }
+
+
+    ndsize_t index() const { return dim_index; }
+
+    /**
+     * @brief The sampling interval of a sampled dimension, 0 for all others.
+     */
+    double samplingInterval() const { return sampling_interval; }
+
+    /**
+     * @brief The offset of a sampled dimension, if set.
+     */
+    boost::optional<double> offset() const { return dim_offset; }
+
+
+    boost::optional<std::string> unit() const { return dim_unit; }
+
+
+    boost::optional<std::string> label() const { return dim_label; }
+
+    /**
+     * @brief The labels of a set dimension, empty for all others.
+     */
+    const std::vector<std::string> &labels() const { return *dim_labels; }
+
+    /**
+     * @brief Get the index of a label of a set dimension.
+     *
+     * The labels are hashed on the first lookup, all further lookups
+     * take constant time. If a label occurs more than once, the first
+     * index is returned.
+     *
+     * @param label     The label.
+     *
+     * @return The index of the label.
+     *
+     * @throws nix::OutOfBounds If the dimension has no such label.
+     */
+    ndsize_t indexOf(const std::string &label) const;
+
+    /**
+     * @brief Get the indices of several labels of a set dimension.
+     *
+     * @param labels    The labels.
+     *
+     * @return The index of every label, in the order of the labels.
+     *
+     * @throws nix::OutOfBounds If one of the labels does not exist.
+     */
+    std::vector<ndsize_t> indicesOf(const std::vector<std::string> &labels) const;
+
+    /**
+     * @brief The ticks of a range dimension, empty for all others.
+     */
+    const std::vector<double> &ticks() const { return *dim_ticks; }
+
+    /**
+     * @brief Whether a range dimension uses the data of its DataArray as ticks.
+     */
+    bool alias() const { return is_alias; }
+
+    /**
+     * @brief Get the index of a position.
+     *
+     * Sampled and range dimensions behave like {@link SampledDimension::indexOf}
+     * and {@link RangeDimension::indexOf}; for set dimensions the position is
+     * rounded to the next index.
+     *
+     * @param position  The position, in the unit of the dimension.
+     *
+     * @return The index.
+     *
+     * @throws nix::OutOfBounds If the position is out of the range of the dimension.
+     */
+    ndsize_t indexOf(double position) const;
+
+    /**
+     * @brief Get the indices of many positions at once.
+     *
+     * Gives the same indices as {@link indexOf} for every position, but
+     * handles the whole array in one pass. Ticks of range dimensions are
+     * searched starting from the previous result as long as the positions
+     * are ascending.
+     *
+     * @param positions The positions.
+     * @param n         The number of positions.
+     * @param indices   Receives the n indices.
+     * @param scaling   Factor that converts the positions into the unit
+     *                  of the dimension.
+     *
+     * @throws nix::OutOfBounds If a position is out of the range of the dimension.
+     */
+    void indicesOf(const double *positions, size_t n, ndsize_t *indices, double scaling = 1.0) const;
+
+    /**
+     * @brief Get the position of an index.
+     *
+     * @param index     The index.
+     *
+     * @return The position, in the unit of the dimension.
+     *
+     * @throws nix::OutOfBounds If the index exceeds the ticks of a range dimension.
+     */
+    double positionAt(ndsize_t index) const;
+
+private:
+
+    struct LabelIndex;
+
+    DimensionType dim_type;
+    ndsize_t dim_index;
+    double sampling_interval;
+    boost::optional<double> dim_offset;
+    boost::optional<std::string> dim_unit;
+    boost::optional<std::string> dim_label;
+    std::shared_ptr<const std::vector<std::string>> dim_labels;
+    std::shared_ptr<const std::vector<double>> dim_ticks;
+    std::shared_ptr<LabelIndex> label_index;
+    bool is_alias;
+};
+
+} // namespace nix
+
+#endif // NIX_DIMENSION_DESCRIPTOR_H
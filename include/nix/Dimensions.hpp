@@ -406,6 +406,47 @@ public:
         backend()->labels(t);
     }
 
+    /**
+     * @brief The number of labels of the dimension.
+     *
+     * Unlike `labels().size()` this does not read the labels.
+     *
+     * @return The number of labels.
+     */
+    ndsize_t labelCount() const {
+        return backend()->labelCount();
+    }
+
+    /**
+     * @brief Get the index of a label.
+     *
+     * The labels are hashed on the first lookup, further lookups on the
+     * same dimension take constant time. Since the positions of a set
+     * dimension are its indices, the result can be used as position of a
+     * {@link Tag} or {@link MultiTag}. If a label occurs more than once,
+     * the first index is returned.
+     *
+     * @param label     The label.
+     *
+     * @return The index of the label.
+     *
+     * @throws nix::OutOfBounds If the dimension has no such label.
+     */
+    ndsize_t indexOf(const std::string &label) const;
+
+    /**
+     * @brief Get the indices of several labels.
+     *
+     * @param labels    The labels.
+     *
+     * @return The index of every label, in the order of the labels.
+     *
+     * @throws nix::OutOfBounds If one of the labels does not exist.
+     */
+    std::vector<ndsize_t> indicesOf(const std::vector<std::string> &labels) const {
+        return backend()->indicesOf(labels);
+    }
+
     /**
      * @brief Assignment operator.
      *
@@ -13,6 +13,8 @@
 #include <nix/base/IFile.hpp>
 #include <nix/Block.hpp>
 #include <nix/Section.hpp>
+#include <nix/MetadataSnapshot.hpp>
+#include <nix/StorageReport.hpp>
 #include <nix/Platform.hpp>
 
 #include <nix/valid/validate.hpp>
@@ -20,6 +22,32 @@
 namespace nix {
 
 
+/**
+ * @brief {@link File} entities are the root of every nix data file.
+ *
+ * <b>Thread safety:</b> a file of the HDF5 back-end that was opened with
+ * FileMode::ReadOnly may be shared by any number of threads, which can
+ * then read the data of different (or the same) entities in parallel.
+ * The back-end serializes all calls into the HDF5 library internally and
+ * every read opens its own handle to the data, so no external locking is
+ * required. Entity objects (e.g. a {@link DataArray}) are handles:
+ * obtaining one handle per thread is recommended, sharing a handle
+ * between threads is fine as long as it is not reassigned; the groups and
+ * caches a handle fills on first use are guarded by the same lock or by a
+ * mutex of their own. Writing to a file while other threads access it is
+ * not supported, neither is concurrent access to files of the file system
+ * back-end.
+ *
+ * <b>Live acquisition:</b> a recording can be read by other processes
+ * while it is being written with the single-writer/multiple-reader (SWMR)
+ * mode of the HDF5 back-end. The writer opens the file with
+ * FileMode::SWMRWrite, creates all entities it needs and then calls
+ * {@link startSWMRWrite}. From then on only data can be written and
+ * appended, readers open the file with FileMode::SWMRRead and see new data
+ * whenever they query the data extent of a {@link DataArray}. SWMR needs
+ * HDF5 1.10 or newer, with older versions opening a file in one of the
+ * SWMR modes throws std::runtime_error.
+ */
 class NIXAPI File : public base::ImplContainer<base::IFile> {
 
 public:
@@ -82,8 +110,10 @@ public:
      *
      * @param name      The name/path of the file.
      * @param mode      The open mode.
-     * @param impl      The back-end implementation the should be used to open the file.
-     *                  (currently only hdf5)
+     * @param impl      The back-end implementation the should be used to open the file:
+     *                  "hdf5" (default), "memory" for a file that only exists in memory
+     *                  and is lost when closed unless saved with {@link saveAs}, or
+     *                  "file" if the file system back-end was built.
      *
      * @return The opened file.
      */
@@ -358,6 +388,45 @@ public:
      */
     bool deleteSection(const Section &section);
 
+    /**
+     * @brief Read the complete metadata tree of the file into memory.
+     *
+     * All sections, properties and values stored in the file are read
+     * in a single pass over the metadata of the file. Querying the
+     * returned snapshot does not access the file any more.
+     *
+     * @return A snapshot of all sections of the file.
+     */
+    MetadataSnapshot loadMetadataSnapshot() const {
+        return backend()->loadMetadataSnapshot();
+    }
+
+    /**
+     * @brief Create all sections of a snapshot in the file.
+     *
+     * The root sections of the snapshot are added to the root sections of
+     * the file; ids stored in the snapshot are preserved. The whole snapshot
+     * is validated before anything is written: names and types must not be
+     * empty, names must be unique among siblings and must not clash with
+     * existing root sections, ids must be unique and links must point to a
+     * section in the snapshot or in the file.
+     *
+     * @param snapshot  The metadata tree to create.
+     */
+    void storeMetadataSnapshot(const MetadataSnapshot &snapshot);
+
+    /**
+     * @brief Collect the storage layout and size of the entities of the file.
+     *
+     * All objects of the file are visited once; the data of the arrays
+     * is not read. See {@link nix::StorageReport}.
+     *
+     * @return The storage report of the file.
+     */
+    StorageReport storageReport() const {
+        return backend()->storageReport();
+    }
+
     //--------------------------------------------------
     // Methods for file attribute access.
     //--------------------------------------------------
@@ -468,6 +537,64 @@ public:
     FileMode fileMode() {
         return backend()->fileMode();
     }
+
+    /**
+     * @brief Start writing in single-writer/multiple-reader mode.
+     *
+     * Only possible for files opened with FileMode::SWMRWrite. A new file
+     * is created in the format required for SWMR access, so the structure
+     * of the recording (blocks, data arrays, dimensions, metadata) can be
+     * set up first; an existing file is already opened for SWMR writing
+     * and calling this method has no effect.
+     *
+     * Once SWMR writing has started, the structure of the file is fixed:
+     * only the data of existing data arrays can be written and their
+     * extent changed, all other modifications throw std::logic_error.
+     * Written data is flushed to the file according to {@link flushInterval}.
+     *
+     * @throws std::logic_error If the file was not opened with FileMode::SWMRWrite.
+     */
+    void startSWMRWrite() {
+        backend()->startSWMRWrite();
+    }
+
+    /**
+     * @brief Set the minimal time between two flushes of written data
+     *        during SWMR writing.
+     *
+     * Readers only see data after it was flushed. With an interval of 0,
+     * the default, the file is flushed after every write; larger values
+     * trade latency for throughput.
+     *
+     * @param seconds   The interval in seconds, must not be negative.
+     */
+    void flushInterval(double seconds) {
+        backend()->flushInterval(seconds);
+    }
+
+    /**
+     * @brief Get the minimal time between two flushes during SWMR writing.
+     *
+     * @return The interval in seconds.
+     */
+    double flushInterval() const {
+        return backend()->flushInterval();
+    }
+
+    /**
+     * @brief Write the contents of an in-memory file to a HDF5 file.
+     *
+     * Files opened with the "memory" back-end are never written to disk
+     * on their own. This method stores all entities, including their ids
+     * and creation times, in a new HDF5 file that can be opened with the
+     * default back-end afterwards. An existing file at the location is
+     * overwritten.
+     *
+     * @param location  The path of the HDF5 file.
+     *
+     * @throws std::logic_error If the file was not opened with the "memory" back-end.
+     */
+    void saveAs(const std::string &location) const;
     /**
      * @brief Assignment operator for none.
      */
@@ -142,11 +142,11 @@ public:
 };
 
 
-template<typename T>
-class data_traits<std::vector<T>> {
+template<typename T, typename Alloc>
+class data_traits<std::vector<T, Alloc>> {
 public:
 
-    typedef std::vector<T>     value_type;
+    typedef std::vector<T, Alloc> value_type;
     typedef value_type&        reference;
     typedef const value_type&  const_reference;
 
@@ -0,0 +1,152 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_INTERVAL_INDEX_H
+#define NIX_INTERVAL_INDEX_H
+
+#include <nix/base/IDataArray.hpp>
+#include <nix/Platform.hpp>
+
+#include <memory>
+#include <vector>
+
+namespace nix {
+
+/**
+ * @brief Sorted index over the positions and extents of a {@link MultiTag}.
+ *
+ * For every dimension of the positions the index keeps the intervals
+ * [position, position + extent] sorted by their start together with the
+ * number of the position they belong to. On top of each sorted array an
+ * implicit interval tree (every element is augmented with the largest end
+ * in its subtree) answers overlap queries in O(log n + k). Positions with
+ * a NaN coordinate are not indexed.
+ *
+ * The index is immutable and does not follow later changes of the data
+ * it was built from. It is obtained and kept up to date by the back-end,
+ * see {@link MultiTag::positionsInRange} and {@link MultiTag::overlapping}.
+ */
+class NIXAPI IntervalIndex {
+
+public:
+
+    /**
+     * @brief Constructor that creates an empty index.
+     */
+    IntervalIndex();
+
+    /**
+     * @brief Build the index from row-major positions and extents.
+     *
+     * @param dimensions    The number of coordinates of each position.
+     * @param positions     The positions, one row of coordinates per position.
+     * @param extents       The extents in the same layout, or an empty vector
+     *                      if the positions are points.
+     */
+    IntervalIndex(size_t dimensions, const std::vector<double> &positions, const std::vector<double> &extents);
+
+    /**
+     * @brief Read the positions and extents of a multi tag and build the index.
+     *
+     * @param positions     The positions of the tag, either one- or two-dimensional.
+     * @param extents       The extents of the tag; may be null.
+     */
+    static IntervalIndex build(const base::IDataArray &positions, const std::shared_ptr<base::IDataArray> &extents);
+
+    /**
+     * @brief Restore an index from its sorted arrays.
+     *
+     * The arrays are the ones returned by {@link starts}, {@link ends} and
+     * {@link rows} of a previously built index; they are not sorted again.
+     *
+     * @param dimensions    The number of coordinates of each position.
+     * @param positions     The total number of positions, including the
+     *                      ones that were not indexed.
+     */
+    static IntervalIndex fromSorted(size_t dimensions, ndsize_t positions, std::vector<double> starts,
+                                    std::vector<double> ends, std::vector<ndsize_t> rows);
+
+    /**
+     * @brief The number of coordinates of each position.
+     */
+    size_t dimensionCount() const { return dims; }
+
+    /**
+     * @brief The number of positions the index was built from.
+     */
+    ndsize_t positionCount() const { return total; }
+
+    /**
+     * @brief The number of indexed positions.
+     */
+    ndsize_t size() const { return count; }
+
+    /**
+     * @brief The positions whose coordinate along a dimension lies in [lo, hi].
+     *
+     * @return The numbers of the positions, ordered by their coordinate.
+     */
+    std::vector<ndsize_t> inRange(double lo, double hi, size_t dim) const;
+
+    /**
+     * @brief The positions whose interval along a dimension overlaps [lo, hi].
+     *
+     * @return The numbers of the positions, ordered by their coordinate.
+     */
+    std::vector<ndsize_t> overlapping(double lo, double hi, size_t dim) const;
+
+    /**
+     * @brief The positions whose region overlaps the window [lo, hi].
+     *
+     * The window may constrain fewer dimensions than the positions have,
+     * the remaining dimensions are not restricted.
+     *
+     * @return The numbers of the positions, ordered by their first coordinate.
+     */
+    std::vector<ndsize_t> overlapping(const std::vector<double> &lo, const std::vector<double> &hi) const;
+
+    /**
+     * @brief The starts of all indexed intervals, dimension after dimension,
+     *        each sorted.
+     */
+    const std::vector<double> &starts() const { return sorted_start; }
+
+    /**
+     * @brief The ends of the intervals in the order of {@link starts}.
+     */
+    const std::vector<double> &ends() const { return sorted_end; }
+
+    /**
+     * @brief The numbers of the positions in the order of {@link starts}.
+     */
+    const std::vector<ndsize_t> &rows() const { return sorted_row; }
+
+private:
+
+    size_t dims;
+    ndsize_t total, count;
+
+    // dims x count, each dimension sorted by start
+    std::vector<double> sorted_start, sorted_end, max_end;
+    std::vector<ndsize_t> sorted_row;
+    std::vector<int> max_level;
+
+    // dims x total, the intervals by position, NaN if not indexed
+    std::vector<double> row_start, row_end;
+
+    void prepare();
+
+    void checkDimension(size_t dim, const char *where) const;
+
+    template<typename F>
+    void query(size_t dim, double lo, double hi, F &&emit) const;
+};
+
+} // namespace nix
+
+#endif // NIX_INTERVAL_INDEX_H
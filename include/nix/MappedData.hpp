@@ -0,0 +1,146 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_MAPPED_DATA_H
+#define NIX_MAPPED_DATA_H
+
+#include <nix/DataType.hpp>
+#include <nix/Exception.hpp>
+#include <nix/NDSize.hpp>
+#include <nix/Platform.hpp>
+
+#include <memory>
+#include <stdexcept>
+
+namespace nix {
+
+/**
+ * @brief Read-only, typed view of the complete data of a {@link DataArray}.
+ *
+ * The view is obtained with {@link DataArray::mapData}. If possible, the
+ * data is mapped into memory directly from the file, otherwise it is read
+ * into a private buffer once. In both cases the view holds the raw stored
+ * values, i.e. like {@link DataArray::getDataDirect} no polynomial or
+ * expansion origin is applied. The elements are laid out in row-major
+ * order; {@link strides} gives the distance between neighbouring elements
+ * of every dimension, in elements.
+ *
+ * Copies of a view share the underlying memory, which stays valid as long
+ * as one copy exists, even after the file was closed.
+ *
+ * ~~~
+ * nix::MappedData view = array.mapData();
+ * const double *values = view.as<double>();
+ * double x = view.at<double>({2, 3});
+ * ~~~
+ */
+class NIXAPI MappedData {
+
+public:
+
+    /**
+     * @brief Constructor that creates an empty view.
+     */
+    MappedData()
+        : dtype(DataType::Nothing), ptr(nullptr), mapped(false) { }
+
+    /**
+     * @brief Create a view of memory that is kept alive by storage.
+     *
+     * @param dtype     The type of the elements.
+     * @param shape     The extent of the data.
+     * @param storage   Owner of the memory, released with the last copy of the view.
+     * @param data      Pointer to the first element.
+     * @param mapped    Whether data points into a mapping of the file.
+     */
+    MappedData(DataType dtype, const NDSize &shape, std::shared_ptr<const void> storage,
+               const void *data, bool mapped)
+        : dtype(dtype), extent(shape), stride(shape.size(), 1), holder(std::move(storage)),
+          ptr(data), mapped(mapped)
+    {
+        for (size_t i = extent.size(); i > 1; i--) {
+            stride[i - 2] = stride[i - 1] * extent[i - 1];
+        }
+    }
+
+
+    DataType dataType() const { return dtype; }
+
+
+    NDSize shape() const { return extent; }
+
+    /**
+     * @brief The distance between two neighbouring elements of every
+     *        dimension, in elements.
+     */
+    NDSize strides() const { return stride; }
+
+    /**
+     * @brief The total number of elements.
+     */
+    ndsize_t size() const { return extent.size() ? extent.nelms() : 0; }
+
+    /**
+     * @brief Whether the view points directly into the file instead of
+     *        a copy of the data.
+     */
+    bool isMapped() const { return mapped; }
+
+
+    bool empty() const { return ptr == nullptr; }
+
+
+    const void *data() const { return ptr; }
+
+    /**
+     * @brief Access the elements as an array of T.
+     *
+     * @throws std::invalid_argument If T does not match the data type of the view.
+     */
+    template<typename T>
+    const T *as() const {
+        if (to_data_type<T>::value != dtype) {
+            throw std::invalid_argument("MappedData::as: type does not match the data type of the view");
+        }
+        return static_cast<const T *>(ptr);
+    }
+
+    /**
+     * @brief Get the element at the given index.
+     *
+     * @throws nix::OutOfBounds If the index lies outside of the data.
+     * @throws nix::InvalidRank If the rank of the index does not match.
+     */
+    template<typename T>
+    T at(const NDSize &index) const {
+        if (index.size() != extent.size()) {
+            throw InvalidRank("MappedData::at: rank of index and data do not match");
+        }
+        ndsize_t pos = 0;
+        for (size_t i = 0; i < index.size(); i++) {
+            if (index[i] >= extent[i]) {
+                throw OutOfBounds("MappedData::at: index is out of bounds", index[i]);
+            }
+            pos += index[i] * stride[i];
+        }
+        return as<T>()[pos];
+    }
+
+private:
+
+    DataType dtype;
+    NDSize extent;
+    NDSize stride;
+    std::shared_ptr<const void> holder;
+    const void *ptr;
+    bool mapped;
+};
+
+} // namespace nix
+
+#endif // NIX_MAPPED_DATA_H
@@ -0,0 +1,309 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_METADATA_SNAPSHOT_H
+#define NIX_METADATA_SNAPSHOT_H
+
+#include <nix/Platform.hpp>
+#include <nix/DataType.hpp>
+#include <nix/Value.hpp>
+
+#include <boost/optional.hpp>
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <ctime>
+
+namespace nix {
+
+/**
+ * @brief Compact in-memory copy of the metadata tree of a file.
+ *
+ * A snapshot holds all sections, properties and values of a metadata tree
+ * in three flat arrays. Entities are addressed by their index into these
+ * arrays; the parent/child relations are stored as indices as well. The
+ * snapshot is a plain value and keeps no reference to the file it was read
+ * from, therefore it can be queried without touching the back-end at all.
+ *
+ * Snapshots are either created by {@link nix::File::loadMetadataSnapshot}
+ * or assembled by hand with {@link addSection} and {@link addProperty}.
+ * A snapshot can be written to a file in one batch with
+ * {@link nix::File::storeMetadataSnapshot}.
+ *
+ * ~~~
+ * nix::MetadataSnapshot snap = file.loadMetadataSnapshot();
+ * size_t rec = snap.findSection("recording");
+ * for (size_t p : snap.properties(rec)) {
+ *     std::cout << snap.property(p).name << std::endl;
+ * }
+ * ~~~
+ */
+class NIXAPI MetadataSnapshot {
+
+public:
+
+    /**
+     * @brief Index value that denotes "no entity", e.g. the parent
+     *        of a root section or a failed lookup.
+     */
+    static const size_t npos = static_cast<size_t>(-1);
+
+    /**
+     * @brief A section in the snapshot.
+     */
+    struct SectionNode {
+        std::string id;
+        std::string name;
+        std::string type;
+        boost::optional<std::string> definition;
+        boost::optional<std::string> repository;
+        boost::optional<std::string> mapping;
+        /// The id of the linked section, if any.
+        boost::optional<std::string> link;
+        time_t created_at = 0;
+        time_t updated_at = 0;
+        /// Index of the parent section or npos for root sections.
+        size_t parent = npos;
+    };
+
+    /**
+     * @brief A property in the snapshot.
+     *
+     * The values of the property are stored as a contiguous range inside
+     * the value array of the snapshot, see {@link MetadataSnapshot::values}.
+     */
+    struct PropertyNode {
+        std::string id;
+        std::string name;
+        boost::optional<std::string> definition;
+        boost::optional<std::string> unit;
+        boost::optional<std::string> mapping;
+        DataType data_type = DataType::Nothing;
+        time_t created_at = 0;
+        time_t updated_at = 0;
+        /// Index of the section the property belongs to.
+        size_t section = npos;
+        size_t value_offset = 0;
+        size_t value_count = 0;
+    };
+
+    /**
+     * @brief Read-only range of entity indices.
+     */
+    class IndexRange {
+        const size_t *first, *last;
+    public:
+        IndexRange(const size_t *first, const size_t *last) : first(first), last(last) {}
+
+        const size_t *begin() const { return first; }
+        const size_t *end() const { return last; }
+        size_t size() const { return static_cast<size_t>(last - first); }
+        bool empty() const { return first == last; }
+        size_t operator[](size_t i) const { return first[i]; }
+    };
+
+    /**
+     * @brief Read-only range of the values of a property.
+     */
+    class ValueRange {
+        const Value *first, *last;
+    public:
+        ValueRange(const Value *first, const Value *last) : first(first), last(last) {}
+
+        const Value *begin() const { return first; }
+        const Value *end() const { return last; }
+        size_t size() const { return static_cast<size_t>(last - first); }
+        bool empty() const { return first == last; }
+        const Value &operator[](size_t i) const { return first[i]; }
+    };
+
+    MetadataSnapshot() : index_dirty(true) {}
+
+    //--------------------------------------------------
+    // Building the snapshot
+    //--------------------------------------------------
+
+    /**
+     * @brief Append a section to the snapshot.
+     *
+     * @param name      The name of the section.
+     * @param type      The type of the section.
+     * @param parent    Index of the parent section or npos for a root section.
+     * @param id        The id of the section; if empty an id is generated
+     *                  once the snapshot is stored.
+     *
+     * @return The index of the new section.
+     */
+    size_t addSection(const std::string &name, const std::string &type,
+                      size_t parent = npos, const std::string &id = "");
+
+    /**
+     * @brief Append a property with the given values to a section.
+     *
+     * @param section   Index of the section the property belongs to.
+     * @param name      The name of the property.
+     * @param values    The values of the property; must not be empty.
+     * @param id        The id of the property; if empty an id is generated
+     *                  once the snapshot is stored.
+     *
+     * @return The index of the new property.
+     */
+    size_t addProperty(size_t section, const std::string &name, const std::vector<Value> &values,
+                       const std::string &id = "");
+
+    /**
+     * @brief Append a property without values to a section.
+     *
+     * @param section   Index of the section the property belongs to.
+     * @param name      The name of the property.
+     * @param dtype     The data type of the property.
+     * @param id        The id of the property; if empty an id is generated
+     *                  once the snapshot is stored.
+     *
+     * @return The index of the new property.
+     */
+    size_t addProperty(size_t section, const std::string &name, DataType dtype,
+                       const std::string &id = "");
+
+    /**
+     * @brief Remove all entities from the snapshot.
+     */
+    void clear();
+
+    //--------------------------------------------------
+    // Entity access
+    //--------------------------------------------------
+
+    size_t sectionCount() const { return section_nodes.size(); }
+
+    size_t propertyCount() const { return property_nodes.size(); }
+
+    size_t valueCount() const { return value_data.size(); }
+
+    bool empty() const { return section_nodes.empty(); }
+
+    /**
+     * @brief Access a section by index.
+     *
+     * The id, name and type of the section may be changed through the
+     * returned reference, the parent must not be changed.
+     */
+    SectionNode &section(size_t index);
+
+    const SectionNode &section(size_t index) const;
+
+    /**
+     * @brief Access a property by index.
+     *
+     * The value range and the section of the property must not be
+     * changed through the returned reference.
+     */
+    PropertyNode &property(size_t index);
+
+    const PropertyNode &property(size_t index) const;
+
+    /**
+     * @brief The indices of all root sections in insertion order.
+     */
+    IndexRange rootSections() const;
+
+    /**
+     * @brief The indices of the direct sub-sections of a section.
+     */
+    IndexRange sections(size_t section) const;
+
+    /**
+     * @brief The indices of the properties of a section.
+     */
+    IndexRange properties(size_t section) const;
+
+    /**
+     * @brief The values of a property.
+     */
+    ValueRange values(size_t property) const;
+
+    //--------------------------------------------------
+    // Queries
+    //--------------------------------------------------
+
+    /**
+     * @brief Find a section by id or name.
+     *
+     * Ids are looked up first; if no section has the given id the first
+     * section (in insertion order) with the given name is returned.
+     *
+     * @param name_or_id    Name or id of the section.
+     *
+     * @return The index of the section or npos.
+     */
+    size_t findSection(const std::string &name_or_id) const;
+
+    /**
+     * @brief Find a section anywhere in the tree by its id.
+     *
+     * @return The index of the section or npos.
+     */
+    size_t findSectionById(const std::string &id) const;
+
+    /**
+     * @brief Find all sections with the given name, anywhere in the tree.
+     */
+    std::vector<size_t> findSectionsByName(const std::string &name) const;
+
+    /**
+     * @brief Find all sections with the given type, anywhere in the tree.
+     */
+    std::vector<size_t> findSectionsByType(const std::string &type) const;
+
+    /**
+     * @brief Find a property of a section by id or name.
+     *
+     * @param section       Index of the section.
+     * @param name_or_id    Name or id of the property.
+     *
+     * @return The index of the property or npos.
+     */
+    size_t findProperty(size_t section, const std::string &name_or_id) const;
+
+    /**
+     * @brief Find a property anywhere in the tree by its id.
+     *
+     * @return The index of the property or npos.
+     */
+    size_t findPropertyById(const std::string &id) const;
+
+    /**
+     * @brief The slash separated names of all sections from the root
+     *        down to the given section, e.g. "/subject/eye".
+     */
+    std::string path(size_t section) const;
+
+private:
+
+    std::vector<SectionNode> section_nodes;
+    std::vector<PropertyNode> property_nodes;
+    std::vector<Value> value_data;
+
+    // lookup tables, rebuilt lazily after the tree was changed
+    mutable bool index_dirty;
+    mutable std::vector<size_t> root_index;
+    mutable std::vector<size_t> child_offsets, child_index;
+    mutable std::vector<size_t> prop_offsets, prop_index;
+    mutable std::unordered_map<std::string, size_t> section_ids, property_ids;
+    mutable std::unordered_multimap<std::string, size_t> section_names, section_types;
+
+    void checkSection(size_t index, const char *where) const;
+
+    void buildIndex() const;
+};
+
+
+} // namespace nix
+
+#endif // NIX_METADATA_SNAPSHOT_H
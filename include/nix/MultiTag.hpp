@@ -272,6 +272,18 @@ public:
      */
     void addReference(const DataArray &reference);
 
+    /**
+     * @brief Add several DataArrays to the list of referenced data at once.
+     *
+     * All arrays are checked before the first one is added; if one of them
+     * does not belong to the block of the tag none is added. The arrays are
+     * linked directly through the given handles, without looking them up
+     * in the block. Arrays that are already referenced are skipped.
+     *
+     * @param references    The DataArrays to add.
+     */
+    void addReferences(const std::vector<DataArray> &references);
+
     /**
      * @brief Remove a DataArray from the list of referenced data.
      *
@@ -345,6 +357,63 @@ public:
      */
     DataView retrieveData(size_t position_index, size_t reference_index) const;
 
+    //--------------------------------------------------
+    // Queries on positions and extents
+    //--------------------------------------------------
+
+    /**
+     * @brief Find the positions that lie in a range.
+     *
+     * The queries on positions and extents use a sorted index that is built
+     * from the data of both arrays on first use. Depending on the back-end
+     * the index is kept in the file and rebuilt only after the positions or
+     * extents were changed. A query then costs O(log n + k) for k results.
+     * Positions with a NaN coordinate are never found.
+     *
+     * The index that the HDF5 back-end keeps in the file is tied to the
+     * versions of the positions and extents, which are only maintained by
+     * this library outside of SWMR writing. Positions or extents that were
+     * overwritten in place during SWMR writing, or by other software, are
+     * not noticed in later sessions; writing them once more in ReadWrite
+     * mode drops the stored index.
+     *
+     * @param lo        Lower bound of the range (inclusive).
+     * @param hi        Upper bound of the range (inclusive).
+     * @param dim       The dimension of the positions to look at, i.e. the
+     *                  column of a two-dimensional positions array.
+     *
+     * @return The indices of the positions, ordered by their coordinate.
+     */
+    std::vector<ndsize_t> positionsInRange(double lo, double hi, size_t dim = 0) const;
+
+    /**
+     * @brief Find the tagged regions that overlap a range.
+     *
+     * A region [position, position + extent] overlaps [lo, hi] if it
+     * touches the range. Without extents this is the same as
+     * {@link positionsInRange}.
+     *
+     * @param lo        Lower bound of the range (inclusive).
+     * @param hi        Upper bound of the range (inclusive).
+     * @param dim       The dimension of the positions to look at.
+     *
+     * @return The indices of the positions, ordered by their coordinate.
+     */
+    std::vector<ndsize_t> overlapping(double lo, double hi, size_t dim = 0) const;
+
+    /**
+     * @brief Find the tagged regions that overlap a window.
+     *
+     * The window may span fewer dimensions than the positions, further
+     * dimensions are not restricted.
+     *
+     * @param lo        Lower bounds of the window, one per dimension.
+     * @param hi        Upper bounds of the window, one per dimension.
+     *
+     * @return The indices of the positions, ordered by their first coordinate.
+     */
+    std::vector<ndsize_t> overlapping(const std::vector<double> &lo, const std::vector<double> &hi) const;
+
     //--------------------------------------------------
     // Methods concerning features.
     //--------------------------------------------------
@@ -12,6 +12,7 @@
 
 
 #include <nix/Hydra.hpp>
+#include <nix/Buffer.hpp>
 #include <nix/NDSize.hpp>
 #include <nix/Platform.hpp>
 
@@ -27,7 +28,19 @@ public:
 
     typedef uint8_t byte_type;
 
-    NDArray(DataType dtype, NDSize dims);
+    /**
+     * @brief Create an array of the given type and shape.
+     *
+     * The storage is 64-byte aligned. If zero_fill is false the elements
+     * are left uninitialized, which saves a pass over the memory when the
+     * array is filled right away, e.g. by reading data into it; this also
+     * applies to elements added by {@link resize}.
+     *
+     * @param dtype     The data type of the elements.
+     * @param dims      The shape of the array.
+     * @param zero_fill Whether the elements are set to zero.
+     */
+    NDArray(DataType dtype, NDSize dims, bool zero_fill = true);
 
     size_t rank() const { return extends.size(); }
     ndsize_t num_elements() const { return extends.nelms(); }
@@ -55,7 +68,8 @@ private:
 
     NDSize                  extends;
     NDSize                  strides;
-    std::vector<byte_type> dstore;
+    Buffer<byte_type>       dstore;
+    bool                    zero_fill;
 
 };
 
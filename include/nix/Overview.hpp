@@ -0,0 +1,50 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_OVERVIEW_H
+#define NIX_OVERVIEW_H
+
+#include <nix/NDArray.hpp>
+#include <nix/Platform.hpp>
+
+namespace nix {
+
+/**
+ * @brief Result of {@link DataArray::overview}.
+ *
+ * Each point of an overview summarizes {@link factor} consecutive samples
+ * along the axis by their minimum, maximum and mean. Minimum and maximum
+ * ignore NaN values, the mean is NaN if any of the samples is.
+ */
+struct NIXAPI Overview {
+    /** The axis along which samples are combined. */
+    size_t axis = 0;
+    /** Number of samples per point, 1 if the points are the samples themselves. */
+    ndsize_t factor = 1;
+    /** Index along the axis of the first sample of the first point. */
+    ndsize_t offset = 0;
+    /** Position of the first sample of the first point, in the unit of the dimension. */
+    double start = 0.0;
+    /** Distance between the first samples of two points. */
+    double step = 0.0;
+    /** Shaped like the data with the axis replaced by the points. */
+    NDArray min, max, mean;
+
+    Overview()
+        : min(DataType::Double, {}), max(DataType::Double, {}), mean(DataType::Double, {})
+    {}
+
+    /** The number of points. */
+    ndsize_t size() const {
+        return min.rank() > axis ? min.shape()[axis] : 0;
+    }
+};
+
+} // namespace nix
+
+#endif // NIX_OVERVIEW_H
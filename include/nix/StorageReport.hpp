@@ -0,0 +1,159 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_STORAGE_REPORT_H
+#define NIX_STORAGE_REPORT_H
+
+#include <nix/Platform.hpp>
+#include <nix/DataType.hpp>
+#include <nix/NDSize.hpp>
+
+#include <string>
+#include <vector>
+
+namespace nix {
+
+/**
+ * @brief Storage layout and size of the entities of a file.
+ *
+ * The report is collected by {@link nix::File::storageReport} in a single
+ * pass over all objects of the file. It tells how much space the data of
+ * every DataArray takes, how the data is laid out and how many entities
+ * and back-end objects the blocks consist of.
+ *
+ * ~~~
+ * nix::StorageReport report = file.storageReport();
+ * for (const auto &array : report.arrays) {
+ *     std::cout << array.name << ": " << array.storage_bytes << " bytes, "
+ *               << array.readAmplification(array.rowSlab()) << std::endl;
+ * }
+ * ~~~
+ */
+struct NIXAPI StorageReport {
+
+    /**
+     * @brief Storage of the data of a DataArray.
+     */
+    struct Array {
+        std::string block;
+        std::string name;
+        /// Path of the array within the file, e.g. "/data/b/data_arrays/a".
+        std::string path;
+        DataType data_type = DataType::Nothing;
+        NDSize extent;
+        /// The chunk shape, empty if the data is not stored in chunks.
+        NDSize chunks;
+        /// Number of chunks that have storage allocated; with HDF5 older
+        /// than 1.10.5 an upper bound for compressed data.
+        ndsize_t chunk_count = 0;
+        /// Names of the filters applied to every chunk, in pipeline order.
+        std::vector<std::string> filters;
+        /// Size of the values, the number of elements times the element size.
+        ndsize_t logical_bytes = 0;
+        /// Size of the values the allocated storage can hold, including
+        /// the padding of chunks at the edges of the data.
+        ndsize_t allocated_bytes = 0;
+        /// Bytes actually used in the file, after filtering.
+        ndsize_t storage_bytes = 0;
+        /// Bytes used by derived data, e.g. overviews.
+        ndsize_t derived_bytes = 0;
+
+        /**
+         * @brief Ratio of allocated to stored bytes, 1 without filters.
+         */
+        double compressionRatio() const;
+
+        /**
+         * @brief Expected number of bytes that have to be read and
+         *        decoded per requested byte when reading a slab.
+         *
+         * Data stored in chunks can only be read in whole chunks, so
+         * reading a slab of the given shape at an arbitrary position
+         * reads all chunks it touches. Contiguous data is read exactly.
+         *
+         * @param count The shape of the slab that is read.
+         *
+         * @return The read amplification, at least 1.
+         */
+        double readAmplification(const NDSize &count) const;
+
+        /**
+         * @brief Slab of one element along the first axis and the whole
+         *        extent along all others, e.g. one sample of all channels.
+         */
+        NDSize rowSlab() const;
+
+        /**
+         * @brief Slab of the whole extent along the first axis and one
+         *        element along all others, e.g. one channel over time.
+         */
+        NDSize columnSlab() const;
+    };
+
+    /**
+     * @brief Number of entities and back-end objects of a block.
+     */
+    struct Block {
+        std::string name;
+        size_t data_arrays = 0;
+        size_t dimensions = 0;
+        size_t tags = 0;
+        size_t multi_tags = 0;
+        size_t features = 0;
+        size_t sources = 0;
+        size_t groups = 0;
+        /// All groups and data sets below the block.
+        size_t objects = 0;
+        /// Attributes of all objects below the block.
+        size_t attributes = 0;
+    };
+
+    /**
+     * @brief A group and the number of links it contains.
+     */
+    struct Group {
+        std::string path;
+        size_t children = 0;
+    };
+
+    /**
+     * @brief How many groups {@link largest_groups} holds at most.
+     */
+    static const size_t max_largest_groups = 16;
+
+    std::string format;
+    std::string location;
+    /// Size of the file, 0 if the back-end does not store a single file.
+    ndsize_t file_size = 0;
+    size_t objects = 0;
+    size_t attributes = 0;
+    size_t sections = 0;
+    size_t properties = 0;
+    /// Bytes used by object headers, indices and heaps of all objects.
+    ndsize_t metadata_bytes = 0;
+
+    std::vector<Array> arrays;
+    std::vector<Block> blocks;
+    /// The groups with the most children, the largest first.
+    std::vector<Group> largest_groups;
+
+    /**
+     * @brief Record a group, keeping only the largest
+     *        {@link max_largest_groups} groups.
+     */
+    void addGroup(const std::string &path, size_t children);
+
+    /**
+     * @brief The sum of the storage of all arrays, including derived data.
+     */
+    ndsize_t storageBytes() const;
+};
+
+} // namespace nix
+
+#endif // NIX_STORAGE_REPORT_H
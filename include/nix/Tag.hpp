@@ -254,6 +254,18 @@ public:
      */
     void addReference(const std::string &id);
 
+    /**
+     * @brief Add several DataArrays to the list of referenced data at once.
+     *
+     * All arrays are checked before the first one is added; if one of them
+     * does not belong to the block of the tag none is added. The arrays are
+     * linked directly through the given handles, without looking them up
+     * in the block. Arrays that are already referenced are skipped.
+     *
+     * @param references    The DataArrays to add.
+     */
+    void addReferences(const std::vector<DataArray> &references);
+
     /**
      * @brief Remove a DataArray from the list of referenced data of the tag.
      *
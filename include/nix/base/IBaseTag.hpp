@@ -48,6 +48,9 @@ public:
     virtual void addReference(const std::string &id) = 0;
 
 
+    virtual void addReferences(const std::vector<DataArray> &references) = 0;
+
+
     virtual bool removeReference(const std::string &id) = 0;
 
     virtual void references(const std::vector<DataArray> &references) = 0;
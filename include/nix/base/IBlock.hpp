@@ -22,6 +22,9 @@
 #include <memory>
 
 namespace nix {
+
+class BlockBatch;
+
 namespace base {
 
 /**
@@ -73,6 +76,13 @@ public:
 
     virtual bool deleteDataArray(const std::string &name_or_id) = 0;
 
+    /**
+     * @brief Delete several data arrays at once.
+     *
+     * @return The number of deleted data arrays.
+     */
+    virtual ndsize_t deleteDataArrays(const std::vector<std::string> &names_or_ids) = 0;
+
     //--------------------------------------------------
     // Methods concerning tags.
     //--------------------------------------------------
@@ -139,6 +149,20 @@ public:
 
     virtual bool deleteGroup(const std::string &name_or_id) = 0;
 
+    //--------------------------------------------------
+    // Batched creation
+    //--------------------------------------------------
+
+    /**
+     * @brief Create all entities of a batch.
+     *
+     * The batch was validated by the front-end: all entities have ids,
+     * their names are not used in the block and all sources and
+     * references are given by the id of an entity of the batch or
+     * of the block.
+     */
+    virtual void createBatch(const BlockBatch &batch) = 0;
+
 
     virtual ~IBlock() {}
 };
@@ -11,9 +11,15 @@
 
 #include <nix/base/IEntityWithSources.hpp>
 #include <nix/base/IDimensions.hpp>
+#include <nix/DimensionDescriptor.hpp>
+#include <nix/Buffer.hpp>
 #include <nix/DataType.hpp>
+#include <nix/MappedData.hpp>
 #include <nix/NDSize.hpp>
 
+#include <boost/optional.hpp>
+
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -96,6 +102,9 @@ public:
 
     virtual bool deleteDimensions() = 0;
 
+
+    virtual std::vector<DimensionDescriptor> dimensionDescriptors() const = 0;
+
     //--------------------------------------------------
     // Methods concerning data access.
     //--------------------------------------------------
@@ -154,6 +163,77 @@ public:
 
     virtual DataType dataType(void) const = 0;
 
+    /**
+     * @brief Map the stored data into memory without copying it.
+     *
+     * @return A view of the raw file contents, or none if the storage
+     *         layout does not permit a direct mapping.
+     */
+    virtual boost::optional<MappedData> mapData() const = 0;
+
+    /**
+     * @brief The chunk shape of the stored data, empty if the data is not chunked.
+     */
+    virtual NDSize chunkExtent() const = 0;
+
+    /**
+     * @brief Whether the data may be read by several threads at once.
+     */
+    virtual bool concurrentReads() const = 0;
+
+    /**
+     * @brief Store the bytes of one chunk as they are.
+     *
+     * @param chunk         The coordinates of the chunk in the chunk grid.
+     * @param data          The stored representation of the chunk.
+     * @param nbytes        The number of bytes in data.
+     * @param filter_mask   Bit i is set if filter i was not applied to data.
+     */
+    virtual void writeChunk(const NDSize &chunk, const void *data, size_t nbytes, uint32_t filter_mask) = 0;
+
+    /**
+     * @brief Read the stored bytes of one chunk.
+     *
+     * @param chunk         The coordinates of the chunk in the chunk grid.
+     * @param data          Receives the bytes of the chunk.
+     * @param filter_mask   Receives the filter mask the chunk was stored with.
+     *
+     * @return false if the chunk was never written.
+     */
+    virtual bool readChunk(const NDSize &chunk, Buffer<char> &data, uint32_t &filter_mask) const = 0;
+
+    //--------------------------------------------------
+    // Derived data
+    //--------------------------------------------------
+
+    /**
+     * @brief The extent of an array of doubles that was derived from the data.
+     *
+     * Derived arrays are stored with the data array, but are not part of the
+     * data model. Each one belongs to the data as it was when the array was
+     * last written; once the data or its calibration changed in any other way
+     * the derived array is considered missing.
+     *
+     * @return The extent, empty if the array does not exist or is outdated.
+     */
+    virtual NDSize derivedExtent(const std::string &name) const = 0;
+
+
+    virtual void readDerived(const std::string &name, double *data, const NDSize &count, const NDSize &offset) const = 0;
+
+    /**
+     * @brief Write part of a derived array.
+     *
+     * The array is created or resized to the given extent first. Afterwards
+     * it belongs to the current data, the caller is responsible for having
+     * brought all of it up to date.
+     */
+    virtual void writeDerived(const std::string &name, const NDSize &extent, const double *data,
+                              const NDSize &count, const NDSize &offset) = 0;
+
+
+    virtual void deleteDerived(const std::string &name) = 0;
+
     /**
      * @brief Destructor
      */
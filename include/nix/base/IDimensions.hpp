@@ -121,6 +121,21 @@ public:
 
     virtual void labels(const none_t t) = 0;
 
+    /**
+     * @brief The number of labels, without reading them.
+     */
+    virtual ndsize_t labelCount() const = 0;
+
+    /**
+     * @brief The indices of the given labels.
+     *
+     * Implementations should keep a hash table of the labels, so that
+     * repeated lookups do not read the labels again.
+     *
+     * @throws nix::OutOfBounds If one of the labels does not exist.
+     */
+    virtual std::vector<ndsize_t> indicesOf(const std::vector<std::string> &labels) const = 0;
+
 
     virtual ~ISetDimension() {}
 
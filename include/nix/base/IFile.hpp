@@ -11,6 +11,8 @@
 
 #include <nix/base/ISection.hpp>
 #include <nix/base/IBlock.hpp>
+#include <nix/MetadataSnapshot.hpp>
+#include <nix/StorageReport.hpp>
 #include <nix/Platform.hpp>
 
 #include <string>
@@ -25,7 +27,11 @@ namespace nix {
 NIXAPI enum class FileMode {
     ReadOnly = 0,
     ReadWrite,
-    Overwrite
+    Overwrite,
+    /** Single writer of a file that is read concurrently, see {@link File::startSWMRWrite}. */
+    SWMRWrite,
+    /** Reader of a file that is written concurrently in SWMRWrite mode. */
+    SWMRRead
 };
 
 
@@ -85,6 +91,15 @@ public:
 
     virtual bool deleteSection(const std::string &name_or_id) = 0;
 
+
+    virtual MetadataSnapshot loadMetadataSnapshot() const = 0;
+
+
+    virtual void storeMetadataSnapshot(const MetadataSnapshot &snapshot) = 0;
+
+
+    virtual StorageReport storageReport() const = 0;
+
     //--------------------------------------------------
     // Methods for file attribute access.
     //--------------------------------------------------
@@ -125,6 +140,15 @@ public:
     virtual FileMode fileMode() const = 0;
 
 
+    virtual void startSWMRWrite() = 0;
+
+
+    virtual void flushInterval(double seconds) = 0;
+
+
+    virtual double flushInterval() const = 0;
+
+
     virtual ~IFile() {}
 
 };
@@ -21,6 +21,7 @@
 namespace nix {
 
 class DataArray;
+class IntervalIndex;
 
 namespace base {
 
@@ -63,6 +64,13 @@ public:
 
     virtual void units(const none_t t) = 0;
 
+    /**
+     * @brief The sorted index over positions and extents.
+     *
+     * Built on first use and rebuilt once the positions or extents changed.
+     */
+    virtual std::shared_ptr<const IntervalIndex> intervalIndex() const = 0;
+
     /**
      * @brief Destructor
      */
@@ -0,0 +1,177 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_COPY_H
+#define NIX_COPY_H
+
+#include <nix/Block.hpp>
+#include <nix/File.hpp>
+#include <nix/NDSize.hpp>
+#include <nix/Platform.hpp>
+
+#include <boost/optional.hpp>
+
+#include <string>
+#include <vector>
+
+namespace nix {
+namespace util {
+
+/**
+ * @brief Options of {@link copyFile}.
+ */
+struct NIXAPI CopyOptions {
+    /** The back-end of the new file, "hdf5" or "file". */
+    std::string backend = "hdf5";
+    /** Target size of a chunk in bytes; 0 keeps the chunk shape of the
+        source, or lets the library choose one if the source has none.
+        Chunking and compression only apply to HDF5 files. */
+    size_t chunk_bytes = 0;
+    /** Deflate level from 1 to 9, 0 stores the data uncompressed. If not
+        set, every array keeps the deflate level of the source. */
+    boost::optional<unsigned> compression;
+    /** Shuffle the bytes of the values before compressing them. If not
+        set, every array keeps the shuffle filter of the source, unless
+        compression is 0. */
+    boost::optional<bool> shuffle;
+    /** Number of threads that compress chunks of HDF5 files or copy the
+        data of the arrays of file system files, 0 uses one per core. */
+    size_t jobs = 0;
+    /** Compare the copy with the source after writing it. */
+    bool verify = false;
+};
+
+/**
+ * @brief Result of {@link copyFile}.
+ */
+struct NIXAPI CopyReport {
+    size_t blocks = 0;
+    size_t data_arrays = 0;
+    /** Number of chunks written, only for HDF5 files, and the size of
+        the copied values. */
+    ndsize_t chunks = 0;
+    ndsize_t bytes = 0;
+    /** Time taken by the copy, without verification. */
+    double seconds = 0;
+    /** Time taken to read all data of the source and of the copy
+        during verification, 0 if the copy was not verified. */
+    double source_read_seconds = 0;
+    double target_read_seconds = 0;
+};
+
+/**
+ * @brief Copy a file into a new file, e.g. to change its storage settings
+ *        or its back-end.
+ *
+ * The source is traversed once and all sections, blocks and entities are
+ * recreated in the new file with their ids and creation times. Because
+ * every object is written anew, the copy contains no free space left
+ * behind by deleted entities and the indices of all groups are rebuilt.
+ * Derived data, e.g. overviews, is not copied.
+ *
+ * In HDF5 files the numeric data of all DataArrays is stored in chunks
+ * with the chunk size and filters of the options; by default the chunk
+ * shape and the filters of every source array are kept. Copying the data is
+ * pipelined: the source is read in slabs, the chunks are assembled and
+ * compressed by a pool of threads and written in order on another thread
+ * as they become ready. If the library was built without zlib or the
+ * HDF5 library is older than 1.10.5, the slabs are written as they are
+ * and the HDF5 library compresses the chunks.
+ *
+ * Files of the file system back-end are written on the calling thread,
+ * except for the values of the arrays: every array stores them in a file
+ * of its own, which is filled by a pool of threads once the array was
+ * created, while the rest of the source is traversed.
+ *
+ * @param source    The file to copy, of any back-end.
+ * @param location  The path of the new file; an existing file is replaced.
+ * @param options   The back-end, chunking and compression of the copy.
+ *
+ * @return The number of copied entities, bytes and the time taken.
+ *
+ * @throws nix::ConsistencyError If verification finds a difference.
+ */
+NIXAPI CopyReport copyFile(const File &source, const std::string &location,
+                           const CopyOptions &options = CopyOptions());
+
+/**
+ * @brief Chunk shape of about chunk_bytes bytes for data of the given extent.
+ *
+ * The chunks span the whole extent of the last axes that fit into the
+ * budget, so that rows of the data are stored together, and as much of the
+ * next axis as fits; all leading axes are cut into single elements. An
+ * axis of extent 0, e.g. of data that is appended to later, gets all of
+ * the remaining budget.
+ *
+ * @param extent        The extent of the data.
+ * @param element_size  The size of one value in bytes.
+ * @param chunk_bytes   The target size of a chunk.
+ *
+ * @return The chunk shape, with the rank of extent and all entries >= 1.
+ */
+NIXAPI NDSize chunkShape(const NDSize &extent, size_t element_size, size_t chunk_bytes);
+
+/**
+ * @brief Create a new DataArray whose values are stored in compressed chunks.
+ *
+ * Works like Block::createDataArray. In HDF5 files the data is stored in
+ * chunks with the deflate filter of the given level, preceded by the
+ * shuffle filter if shuffle is set; the other back-ends store the data
+ * uncompressed. Values written with setData are compressed by the HDF5
+ * library, chunks prepared with {@link encodeChunk} can be stored with
+ * DataArray::writeChunk.
+ *
+ * @param block         The block of the new DataArray.
+ * @param name          The name of the DataArray.
+ * @param type          The type of the DataArray.
+ * @param data_type     The data type of the values.
+ * @param shape         The extent of the data.
+ * @param compression   Deflate level from 1 to 9, 0 for no compression.
+ * @param shuffle       Shuffle the bytes of the values before compressing them.
+ *
+ * @return The new DataArray.
+ *
+ * @throws std::invalid_argument If the compression level is larger than 9.
+ */
+NIXAPI DataArray createCompressedDataArray(Block &block, const std::string &name, const std::string &type,
+                                           DataType data_type, const NDSize &shape,
+                                           unsigned compression, bool shuffle);
+
+/**
+ * @brief Whether chunks can be prepared with {@link encodeChunk} and
+ *        stored with DataArray::writeChunk.
+ *
+ * This needs HDF5 1.10.5 or newer and, if the chunks are compressed, a
+ * library built with zlib.
+ *
+ * @param compression   The deflate level of the chunks, 0 for none.
+ */
+NIXAPI bool canWriteChunks(unsigned compression);
+
+/**
+ * @brief Run the filters of {@link createCompressedDataArray} on one chunk.
+ *
+ * The values of the whole chunk are given in little-endian byte order,
+ * chunks at the border of the data padded to the full chunk shape. They
+ * are replaced by the bytes to store with DataArray::writeChunk. Chunks
+ * can be encoded on several threads at once.
+ *
+ * @param data          The values of the chunk, replaced by the filtered bytes.
+ * @param element_size  The size of one value in bytes.
+ * @param compression   Deflate level from 1 to 9, 0 for no compression.
+ * @param shuffle       Shuffle the bytes of the values.
+ *
+ * @throws std::runtime_error If the chunk cannot be compressed, e.g.
+ *                            because the library was built without zlib.
+ */
+NIXAPI void encodeChunk(std::vector<char> &data, size_t element_size, unsigned compression, bool shuffle);
+
+} // namespace util
+} // namespace nix
+
+#endif // NIX_COPY_H
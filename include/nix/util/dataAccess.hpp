@@ -80,6 +80,53 @@ NIXAPI ndsize_t positionToIndex(double position, const std::string &unit, const
  */
 NIXAPI ndsize_t positionToIndex(double position, const std::string &unit, const RangeDimension &dimension);
 
+/**
+ * @brief Converts a position given in a unit into an index according to the dimension descriptor.
+ *
+ * Works like the overloads for the individual dimension types, but uses the
+ * resolved properties of the descriptor and does not access the file.
+ *
+ * @param position      The position
+ * @param unit          The unit in which the position is given, may be "none"
+ * @param dimension     The resolved dimension, see {@link DataArray::dimensionDescriptors}.
+ *
+ * @return The calculated index.
+ *
+ * @throws nix::IncompatibleDimension The the dimensions are incompatible.
+ * @throws nix::OutOfBounds If the position either too large or too small for the dimension.
+ */
+NIXAPI ndsize_t positionToIndex(double position, const std::string &unit, const DimensionDescriptor &dimension);
+
+/**
+ * @brief Get the factor that converts positions given in a unit into the unit of a dimension.
+ *
+ * @param unit          The unit in which positions are given, may be "none"
+ * @param dimension     The resolved dimension.
+ *
+ * @return The scaling, 1 if no conversion is needed.
+ *
+ * @throws nix::IncompatibleDimension If the unit does not fit the dimension.
+ */
+NIXAPI double positionScaling(const std::string &unit, const DimensionDescriptor &dimension);
+
+/**
+ * @brief Converts many positions given in the same unit into indices.
+ *
+ * Gives the same indices as {@link positionToIndex} for every position, but
+ * resolves the unit only once, see {@link DimensionDescriptor::indicesOf}.
+ *
+ * @param positions     The positions
+ * @param n             The number of positions
+ * @param unit          The unit in which the positions are given, may be "none"
+ * @param dimension     The resolved dimension, see {@link DataArray::dimensionDescriptors}.
+ * @param[out] indices  Receives the n indices.
+ *
+ * @throws nix::IncompatibleDimension The the dimensions are incompatible.
+ * @throws nix::OutOfBounds If a position either too large or too small for the dimension.
+ */
+NIXAPI void positionsToIndices(const double *positions, size_t n, const std::string &unit,
+                               const DimensionDescriptor &dimension, ndsize_t *indices);
+
 /**
  * @brief Returns the offsets and element counts associated with position and extent of a Tag and
  *        the referenced DataArray.
@@ -0,0 +1,113 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_REDUCE_H
+#define NIX_REDUCE_H
+
+#include <nix/DataArray.hpp>
+#include <nix/NDArray.hpp>
+#include <nix/Platform.hpp>
+
+#include <vector>
+
+namespace nix {
+namespace util {
+
+/**
+ * @brief The reductions supported by {@link reduce}.
+ */
+enum class ReduceOp {
+    Min, Max, Sum, Mean,
+    /** Population variance, i.e. the squared deviations are divided by n. */
+    Variance
+};
+
+/**
+ * @brief Result of {@link histogram}.
+ */
+struct NIXAPI Histogram {
+    double lower = 0;
+    double upper = 0;
+    /** One count per bin; bin i covers [lower + i*w, lower + (i+1)*w),
+        the last bin also includes upper. */
+    std::vector<ndsize_t> counts;
+    /** Number of values below lower and above upper. */
+    ndsize_t below = 0;
+    ndsize_t above = 0;
+
+    double binWidth() const {
+        return counts.empty() ? 0.0 : (upper - lower) / counts.size();
+    }
+};
+
+/**
+ * @brief Reduce all data of a DataArray to a single value.
+ *
+ * The data is read in slabs along the first dimension, in storage order,
+ * and converted to double; polynomial coefficients and the expansion origin
+ * of the array are applied to every slab. Slabs are processed in parallel
+ * on the given number of threads; rows that are larger than a slab are
+ * read in pieces. Memory use is bounded by the slab size times the number
+ * of threads and does not grow with the array. Slabs are aligned with the
+ * chunks of the data, every chunk is read by one thread only. Arrays that
+ * do not support concurrent reads (see DataArray::concurrentReads, only
+ * the HDF5 back-end does) are read on the calling thread.
+ *
+ * For a given number of threads the result is deterministic. Min, max,
+ * mean and variance of an empty array are NaN, its sum is 0.
+ *
+ * @param array     The DataArray to reduce.
+ * @param op        The reduction.
+ * @param threads   The number of worker threads, 0 uses one per core;
+ *                  ignored if the array does not support concurrent reads.
+ *
+ * @return The reduced value.
+ */
+NIXAPI double reduce(const DataArray &array, ReduceOp op, size_t threads = 0);
+
+/**
+ * @brief Reduce the data of a DataArray along one axis.
+ *
+ * Works like {@link reduce(const DataArray&, ReduceOp, size_t)} but only
+ * combines values along the given axis.
+ *
+ * @param array     The DataArray to reduce.
+ * @param axis      The axis along which values are combined.
+ * @param op        The reduction.
+ * @param threads   The number of worker threads, 0 uses one per core;
+ *                  ignored if the array does not support concurrent reads.
+ *
+ * @return A double array with the shape of the data without axis; the
+ *         result of reducing a 1D array has shape {1}.
+ *
+ * @throws nix::OutOfBounds If axis exceeds the rank of the data.
+ */
+NIXAPI NDArray reduce(const DataArray &array, size_t axis, ReduceOp op, size_t threads = 0);
+
+/**
+ * @brief Count the values of a DataArray in equally sized bins.
+ *
+ * The data is processed in the same streaming fashion as with
+ * {@link reduce}. NaN values are not counted at all.
+ *
+ * @param array     The DataArray.
+ * @param lower     The lower edge of the first bin.
+ * @param upper     The upper edge of the last bin.
+ * @param bins      The number of bins.
+ * @param threads   The number of worker threads, 0 uses one per core;
+ *                  ignored if the array does not support concurrent reads.
+ *
+ * @return The histogram.
+ */
+NIXAPI Histogram histogram(const DataArray &array, double lower, double upper, size_t bins,
+                           size_t threads = 0);
+
+} // namespace util
+} // namespace nix
+
+#endif // NIX_REDUCE_H
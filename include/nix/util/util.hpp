@@ -135,7 +135,10 @@ NIXAPI void checkEmptyString(const std::string &str, const std::string &field_na
 NIXAPI void checkEntityNameAndType(const std::string &name, const std::string &type);
 
 /**
- * @brief Generates an ID-String.
+ * @brief Generates an ID-String, a random UUID (version 4).
+ *
+ * Safe to call from multiple threads; every thread draws from its own
+ * generator, so ids are created without locking.
  *
  * @return The generated id string.
  */
@@ -144,6 +147,10 @@ NIXAPI std::string createId();
 /**
  * @brief Convert a time value into a string representation.
  *
+ * The time is written in the basic ISO 8601 format in UTC, e.g.
+ * "20140101T120000". The string is kept per thread and only rendered
+ * again when the second changes.
+ *
  * @param time    The time to convert.
  *
  * @return The sting representation of time.
@@ -7,7 +7,7 @@ License:	BSD
 URL:		https://www.g-node.org/nix
 Source0:	https://github.com/G-Node/nix/archive/%{version}/%{name}-%{version}.tar.gz
 
-BuildRequires:	cmake, boost-devel, hdf5-devel, cppunit-devel
+BuildRequires:	cmake, boost-devel, hdf5-devel, zlib-devel, cppunit-devel
 
 %description
 Neuroscience information exchange - data model for annotated (neuroscience)
@@ -7,6 +7,7 @@
 // LICENSE file in the root of the Project.
 
 #include <nix/Block.hpp>
+#include <nix/BlockBatch.hpp>
 #include <nix/util/util.hpp>
 
 namespace nix {
@@ -87,6 +88,17 @@ bool Block::deleteDataArray(const DataArray &data_array) {
     return backend()->deleteDataArray(data_array.id());
 }
 
+ndsize_t Block::deleteDataArrays(const std::vector<DataArray> &data_arrays) {
+    std::vector<std::string> ids;
+    ids.reserve(data_arrays.size());
+    for (const DataArray &da : data_arrays) {
+        if (util::checkEntityInput(da, false)) {
+            ids.push_back(da.id());
+        }
+    }
+    return backend()->deleteDataArrays(ids);
+}
+
 Tag Block::createTag(const std::string &name, const std::string &type, const std::vector<double> &position) {
     util::checkEntityNameAndType(name, type);
     if (backend()->hasTag(name)){
@@ -186,6 +198,10 @@ bool Block::deleteGroup(const Group &group) {
     return backend()->deleteGroup(group.id());
 }
 
+BlockBatch Block::batch() const {
+    return BlockBatch(*this);
+}
+
 std::ostream &operator<<(std::ostream &out, const Block &ent) {
     out << "Block: {name = " << ent.name();
     out << ", type = " << ent.type();
@@ -0,0 +1,376 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/BlockBatch.hpp>
+#include <nix/Exception.hpp>
+#include <nix/util/util.hpp>
+
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace nix {
+
+namespace {
+
+// removes repeated entries, keeps the order of the first occurrences
+void remove_duplicates(std::vector<std::string> &values) {
+    std::unordered_set<std::string> seen;
+    auto last = std::remove_if(values.begin(), values.end(), [&seen](const std::string &v) {
+        return !seen.insert(v).second;
+    });
+    values.erase(last, values.end());
+}
+
+
+void check_dimension(const BlockBatch::DimensionSpec &dim, const std::string &array) {
+    const std::string where = "BlockBatch::commit";
+
+    if (dim.label) {
+        util::checkEmptyString(*dim.label, "label");
+    }
+    if (dim.unit) {
+        util::checkEmptyString(*dim.unit, "unit");
+        if (!util::isSIUnit(*dim.unit)) {
+            throw InvalidUnit("Unit of a dimension of " + array + " is not an atomic SI unit.", where);
+        }
+    }
+
+    switch (dim.type) {
+        case DimensionType::Sample:
+            if (dim.sampling_interval <= 0.0) {
+                throw std::runtime_error(where + ": Sampling intervals must be larger than 0.0!");
+            }
+            break;
+        case DimensionType::Range:
+            if (dim.ticks.empty()) {
+                throw InvalidDimension("The ticks of a range dimension must not be empty!", where);
+            }
+            if (!std::is_sorted(dim.ticks.begin(), dim.ticks.end())) {
+                throw UnsortedTicks(where);
+            }
+            break;
+        case DimensionType::Set:
+            if (dim.unit || dim.label) {
+                throw InvalidDimension("A set dimension has neither unit nor label!", where);
+            }
+            break;
+    }
+}
+
+}
+
+
+BlockBatch::DimensionSpec BlockBatch::DimensionSpec::sampled(double sampling_interval) {
+    DimensionSpec dim;
+    dim.type = DimensionType::Sample;
+    dim.sampling_interval = sampling_interval;
+    return dim;
+}
+
+
+BlockBatch::DimensionSpec BlockBatch::DimensionSpec::set(const std::vector<std::string> &labels) {
+    DimensionSpec dim;
+    dim.type = DimensionType::Set;
+    dim.labels = labels;
+    return dim;
+}
+
+
+BlockBatch::DimensionSpec BlockBatch::DimensionSpec::range(const std::vector<double> &ticks) {
+    DimensionSpec dim;
+    dim.type = DimensionType::Range;
+    dim.ticks = ticks;
+    return dim;
+}
+
+
+BlockBatch::BlockBatch(const Block &block)
+    : blk(block)
+{
+}
+
+
+size_t BlockBatch::addSource(const std::string &name, const std::string &type, const std::string &id) {
+    SourceSpec spec;
+    spec.id = id;
+    spec.name = name;
+    spec.type = type;
+
+    source_specs.push_back(std::move(spec));
+    return source_specs.size() - 1;
+}
+
+
+size_t BlockBatch::addDataArray(const std::string &name, const std::string &type, DataType data_type,
+                                const NDSize &shape, const std::string &id) {
+    DataArraySpec spec;
+    spec.id = id;
+    spec.name = name;
+    spec.type = type;
+    spec.data_type = data_type;
+    spec.shape = shape;
+
+    data_array_specs.push_back(std::move(spec));
+    return data_array_specs.size() - 1;
+}
+
+
+size_t BlockBatch::addTag(const std::string &name, const std::string &type, const std::vector<double> &position,
+                          const std::string &id) {
+    TagSpec spec;
+    spec.id = id;
+    spec.name = name;
+    spec.type = type;
+    spec.position = position;
+
+    tag_specs.push_back(std::move(spec));
+    return tag_specs.size() - 1;
+}
+
+
+void BlockBatch::clear() {
+    source_specs.clear();
+    data_array_specs.clear();
+    tag_specs.clear();
+}
+
+
+BlockBatch::SourceSpec &BlockBatch::source(size_t index) {
+    if (index >= source_specs.size()) {
+        throw OutOfBounds("BlockBatch::source: index out of bounds", index);
+    }
+    return source_specs[index];
+}
+
+
+const BlockBatch::SourceSpec &BlockBatch::source(size_t index) const {
+    if (index >= source_specs.size()) {
+        throw OutOfBounds("BlockBatch::source: index out of bounds", index);
+    }
+    return source_specs[index];
+}
+
+
+BlockBatch::DataArraySpec &BlockBatch::dataArray(size_t index) {
+    if (index >= data_array_specs.size()) {
+        throw OutOfBounds("BlockBatch::dataArray: index out of bounds", index);
+    }
+    return data_array_specs[index];
+}
+
+
+const BlockBatch::DataArraySpec &BlockBatch::dataArray(size_t index) const {
+    if (index >= data_array_specs.size()) {
+        throw OutOfBounds("BlockBatch::dataArray: index out of bounds", index);
+    }
+    return data_array_specs[index];
+}
+
+
+BlockBatch::TagSpec &BlockBatch::tag(size_t index) {
+    if (index >= tag_specs.size()) {
+        throw OutOfBounds("BlockBatch::tag: index out of bounds", index);
+    }
+    return tag_specs[index];
+}
+
+
+const BlockBatch::TagSpec &BlockBatch::tag(size_t index) const {
+    if (index >= tag_specs.size()) {
+        throw OutOfBounds("BlockBatch::tag: index out of bounds", index);
+    }
+    return tag_specs[index];
+}
+
+
+void BlockBatch::commit() {
+    if (blk.isNone()) {
+        throw UninitializedEntity();
+    }
+    std::shared_ptr<base::IBlock> backend = blk.impl();
+
+    // the ids of all entities of the block, nested sources included, are
+    // collected in a single pass the first time a given id is checked or a
+    // reference is resolved
+    std::unordered_set<std::string> block_ids, block_sources, block_arrays;
+    bool collected = false;
+    auto collect = [&]() {
+        if (collected) {
+            return;
+        }
+        for (const Source &source : blk.findSources()) {
+            block_sources.insert(source.id());
+        }
+        for (const DataArray &array : blk.dataArrays()) {
+            block_arrays.insert(array.id());
+        }
+        block_ids.insert(block_sources.begin(), block_sources.end());
+        block_ids.insert(block_arrays.begin(), block_arrays.end());
+        for (const Tag &tag : blk.tags()) {
+            block_ids.insert(tag.id());
+        }
+        for (const MultiTag &tag : blk.multiTags()) {
+            block_ids.insert(tag.id());
+        }
+        for (const Group &group : blk.groups()) {
+            block_ids.insert(group.id());
+        }
+        collected = true;
+    };
+
+    // given ids must be unique within the batch and must not be used by
+    // any entity of the block
+    std::unordered_set<std::string> ids, names;
+    auto check_id = [&](std::string &id) {
+        if (id.empty()) {
+            return;
+        }
+        if (!ids.insert(id).second) {
+            throw std::runtime_error("BlockBatch::commit: duplicate id " + id);
+        }
+        collect();
+        if (block_ids.count(id) > 0) {
+            throw std::runtime_error("BlockBatch::commit: id " + id + " is already used in the block");
+        }
+    };
+    auto assign_id = [](std::string &id) {
+        if (id.empty()) {
+            id = util::createId();
+        }
+    };
+
+    // entities of the batch by name and by id
+    std::unordered_map<std::string, std::string> batch_sources, batch_arrays;
+
+    for (SourceSpec &spec : source_specs) {
+        util::checkEntityNameAndType(spec.name, spec.type);
+        if (!names.insert(spec.name).second || backend->hasSource(spec.name)) {
+            throw DuplicateName("BlockBatch::commit: source " + spec.name);
+        }
+        check_id(spec.id);
+    }
+
+    names.clear();
+    for (DataArraySpec &spec : data_array_specs) {
+        util::checkEntityNameAndType(spec.name, spec.type);
+        if (!names.insert(spec.name).second || backend->hasDataArray(spec.name)) {
+            throw DuplicateName("BlockBatch::commit: data array " + spec.name);
+        }
+        check_id(spec.id);
+
+        if (spec.data_type == DataType::Nothing) {
+            throw std::runtime_error("BlockBatch::commit: data array " + spec.name + " without data type");
+        }
+        if (spec.label) {
+            util::checkEmptyString(*spec.label, "label");
+        }
+        if (spec.unit) {
+            util::checkEmptyString(*spec.unit, "unit");
+            if (!(util::isSIUnit(*spec.unit) || util::isCompoundSIUnit(*spec.unit))) {
+                throw InvalidUnit("Unit of " + spec.name + " is not SI or composite of SI units.", "BlockBatch::commit");
+            }
+        }
+        for (const DimensionSpec &dim : spec.dimensions) {
+            check_dimension(dim, spec.name);
+        }
+    }
+
+    names.clear();
+    for (TagSpec &spec : tag_specs) {
+        util::checkEntityNameAndType(spec.name, spec.type);
+        if (!names.insert(spec.name).second || backend->hasTag(spec.name)) {
+            throw DuplicateName("BlockBatch::commit: tag " + spec.name);
+        }
+        check_id(spec.id);
+
+        if (spec.position.empty()) {
+            throw std::runtime_error("BlockBatch::commit: tag " + spec.name + " without position");
+        }
+        if (!spec.extent.empty() && spec.extent.size() != spec.position.size()) {
+            throw IncompatibleDimensions("Position and extent of tag " + spec.name + " differ in size",
+                                         "BlockBatch::commit");
+        }
+        if (!spec.units.empty() && spec.units.size() != spec.position.size()) {
+            throw IncompatibleDimensions("Position and units of tag " + spec.name + " differ in size",
+                                         "BlockBatch::commit");
+        }
+        for (std::string &unit : spec.units) {
+            unit = util::unitSanitizer(unit);
+            if (unit.length() > 0 && unit != "none" && !util::isSIUnit(unit)) {
+                throw InvalidUnit("Unit " + unit + " of tag " + spec.name + " is not a SI unit.", "BlockBatch::commit");
+            }
+        }
+    }
+
+    // all given ids are known now, the generated ones cannot collide
+    for (SourceSpec &spec : source_specs) {
+        assign_id(spec.id);
+        batch_sources[spec.name] = spec.id;
+        batch_sources[spec.id] = spec.id;
+    }
+    for (DataArraySpec &spec : data_array_specs) {
+        assign_id(spec.id);
+        batch_arrays[spec.name] = spec.id;
+        batch_arrays[spec.id] = spec.id;
+    }
+    for (TagSpec &spec : tag_specs) {
+        assign_id(spec.id);
+    }
+
+    auto resolve_sources = [&](std::vector<std::string> &sources) {
+        for (std::string &ref : sources) {
+            auto it = batch_sources.find(ref);
+            if (it != batch_sources.end()) {
+                ref = it->second;
+                continue;
+            }
+            collect();
+            if (block_sources.count(ref) > 0) {
+                continue;
+            }
+            // otherwise the name of a source of the block
+            std::shared_ptr<base::ISource> source = backend->getSource(ref);
+            if (!source) {
+                throw std::runtime_error("BlockBatch::commit: source " + ref + " not found in block");
+            }
+            ref = source->id();
+        }
+        remove_duplicates(sources);
+    };
+
+    for (DataArraySpec &spec : data_array_specs) {
+        resolve_sources(spec.sources);
+    }
+
+    for (TagSpec &spec : tag_specs) {
+        resolve_sources(spec.sources);
+
+        for (std::string &ref : spec.references) {
+            auto it = batch_arrays.find(ref);
+            if (it != batch_arrays.end()) {
+                ref = it->second;
+                continue;
+            }
+            collect();
+            if (block_arrays.count(ref) > 0) {
+                continue;
+            }
+            std::shared_ptr<base::IDataArray> array = backend->getDataArray(ref);
+            if (!array) {
+                throw std::runtime_error("BlockBatch::commit: data array " + ref + " not found in block");
+            }
+            ref = array->id();
+        }
+        remove_duplicates(spec.references);
+    }
+
+    backend->createBatch(*this);
+}
+
+} // namespace nix
@@ -7,8 +7,11 @@
 // LICENSE file in the root of the Project.
 
 #include <nix/DataArray.hpp>
+#include <nix/Buffer.hpp>
+#include <nix/DataView.hpp>
 
 #include <nix/util/util.hpp>
+#include <nix/util/dataAccess.hpp>
 #include "hdf5/h5x/H5DataType.hpp"
 
 #include <cstring>
@@ -91,11 +94,40 @@ void DataArray::appendData(DataType dtype, const void *data, const NDSize &count
     offset[axis] = extent[axis];
     extent[axis] += count[axis];
 
+    // an overview pyramid is only kept if it was up to date before
+    const std::pair<size_t, size_t> overview = overviewLayout();
+
     //enlarge the DataArray to fit the new data
     dataExtent(extent);
 
     setData(dtype, data, count, offset);
 
+    if (overview.second > 0 && overview.first == axis) {
+        updateOverview(axis, overview.second, offset[axis]);
+    }
+}
+
+
+MappedData DataArray::mapData() const {
+    boost::optional<MappedData> view = backend()->mapData();
+    if (view) {
+        return *view;
+    }
+
+    const DataType dtype = dataType();
+    if (dtype == DataType::String || dtype == DataType::Nothing) {
+        throw std::invalid_argument("DataArray::mapData: only numeric data can be mapped");
+    }
+
+    const NDSize extent = dataExtent();
+    const size_t nelms = check::fits_in_size_t(extent.nelms(), "DataArray::mapData: data does not fit into memory");
+    auto buffer = std::make_shared<Buffer<char>>(nelms * data_type_to_size(dtype));
+    if (nelms > 0) {
+        getDataDirect(dtype, buffer->data(), extent, NDSize(extent.size(), 0));
+    }
+
+    std::shared_ptr<const void> storage(buffer, buffer->data());
+    return MappedData(dtype, extent, storage, buffer->data(), false);
 }
 
 void DataArray::unit(const std::string &unit) {
@@ -115,6 +147,43 @@ std::vector<Dimension> DataArray::dimensions(const util::Filter<Dimension>::type
 }
 
 
+std::vector<ndsize_t> DataArray::positionsToIndices(size_t dim, const double *positions, size_t n,
+                                                    const std::string &unit) const {
+    const std::vector<DimensionDescriptor> dims = dimensionDescriptors();
+    if (dim == 0 || dim > dims.size()) {
+        throw OutOfBounds("DataArray::positionsToIndices: invalid dimension index", dim);
+    }
+
+    std::vector<ndsize_t> indices(n);
+    util::positionsToIndices(positions, n, unit, dims[dim - 1], indices.data());
+    return indices;
+}
+
+
+DataView DataArray::sliceByPosition(const std::vector<std::pair<double, double>> &ranges,
+                                    const std::vector<std::string> &units) const {
+    const std::vector<DimensionDescriptor> dims = dimensionDescriptors();
+    NDSize count = dataExtent();
+    NDSize offset(count.size(), 0);
+    if (ranges.size() > count.size() || ranges.size() > dims.size()) {
+        throw IncompatibleDimensions("More ranges than dimensions of the data", "DataArray::sliceByPosition");
+    }
+
+    for (size_t i = 0; i < ranges.size(); i++) {
+        if (ranges[i].second < ranges[i].first) {
+            throw std::invalid_argument("DataArray::sliceByPosition: range ends before it starts");
+        }
+        const double bounds[2] = {ranges[i].first, ranges[i].second};
+        ndsize_t indices[2];
+        util::positionsToIndices(bounds, 2, i < units.size() ? units[i] : "none", dims[i], indices);
+        offset[i] = indices[0];
+        count[i] = indices[1] > indices[0] ? indices[1] - indices[0] : 1;
+    }
+
+    return DataView(*this, count, offset);
+}
+
+
 std::ostream& nix::operator<<(std::ostream &out, const DataArray &ent) {
     out << "DataArray: {name = " << ent.name();
     out << ", type = " << ent.type();
@@ -0,0 +1,160 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/DataArrayReader.hpp>
+#include <nix/Exception.hpp>
+
+#include <algorithm>
+
+namespace nix {
+
+
+DataArrayReader::DataArrayReader(const DataArray &array, DataType dtype, const NDSize &shape, size_t axis,
+                                 ndsize_t stride, size_t depth, const NDSize &start)
+    : array(array), dtype(dtype), shape(shape), start(start), axis(axis), stride(stride), slab_total(0),
+      produced(0), consumed(0), released(0), stopped(false)
+{
+    if (!array) {
+        throw UninitializedEntity();
+    }
+
+    if (dtype == DataType::String || dtype == DataType::Nothing) {
+        throw std::invalid_argument("DataArrayReader: only numeric data types are supported");
+    }
+
+    const NDSize extent = array.dataExtent();
+    if (shape.size() != extent.size()) {
+        throw InvalidRank("DataArrayReader: rank of the slab shape does not match the data");
+    }
+
+    if (axis >= extent.size()) {
+        throw OutOfBounds("DataArrayReader: axis exceeds the rank of the data", axis);
+    }
+
+    if (this->start.size() == 0) {
+        this->start = NDSize(extent.size(), 0);
+    } else if (this->start.size() != extent.size()) {
+        throw InvalidRank("DataArrayReader: rank of the start position does not match the data");
+    }
+
+    if (shape[axis] == 0) {
+        throw std::invalid_argument("DataArrayReader: slab shape must not be zero along the axis");
+    }
+
+    for (size_t i = 0; i < extent.size(); i++) {
+        if (i != axis && this->start[i] + shape[i] > extent[i]) {
+            throw OutOfBounds("DataArrayReader: slab shape exceeds the data extent");
+        }
+    }
+
+    if (this->stride == 0) {
+        this->stride = shape[axis];
+    }
+
+    if (this->start[axis] < extent[axis]) {
+        ndsize_t len = extent[axis] - this->start[axis];
+        slab_total = (len + this->stride - 1) / this->stride;
+    }
+
+    size_t slab_bytes = check::fits_in_size_t(shape.nelms() * data_type_to_size(dtype),
+                                              "DataArrayReader: slab does not fit into memory");
+    depth = static_cast<size_t>(std::min<ndsize_t>(std::max<size_t>(depth, 1), std::max<ndsize_t>(slab_total, 1)));
+
+    ring.resize(depth);
+    for (Slot &slot : ring) {
+        slot.buffer.resize(slab_bytes);
+    }
+
+    if (slab_total > 0) {
+        worker = std::thread(&DataArrayReader::run, this);
+    }
+}
+
+
+bool DataArrayReader::next(Slab &slab) {
+    std::unique_lock<std::mutex> lock(mutex);
+
+    // give back the slab handed out last time
+    if (released < consumed) {
+        released = consumed;
+        cond_free.notify_one();
+    }
+
+    cond_filled.wait(lock, [this] {
+        return produced > consumed || error || consumed == slab_total;
+    });
+
+    if (produced <= consumed && error) {
+        std::rethrow_exception(error);
+    }
+
+    if (consumed == slab_total) {
+        return false;
+    }
+
+    const Slot &slot = ring[consumed % ring.size()];
+    slab.ptr = slot.buffer.data();
+    slab.slab_offset = slot.offset;
+    slab.slab_count = slot.count;
+    slab.slab_index = consumed;
+    consumed++;
+
+    return true;
+}
+
+
+void DataArrayReader::run() {
+    const ndsize_t end = array.dataExtent()[axis];
+
+    for (ndsize_t i = 0; i < slab_total; i++) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cond_free.wait(lock, [this] {
+                return stopped || produced - released < ring.size();
+            });
+            if (stopped) {
+                return;
+            }
+        }
+
+        // the slot is owned by this thread until produced is increased
+        Slot &slot = ring[i % ring.size()];
+        slot.offset = start;
+        slot.offset[axis] += i * stride;
+        slot.count = shape;
+        slot.count[axis] = std::min(shape[axis], end - slot.offset[axis]);
+
+        try {
+            array.getData(dtype, slot.buffer.data(), slot.count, slot.offset);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            error = std::current_exception();
+            cond_filled.notify_one();
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        produced++;
+        cond_filled.notify_one();
+    }
+}
+
+
+DataArrayReader::~DataArrayReader() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopped = true;
+    }
+    cond_free.notify_one();
+
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+} // namespace nix
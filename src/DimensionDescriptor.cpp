@@ -0,0 +1,202 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/DimensionDescriptor.hpp>
+#include <nix/Exception.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <mutex>
+#include <unordered_map>
+
+namespace nix {
+
+// built on the first lookup, shared between copies of a descriptor
+struct DimensionDescriptor::LabelIndex {
+    std::once_flag built;
+    std::unordered_map<std::string, ndsize_t> index;
+};
+
+namespace {
+
+const std::shared_ptr<const std::vector<std::string>> NO_LABELS = std::make_shared<const std::vector<std::string>>();
+const std::shared_ptr<const std::vector<double>> NO_TICKS = std::make_shared<const std::vector<double>>();
+
+}
+
+
+DimensionDescriptor::DimensionDescriptor()
+    : dim_type(DimensionType::Set), dim_index(0), sampling_interval(0.0),
+      dim_labels(NO_LABELS), dim_ticks(NO_TICKS), is_alias(false)
+{
+}
+
+
+DimensionDescriptor::DimensionDescriptor(const base::IDimension &dimension)
+    : DimensionDescriptor()
+{
+    dim_type = dimension.dimensionType();
+    dim_index = dimension.index();
+
+    switch (dim_type) {
+        case DimensionType::Sample: {
+            auto &dim = dynamic_cast<const base::ISampledDimension &>(dimension);
+            sampling_interval = dim.samplingInterval();
+            dim_offset = dim.offset();
+            dim_unit = dim.unit();
+            dim_label = dim.label();
+            break;
+        }
+        case DimensionType::Set: {
+            auto &dim = dynamic_cast<const base::ISetDimension &>(dimension);
+            dim_labels = std::make_shared<const std::vector<std::string>>(dim.labels());
+            label_index = std::make_shared<LabelIndex>();
+            break;
+        }
+        case DimensionType::Range: {
+            auto &dim = dynamic_cast<const base::IRangeDimension &>(dimension);
+            is_alias = dim.alias();
+            dim_unit = dim.unit();
+            dim_label = dim.label();
+            dim_ticks = std::make_shared<const std::vector<double>>(dim.ticks());
+            break;
+        }
+    }
+}
+
+
+ndsize_t DimensionDescriptor::indexOf(double position) const {
+    switch (dim_type) {
+        case DimensionType::Sample: {
+            double off = dim_offset ? *dim_offset : 0.0;
+            ndssize_t index = static_cast<ndssize_t>(round((position - off) / sampling_interval));
+            if (index < 0) {
+                throw nix::OutOfBounds("Position is out of bounds of this dimension!", 0);
+            }
+            return static_cast<ndsize_t>(index);
+        }
+        case DimensionType::Range: {
+            const std::vector<double> &t = *dim_ticks;
+            if (t.empty()) {
+                throw nix::OutOfBounds("Position is out of bounds of this dimension!", 0);
+            }
+            if (position < t.front()) {
+                return 0;
+            } else if (position > t.back()) {
+                return t.size() - 1;
+            }
+            return std::lower_bound(t.begin(), t.end(), position) - t.begin();
+        }
+        case DimensionType::Set:
+            break;
+    }
+
+    ndssize_t index = static_cast<ndssize_t>(round(position));
+    if (index < 0 || (dim_labels->size() > 0 && static_cast<ndsize_t>(index) > dim_labels->size())) {
+        throw nix::OutOfBounds("Position is out of bounds in setDimension.", static_cast<int>(position));
+    }
+    return static_cast<ndsize_t>(index);
+}
+
+
+void DimensionDescriptor::indicesOf(const double *positions, size_t n, ndsize_t *indices, double scaling) const {
+    switch (dim_type) {
+        case DimensionType::Sample: {
+            const double off = dim_offset ? *dim_offset : 0.0;
+            bool negative = false;
+            for (size_t i = 0; i < n; i++) {
+                const ndssize_t index = static_cast<ndssize_t>(round((positions[i] * scaling - off) / sampling_interval));
+                negative = negative || index < 0;
+                indices[i] = static_cast<ndsize_t>(index);
+            }
+            if (negative) {
+                throw nix::OutOfBounds("Position is out of bounds of this dimension!", 0);
+            }
+            return;
+        }
+        case DimensionType::Range: {
+            const std::vector<double> &t = *dim_ticks;
+            if (n > 0 && t.empty()) {
+                throw nix::OutOfBounds("Position is out of bounds of this dimension!", 0);
+            }
+            // lower_bound of an ascending sequence of positions never moves backwards
+            auto hint = t.begin();
+            double last = -std::numeric_limits<double>::infinity();
+            for (size_t i = 0; i < n; i++) {
+                const double position = positions[i] * scaling;
+                if (position < t.front()) {
+                    indices[i] = 0;
+                } else if (position > t.back()) {
+                    indices[i] = t.size() - 1;
+                } else {
+                    hint = std::lower_bound(position >= last ? hint : t.begin(), t.end(), position);
+                    last = position;
+                    indices[i] = hint - t.begin();
+                }
+            }
+            return;
+        }
+        case DimensionType::Set:
+            break;
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        indices[i] = indexOf(positions[i] * scaling);
+    }
+}
+
+
+ndsize_t DimensionDescriptor::indexOf(const std::string &label) const {
+    if (!label_index) {
+        throw nix::IncompatibleDimensions("Only set dimensions have labels", "DimensionDescriptor::indexOf");
+    }
+
+    const std::vector<std::string> &labels = *dim_labels;
+    LabelIndex &li = *label_index;
+    std::call_once(li.built, [&labels, &li] {
+        li.index.reserve(labels.size());
+        for (size_t i = 0; i < labels.size(); i++) {
+            li.index.emplace(labels[i], i);
+        }
+    });
+
+    auto it = li.index.find(label);
+    if (it == li.index.end()) {
+        throw nix::OutOfBounds("DimensionDescriptor::indexOf: No such label: " + label);
+    }
+    return it->second;
+}
+
+
+std::vector<ndsize_t> DimensionDescriptor::indicesOf(const std::vector<std::string> &labels) const {
+    std::vector<ndsize_t> indices;
+    indices.reserve(labels.size());
+    for (const std::string &label : labels) {
+        indices.push_back(indexOf(label));
+    }
+    return indices;
+}
+
+
+double DimensionDescriptor::positionAt(ndsize_t index) const {
+    switch (dim_type) {
+        case DimensionType::Sample:
+            return index * sampling_interval + (dim_offset ? *dim_offset : 0.0);
+        case DimensionType::Range:
+            if (index >= dim_ticks->size()) {
+                throw nix::OutOfBounds("DimensionDescriptor::positionAt: Given index is out of bounds!", index);
+            }
+            return (*dim_ticks)[static_cast<size_t>(index)];
+        case DimensionType::Set:
+            break;
+    }
+    return static_cast<double>(index);
+}
+
+} // namespace nix
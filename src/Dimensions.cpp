@@ -259,6 +259,11 @@ SetDimension::SetDimension(const SetDimension &other)
 }
 
 
+ndsize_t SetDimension::indexOf(const std::string &label) const {
+    return backend()->indicesOf({label})[0];
+}
+
+
 SetDimension& SetDimension::operator=(const SetDimension &other) {
     shared_ptr<ISetDimension> tmp(other.impl());
 
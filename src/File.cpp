@@ -14,15 +14,23 @@
 #include "fs/FileFS.hpp"
 #endif
 
+#ifdef ENABLE_MEM_BACKEND
+#include "mem/FileMem.hpp"
+#endif
+
 #include <nix/valid/validate.hpp>
+#include <nix/util/filter.hpp>
 #include <boost/filesystem.hpp>
 
+#include <set>
+#include <unordered_set>
+
 namespace bfs = boost::filesystem;
 
 namespace nix {
 
 File File::open(const std::string &name, FileMode mode, const std::string &impl) {
-    if (mode == nix::FileMode::ReadOnly && !bfs::exists({name})) {
+    if ((mode == nix::FileMode::ReadOnly || mode == nix::FileMode::SWMRRead) && !bfs::exists(bfs::path{name})) {
         throw std::runtime_error("Cannot open non-existent file in ReadOnly mode!");
     }
     if (impl == "hdf5") {
@@ -30,8 +38,19 @@ File File::open(const std::string &name, FileMode mode, const std::string &impl)
     }
 #ifdef  ENABLE_FS_BACKEND
     else if (impl == "file") {
+        if (mode == nix::FileMode::SWMRWrite || mode == nix::FileMode::SWMRRead) {
+            throw std::invalid_argument("SWMR modes are only supported by the hdf5 backend!");
+        }
         return File(std::make_shared<file::FileFS>(name, mode));
     }
+#endif
+#ifdef ENABLE_MEM_BACKEND
+    else if (impl == "memory") {
+        if (mode != nix::FileMode::ReadWrite && mode != nix::FileMode::Overwrite) {
+            throw std::invalid_argument("In-memory files can only be opened in ReadWrite or Overwrite mode!");
+        }
+        return File(std::make_shared<mem::FileMem>(name, mode));
+    }
 #endif
     else {
         throw std::runtime_error("Unknown implementation!");
@@ -43,6 +62,18 @@ bool File::flush() {
     return backend()->flush();
 }
 
+
+void File::saveAs(const std::string &location) const {
+#ifdef ENABLE_MEM_BACKEND
+    std::shared_ptr<mem::FileMem> file = std::dynamic_pointer_cast<mem::FileMem>(impl());
+    if (file) {
+        file->saveAs(location);
+        return;
+    }
+#endif
+    throw std::logic_error("File::saveAs: only files of the memory back-end can be saved");
+}
+
     
 Block File::createBlock(const std::string &name, const std::string &type) {
     util::checkEntityNameAndType(name, type);
@@ -108,6 +139,64 @@ bool File::deleteSection(const Section &section) {
 }
 
 
+void File::storeMetadataSnapshot(const MetadataSnapshot &snapshot) {
+    typedef MetadataSnapshot snap_t;
+
+    std::set<std::pair<size_t, std::string>> section_names;
+    std::unordered_set<std::string> ids;
+
+    for (size_t i = 0; i < snapshot.sectionCount(); i++) {
+        const snap_t::SectionNode &node = snapshot.section(i);
+        util::checkEntityNameAndType(node.name, node.type);
+
+        if (!section_names.emplace(node.parent, node.name).second) {
+            throw DuplicateName("storeMetadataSnapshot: section " + snapshot.path(i));
+        }
+        if (node.parent == snap_t::npos && backend()->hasSection(node.name)) {
+            throw DuplicateName("storeMetadataSnapshot: root section " + node.name);
+        }
+        if (!node.id.empty() && !ids.insert(node.id).second) {
+            throw std::runtime_error("File::storeMetadataSnapshot: duplicate id " + node.id);
+        }
+    }
+
+    std::set<std::pair<size_t, std::string>> property_names;
+    for (size_t i = 0; i < snapshot.propertyCount(); i++) {
+        const snap_t::PropertyNode &node = snapshot.property(i);
+        util::checkEntityName(node.name);
+
+        if (!property_names.emplace(node.section, node.name).second) {
+            throw DuplicateName("storeMetadataSnapshot: property " + node.name +
+                                " in section " + snapshot.path(node.section));
+        }
+        if (!node.id.empty() && !ids.insert(node.id).second) {
+            throw std::runtime_error("File::storeMetadataSnapshot: duplicate id " + node.id);
+        }
+        if (node.data_type == DataType::Nothing || !Value::supports_type(node.data_type)) {
+            throw std::runtime_error("File::storeMetadataSnapshot: unsupported data type for property " + node.name);
+        }
+        for (const Value &value : snapshot.values(i)) {
+            if (value.type() != node.data_type) {
+                throw std::runtime_error("File::storeMetadataSnapshot: values of property " + node.name +
+                                         " do not match its data type");
+            }
+        }
+    }
+
+    for (size_t i = 0; i < snapshot.sectionCount(); i++) {
+        const boost::optional<std::string> &link = snapshot.section(i).link;
+        if (!link || snapshot.findSectionById(*link) != snap_t::npos) {
+            continue;
+        }
+        if (findSections(util::IdFilter<Section>(*link)).empty()) {
+            throw std::runtime_error("File::storeMetadataSnapshot: linked section " + *link + " not found");
+        }
+    }
+
+    backend()->storeMetadataSnapshot(snapshot);
+}
+
+
 std::vector<Section> File::findSections(const util::Filter<Section>::type &filter, size_t max_depth) const {
     std::vector<Section> results;
     std::vector<Section> roots = sections();
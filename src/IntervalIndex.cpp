@@ -0,0 +1,318 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/IntervalIndex.hpp>
+#include <nix/Exception.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+namespace nix {
+
+IntervalIndex::IntervalIndex()
+    : dims(0), total(0), count(0)
+{
+}
+
+
+IntervalIndex::IntervalIndex(size_t dimensions, const std::vector<double> &positions,
+                             const std::vector<double> &extents)
+    : dims(dimensions), total(0), count(0)
+{
+    if (dims == 0 || positions.size() % dims != 0) {
+        throw std::invalid_argument("IntervalIndex: positions do not match the number of dimensions");
+    }
+    if (!extents.empty() && extents.size() != positions.size()) {
+        throw IncompatibleDimensions("Positions and extents differ in size", "IntervalIndex");
+    }
+    total = positions.size() / dims;
+
+    // positions with a NaN coordinate are left out in all dimensions
+    std::vector<ndsize_t> valid;
+    valid.reserve(total);
+    for (ndsize_t row = 0; row < total; row++) {
+        bool ok = true;
+        for (size_t d = 0; d < dims && ok; d++) {
+            const size_t i = row * dims + d;
+            ok = !std::isnan(positions[i]) && (extents.empty() || !std::isnan(extents[i]));
+        }
+        if (ok) {
+            valid.push_back(row);
+        }
+    }
+    count = valid.size();
+
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    row_start.assign(dims * total, nan);
+    row_end.assign(dims * total, nan);
+    sorted_start.resize(dims * count);
+    sorted_end.resize(dims * count);
+    sorted_row.resize(dims * count);
+
+    std::vector<ndsize_t> order;
+    for (size_t d = 0; d < dims; d++) {
+        for (ndsize_t row : valid) {
+            const size_t i = row * dims + d;
+            // negative extents are treated as empty
+            const double extent = extents.empty() ? 0.0 : std::max(extents[i], 0.0);
+            row_start[d * total + row] = positions[i];
+            row_end[d * total + row] = positions[i] + extent;
+        }
+
+        const double *start = &row_start[d * total];
+        order = valid;
+        std::sort(order.begin(), order.end(), [start](ndsize_t a, ndsize_t b) {
+            return start[a] < start[b] || (start[a] == start[b] && a < b);
+        });
+
+        const size_t off = d * count;
+        for (size_t i = 0; i < count; i++) {
+            sorted_start[off + i] = row_start[d * total + order[i]];
+            sorted_end[off + i] = row_end[d * total + order[i]];
+            sorted_row[off + i] = order[i];
+        }
+    }
+
+    prepare();
+}
+
+
+IntervalIndex IntervalIndex::build(const base::IDataArray &positions, const std::shared_ptr<base::IDataArray> &extents) {
+    const NDSize shape = positions.dataExtent();
+    if (shape.size() == 0) {
+        return IntervalIndex();
+    }
+    if (shape.size() > 2) {
+        throw IncompatibleDimensions("Positions must be one- or two-dimensional", "IntervalIndex::build");
+    }
+
+    const size_t dims = shape.size() == 2 ? shape[1] : 1;
+    if (dims == 0) {
+        return IntervalIndex();
+    }
+
+    const NDSize origin(shape.size(), 0);
+    std::vector<double> pos(shape.nelms()), ext;
+    if (!pos.empty()) {
+        positions.read(DataType::Double, pos.data(), shape, origin);
+    }
+
+    if (extents) {
+        if (extents->dataExtent() != shape) {
+            throw IncompatibleDimensions("Positions and extents differ in shape", "IntervalIndex::build");
+        }
+        ext.resize(pos.size());
+        if (!ext.empty()) {
+            extents->read(DataType::Double, ext.data(), shape, origin);
+        }
+    }
+
+    return IntervalIndex(dims, pos, ext);
+}
+
+
+IntervalIndex IntervalIndex::fromSorted(size_t dimensions, ndsize_t positions, std::vector<double> starts,
+                                        std::vector<double> ends, std::vector<ndsize_t> rows) {
+    if (dimensions == 0 || starts.size() % dimensions != 0 ||
+        ends.size() != starts.size() || rows.size() != starts.size()) {
+        throw std::invalid_argument("IntervalIndex::fromSorted: sizes of the sorted arrays do not match");
+    }
+
+    IntervalIndex index;
+    index.dims = dimensions;
+    index.total = positions;
+    index.count = starts.size() / dimensions;
+
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    index.row_start.assign(dimensions * positions, nan);
+    index.row_end.assign(dimensions * positions, nan);
+    for (size_t d = 0; d < dimensions; d++) {
+        for (size_t i = d * index.count; i < (d + 1) * index.count; i++) {
+            if (rows[i] >= positions) {
+                throw OutOfBounds("IntervalIndex::fromSorted: position number out of bounds", rows[i]);
+            }
+            index.row_start[d * positions + rows[i]] = starts[i];
+            index.row_end[d * positions + rows[i]] = ends[i];
+        }
+    }
+
+    index.sorted_start = std::move(starts);
+    index.sorted_end = std::move(ends);
+    index.sorted_row = std::move(rows);
+    index.prepare();
+    return index;
+}
+
+
+/*
+ * The sorted intervals of each dimension form an implicit binary search
+ * tree: elements with an even index are leaves, the element at index i
+ * with k trailing one bits is an inner node at level k. Every node gets
+ * the largest end of its subtree, which lets queries skip subtrees that
+ * end before the queried interval starts.
+ */
+void IntervalIndex::prepare() {
+    max_end.resize(sorted_end.size());
+    max_level.assign(dims, -1);
+
+    const ndsize_t n = count;
+    for (size_t d = 0; d < dims && n > 0; d++) {
+        const double *end = &sorted_end[d * n];
+        double *mx = &max_end[d * n];
+
+        ndsize_t last_i = 0;
+        double last = 0.0;
+        for (ndsize_t i = 0; i < n; i += 2) {
+            last_i = i;
+            last = mx[i] = end[i];
+        }
+
+        int k;
+        for (k = 1; (ndsize_t(1) << k) <= n; k++) {
+            const ndsize_t x = ndsize_t(1) << (k - 1), i0 = (x << 1) - 1, step = x << 2;
+            for (ndsize_t i = i0; i < n; i += step) {
+                const double el = mx[i - x];
+                const double er = i + x < n ? mx[i + x] : last;
+                mx[i] = std::max(end[i], std::max(el, er));
+            }
+            // the rightmost node of this level may lie beyond the end of the array
+            last_i = (last_i >> k & 1) ? last_i - x : last_i + x;
+            if (last_i < n && mx[last_i] > last) {
+                last = mx[last_i];
+            }
+        }
+        max_level[d] = k - 1;
+    }
+}
+
+
+void IntervalIndex::checkDimension(size_t dim, const char *where) const {
+    if (dim >= dims) {
+        throw OutOfBounds(std::string(where) + ": dimension out of bounds", dim);
+    }
+}
+
+
+template<typename F>
+void IntervalIndex::query(size_t dim, double lo, double hi, F &&emit) const {
+    const ndsize_t n = count;
+    if (n == 0 || !(lo <= hi)) {
+        return;
+    }
+
+    const double *start = &sorted_start[dim * n];
+    const double *end = &sorted_end[dim * n];
+    const double *mx = &max_end[dim * n];
+
+    struct Node {
+        ndsize_t x;
+        int k;
+        bool left_done;
+    };
+
+    // the depth of the traversal is bounded by twice the height of the tree
+    Node stack[130];
+    int t = 0;
+    const int root = max_level[dim];
+    stack[t++] = Node{(ndsize_t(1) << root) - 1, root, false};
+
+    while (t > 0) {
+        const Node z = stack[--t];
+        if (z.k <= 3) {
+            // small subtree: scan it, elements are visited in sorted order
+            ndsize_t i = z.x >> z.k << z.k;
+            const ndsize_t i1 = std::min(i + (ndsize_t(1) << (z.k + 1)) - 1, n);
+            for (; i < i1 && start[i] <= hi; i++) {
+                if (end[i] >= lo) {
+                    emit(i);
+                }
+            }
+        } else if (!z.left_done) {
+            const ndsize_t y = z.x - (ndsize_t(1) << (z.k - 1));
+            stack[t++] = Node{z.x, z.k, true};
+            // the left child may lie beyond the array, its own left subtree does not
+            if (y >= n || mx[y] >= lo) {
+                stack[t++] = Node{y, z.k - 1, false};
+            }
+        } else if (z.x < n && start[z.x] <= hi) {
+            if (end[z.x] >= lo) {
+                emit(z.x);
+            }
+            stack[t++] = Node{z.x + (ndsize_t(1) << (z.k - 1)), z.k - 1, false};
+        }
+    }
+}
+
+
+std::vector<ndsize_t> IntervalIndex::inRange(double lo, double hi, size_t dim) const {
+    std::vector<ndsize_t> result;
+    if (dims == 0) {
+        return result;
+    }
+    checkDimension(dim, "IntervalIndex::inRange");
+
+    const auto first = sorted_start.begin() + dim * count;
+    const auto last = first + count;
+    const auto from = std::lower_bound(first, last, lo);
+    const auto to = std::upper_bound(from, last, hi);
+
+    const auto rows = sorted_row.begin() + (from - sorted_start.begin());
+    result.assign(rows, rows + (to - from));
+    return result;
+}
+
+
+std::vector<ndsize_t> IntervalIndex::overlapping(double lo, double hi, size_t dim) const {
+    std::vector<ndsize_t> result;
+    if (dims == 0) {
+        return result;
+    }
+    checkDimension(dim, "IntervalIndex::overlapping");
+
+    const ndsize_t *rows = sorted_row.data() + dim * count;
+    query(dim, lo, hi, [&result, rows](ndsize_t i) {
+        result.push_back(rows[i]);
+    });
+    return result;
+}
+
+
+std::vector<ndsize_t> IntervalIndex::overlapping(const std::vector<double> &lo, const std::vector<double> &hi) const {
+    if (lo.size() != hi.size()) {
+        throw IncompatibleDimensions("Lower and upper bounds of the window differ in size", "IntervalIndex::overlapping");
+    }
+    if (lo.empty()) {
+        throw std::invalid_argument("IntervalIndex::overlapping: the window must not be empty");
+    }
+
+    std::vector<ndsize_t> result;
+    if (dims == 0) {
+        return result;
+    }
+    if (lo.size() > dims) {
+        throw IncompatibleDimensions("The window has more dimensions than the positions", "IntervalIndex::overlapping");
+    }
+
+    const ndsize_t *rows = sorted_row.data();
+    query(0, lo[0], hi[0], [&](ndsize_t i) {
+        const ndsize_t row = rows[i];
+        for (size_t d = 1; d < lo.size(); d++) {
+            const size_t j = d * total + row;
+            if (!(row_start[j] <= hi[d] && row_end[j] >= lo[d])) {
+                return;
+            }
+        }
+        result.push_back(row);
+    });
+    return result;
+}
+
+} // namespace nix
@@ -0,0 +1,300 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/MetadataSnapshot.hpp>
+#include <nix/Exception.hpp>
+
+#include <algorithm>
+
+namespace nix {
+
+const size_t MetadataSnapshot::npos;
+
+
+size_t MetadataSnapshot::addSection(const std::string &name, const std::string &type,
+                                    size_t parent, const std::string &id) {
+    if (parent != npos) {
+        checkSection(parent, "MetadataSnapshot::addSection");
+    }
+
+    SectionNode node;
+    node.id = id;
+    node.name = name;
+    node.type = type;
+    node.parent = parent;
+
+    section_nodes.push_back(std::move(node));
+    index_dirty = true;
+
+    return section_nodes.size() - 1;
+}
+
+
+size_t MetadataSnapshot::addProperty(size_t section, const std::string &name,
+                                     const std::vector<Value> &values, const std::string &id) {
+    if (values.empty()) {
+        throw std::runtime_error("MetadataSnapshot::addProperty: property without values, use the DataType overload!");
+    }
+
+    size_t index = addProperty(section, name, values[0].type(), id);
+    PropertyNode &node = property_nodes[index];
+
+    node.value_offset = value_data.size();
+    node.value_count = values.size();
+    value_data.insert(value_data.end(), values.begin(), values.end());
+
+    return index;
+}
+
+
+size_t MetadataSnapshot::addProperty(size_t section, const std::string &name, DataType dtype,
+                                     const std::string &id) {
+    checkSection(section, "MetadataSnapshot::addProperty");
+
+    PropertyNode node;
+    node.id = id;
+    node.name = name;
+    node.data_type = dtype;
+    node.section = section;
+    node.value_offset = value_data.size();
+    node.value_count = 0;
+
+    property_nodes.push_back(std::move(node));
+    index_dirty = true;
+
+    return property_nodes.size() - 1;
+}
+
+
+void MetadataSnapshot::clear() {
+    section_nodes.clear();
+    property_nodes.clear();
+    value_data.clear();
+    index_dirty = true;
+}
+
+
+MetadataSnapshot::SectionNode &MetadataSnapshot::section(size_t index) {
+    checkSection(index, "MetadataSnapshot::section");
+    // the caller might change the id, name or type
+    index_dirty = true;
+    return section_nodes[index];
+}
+
+
+const MetadataSnapshot::SectionNode &MetadataSnapshot::section(size_t index) const {
+    checkSection(index, "MetadataSnapshot::section");
+    return section_nodes[index];
+}
+
+
+MetadataSnapshot::PropertyNode &MetadataSnapshot::property(size_t index) {
+    if (index >= property_nodes.size()) {
+        throw OutOfBounds("MetadataSnapshot::property: index out of bounds", index);
+    }
+    index_dirty = true;
+    return property_nodes[index];
+}
+
+
+const MetadataSnapshot::PropertyNode &MetadataSnapshot::property(size_t index) const {
+    if (index >= property_nodes.size()) {
+        throw OutOfBounds("MetadataSnapshot::property: index out of bounds", index);
+    }
+    return property_nodes[index];
+}
+
+
+MetadataSnapshot::IndexRange MetadataSnapshot::rootSections() const {
+    buildIndex();
+    return IndexRange(root_index.data(), root_index.data() + root_index.size());
+}
+
+
+MetadataSnapshot::IndexRange MetadataSnapshot::sections(size_t section) const {
+    checkSection(section, "MetadataSnapshot::sections");
+    buildIndex();
+    const size_t *base = child_index.data();
+    return IndexRange(base + child_offsets[section], base + child_offsets[section + 1]);
+}
+
+
+MetadataSnapshot::IndexRange MetadataSnapshot::properties(size_t section) const {
+    checkSection(section, "MetadataSnapshot::properties");
+    buildIndex();
+    const size_t *base = prop_index.data();
+    return IndexRange(base + prop_offsets[section], base + prop_offsets[section + 1]);
+}
+
+
+MetadataSnapshot::ValueRange MetadataSnapshot::values(size_t property) const {
+    const PropertyNode &node = this->property(property);
+    const Value *base = value_data.data() + node.value_offset;
+    return ValueRange(base, base + node.value_count);
+}
+
+
+size_t MetadataSnapshot::findSection(const std::string &name_or_id) const {
+    size_t found = findSectionById(name_or_id);
+    if (found != npos) {
+        return found;
+    }
+
+    auto by_name = section_names.equal_range(name_or_id);
+    for (auto it = by_name.first; it != by_name.second; ++it) {
+        found = std::min(found, it->second);
+    }
+
+    return found;
+}
+
+
+size_t MetadataSnapshot::findSectionById(const std::string &id) const {
+    buildIndex();
+    auto it = section_ids.find(id);
+    return it != section_ids.end() ? it->second : npos;
+}
+
+
+static std::vector<size_t> sorted_matches(const std::unordered_multimap<std::string, size_t> &map,
+                                          const std::string &key) {
+    std::vector<size_t> result;
+    auto range = map.equal_range(key);
+    for (auto it = range.first; it != range.second; ++it) {
+        result.push_back(it->second);
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+
+std::vector<size_t> MetadataSnapshot::findSectionsByName(const std::string &name) const {
+    buildIndex();
+    return sorted_matches(section_names, name);
+}
+
+
+std::vector<size_t> MetadataSnapshot::findSectionsByType(const std::string &type) const {
+    buildIndex();
+    return sorted_matches(section_types, type);
+}
+
+
+size_t MetadataSnapshot::findProperty(size_t section, const std::string &name_or_id) const {
+    size_t by_id = findPropertyById(name_or_id);
+    if (by_id != npos && property_nodes[by_id].section == section) {
+        return by_id;
+    }
+
+    for (size_t p : properties(section)) {
+        if (property_nodes[p].name == name_or_id) {
+            return p;
+        }
+    }
+
+    return npos;
+}
+
+
+size_t MetadataSnapshot::findPropertyById(const std::string &id) const {
+    buildIndex();
+    auto it = property_ids.find(id);
+    return it != property_ids.end() ? it->second : npos;
+}
+
+
+std::string MetadataSnapshot::path(size_t section) const {
+    checkSection(section, "MetadataSnapshot::path");
+
+    std::vector<const std::string *> names;
+    for (size_t cur = section; cur != npos; cur = section_nodes[cur].parent) {
+        names.push_back(&section_nodes[cur].name);
+    }
+
+    std::string result;
+    for (auto it = names.rbegin(); it != names.rend(); ++it) {
+        result += "/" + **it;
+    }
+
+    return result;
+}
+
+
+void MetadataSnapshot::checkSection(size_t index, const char *where) const {
+    if (index >= section_nodes.size()) {
+        throw OutOfBounds(std::string(where) + ": section index out of bounds", index);
+    }
+}
+
+
+void MetadataSnapshot::buildIndex() const {
+    if (!index_dirty) {
+        return;
+    }
+
+    const size_t nsec = section_nodes.size();
+
+    // children and properties are stored in CSR form: the entries of
+    // section i are found at [offsets[i], offsets[i+1]) in the index array
+    root_index.clear();
+    child_offsets.assign(nsec + 1, 0);
+    prop_offsets.assign(nsec + 1, 0);
+
+    for (size_t i = 0; i < nsec; i++) {
+        size_t parent = section_nodes[i].parent;
+        if (parent == npos) {
+            root_index.push_back(i);
+        } else {
+            child_offsets[parent + 1]++;
+        }
+    }
+
+    for (const PropertyNode &prop : property_nodes) {
+        prop_offsets[prop.section + 1]++;
+    }
+
+    for (size_t i = 0; i < nsec; i++) {
+        child_offsets[i + 1] += child_offsets[i];
+        prop_offsets[i + 1] += prop_offsets[i];
+    }
+
+    std::vector<size_t> child_pos(child_offsets.begin(), child_offsets.end() - 1);
+    std::vector<size_t> prop_pos(prop_offsets.begin(), prop_offsets.end() - 1);
+
+    child_index.resize(child_offsets[nsec]);
+    prop_index.resize(prop_offsets[nsec]);
+
+    section_ids.clear();
+    section_names.clear();
+    section_types.clear();
+    property_ids.clear();
+
+    for (size_t i = 0; i < nsec; i++) {
+        const SectionNode &node = section_nodes[i];
+        if (node.parent != npos) {
+            child_index[child_pos[node.parent]++] = i;
+        }
+        if (!node.id.empty()) {
+            section_ids.emplace(node.id, i);
+        }
+        section_names.emplace(node.name, i);
+        section_types.emplace(node.type, i);
+    }
+
+    for (size_t i = 0; i < property_nodes.size(); i++) {
+        const PropertyNode &prop = property_nodes[i];
+        prop_index[prop_pos[prop.section]++] = i;
+        if (!prop.id.empty()) {
+            property_ids.emplace(prop.id, i);
+        }
+    }
+
+    index_dirty = false;
+}
+
+} // namespace nix
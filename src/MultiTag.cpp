@@ -7,6 +7,7 @@
 // LICENSE file in the root of the Project.
 
 #include <nix/MultiTag.hpp>
+#include <nix/IntervalIndex.hpp>
 
 #include <nix/util/util.hpp>
 #include <nix/util/dataAccess.hpp>
@@ -81,7 +82,17 @@ void MultiTag::addReference(const DataArray &reference) {
     if(!util::checkEntityInput(reference)) {
         throw UninitializedEntity();
     }
-    backend()->addReference(reference.id());
+    backend()->addReferences({reference});
+}
+
+
+void MultiTag::addReferences(const std::vector<DataArray> &references) {
+    for (const DataArray &reference : references) {
+        if (!util::checkEntityInput(reference)) {
+            throw UninitializedEntity();
+        }
+    }
+    backend()->addReferences(references);
 }
 
 
@@ -104,6 +115,21 @@ DataView MultiTag::retrieveData(size_t position_index, size_t reference_index) c
 }
 
 
+std::vector<ndsize_t> MultiTag::positionsInRange(double lo, double hi, size_t dim) const {
+    return backend()->intervalIndex()->inRange(lo, hi, dim);
+}
+
+
+std::vector<ndsize_t> MultiTag::overlapping(double lo, double hi, size_t dim) const {
+    return backend()->intervalIndex()->overlapping(lo, hi, dim);
+}
+
+
+std::vector<ndsize_t> MultiTag::overlapping(const std::vector<double> &lo, const std::vector<double> &hi) const {
+    return backend()->intervalIndex()->overlapping(lo, hi);
+}
+
+
 bool MultiTag::hasFeature(const Feature &feature) const {
     if (!util::checkEntityInput(feature, false)) {
         return false;
@@ -9,10 +9,13 @@
 
 #include <nix/NDArray.hpp>
 
+#include <cstring>
+
 namespace nix {
 
 
-NDArray::NDArray(DataType dtype, NDSize dims) : dataType(dtype), extends(dims) {
+NDArray::NDArray(DataType dtype, NDSize dims, bool zero_fill)
+    : dataType(dtype), extends(dims), zero_fill(zero_fill) {
     allocate_space();
 }
 
@@ -21,8 +24,14 @@ void NDArray::allocate_space() {
     size_t type_size = data_type_to_size(dataType);
 	ndsize_t bytes = extends.nelms() * type_size;
 	size_t alloc_size = check::fits_in_size_t(bytes, "Cannot allocate storage (exceeds memory)");
+    size_t old_size = dstore.size();
     dstore.resize(alloc_size);
 
+    // the storage does not initialize new elements by itself
+    if (zero_fill && alloc_size > old_size) {
+        std::memset(dstore.data() + old_size, 0, alloc_size - old_size);
+    }
+
     calc_strides();
 }
 
@@ -0,0 +1,411 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/DataArray.hpp>
+#include <nix/Exception.hpp>
+#include <nix/util/util.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+
+namespace nix {
+
+namespace {
+
+/*
+ * An overview pyramid is stored as derived arrays of the data array: one
+ * array of minima, maxima and means for every level and, written last, the
+ * array "overview" with axis, factor and number of samples. Level l has the
+ * shape of the data with the axis replaced by ceil(count / factor^l) bins.
+ */
+const char *const meta_name = "overview";
+const char *const stat_names[3] = {"min", "max", "mean"};
+
+const size_t max_levels = 64;
+const size_t default_factor = 16;
+
+// number of doubles read at once while combining samples
+const ndsize_t slab_size = ndsize_t(1) << 20;
+
+
+std::string level_name(size_t stat, size_t level) {
+    return std::string("overview_") + stat_names[stat] + "_" + util::numToStr(level);
+}
+
+
+struct Pyramid {
+    NDSize shape;
+    size_t axis;
+    ndsize_t factor;
+
+    ndsize_t count() const {
+        return shape[axis];
+    }
+
+    ndsize_t outer() const {
+        ndsize_t n = 1;
+        for (size_t i = 0; i < axis; i++) {
+            n *= shape[i];
+        }
+        return n;
+    }
+
+    ndsize_t inner() const {
+        ndsize_t n = 1;
+        for (size_t i = axis + 1; i < shape.size(); i++) {
+            n *= shape[i];
+        }
+        return n;
+    }
+
+    // samples per bin of a level, saturated at the largest ndsize_t
+    ndsize_t binSize(size_t level) const {
+        ndsize_t n = 1;
+        for (size_t l = 0; l < level; l++) {
+            if (n > std::numeric_limits<ndsize_t>::max() / factor) {
+                return std::numeric_limits<ndsize_t>::max();
+            }
+            n *= factor;
+        }
+        return n;
+    }
+
+    ndsize_t bins(size_t level) const {
+        const ndsize_t size = binSize(level);
+        return count() / size + (count() % size != 0);
+    }
+
+    // levels are added until one bin covers all samples
+    size_t levels() const {
+        size_t l = 0;
+        for (ndsize_t size = 1; size < count(); l++) {
+            size = size > count() / factor ? count() : size * factor;
+        }
+        return l;
+    }
+
+    NDSize levelShape(size_t level) const {
+        NDSize s = shape;
+        s[axis] = bins(level);
+        return s;
+    }
+
+    // count and offset of a slab of n points along the axis
+    void slab(ndsize_t off, ndsize_t n, NDSize &count, NDSize &offset) const {
+        count = shape;
+        count[axis] = n;
+        offset = NDSize(shape.size(), 0);
+        offset[axis] = off;
+    }
+};
+
+
+bool read_pyramid(const base::IDataArray &array, Pyramid &p) {
+    if (array.derivedExtent(meta_name) != NDSize({3})) {
+        return false;
+    }
+    double meta[3];
+    array.readDerived(meta_name, meta, NDSize({3}), NDSize({0}));
+
+    p.shape = array.dataExtent();
+    p.axis = static_cast<size_t>(meta[0]);
+    p.factor = static_cast<ndsize_t>(meta[1]);
+    if (p.axis >= p.shape.size() || p.factor < 2 || meta[2] != static_cast<double>(p.count())) {
+        return false;
+    }
+
+    const size_t levels = p.levels();
+    for (size_t l = 1; l <= levels; l++) {
+        const NDSize shape = p.levelShape(l);
+        for (size_t s = 0; s < 3; s++) {
+            if (array.derivedExtent(level_name(s, l)) != shape) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+
+// reads n points from off along the axis, one array each for min, max and mean
+typedef std::function<void(ndsize_t off, ndsize_t n, const double *stats[3])> SlabReader;
+typedef std::function<void(ndsize_t off, ndsize_t n, const double *const stats[3])> SlabWriter;
+
+/*
+ * Combine the points [from * ratio, to * ratio) of a source, whose points
+ * cover src_bin samples each, into the bins [from, to). Minimum and maximum
+ * skip NaN values, the mean is weighted by the samples of each point.
+ */
+void reduce(const Pyramid &p, ndsize_t src_bin, ndsize_t ratio, ndsize_t from, ndsize_t to,
+            const SlabReader &read, const SlabWriter &write) {
+    const ndsize_t outer = p.outer(), inner = p.inner(), count = p.count();
+    const ndsize_t src_n = count / src_bin + (count % src_bin != 0);
+    const ndsize_t plane = std::max<ndsize_t>(outer * inner, 1);
+    const ndsize_t chunk = std::max<ndsize_t>(slab_size / plane / ratio, 1);
+    const ndsize_t step = std::max<ndsize_t>(slab_size / plane, 1);
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+
+    std::vector<double> mn, mx, sum;
+    for (ndsize_t b0 = from; b0 < to; b0 += chunk) {
+        const ndsize_t nb = std::min(chunk, to - b0);
+        const size_t n = check::fits_in_size_t(outer * nb * inner, "Overview slab exceeds memory.");
+        mn.assign(n, nan);
+        mx.assign(n, nan);
+        sum.assign(n, 0.0);
+
+        const ndsize_t c_end = std::min((b0 + nb) * ratio, src_n);
+        for (ndsize_t s = b0 * ratio; s < c_end; s += step) {
+            const ndsize_t ns = std::min(step, c_end - s);
+            const double *src[3];
+            read(s, ns, src);
+
+            for (ndsize_t o = 0; o < outer; o++) {
+                for (ndsize_t c = s; c < s + ns; c++) {
+                    const double w = static_cast<double>(std::min(src_bin, count - c * src_bin));
+                    double *a_mn = &mn[(o * nb + c / ratio - b0) * inner];
+                    double *a_mx = &mx[(o * nb + c / ratio - b0) * inner];
+                    double *a_sum = &sum[(o * nb + c / ratio - b0) * inner];
+                    const ndsize_t r = (o * ns + c - s) * inner;
+                    for (ndsize_t i = 0; i < inner; i++) {
+                        const double v_mn = src[0][r + i], v_mx = src[1][r + i];
+                        if (std::isnan(a_mn[i]) || v_mn < a_mn[i]) {
+                            a_mn[i] = v_mn;
+                        }
+                        if (std::isnan(a_mx[i]) || v_mx > a_mx[i]) {
+                            a_mx[i] = v_mx;
+                        }
+                        a_sum[i] += w * src[2][r + i];
+                    }
+                }
+            }
+        }
+
+        const ndsize_t bin_size = ratio * src_bin;
+        for (ndsize_t o = 0; o < outer; o++) {
+            for (ndsize_t b = 0; b < nb; b++) {
+                const double total = static_cast<double>(std::min(bin_size, count - (b0 + b) * bin_size));
+                double *a_sum = &sum[(o * nb + b) * inner];
+                for (ndsize_t i = 0; i < inner; i++) {
+                    a_sum[i] /= total;
+                }
+            }
+        }
+
+        const double *const stats[3] = {mn.data(), mx.data(), sum.data()};
+        write(b0, nb, stats);
+    }
+}
+
+} // anonymous namespace
+
+
+void DataArray::createOverview(size_t axis, size_t factor) {
+    if (factor < 2) {
+        throw std::invalid_argument("DataArray::createOverview: the factor must be at least 2");
+    }
+    if (axis >= dataExtent().size()) {
+        throw OutOfBounds("DataArray::createOverview: axis out of bounds", axis);
+    }
+
+    deleteOverview();
+    updateOverview(axis, factor, 0);
+}
+
+
+bool DataArray::hasOverview() const {
+    Pyramid p;
+    return read_pyramid(*backend(), p);
+}
+
+
+void DataArray::deleteOverview() {
+    backend()->deleteDerived(meta_name);
+    for (size_t l = 1; l <= max_levels; l++) {
+        for (size_t s = 0; s < 3; s++) {
+            backend()->deleteDerived(level_name(s, l));
+        }
+    }
+}
+
+
+std::pair<size_t, size_t> DataArray::overviewLayout() const {
+    Pyramid p;
+    if (!read_pyramid(*backend(), p)) {
+        return std::make_pair(size_t(0), size_t(0));
+    }
+    return std::make_pair(p.axis, static_cast<size_t>(p.factor));
+}
+
+
+void DataArray::updateOverview(size_t axis, size_t factor, ndsize_t old_count) {
+    Pyramid p;
+    p.shape = dataExtent();
+    p.axis = axis;
+    p.factor = factor;
+
+    Pyramid old = p;
+    old.shape[axis] = old_count;
+    const size_t old_levels = old.levels();
+
+    std::vector<double> raw;
+    std::vector<double> buf[3];
+    NDSize count, offset;
+
+    const SlabReader read_raw = [&](ndsize_t off, ndsize_t n, const double *stats[3]) {
+        p.slab(off, n, count, offset);
+        raw.resize(count.nelms());
+        if (!raw.empty()) {
+            getData(DataType::Double, raw.data(), count, offset);
+        }
+        stats[0] = stats[1] = stats[2] = raw.data();
+    };
+
+    const size_t levels = p.levels();
+    for (size_t l = 1; l <= levels; l++) {
+        const NDSize shape = p.levelShape(l);
+        const ndsize_t bins = shape[axis];
+        // complete bins before the first appended sample are unchanged
+        const ndsize_t from = l <= old_levels ? std::min(old_count / p.binSize(l), bins - 1) : 0;
+
+        const SlabReader read_level = [&](ndsize_t off, ndsize_t n, const double *stats[3]) {
+            p.slab(off, n, count, offset);
+            for (size_t s = 0; s < 3; s++) {
+                buf[s].resize(count.nelms());
+                if (!buf[s].empty()) {
+                    backend()->readDerived(level_name(s, l - 1), buf[s].data(), count, offset);
+                }
+                stats[s] = buf[s].data();
+            }
+        };
+
+        const SlabWriter write = [&](ndsize_t off, ndsize_t n, const double *const stats[3]) {
+            p.slab(off, n, count, offset);
+            for (size_t s = 0; s < 3; s++) {
+                backend()->writeDerived(level_name(s, l), shape, stats[s], count, offset);
+            }
+        };
+
+        reduce(p, p.binSize(l - 1), factor, from, bins, l == 1 ? read_raw : read_level, write);
+    }
+
+    const double meta[3] = {static_cast<double>(axis), static_cast<double>(factor),
+                            static_cast<double>(p.count())};
+    backend()->writeDerived(meta_name, NDSize({3}), meta, NDSize({3}), NDSize({0}));
+}
+
+
+Overview DataArray::overview(size_t axis, double lo, double hi, size_t max_points) const {
+    if (max_points == 0) {
+        throw std::invalid_argument("DataArray::overview: max_points must be at least 1");
+    }
+    const NDSize shape = dataExtent();
+    if (axis >= shape.size()) {
+        throw OutOfBounds("DataArray::overview: axis out of bounds", axis);
+    }
+    if (dimensionCount() <= axis || getDimension(axis + 1).dimensionType() != DimensionType::Sample) {
+        throw IncompatibleDimensions("The dimension of the axis is not a sampled dimension", "DataArray::overview");
+    }
+
+    const SampledDimension dim = getDimension(axis + 1).asSampledDimension();
+    const double interval = dim.samplingInterval();
+    const boost::optional<double> dim_offset = dim.offset();
+    const double origin = dim_offset ? *dim_offset : 0.0;
+
+    Pyramid p;
+    const bool stored = read_pyramid(*backend(), p) && p.axis == axis;
+    if (!stored) {
+        p.shape = shape;
+        p.axis = axis;
+        p.factor = default_factor;
+    }
+
+    Overview result;
+    result.axis = axis;
+    result.start = origin;
+    result.step = interval;
+
+    // the samples within the window
+    const ndsize_t n = shape[axis];
+    const double first = std::ceil((lo - origin) / interval);
+    const double last = std::floor((hi - origin) / interval);
+    NDSize result_shape = shape;
+    result_shape[axis] = 0;
+    if (n == 0 || !(first <= last) || last < 0 || first > static_cast<double>(n - 1)) {
+        result.min = result.max = result.mean = NDArray(DataType::Double, result_shape);
+        return result;
+    }
+    const ndsize_t i0 = first < 0 ? 0 : static_cast<ndsize_t>(first);
+    const ndsize_t i1 = std::min(n - 1, static_cast<ndsize_t>(last));
+
+    // the finest level with few enough points
+    const size_t top = stored ? p.levels() : max_levels;
+    size_t level = 0;
+    ndsize_t bin = 1;
+    while (i1 / bin - i0 / bin + 1 > max_points && level < top) {
+        level++;
+        bin = p.binSize(level);
+    }
+
+    const ndsize_t b0 = i0 / bin;
+    const ndsize_t points = i1 / bin - b0 + 1;
+    result_shape[axis] = points;
+    result.min = NDArray(DataType::Double, result_shape, false);
+    result.max = NDArray(DataType::Double, result_shape, false);
+    result.mean = NDArray(DataType::Double, result_shape, false);
+    double *out[3] = {reinterpret_cast<double *>(result.min.data()),
+                      reinterpret_cast<double *>(result.max.data()),
+                      reinterpret_cast<double *>(result.mean.data())};
+
+    const size_t nelms = check::fits_in_size_t(result_shape.nelms(), "Overview exceeds memory.");
+    NDSize count, offset;
+    if (nelms == 0) {
+        // nothing to read
+    } else if (level == 0) {
+        p.slab(i0, points, count, offset);
+        getData(DataType::Double, out[0], count, offset);
+        std::memcpy(out[1], out[0], nelms * sizeof(double));
+        std::memcpy(out[2], out[0], nelms * sizeof(double));
+    } else if (stored) {
+        p.slab(b0, points, count, offset);
+        for (size_t s = 0; s < 3; s++) {
+            backend()->readDerived(level_name(s, level), out[s], count, offset);
+        }
+    } else {
+        std::vector<double> raw;
+        const SlabReader read_raw = [&](ndsize_t off, ndsize_t n, const double *stats[3]) {
+            p.slab(off, n, count, offset);
+            raw.resize(count.nelms());
+            getData(DataType::Double, raw.data(), count, offset);
+            stats[0] = stats[1] = stats[2] = raw.data();
+        };
+
+        const ndsize_t outer = p.outer(), inner = p.inner();
+        const SlabWriter write = [&](ndsize_t off, ndsize_t n, const double *const stats[3]) {
+            for (size_t s = 0; s < 3; s++) {
+                for (ndsize_t o = 0; o < outer; o++) {
+                    std::memcpy(out[s] + (o * points + off - b0) * inner, stats[s] + o * n * inner,
+                                n * inner * sizeof(double));
+                }
+            }
+        };
+
+        reduce(p, 1, bin, b0, b0 + points, read_raw, write);
+    }
+
+    result.factor = bin;
+    result.offset = b0 * bin;
+    result.start = origin + static_cast<double>(result.offset) * interval;
+    result.step = static_cast<double>(bin) * interval;
+    return result;
+}
+
+} // namespace nix
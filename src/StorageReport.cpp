@@ -0,0 +1,97 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/StorageReport.hpp>
+#include <nix/Exception.hpp>
+
+#include <algorithm>
+
+namespace nix {
+
+const size_t StorageReport::max_largest_groups;
+
+
+double StorageReport::Array::compressionRatio() const {
+    if (allocated_bytes == 0 || storage_bytes == 0) {
+        return 1.0;
+    }
+    return static_cast<double>(allocated_bytes) / static_cast<double>(storage_bytes);
+}
+
+
+double StorageReport::Array::readAmplification(const NDSize &count) const {
+    if (count.size() != extent.size()) {
+        throw InvalidRank("StorageReport::Array::readAmplification: rank of the slab does not match the data");
+    }
+    if (chunks.size() != extent.size() || count.nelms() == 0) {
+        return 1.0;
+    }
+
+    double amplification = 1.0;
+    for (size_t i = 0; i < extent.size(); i++) {
+        const double c = static_cast<double>(chunks[i]);
+        const ndsize_t n = std::min(count[i], extent[i]);
+        double touched;
+        if (n == extent[i]) {
+            // the whole extent, only the last chunk is padded
+            touched = static_cast<double>((extent[i] + chunks[i] - 1) / chunks[i]) * c;
+        } else {
+            // expected number of chunks a range of n elements at a random offset spans
+            touched = (1.0 + static_cast<double>(n - 1) / c) * c;
+        }
+        amplification *= touched / static_cast<double>(n);
+    }
+    return std::max(amplification, 1.0);
+}
+
+
+NDSize StorageReport::Array::rowSlab() const {
+    NDSize slab = extent;
+    if (slab.size() > 0) {
+        slab[0] = 1;
+    }
+    return slab;
+}
+
+
+NDSize StorageReport::Array::columnSlab() const {
+    NDSize slab(extent.size(), 1);
+    if (slab.size() > 0) {
+        slab[0] = extent[0];
+    }
+    return slab;
+}
+
+
+void StorageReport::addGroup(const std::string &path, size_t children) {
+    if (largest_groups.size() == max_largest_groups && largest_groups.back().children >= children) {
+        return;
+    }
+
+    auto pos = std::upper_bound(largest_groups.begin(), largest_groups.end(), children,
+                                [](size_t n, const Group &group) { return n > group.children; });
+    Group group;
+    group.path = path;
+    group.children = children;
+    largest_groups.insert(pos, group);
+
+    if (largest_groups.size() > max_largest_groups) {
+        largest_groups.pop_back();
+    }
+}
+
+
+ndsize_t StorageReport::storageBytes() const {
+    ndsize_t total = 0;
+    for (const Array &array : arrays) {
+        total += array.storage_bytes + array.derived_bytes;
+    }
+    return total;
+}
+
+} // namespace nix
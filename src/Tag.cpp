@@ -49,7 +49,17 @@ void Tag::addReference(const DataArray &reference) {
     if (!util::checkEntityInput(reference, false)) {
         throw UninitializedEntity();
     }
-    backend()->addReference(reference.id());
+    backend()->addReferences({reference});
+}
+
+
+void Tag::addReferences(const std::vector<DataArray> &references) {
+    for (const DataArray &reference : references) {
+        if (!util::checkEntityInput(reference, false)) {
+            throw UninitializedEntity();
+        }
+    }
+    backend()->addReferences(references);
 }
 
 
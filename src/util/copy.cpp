@@ -0,0 +1,790 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/util/copy.hpp>
+#include <nix/Exception.hpp>
+#include <nix/util/util.hpp>
+#include "hdf5/FileHDF5.hpp"
+#include "hdf5/BlockHDF5.hpp"
+#include "hdf5/EntityCopyHDF5.hpp"
+
+#ifdef ENABLE_FS_BACKEND
+#include "fs/FileFS.hpp"
+#include "fs/EntityCopyFS.hpp"
+#endif
+
+#include <boost/filesystem.hpp>
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+
+namespace bfs = boost::filesystem;
+
+namespace nix {
+namespace util {
+
+namespace {
+
+// upper bound for the size of the slabs read by copy and verification
+const ndsize_t SLAB_BYTES = 8 << 20;
+
+typedef std::chrono::steady_clock Clock;
+
+double seconds_since(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+
+size_t pool_size(size_t jobs) {
+    return jobs ? jobs : std::max<size_t>(1, std::thread::hardware_concurrency());
+}
+
+
+bool little_endian() {
+    const uint16_t one = 1;
+    return *reinterpret_cast<const uint8_t *>(&one) == 1;
+}
+
+
+/*
+ * The HDF5 shuffle filter: byte j of value i is moved to j * n + i, so that
+ * bytes of the same significance are stored next to each other.
+ */
+void shuffle_bytes(const char *in, char *out, size_t n, size_t esize) {
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < esize; j++) {
+            out[j * n + i] = in[i * esize + j];
+        }
+    }
+}
+
+
+void swap_bytes(char *data, size_t n, size_t esize) {
+    for (size_t i = 0; i < n; i++) {
+        std::reverse(data + i * esize, data + (i + 1) * esize);
+    }
+}
+
+
+/*
+ * Copy the part of a slab that falls into one chunk into a zero-padded
+ * chunk buffer. first is the position of the chunk within the slab.
+ */
+void gather(const char *slab, const NDSize &count, const NDSize &chunks, const NDSize &first,
+            size_t esize, char *out) {
+    const size_t rank = count.size();
+    NDSize size(rank, 0), pos(rank, 0);
+    for (size_t d = 0; d < rank; d++) {
+        size[d] = std::min(chunks[d], count[d] - first[d]);
+    }
+
+    const size_t run = static_cast<size_t>(size[rank - 1]) * esize;
+    const ndsize_t rows = size.nelms() / size[rank - 1];
+    for (ndsize_t r = 0; r < rows; r++) {
+        ndsize_t src = 0, dst = 0;
+        for (size_t d = 0; d < rank; d++) {
+            src = src * count[d] + first[d] + pos[d];
+            dst = dst * chunks[d] + pos[d];
+        }
+        std::memcpy(out + dst * esize, slab + src * esize, run);
+
+        for (size_t d = rank - 1; d-- > 0;) {
+            if (++pos[d] < size[d]) {
+                break;
+            }
+            pos[d] = 0;
+        }
+    }
+}
+
+
+struct Tile {
+    ndsize_t index = 0;
+    NDSize chunk;
+    std::vector<char> data;
+};
+
+
+/*
+ * Filters chunks on a pool of threads and writes them on a separate
+ * thread, in the order in which they were pushed. At most window chunks
+ * are in flight at any time, push blocks until one of them is written.
+ */
+class ChunkWriter {
+
+public:
+
+    ChunkWriter(const DataArray &target, size_t esize, unsigned compression, bool shuffle, size_t jobs)
+        : target(target), esize(esize), compression(compression), shuffle(shuffle),
+          pushed(0), written(0), closing(false), aborted(false)
+    {
+        jobs = pool_size(jobs);
+        window = 4 * jobs;
+        for (size_t i = 0; i < jobs; i++) {
+            workers.emplace_back(&ChunkWriter::filter, this);
+        }
+        writer = std::thread(&ChunkWriter::write, this);
+    }
+
+    ChunkWriter(const ChunkWriter &other) = delete;
+    ChunkWriter &operator=(const ChunkWriter &other) = delete;
+
+    void push(Tile &&tile) {
+        std::unique_lock<std::mutex> lock(mutex);
+        cond.wait(lock, [this] { return error || pushed - written < window; });
+        if (error) {
+            std::rethrow_exception(error);
+        }
+        tile.index = pushed++;
+        pending.push_back(std::move(tile));
+        cond.notify_all();
+    }
+
+    ndsize_t finish() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            closing = true;
+        }
+        cond.notify_all();
+        join();
+        if (error) {
+            std::rethrow_exception(error);
+        }
+        return written;
+    }
+
+    ~ChunkWriter() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            aborted = true;
+        }
+        cond.notify_all();
+        join();
+    }
+
+private:
+
+    DataArray target;
+    size_t esize;
+    unsigned compression;
+    bool shuffle;
+
+    std::mutex mutex;
+    std::condition_variable cond;
+    std::deque<Tile> pending;
+    std::map<ndsize_t, Tile> ready;
+    ndsize_t window, pushed, written;
+    bool closing, aborted;
+    std::exception_ptr error;
+    std::vector<std::thread> workers;
+    std::thread writer;
+
+    void join() {
+        for (auto &worker : workers) {
+            if (worker.joinable()) {
+                worker.join();
+            }
+        }
+        if (writer.joinable()) {
+            writer.join();
+        }
+    }
+
+    void fail() {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!error) {
+            error = std::current_exception();
+        }
+        cond.notify_all();
+    }
+
+    void encode(std::vector<char> &data) const {
+        if (!little_endian()) {
+            swap_bytes(data.data(), data.size() / esize, esize);
+        }
+        encodeChunk(data, esize, compression, shuffle);
+    }
+
+    void filter() {
+        try {
+            for (;;) {
+                Tile tile;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    cond.wait(lock, [this] { return error || aborted || closing || !pending.empty(); });
+                    if (error || aborted || pending.empty()) {
+                        return;
+                    }
+                    tile = std::move(pending.front());
+                    pending.pop_front();
+                }
+
+                encode(tile.data);
+
+                std::lock_guard<std::mutex> lock(mutex);
+                ready.emplace(tile.index, std::move(tile));
+                cond.notify_all();
+            }
+        } catch (...) {
+            fail();
+        }
+    }
+
+    void write() {
+        try {
+            for (;;) {
+                Tile tile;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    cond.wait(lock, [this] {
+                        return error || aborted || ready.count(written) > 0 || (closing && written == pushed);
+                    });
+                    auto it = ready.find(written);
+                    if (error || aborted || it == ready.end()) {
+                        return;
+                    }
+                    tile = std::move(it->second);
+                    ready.erase(it);
+                }
+
+                target.writeChunk(tile.chunk, tile.data.data(), tile.data.size(), 0);
+
+                std::lock_guard<std::mutex> lock(mutex);
+                written++;
+                cond.notify_all();
+            }
+        } catch (...) {
+            fail();
+        }
+    }
+};
+
+
+/*
+ * The filters of the copy of an array: those of the options, where they
+ * are not set those of the source. Dropping the compression also drops
+ * the shuffle filter unless it was asked for.
+ */
+void copy_filters(const std::shared_ptr<base::IDataArray> &src, const CopyOptions &options,
+                  unsigned &compression, bool &shuffle) {
+    compression = 0;
+    shuffle = false;
+    auto hdf5_src = std::dynamic_pointer_cast<hdf5::DataArrayHDF5>(src);
+    if (hdf5_src && !(options.compression && options.shuffle)) {
+        hdf5_src->deflateFilter(compression, shuffle);
+    }
+    if (options.compression) {
+        compression = *options.compression;
+        shuffle = shuffle && compression > 0;
+    }
+    if (options.shuffle) {
+        shuffle = *options.shuffle;
+    }
+}
+
+
+/*
+ * Copy the data of a DataArray chunk by chunk. The source is read in slabs
+ * of whole chunk rows; every slab is cut into chunks which are handed to
+ * the ChunkWriter, so reading the next slab overlaps with filtering and
+ * writing the chunks of the previous ones. Where the chunks cannot be
+ * written directly, the slabs are written as they are and the filters
+ * run in the HDF5 library.
+ */
+void copy_chunked(const std::shared_ptr<base::IDataArray> &src, const std::shared_ptr<hdf5::DataArrayHDF5> &dst,
+                  const CopyOptions &options, CopyReport &report) {
+    const DataType dtype = src->dataType();
+    const NDSize extent = src->dataExtent();
+    report.data_arrays++;
+
+    // the stored representation of these is not plain values
+    if (!data_type_is_numeric(dtype) || dtype == DataType::Bool || extent.size() == 0) {
+        hdf5::copyData(src, dst);
+        return;
+    }
+
+    const size_t esize = data_type_to_size(dtype);
+    NDSize chunks = options.chunk_bytes > 0 ? chunkShape(extent, esize, options.chunk_bytes) : src->chunkExtent();
+    unsigned compression;
+    bool shuffle;
+    copy_filters(src, options, compression, shuffle);
+    dst->createData(dtype, extent, chunks, compression, shuffle);
+    if (extent.nelms() == 0) {
+        return;
+    }
+    chunks = dst->chunkExtent();
+
+    const size_t rank = extent.size();
+    NDSize grid(rank), chunk(rank, 0);
+    for (size_t d = 0; d < rank; d++) {
+        grid[d] = (extent[d] + chunks[d] - 1) / chunks[d];
+    }
+    const ndsize_t row_chunks = grid.nelms() / grid[0];
+    const size_t chunk_bytes = check::fits_in_size_t(chunks.nelms() * esize, "Chunk does not fit into memory");
+
+    // zero filled, back-ends leave the buffer alone where there is no data
+    std::vector<char> slab;
+    NDSize count = extent, offset(rank, 0), first(rank, 0);
+
+    if (!canWriteChunks(compression)) {
+        for (ndsize_t row = 0; row < grid[0]; row++) {
+            offset[0] = row * chunks[0];
+            count[0] = std::min(chunks[0], extent[0] - offset[0]);
+            slab.assign(check::fits_in_size_t(count.nelms() * esize, "Slab does not fit into memory"), 0);
+            src->read(dtype, slab.data(), count, offset);
+            dst->write(dtype, slab.data(), count, offset);
+        }
+        report.chunks += grid.nelms();
+        report.bytes += extent.nelms() * esize;
+        return;
+    }
+
+    ChunkWriter writer(DataArray(dst), esize, compression, shuffle, options.jobs);
+
+    for (ndsize_t row = 0; row < grid[0]; row++) {
+        offset[0] = row * chunks[0];
+        count[0] = std::min(chunks[0], extent[0] - offset[0]);
+        slab.assign(check::fits_in_size_t(count.nelms() * esize, "Slab does not fit into memory"), 0);
+        src->read(dtype, slab.data(), count, offset);
+
+        chunk[0] = row;
+        for (size_t d = 1; d < rank; d++) {
+            chunk[d] = 0;
+        }
+        for (ndsize_t k = 0; k < row_chunks; k++) {
+            for (size_t d = 1; d < rank; d++) {
+                first[d] = chunk[d] * chunks[d];
+            }
+
+            Tile tile;
+            tile.chunk = chunk;
+            tile.data.assign(chunk_bytes, 0);
+            gather(slab.data(), count, chunks, first, esize, tile.data.data());
+            writer.push(std::move(tile));
+
+            for (size_t d = rank; d-- > 1;) {
+                if (++chunk[d] < grid[d]) {
+                    break;
+                }
+                chunk[d] = 0;
+            }
+        }
+    }
+
+    report.chunks += writer.finish();
+    report.bytes += extent.nelms() * esize;
+}
+
+
+void copy_to_hdf5(const File &source, const std::string &location, const CopyOptions &options, CopyReport &report) {
+    auto out = std::make_shared<hdf5::FileHDF5>(location, FileMode::Overwrite);
+    out->storeMetadataSnapshot(source.loadMetadataSnapshot());
+
+    auto copy_data = [&](const std::shared_ptr<base::IDataArray> &src,
+                         const std::shared_ptr<hdf5::DataArrayHDF5> &dst) {
+        copy_chunked(src, dst, options, report);
+    };
+    for (const Block &block : source.blocks()) {
+        hdf5::copyBlock(out, block.impl(), copy_data);
+        report.blocks++;
+    }
+    out->close();
+}
+
+
+#ifdef ENABLE_FS_BACKEND
+
+/*
+ * Runs jobs on a fixed number of threads. At most as many jobs as there
+ * are threads wait in the queue, submit blocks until one of them is taken.
+ */
+class JobPool {
+
+public:
+
+    typedef std::function<void()> Job;
+
+    explicit JobPool(size_t threads)
+        : capacity(threads), closing(false)
+    {
+        for (size_t i = 0; i < threads; i++) {
+            workers.emplace_back(&JobPool::run, this);
+        }
+    }
+
+    JobPool(const JobPool &other) = delete;
+    JobPool &operator=(const JobPool &other) = delete;
+
+    void submit(Job &&job) {
+        std::unique_lock<std::mutex> lock(mutex);
+        cond.wait(lock, [this] { return error || queue.size() < capacity; });
+        if (error) {
+            std::rethrow_exception(error);
+        }
+        queue.push_back(std::move(job));
+        cond.notify_all();
+    }
+
+    void finish() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            closing = true;
+        }
+        cond.notify_all();
+        join();
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    ~JobPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            closing = true;
+            queue.clear();
+        }
+        cond.notify_all();
+        join();
+    }
+
+private:
+
+    size_t capacity;
+    std::mutex mutex;
+    std::condition_variable cond;
+    std::deque<Job> queue;
+    bool closing;
+    std::exception_ptr error;
+    std::vector<std::thread> workers;
+
+    void join() {
+        for (auto &worker : workers) {
+            if (worker.joinable()) {
+                worker.join();
+            }
+        }
+    }
+
+    void run() {
+        for (;;) {
+            Job job;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                cond.wait(lock, [this] { return error || closing || !queue.empty(); });
+                if (error || queue.empty()) {
+                    return;
+                }
+                job = std::move(queue.front());
+                queue.pop_front();
+                cond.notify_all();
+            }
+
+            try {
+                job();
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+                cond.notify_all();
+                return;
+            }
+        }
+    }
+};
+
+
+/*
+ * Copy the stored values of an array in slabs along the first axis.
+ */
+ndsize_t copy_slabs(const std::shared_ptr<base::IDataArray> &src, const std::shared_ptr<base::IDataArray> &dst,
+                    DataType dtype, const NDSize &extent) {
+    const size_t esize = data_type_to_size(dtype);
+    const ndsize_t row_bytes = extent.nelms() / extent[0] * esize;
+    const ndsize_t slab_rows = std::max<ndsize_t>(1, SLAB_BYTES / row_bytes);
+    std::vector<char> slab;
+    NDSize count = extent, offset(extent.size(), 0);
+
+    for (offset[0] = 0; offset[0] < extent[0]; offset[0] += slab_rows) {
+        count[0] = std::min(slab_rows, extent[0] - offset[0]);
+        slab.assign(check::fits_in_size_t(count.nelms() * esize, "Slab does not fit into memory"), 0);
+        src->read(dtype, slab.data(), count, offset);
+        dst->write(dtype, slab.data(), count, offset);
+    }
+    return extent.nelms() * esize;
+}
+
+
+/*
+ * The entities, their attributes and the metadata are written on this
+ * thread only. Every array of the file system back-end keeps its values in
+ * a data file of its own, so once an array was created on this thread its
+ * values are copied on the pool while the rest of the file is traversed.
+ */
+void copy_to_fs(const File &source, const std::string &location, const CopyOptions &options, CopyReport &report) {
+    auto out = std::make_shared<file::FileFS>(location, FileMode::Overwrite);
+    out->storeMetadataSnapshot(source.loadMetadataSnapshot());
+
+    std::atomic<ndsize_t> bytes(0);
+    JobPool pool(pool_size(options.jobs));
+
+    auto copy_data = [&](const std::shared_ptr<base::IDataArray> &src,
+                         const std::shared_ptr<file::DataArrayFS> &dst) {
+        report.data_arrays++;
+        const DataType dtype = src->dataType();
+        const NDSize extent = src->dataExtent();
+        if (!data_type_is_numeric(dtype) || extent.size() == 0) {
+            file::copyData(src, dst);
+            return;
+        }
+        dst->createData(dtype, extent);
+        if (extent.nelms() > 0) {
+            pool.submit([src, dst, dtype, extent, &bytes] {
+                bytes += copy_slabs(src, dst, dtype, extent);
+            });
+        }
+    };
+    for (const Block &block : source.blocks()) {
+        file::copyBlock(out, block.impl(), copy_data);
+        report.blocks++;
+    }
+    pool.finish();
+    report.bytes = bytes;
+    out->close();
+}
+
+#endif
+
+
+/*
+ * Read both arrays slab by slab and compare the stored values, timing the
+ * reads of each file separately.
+ */
+void verify_data(const DataArray &source, const DataArray &target, CopyReport &report) {
+    const DataType dtype = source.dataType();
+    const NDSize extent = source.dataExtent();
+    if (target.dataType() != dtype || target.dataExtent() != extent) {
+        throw ConsistencyError("copyFile: type or extent of DataArray " + source.id() + " differ in the copy");
+    }
+    if (dtype == DataType::Nothing || extent.size() == 0 || extent.nelms() == 0) {
+        return;
+    }
+
+    if (dtype == DataType::String) {
+        const size_t n = check::fits_in_size_t(extent.nelms(), "Data does not fit into memory");
+        std::vector<std::string> a(n), b(n);
+        Clock::time_point start = Clock::now();
+        source.getDataDirect(dtype, a.data(), extent, {});
+        report.source_read_seconds += seconds_since(start);
+        start = Clock::now();
+        target.getDataDirect(dtype, b.data(), extent, {});
+        report.target_read_seconds += seconds_since(start);
+        if (a != b) {
+            throw ConsistencyError("copyFile: data of DataArray " + source.id() + " differs in the copy");
+        }
+        return;
+    }
+
+    const size_t esize = data_type_to_size(dtype);
+    const ndsize_t row_bytes = extent.nelms() / extent[0] * esize;
+    const ndsize_t slab_rows = std::max<ndsize_t>(1, SLAB_BYTES / row_bytes);
+    std::vector<char> a, b;
+    NDSize count = extent, offset(extent.size(), 0);
+
+    for (offset[0] = 0; offset[0] < extent[0]; offset[0] += slab_rows) {
+        count[0] = std::min(slab_rows, extent[0] - offset[0]);
+        const size_t nbytes = check::fits_in_size_t(count.nelms() * esize, "Slab does not fit into memory");
+        a.assign(nbytes, 0);
+        b.assign(nbytes, 0);
+
+        Clock::time_point start = Clock::now();
+        source.getDataDirect(dtype, a.data(), count, offset);
+        report.source_read_seconds += seconds_since(start);
+        start = Clock::now();
+        target.getDataDirect(dtype, b.data(), count, offset);
+        report.target_read_seconds += seconds_since(start);
+
+        if (std::memcmp(a.data(), b.data(), nbytes) != 0) {
+            throw ConsistencyError("copyFile: data of DataArray " + source.id() + " differs in the copy");
+        }
+    }
+}
+
+
+void verify_count(ndsize_t source, ndsize_t target, const std::string &what, const std::string &block) {
+    if (source != target) {
+        throw ConsistencyError("copyFile: number of " + what + " in block " + block + " differs in the copy");
+    }
+}
+
+
+void verify(const File &source, const File &target, CopyReport &report) {
+    if (source.sectionCount() != target.sectionCount() || source.blockCount() != target.blockCount()) {
+        throw ConsistencyError("copyFile: number of sections or blocks differs in the copy");
+    }
+
+    for (const Block &block : source.blocks()) {
+        Block copy = target.getBlock(block.id());
+        if (!copy) {
+            throw ConsistencyError("copyFile: block " + block.id() + " is missing in the copy");
+        }
+        verify_count(block.sourceCount(), copy.sourceCount(), "sources", block.id());
+        verify_count(block.tagCount(), copy.tagCount(), "tags", block.id());
+        verify_count(block.multiTagCount(), copy.multiTagCount(), "multi tags", block.id());
+        verify_count(block.groupCount(), copy.groupCount(), "groups", block.id());
+        verify_count(block.dataArrayCount(), copy.dataArrayCount(), "data arrays", block.id());
+
+        for (const Tag &tag : block.tags()) {
+            if (!copy.hasTag(tag.id())) {
+                throw ConsistencyError("copyFile: tag " + tag.id() + " is missing in the copy");
+            }
+        }
+        for (const MultiTag &mtag : block.multiTags()) {
+            if (!copy.hasMultiTag(mtag.id())) {
+                throw ConsistencyError("copyFile: multi tag " + mtag.id() + " is missing in the copy");
+            }
+        }
+        for (const DataArray &array : block.dataArrays()) {
+            DataArray other = copy.getDataArray(array.id());
+            if (!other || other.dimensionCount() != array.dimensionCount()) {
+                throw ConsistencyError("copyFile: DataArray " + array.id() + " is missing in the copy");
+            }
+            verify_data(array, other, report);
+        }
+    }
+}
+
+} // anonymous namespace
+
+
+NDSize chunkShape(const NDSize &extent, size_t element_size, size_t chunk_bytes) {
+    NDSize chunks(extent.size(), 1);
+    ndsize_t budget = std::max<ndsize_t>(1, chunk_bytes / std::max<size_t>(1, element_size));
+
+    for (size_t d = extent.size(); d-- > 0;) {
+        if (extent[d] > 0 && extent[d] <= budget) {
+            chunks[d] = extent[d];
+            budget /= extent[d];
+        } else {
+            chunks[d] = budget;
+            break;
+        }
+    }
+
+    return chunks;
+}
+
+
+DataArray createCompressedDataArray(Block &block, const std::string &name, const std::string &type,
+                                    DataType data_type, const NDSize &shape,
+                                    unsigned compression, bool shuffle) {
+    if (compression > 9) {
+        throw std::invalid_argument("createCompressedDataArray: compression level must be between 0 and 9");
+    }
+    auto hdf5_block = std::dynamic_pointer_cast<hdf5::BlockHDF5>(block.impl());
+    if (!hdf5_block) {
+        return block.createDataArray(name, type, data_type, shape);
+    }
+
+    checkEntityNameAndType(name, type);
+    if (block.hasDataArray(name)) {
+        throw DuplicateName("create DataArray");
+    }
+    return DataArray(hdf5_block->createDataArray(name, type, data_type, shape, NDSize{}, compression, shuffle));
+}
+
+
+bool canWriteChunks(unsigned compression) {
+#if !H5_VERSION_GE(1, 10, 5)
+    return false;
+#elif defined(HAVE_ZLIB)
+    return true;
+#else
+    return compression == 0;
+#endif
+}
+
+
+void encodeChunk(std::vector<char> &data, size_t element_size, unsigned compression, bool shuffle) {
+    if (shuffle && element_size > 1) {
+        std::vector<char> out(data.size());
+        shuffle_bytes(data.data(), out.data(), data.size() / element_size, element_size);
+        data.swap(out);
+    }
+
+    if (compression > 0) {
+#ifdef HAVE_ZLIB
+        uLongf nbytes = compressBound(static_cast<uLong>(data.size()));
+        std::vector<char> out(nbytes);
+        int res = compress2(reinterpret_cast<Bytef *>(out.data()), &nbytes,
+                            reinterpret_cast<const Bytef *>(data.data()), static_cast<uLong>(data.size()),
+                            static_cast<int>(compression));
+        if (res != Z_OK) {
+            throw std::runtime_error("encodeChunk: could not compress chunk");
+        }
+        out.resize(nbytes);
+        data.swap(out);
+#else
+        throw std::runtime_error("encodeChunk: the library was built without zlib");
+#endif
+    }
+}
+
+
+CopyReport copyFile(const File &source, const std::string &location, const CopyOptions &options) {
+    if (!source) {
+        throw UninitializedEntity();
+    }
+    if (options.compression && *options.compression > 9) {
+        throw std::invalid_argument("copyFile: compression level must be between 0 and 9");
+    }
+    boost::system::error_code ec;
+    if (bfs::equivalent(source.location(), location, ec)) {
+        throw std::invalid_argument("copyFile: source and destination are the same file");
+    }
+
+    CopyReport report;
+    const Clock::time_point start = Clock::now();
+
+    if (options.backend == "hdf5") {
+        copy_to_hdf5(source, location, options, report);
+    }
+#ifdef ENABLE_FS_BACKEND
+    else if (options.backend == "file") {
+        copy_to_fs(source, location, options, report);
+    }
+#endif
+    else {
+        throw std::invalid_argument("copyFile: unknown back-end " + options.backend);
+    }
+
+    report.seconds = seconds_since(start);
+
+    if (options.verify) {
+        File target = File::open(location, FileMode::ReadOnly, options.backend);
+        verify(source, target, report);
+        target.close();
+    }
+
+    return report;
+}
+
+} // namespace util
+} // namespace nix
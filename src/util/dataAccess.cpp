@@ -70,7 +70,8 @@ ndsize_t positionToIndex(double position, const string &unit, const SetDimension
         throw nix::IncompatibleDimensions("Cannot apply a position with unit to a SetDimension", "nix::util::positionToIndex");
     }
     index = static_cast<ndsize_t>(round(position));
-    if (dimension.labels().size() > 0 && index > dimension.labels().size()) {
+    ndsize_t label_count = dimension.labelCount();
+    if (label_count > 0 && index > label_count) {
         throw nix::OutOfBounds("Position is out of bounds in setDimension.", static_cast<int>(position));
     }
     return index;
@@ -92,6 +93,54 @@ ndsize_t positionToIndex(double position, const string &unit, const RangeDimensi
 }
 
 
+double positionScaling(const string &unit, const DimensionDescriptor &dimension) {
+    boost::optional<string> dim_unit = dimension.unit();
+    double scaling = 1.0;
+
+    switch (dimension.dimensionType()) {
+        case DimensionType::Set:
+            if (unit.length() > 0 && unit != "none") {
+                throw nix::IncompatibleDimensions("Cannot apply a position with unit to a SetDimension", "nix::util::positionToIndex");
+            }
+            break;
+        case DimensionType::Sample:
+            if (!dim_unit && unit != "none") {
+                throw nix::IncompatibleDimensions("Units of position and SampledDimension must both be given!", "nix::util::positionToIndex");
+            }
+            if (dim_unit && unit != "none") {
+                try {
+                    scaling = util::getSIScaling(unit, *dim_unit);
+                } catch (...) {
+                    throw nix::IncompatibleDimensions("Cannot apply a position with unit to a SetDimension", "nix::util::positionToIndex");
+                }
+            }
+            break;
+        case DimensionType::Range:
+            if (dim_unit && unit != "none") {
+                try {
+                    scaling = util::getSIScaling(unit, *dim_unit);
+                } catch (...) {
+                    throw nix::IncompatibleDimensions("Provided units are not scalable!", "nix::util::positionToIndex");
+                }
+            }
+            break;
+    }
+
+    return scaling;
+}
+
+
+ndsize_t positionToIndex(double position, const string &unit, const DimensionDescriptor &dimension) {
+    return dimension.indexOf(position * positionScaling(unit, dimension));
+}
+
+
+void positionsToIndices(const double *positions, size_t n, const string &unit,
+                        const DimensionDescriptor &dimension, ndsize_t *indices) {
+    dimension.indicesOf(positions, n, indices, positionScaling(unit, dimension));
+}
+
+
 void getOffsetAndCount(const Tag &tag, const DataArray &array, NDSize &offset, NDSize &count) {
     vector<double> position = tag.position();
     vector<double> extent = tag.extent();
@@ -102,8 +151,12 @@ void getOffsetAndCount(const Tag &tag, const DataArray &array, NDSize &offset, N
     if (array.dimensionCount() != position.size() || (extent.size() > 0 && extent.size() != array.dimensionCount())) {
         throw std::runtime_error("Dimensionality of position or extent vector does not match dimensionality of data!");
     }
+    vector<DimensionDescriptor> dimensions = array.dimensionDescriptors();
+    if (dimensions.size() < position.size()) {
+        throw nix::IncompatibleDimensions("DataArray lacks dimension descriptors", "util::getOffsetAndCount");
+    }
     for (size_t i = 0; i < position.size(); ++i) {
-        Dimension dim = array.getDimension(i+1);
+        const DimensionDescriptor &dim = dimensions[i];
         temp_offset[i] = positionToIndex(position[i], i >= units.size() ? "none" : units[i], dim);
         if (i < extent.size()) {
             ndsize_t c = positionToIndex(position[i] + extent[i], i >= units.size() ? "none" : units[i], dim) - temp_offset[i];
@@ -161,9 +214,13 @@ void getOffsetAndCount(const MultiTag &tag, const DataArray &array, ndsize_t ind
     NDSize data_offset(dc_sizet, static_cast<ndsize_t>(0));
     NDSize data_count(dc_sizet, static_cast<ndsize_t>(1));
     vector<string> units = tag.units();
-    
+    vector<DimensionDescriptor> dimensions = array.dimensionDescriptors();
+    if (dimensions.size() < offset.size()) {
+        throw nix::IncompatibleDimensions("DataArray lacks dimension descriptors", "util::getOffsetAndCount");
+    }
+
     for (size_t i = 0; i < offset.size(); ++i) {
-        Dimension dimension = array.getDimension(i+1);
+        const DimensionDescriptor &dimension = dimensions[i];
         string unit = "none";
         if (i <= units.size() && units.size() > 0) {
             unit = units[i];
@@ -175,7 +232,7 @@ void getOffsetAndCount(const MultiTag &tag, const DataArray &array, ndsize_t ind
         vector<double> extent;
         extents.getData(extent, temp_count, temp_offset);
         for (size_t i = 0; i < extent.size(); ++i) {
-            Dimension dimension = array.getDimension(i+1);
+            const DimensionDescriptor &dimension = dimensions[i];
             string unit = "none";
             if (i <= units.size() && units.size() > 0) {
                 unit = units[i];
@@ -0,0 +1,490 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/util/reduce.hpp>
+#include <nix/Buffer.hpp>
+#include <nix/Exception.hpp>
+
+#include <algorithm>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <thread>
+
+namespace nix {
+namespace util {
+
+namespace {
+
+// upper bound for the number of elements read by one thread at once
+const ndsize_t SLAB_ELEMENTS = 1 << 18;
+
+const double INF = std::numeric_limits<double>::infinity();
+const double NaN = std::numeric_limits<double>::quiet_NaN();
+
+/*
+ * Accumulators for a number of output cells; every cell has seen the
+ * same number of values n. Partial results are combined with the
+ * pairwise update of Chan et al. for the sum of squared deviations.
+ */
+struct Partial {
+    ndsize_t n = 0;
+    std::vector<double> sum, m2, min, max;
+
+    explicit Partial(size_t cells = 0)
+        : sum(cells, 0.0), m2(cells, 0.0), min(cells, INF), max(cells, -INF) { }
+};
+
+
+/*
+ * Accumulate rows x inner values, combining along the rows. The loops
+ * only touch contiguous memory so that the compiler can vectorize them.
+ */
+void accumulate(const double *data, size_t rows, size_t inner, bool need_m2, Partial &p) {
+    p.n = rows;
+
+    if (inner == 1) {
+        double s = 0.0, lo = INF, hi = -INF;
+        for (size_t r = 0; r < rows; r++) {
+            const double x = data[r];
+            s += x;
+            lo = x < lo ? x : lo;
+            hi = x > hi ? x : hi;
+        }
+        p.sum[0] = s;
+        p.min[0] = lo;
+        p.max[0] = hi;
+
+        if (need_m2) {
+            const double mean = s / rows;
+            double q = 0.0;
+            for (size_t r = 0; r < rows; r++) {
+                const double d = data[r] - mean;
+                q += d * d;
+            }
+            p.m2[0] = q;
+        }
+        return;
+    }
+
+    double *s = p.sum.data(), *lo = p.min.data(), *hi = p.max.data();
+    for (size_t r = 0; r < rows; r++) {
+        const double *row = data + r * inner;
+        for (size_t i = 0; i < inner; i++) {
+            const double x = row[i];
+            s[i] += x;
+            lo[i] = x < lo[i] ? x : lo[i];
+            hi[i] = x > hi[i] ? x : hi[i];
+        }
+    }
+
+    if (need_m2) {
+        std::vector<double> mean(inner);
+        for (size_t i = 0; i < inner; i++) {
+            mean[i] = s[i] / rows;
+        }
+        double *q = p.m2.data();
+        for (size_t r = 0; r < rows; r++) {
+            const double *row = data + r * inner;
+            for (size_t i = 0; i < inner; i++) {
+                const double d = row[i] - mean[i];
+                q[i] += d * d;
+            }
+        }
+    }
+}
+
+
+/*
+ * Add one value to each of the cells first .. first + n - 1, which have
+ * seen `seen` values before; the caller sets p.n once all cells got their
+ * value. This is the update of merge() for a partial of a single value.
+ */
+void accumulateValues(const double *data, size_t first, size_t n, ndsize_t seen, Partial &p) {
+    double *s = p.sum.data() + first, *q = p.m2.data() + first;
+    double *lo = p.min.data() + first, *hi = p.max.data() + first;
+    const double na = static_cast<double>(seen), f = na / (na + 1.0);
+    for (size_t i = 0; i < n; i++) {
+        const double x = data[i];
+        if (seen > 0) {
+            const double delta = x - s[i] / na;
+            q[i] += delta * delta * f;
+        }
+        s[i] += x;
+        lo[i] = x < lo[i] ? x : lo[i];
+        hi[i] = x > hi[i] ? x : hi[i];
+    }
+}
+
+
+void merge(Partial &a, const Partial &b) {
+    if (b.n == 0) {
+        return;
+    }
+    if (a.n == 0) {
+        a = b;
+        return;
+    }
+
+    const double na = static_cast<double>(a.n), nb = static_cast<double>(b.n);
+    const double f = na * nb / (na + nb);
+    for (size_t i = 0; i < a.sum.size(); i++) {
+        const double delta = b.sum[i] / nb - a.sum[i] / na;
+        a.m2[i] += b.m2[i] + delta * delta * f;
+        a.sum[i] += b.sum[i];
+        a.min[i] = std::min(a.min[i], b.min[i]);
+        a.max[i] = std::max(a.max[i], b.max[i]);
+    }
+    a.n += b.n;
+}
+
+
+double finish(const Partial &p, size_t i, ReduceOp op) {
+    if (p.n == 0) {
+        return op == ReduceOp::Sum ? 0.0 : NaN;
+    }
+
+    switch (op) {
+        case ReduceOp::Min: return p.min[i];
+        case ReduceOp::Max: return p.max[i];
+        case ReduceOp::Sum: return p.sum[i];
+        case ReduceOp::Mean: return p.sum[i] / p.n;
+        case ReduceOp::Variance: return p.m2[i] / p.n;
+    }
+
+    return NaN;
+}
+
+
+size_t poolSize(size_t threads) {
+    return threads ? threads : std::max<size_t>(1, std::thread::hardware_concurrency());
+}
+
+
+/*
+ * The data of back-ends that do not support concurrent reads is read on
+ * the calling thread.
+ */
+size_t poolSize(const DataArray &array, size_t threads) {
+    return array.concurrentReads() ? poolSize(threads) : 1;
+}
+
+
+/*
+ * Read the data as double in slabs along the first dimension and call
+ * fn(thread, data, first_row, rows, first_elm, elms) for every slab. The
+ * rows are dealt out in groups of whole chunks, so that no chunk is read
+ * and decompressed by two threads; a group holds one slab, or the slabs
+ * of one chunk if a chunk has more rows than a slab. Group k is handled by
+ * thread k % threads, in increasing order of k, so that the results of the
+ * callers are deterministic for a given number of threads.
+ *
+ * A slab normally holds whole rows; then first_elm is 0 and elms is the
+ * number of values of the rows. Rows larger than a slab are read in pieces
+ * of a single row instead: all pieces of a row are read in storage order
+ * by the same thread, first_elm is the index of the first value of the
+ * piece within the row and elms the number of values in the piece.
+ */
+typedef std::function<void(size_t, const double *, ndsize_t, ndsize_t, ndsize_t, ndsize_t)> SlabFunc;
+
+size_t forEachSlab(const DataArray &array, size_t threads, const SlabFunc &fn, const NDSize &extent) {
+    if (extent.size() == 0 || extent.nelms() == 0) {
+        return 0;
+    }
+
+    const ndsize_t row_elms = extent.nelms() / extent[0];
+    const bool pieces = row_elms > SLAB_ELEMENTS;
+    ndsize_t slab_rows = pieces ? 1 : SLAB_ELEMENTS / row_elms;
+
+    // slabs of whole chunks along the first axis, if a chunk fits
+    const NDSize chunks = array.chunkExtent();
+    const ndsize_t chunk_rows = chunks.size() > 0 ? chunks[0] : 1;
+    ndsize_t group_rows = chunk_rows;
+    if (chunk_rows <= slab_rows) {
+        slab_rows = group_rows = slab_rows / chunk_rows * chunk_rows;
+    }
+    const ndsize_t n_groups = (extent[0] + group_rows - 1) / group_rows;
+
+    // pieces span the trailing axes that fit into a slab and part of the
+    // axis before them; all axes in front of it are cut into single indices
+    size_t split = extent.size() - 1;
+    ndsize_t trailing = 1;
+    while (pieces && trailing * extent[split] <= SLAB_ELEMENTS) {
+        trailing *= extent[split--];
+    }
+    const ndsize_t piece_len = std::max<ndsize_t>(1, SLAB_ELEMENTS / trailing);
+
+    threads = static_cast<size_t>(std::min<ndsize_t>(poolSize(threads), n_groups));
+
+    std::vector<std::exception_ptr> errors(threads);
+
+    auto work = [&](size_t t) {
+        try {
+            Buffer<double> buffer;
+            NDSize count = extent, offset(extent.size(), 0);
+            for (ndsize_t k = t; k < n_groups; k += threads) {
+                const ndsize_t end = std::min((k + 1) * group_rows, extent[0]);
+                for (offset[0] = k * group_rows; offset[0] < end; offset[0] += count[0]) {
+                    count[0] = std::min(slab_rows, end - offset[0]);
+                    if (!pieces) {
+                        buffer.resize(check::fits_in_size_t(count.nelms(), "Slab does not fit into memory"));
+                        array.getData(DataType::Double, buffer.data(), count, offset);
+                        fn(t, buffer.data(), offset[0], count[0], 0, count.nelms());
+                        continue;
+                    }
+
+                    for (size_t i = 1; i < split; i++) {
+                        count[i] = 1;
+                    }
+                    ndsize_t first_elm = 0;
+                    while (true) {
+                        count[split] = std::min(piece_len, extent[split] - offset[split]);
+                        buffer.resize(static_cast<size_t>(count.nelms()));
+                        array.getData(DataType::Double, buffer.data(), count, offset);
+                        fn(t, buffer.data(), offset[0], 1, first_elm, count.nelms());
+                        first_elm += count.nelms();
+
+                        // next piece of the row, in storage order
+                        size_t i = split;
+                        offset[i] += count[i];
+                        while (i > 1 && offset[i] == extent[i]) {
+                            offset[i] = 0;
+                            offset[--i]++;
+                        }
+                        if (offset[i] == extent[i]) {
+                            offset[i] = 0;
+                            break;
+                        }
+                    }
+                }
+            }
+        } catch (...) {
+            errors[t] = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (size_t t = 1; t < threads; t++) {
+        pool.emplace_back(work, t);
+    }
+    work(0);
+    for (auto &thread : pool) {
+        thread.join();
+    }
+
+    for (auto &error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    return threads;
+}
+
+
+void checkDataType(const DataArray &array, const char *where) {
+    DataType dtype = array.dataType();
+    if (dtype == DataType::String || dtype == DataType::Nothing) {
+        throw std::invalid_argument(std::string(where) + ": only numeric data can be reduced");
+    }
+}
+
+} // namespace
+
+
+double reduce(const DataArray &array, ReduceOp op, size_t threads) {
+    checkDataType(array, "util::reduce");
+    threads = poolSize(array, threads);
+
+    const bool need_m2 = op == ReduceOp::Variance;
+    const NDSize extent = array.dataExtent();
+    std::vector<Partial> partials(threads, Partial(1));
+
+    size_t used = forEachSlab(array, threads, [&](size_t t, const double *data, ndsize_t, ndsize_t,
+                                                  ndsize_t, ndsize_t elms) {
+        Partial p(1);
+        accumulate(data, static_cast<size_t>(elms), 1, need_m2, p);
+        merge(partials[t], p);
+    }, extent);
+
+    Partial total(1);
+    for (size_t t = 0; t < used; t++) {
+        merge(total, partials[t]);
+    }
+
+    return finish(total, 0, op);
+}
+
+
+NDArray reduce(const DataArray &array, size_t axis, ReduceOp op, size_t threads) {
+    checkDataType(array, "util::reduce");
+    threads = poolSize(array, threads);
+
+    const NDSize extent = array.dataExtent();
+    if (axis >= extent.size()) {
+        throw OutOfBounds("util::reduce: axis exceeds the rank of the data", axis);
+    }
+
+    // the data is viewed as outer x len x inner, combining along len
+    ndsize_t outer = 1, inner = 1;
+    for (size_t i = 0; i < axis; i++) {
+        outer *= extent[i];
+    }
+    for (size_t i = axis + 1; i < extent.size(); i++) {
+        inner *= extent[i];
+    }
+    const ndsize_t len = extent[axis];
+
+    NDSize shape(std::max<size_t>(extent.size() - 1, 1), 1);
+    for (size_t i = 0, j = 0; i < extent.size(); i++) {
+        if (i != axis) {
+            shape[j++] = extent[i];
+        }
+    }
+
+    NDArray result(DataType::Double, shape);
+    const size_t cells = check::fits_in_size_t(outer * inner, "util::reduce: result does not fit into memory");
+    const size_t inner_cells = static_cast<size_t>(inner);
+    const bool need_m2 = op == ReduceOp::Variance;
+
+    if (extent.nelms() == 0) {
+        // no values at all: every cell is the reduction of an empty set
+        for (size_t i = 0; i < cells; i++) {
+            result.set(i, finish(Partial(1), 0, op));
+        }
+        return result;
+    }
+
+    if (axis == 0) {
+        // every slab contributes to all cells
+        std::vector<Partial> partials(threads, Partial(cells));
+
+        size_t used = forEachSlab(array, threads, [&](size_t t, const double *data, ndsize_t, ndsize_t rows,
+                                                      ndsize_t first_elm, ndsize_t elms) {
+            if (elms == rows * cells) {
+                Partial p(cells);
+                accumulate(data, static_cast<size_t>(rows), inner_cells, need_m2, p);
+                merge(partials[t], p);
+                return;
+            }
+            // a piece of a row, the other pieces of the row follow on this thread
+            Partial &p = partials[t];
+            accumulateValues(data, static_cast<size_t>(first_elm), static_cast<size_t>(elms), p.n, p);
+            if (first_elm + elms == cells) {
+                p.n++;
+            }
+        }, extent);
+
+        Partial total(cells);
+        for (size_t t = 0; t < used; t++) {
+            merge(total, partials[t]);
+        }
+        for (size_t i = 0; i < cells; i++) {
+            result.set(i, finish(total, i, op));
+        }
+    } else {
+        // slabs cover disjoint cells, the results are written directly
+        const ndsize_t per_row = outer / extent[0];
+        const size_t block = static_cast<size_t>(len * inner);
+        const size_t row_cells = static_cast<size_t>(per_row * inner);
+        std::vector<Partial> row_partials(threads);
+
+        forEachSlab(array, threads, [&](size_t t, const double *data, ndsize_t first, ndsize_t rows,
+                                        ndsize_t first_elm, ndsize_t elms) {
+            if (elms != rows * per_row * block) {
+                // a piece of a row: collect the cells of the row until its last piece
+                Partial &p = row_partials[t];
+                if (p.sum.empty()) {
+                    p = Partial(row_cells);
+                }
+                for (ndsize_t e = first_elm, end = first_elm + elms; e < end; ) {
+                    const ndsize_t i = e % inner, run = std::min(end - e, inner - i);
+                    const ndsize_t cell = e / block * inner + i;
+                    accumulateValues(data, static_cast<size_t>(cell), static_cast<size_t>(run), e / inner % len, p);
+                    data += run;
+                    e += run;
+                }
+                if (first_elm + elms == per_row * block) {
+                    p.n = len;
+                    const size_t base = static_cast<size_t>(first * row_cells);
+                    for (size_t i = 0; i < row_cells; i++) {
+                        result.set(base + i, finish(p, i, op));
+                    }
+                    p = Partial(row_cells);
+                }
+                return;
+            }
+
+            Partial p(inner_cells);
+            for (ndsize_t o = 0; o < rows * per_row; o++) {
+                std::fill(p.sum.begin(), p.sum.end(), 0.0);
+                std::fill(p.m2.begin(), p.m2.end(), 0.0);
+                std::fill(p.min.begin(), p.min.end(), INF);
+                std::fill(p.max.begin(), p.max.end(), -INF);
+                accumulate(data + o * block, static_cast<size_t>(len), inner_cells, need_m2, p);
+
+                size_t base = static_cast<size_t>((first * per_row + o) * inner);
+                for (size_t i = 0; i < inner_cells; i++) {
+                    result.set(base + i, finish(p, i, op));
+                }
+            }
+        }, extent);
+    }
+
+    return result;
+}
+
+
+Histogram histogram(const DataArray &array, double lower, double upper, size_t bins, size_t threads) {
+    checkDataType(array, "util::histogram");
+
+    if (bins == 0 || !(upper > lower)) {
+        throw std::invalid_argument("util::histogram: need at least one bin and upper > lower");
+    }
+
+    Histogram hist;
+    hist.lower = lower;
+    hist.upper = upper;
+    hist.counts.assign(bins, 0);
+
+    threads = poolSize(array, threads);
+    const NDSize extent = array.dataExtent();
+    const double scale = bins / (upper - lower);
+
+    std::vector<Histogram> partials(threads, hist);
+
+    size_t used = forEachSlab(array, threads, [&](size_t t, const double *data, ndsize_t, ndsize_t,
+                                                  ndsize_t, ndsize_t elms) {
+        Histogram &h = partials[t];
+        const size_t n = static_cast<size_t>(elms);
+        for (size_t i = 0; i < n; i++) {
+            const double x = data[i];
+            if (x < lower) {
+                h.below++;
+            } else if (x > upper) {
+                h.above++;
+            } else if (x == x) {
+                size_t bin = static_cast<size_t>((x - lower) * scale);
+                h.counts[bin < bins ? bin : bins - 1]++;
+            }
+        }
+    }, extent);
+
+    for (size_t t = 0; t < used; t++) {
+        for (size_t b = 0; b < bins; b++) {
+            hist.counts[b] += partials[t].counts[b];
+        }
+        hist.below += partials[t].below;
+        hist.above += partials[t].above;
+    }
+
+    return hist;
+}
+
+} // namespace util
+} // namespace nix
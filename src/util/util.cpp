@@ -11,17 +11,17 @@
 #include <nix/base/IDimensions.hpp>
 
 #include <string>
+#include <chrono>
+#include <cstdint>
 #include <cstdlib>
-#include <mutex>
+#include <functional>
 #include <random>
+#include <thread>
+#include <vector>
 #include <math.h>
 
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/regex.hpp>
-#include <boost/random.hpp>
-#include <boost/uuid/uuid.hpp>
-#include <boost/uuid/uuid_generators.hpp>
-#include <boost/uuid/uuid_io.hpp>
 
 
 using namespace std;
@@ -41,19 +41,101 @@ const map<string, double> PREFIX_FACTORS = {{"y", 1.0e-24}, {"z", 1.0e-21}, {"a"
     {"k", 1.0e3}, {"M",1.0e6}, {"G", 1.0e9}, {"T", 1.0e12}, {"P", 1.0e15}, {"E",1.0e18}, {"Z", 1.0e21}, {"Y", 1.0e24}};
 
 
+namespace {
+
+// A generator per thread, so that ids can be created without locking; the
+// seed mixes the random device with the clock and the thread id, in case
+// the random device is deterministic or unavailable.
+std::mt19937_64 seeded_generator() {
+    std::vector<uint32_t> seed;
+    try {
+        std::random_device rd;
+        for (int i = 0; i < 4; i++) {
+            seed.push_back(rd());
+        }
+    } catch (const std::exception &) { }
+    const uint64_t now = static_cast<uint64_t>(std::chrono::high_resolution_clock::now().time_since_epoch().count());
+    const uint64_t tid = std::hash<std::thread::id>()(std::this_thread::get_id());
+    seed.insert(seed.end(), {static_cast<uint32_t>(now), static_cast<uint32_t>(now >> 32),
+                             static_cast<uint32_t>(tid), static_cast<uint32_t>(tid >> 32)});
+    std::seed_seq seq(seed.begin(), seed.end());
+    return std::mt19937_64(seq);
+}
+
+
+void put_digits(char *out, int64_t value, int digits) {
+    for (int i = digits - 1; i >= 0; i--) {
+        out[i] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+}
+
+} // anonymous namespace
+
+
 string createId() {
-    typedef boost::mt19937::result_type seed_type;
-    static boost::mt19937 ran(static_cast<seed_type>(std::time(0)));
-    static boost::uuids::basic_random_generator<boost::mt19937> gen(&ran);
-    boost::uuids::uuid u = gen();
-    return boost::uuids::to_string(u);
+    static const char *HEX = "0123456789abcdef";
+    static thread_local std::mt19937_64 gen = seeded_generator();
+
+    // random UUID (RFC 4122 version 4): set the version and variant bits
+    uint64_t hi = gen(), lo = gen();
+    hi = (hi & ~uint64_t(0xF000)) | uint64_t(0x4000);
+    lo = (lo & ~(uint64_t(0xC0) << 56)) | (uint64_t(0x80) << 56);
+
+    char buf[36];
+    size_t pos = 0;
+    for (int i = 0; i < 32; i++) {
+        if (i == 8 || i == 12 || i == 16 || i == 20) {
+            buf[pos++] = '-';
+        }
+        const uint64_t word = i < 16 ? hi : lo;
+        buf[pos++] = HEX[(word >> (60 - 4 * (i % 16))) & 0xF];
+    }
+    return string(buf, sizeof(buf));
 }
 
 
 string timeToStr(time_t time) {
-    using namespace boost::posix_time;
-    ptime timetmp = from_time_t(time);
-    return to_iso_string(timetmp);
+    // entities are mostly created in bursts, which share their time stamp
+    static thread_local time_t cached_time = 0;
+    static thread_local string cached;
+    if (!cached.empty() && time == cached_time) {
+        return cached;
+    }
+
+    // the date of the day, for the proleptic Gregorian calendar
+    const int64_t t = static_cast<int64_t>(time);
+    const int64_t days = t >= 0 ? t / 86400 : (t - 86399) / 86400;
+    const int64_t secs = t - days * 86400;
+    const int64_t z = days + 719468;
+    const int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+    const int64_t doe = z - era * 146097;
+    const int64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const int64_t mp = (5 * doy + 2) / 153;
+    const int64_t day = doy - (153 * mp + 2) / 5 + 1;
+    const int64_t month = mp < 10 ? mp + 3 : mp - 9;
+    const int64_t year = yoe + era * 400 + (month <= 2 ? 1 : 0);
+
+    if (year < 1400 || year > 9999) {
+        // outside of the range of boost's calendar, which reports the error
+        using namespace boost::posix_time;
+        return to_iso_string(from_time_t(time));
+    }
+
+    // same format as boost::posix_time::to_iso_string, e.g. 20140101T120000
+    char buf[15];
+    put_digits(buf, year, 4);
+    put_digits(buf + 4, month, 2);
+    put_digits(buf + 6, day, 2);
+    buf[8] = 'T';
+    put_digits(buf + 9, secs / 3600, 2);
+    put_digits(buf + 11, secs / 60 % 60, 2);
+    put_digits(buf + 13, secs % 60, 2);
+
+    cached.assign(buf, sizeof(buf));
+    cached_time = time;
+    return cached;
 }
 
 
@@ -170,6 +170,161 @@ void BaseTestBlock::testDataArrayAccess() {
 }
 
 
+void BaseTestBlock::testDeleteDataArrays() {
+    std::vector<DataArray> arrays;
+    for (int i = 0; i < 6; i++) {
+        arrays.push_back(block.createDataArray("bulk_" + nix::util::numToStr(i), "channel",
+                                               DataType::Double, nix::NDSize({ 2 })));
+    }
+    DataArray positions = block.createDataArray("bulk_positions", "positions", DataType::Double, nix::NDSize({ 1 }));
+    Tag tag = block.createTag("bulk_tag", "event", {0.0});
+    MultiTag mtag = block.createMultiTag("bulk_mtag", "events", positions);
+    Group group = block.createGroup("bulk_group", "channels");
+    for (const DataArray &da : arrays) {
+        tag.addReference(da);
+        mtag.addReference(da);
+        group.addDataArray(da);
+    }
+
+    std::vector<DataArray> doomed = {arrays[1], arrays[3], arrays[4], DataArray()};
+    CPPUNIT_ASSERT_EQUAL(static_cast<ndsize_t>(3), block.deleteDataArrays(doomed));
+    CPPUNIT_ASSERT_EQUAL(static_cast<ndsize_t>(4), block.dataArrayCount());
+    CPPUNIT_ASSERT_EQUAL(static_cast<ndsize_t>(3), tag.referenceCount());
+    CPPUNIT_ASSERT_EQUAL(static_cast<ndsize_t>(3), mtag.referenceCount());
+    CPPUNIT_ASSERT_EQUAL(static_cast<ndsize_t>(3), group.dataArrayCount());
+    CPPUNIT_ASSERT(!tag.hasReference(arrays[3].id()));
+    CPPUNIT_ASSERT(tag.hasReference(arrays[2].id()));
+    CPPUNIT_ASSERT(!group.hasDataArray(arrays[4].id()));
+
+    // deleted arrays are not counted twice
+    CPPUNIT_ASSERT_EQUAL(static_cast<ndsize_t>(0), block.deleteDataArrays(doomed));
+
+    // arrays referenced after the first deletion
+    Tag other = block.createTag("bulk_other", "event", {0.0});
+    other.addReference(arrays[0]);
+    group.addDataArray(positions);
+    CPPUNIT_ASSERT_EQUAL(static_cast<ndsize_t>(2), block.deleteDataArrays({arrays[0], positions}));
+    CPPUNIT_ASSERT_EQUAL(static_cast<ndsize_t>(0), other.referenceCount());
+    CPPUNIT_ASSERT_EQUAL(static_cast<ndsize_t>(2), group.dataArrayCount());
+
+    block.deleteDataArrays(block.dataArrays());
+    CPPUNIT_ASSERT_EQUAL(static_cast<ndsize_t>(0), block.dataArrayCount());
+    CPPUNIT_ASSERT_EQUAL(static_cast<ndsize_t>(0), tag.referenceCount());
+
+    block.deleteTag(tag);
+    block.deleteTag(other);
+    block.deleteMultiTag(mtag);
+    block.deleteGroup(group);
+}
+
+
+void BaseTestBlock::testBatch() {
+    typedef BlockBatch::DimensionSpec dim_spec;
+    Source existing = block.createSource("batch_existing", "cell");
+    Source nested = existing.createSource("batch_nested", "cell");
+    DataArray old = block.createDataArray("batch_old", "signal", DataType::Double, {3});
+
+    BlockBatch batch = block.batch();
+    CPPUNIT_ASSERT(batch.empty());
+    batch.addSource("batch_src", "cell");
+    std::string id = util::createId();
+    size_t a = batch.addDataArray("batch_a", "signal", DataType::Double, {10, 3}, id);
+    batch.dataArray(a).unit = "mV";
+    batch.dataArray(a).label = "voltage";
+    batch.dataArray(a).dimensions.push_back(dim_spec::sampled(0.1));
+    batch.dataArray(a).dimensions.back().offset = 1.0;
+    batch.dataArray(a).dimensions.back().unit = "s";
+    batch.dataArray(a).dimensions.push_back(dim_spec::set({"x", "y", "z"}));
+    batch.dataArray(a).sources = {"batch_src", existing.id(), nested.id()};
+    size_t b = batch.addDataArray("batch_b", "signal", DataType::Int32, {4});
+    batch.dataArray(b).dimensions.push_back(dim_spec::range({1.0, 2.0, 4.0, 8.0}));
+    size_t t = batch.addTag("batch_tag", "event", {1.0, 0.0});
+    batch.tag(t).extent = {2.0, 3.0};
+    batch.tag(t).units = {"ms", "none"};
+    batch.tag(t).references = {"batch_a", id, "batch_b", old.name()};
+    batch.tag(t).sources = {"batch_src"};
+
+    // nothing is written if any entity is invalid
+    size_t bad = batch.addTag("batch_bad", "event", {1.0});
+    batch.tag(bad).references = {"missing"};
+    ndsize_t arrays = block.dataArrayCount();
+    CPPUNIT_ASSERT_THROW(batch.commit(), std::runtime_error);
+    CPPUNIT_ASSERT_EQUAL(arrays, block.dataArrayCount());
+    batch.tag(bad).references.clear();
+    batch.tag(bad).name = "batch_a";
+    batch.tag(bad).units = {"furlong"};
+    CPPUNIT_ASSERT_THROW(batch.commit(), InvalidUnit);
+    batch.tag(bad).units.clear();
+    batch.tag(bad).name = "batch_tag";
+    CPPUNIT_ASSERT_THROW(batch.commit(), DuplicateName);
+    batch.tag(bad).name = "batch_bad";
+    batch.tag(bad).id = id;
+    CPPUNIT_ASSERT_THROW(batch.commit(), std::runtime_error);
+    batch.tag(bad).id = old.id();
+    CPPUNIT_ASSERT_THROW(batch.commit(), std::runtime_error);
+    batch.tag(bad).id = nested.id();
+    CPPUNIT_ASSERT_THROW(batch.commit(), std::runtime_error);
+    batch.tag(bad).id = "";
+    batch.tag(bad).position.clear();
+    CPPUNIT_ASSERT_THROW(batch.commit(), std::runtime_error);
+    batch.tag(bad).position = {1.0};
+    batch.dataArray(b).dimensions[0].ticks = {2.0, 1.0};
+    CPPUNIT_ASSERT_THROW(batch.commit(), UnsortedTicks);
+    batch.dataArray(b).dimensions[0].ticks = {1.0, 2.0, 4.0, 8.0};
+    CPPUNIT_ASSERT_EQUAL(arrays, block.dataArrayCount());
+    CPPUNIT_ASSERT(!block.hasTag("batch_tag"));
+
+    batch.commit();
+    CPPUNIT_ASSERT_EQUAL(arrays + 2, block.dataArrayCount());
+    CPPUNIT_ASSERT(!batch.source(0).id.empty());
+
+    DataArray da = block.getDataArray(id);
+    CPPUNIT_ASSERT(da);
+    CPPUNIT_ASSERT_EQUAL(std::string("batch_a"), da.name());
+    CPPUNIT_ASSERT_EQUAL(std::string("mV"), *da.unit());
+    CPPUNIT_ASSERT_EQUAL(std::string("voltage"), *da.label());
+    CPPUNIT_ASSERT(da.dataType() == DataType::Double);
+    CPPUNIT_ASSERT_EQUAL(NDSize({10, 3}), da.dataExtent());
+    CPPUNIT_ASSERT_EQUAL(ndsize_t(2), da.dimensionCount());
+    SampledDimension sd = da.getDimension(1).asSampledDimension();
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(0.1, sd.samplingInterval(), 1e-12);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, *sd.offset(), 1e-12);
+    CPPUNIT_ASSERT_EQUAL(std::string("s"), *sd.unit());
+    CPPUNIT_ASSERT_EQUAL(ndsize_t(1), da.getDimension(2).asSetDimension().indexOf("y"));
+    CPPUNIT_ASSERT_EQUAL(ndsize_t(3), da.sourceCount());
+    CPPUNIT_ASSERT(da.hasSource(nested));
+    CPPUNIT_ASSERT(da.hasSource(batch.source(0).id));
+
+    DataArray db = block.getDataArray("batch_b");
+    CPPUNIT_ASSERT(db.dataType() == DataType::Int32);
+    std::vector<double> ticks = db.getDimension(1).asRangeDimension().ticks();
+    CPPUNIT_ASSERT_EQUAL(size_t(4), ticks.size());
+
+    Tag tag = block.getTag("batch_tag");
+    CPPUNIT_ASSERT_EQUAL(batch.tag(t).id, tag.id());
+    CPPUNIT_ASSERT_EQUAL(size_t(2), tag.extent().size());
+    std::vector<std::string> units = tag.units();
+    CPPUNIT_ASSERT_EQUAL(std::string("ms"), units[0]);
+    // duplicates given by name and id are linked once
+    CPPUNIT_ASSERT_EQUAL(ndsize_t(3), tag.referenceCount());
+    CPPUNIT_ASSERT(tag.hasReference(old));
+    CPPUNIT_ASSERT(tag.hasReference(db));
+    CPPUNIT_ASSERT_EQUAL(ndsize_t(1), tag.sourceCount());
+    CPPUNIT_ASSERT(block.getTag("batch_bad"));
+
+    // the batch was created
+    CPPUNIT_ASSERT_THROW(batch.commit(), DuplicateName);
+
+    block.deleteTag("batch_tag");
+    block.deleteTag("batch_bad");
+    block.deleteDataArray(da);
+    block.deleteDataArray(db);
+    block.deleteDataArray(old);
+    block.deleteSource(batch.source(0).id);
+    block.deleteSource(existing);
+}
+
+
 void BaseTestBlock::testTagAccess() {
     std::vector<std::string> names = { "tag_a", "tag_b", "tag_c", "tag_d", "tag_e" };
     std::vector<std::string> array_names = { "data_array_a", "data_array_b", "data_array_c",
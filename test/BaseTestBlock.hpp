@@ -32,6 +32,8 @@ public:
     void testMetadataAccess();
     void testSourceAccess();
     void testDataArrayAccess();
+    void testDeleteDataArrays();
+    void testBatch();
     void testTagAccess();
     void testMultiTagAccess();
     void testGroupAccess();
@@ -6,13 +6,16 @@
 // modification, are permitted under the terms of the BSD License. See
 // LICENSE file in the root of the Project.
 
+#include <cmath>
 #include <iostream>
 #include <sstream>
 #include <iterator>
+#include <numeric>
 #include <stdexcept>
 
 #include <nix/hydra/multiArray.hpp>
 #include <nix/util/dataAccess.hpp>
+#include <nix/util/reduce.hpp>
 
 #include <cppunit/extensions/HelperMacros.h>
 #include <cppunit/CompilerOutputter.h>
@@ -389,3 +392,146 @@ void BaseTestDataAccess::testDataView() {
 
 
 }
+
+
+void BaseTestDataAccess::testReduce() {
+    typedef boost::multi_array<double, 3> array_type;
+    array_type data(boost::extents[2][10][5]);
+    data_array.getData(data);
+
+    // whole array: the values are 0..49 in both halves
+    double sum = 0, sq = 0;
+    for (size_t i = 0; i < 2; i++)
+        for (size_t j = 0; j < 10; j++)
+            for (size_t k = 0; k < 5; k++)
+                sum += data[i][j][k];
+    double mean = sum / 100;
+    for (size_t i = 0; i < 2; i++)
+        for (size_t j = 0; j < 10; j++)
+            for (size_t k = 0; k < 5; k++)
+                sq += (data[i][j][k] - mean) * (data[i][j][k] - mean);
+
+    for (size_t threads : {1, 3}) {
+        CPPUNIT_ASSERT_EQUAL(0.0, util::reduce(data_array, util::ReduceOp::Min, threads));
+        CPPUNIT_ASSERT_EQUAL(49.0, util::reduce(data_array, util::ReduceOp::Max, threads));
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(sum, util::reduce(data_array, util::ReduceOp::Sum, threads), 1e-9);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(mean, util::reduce(data_array, util::ReduceOp::Mean, threads), 1e-9);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(sq / 100, util::reduce(data_array, util::ReduceOp::Variance, threads), 1e-9);
+    }
+
+    // along every axis
+    for (size_t axis = 0; axis < 3; axis++) {
+        NDArray mx = util::reduce(data_array, axis, util::ReduceOp::Max, 2);
+        NDArray mn = util::reduce(data_array, axis, util::ReduceOp::Mean, 2);
+        NDSize shape = data_array.dataExtent();
+        const ndsize_t len = shape[axis];
+        CPPUNIT_ASSERT_EQUAL(ndsize_t(100 / len), mx.num_elements());
+
+        for (size_t i = 0; i < 2; i++) {
+            for (size_t j = 0; j < 10; j++) {
+                for (size_t k = 0; k < 5; k++) {
+                    size_t idx[3] = {i, j, k};
+                    if (idx[axis] != 0) continue;
+                    double m = -1, s = 0;
+                    for (size_t a = 0; a < len; a++) {
+                        idx[axis] = a;
+                        double v = data[idx[0]][idx[1]][idx[2]];
+                        m = std::max(m, v);
+                        s += v;
+                    }
+                    size_t cell = axis == 0 ? j * 5 + k : axis == 1 ? i * 5 + k : i * 10 + j;
+                    CPPUNIT_ASSERT_EQUAL(m, mx.get<double>(cell));
+                    CPPUNIT_ASSERT_DOUBLES_EQUAL(s / len, mn.get<double>(cell), 1e-9);
+                }
+            }
+        }
+    }
+    CPPUNIT_ASSERT_THROW(util::reduce(data_array, 3, util::ReduceOp::Sum), nix::OutOfBounds);
+
+    // arrays without values: one empty cell per remaining index
+    DataArray empty = block.createDataArray("empty", "test", nix::DataType::Double, nix::NDSize({0, 5}));
+    NDArray e_mean = util::reduce(empty, 1, util::ReduceOp::Mean, 2);
+    CPPUNIT_ASSERT_EQUAL(ndsize_t(0), e_mean.num_elements());
+    e_mean = util::reduce(empty, 0, util::ReduceOp::Mean, 2);
+    NDArray e_sum = util::reduce(empty, 0, util::ReduceOp::Sum, 2);
+    CPPUNIT_ASSERT_EQUAL(ndsize_t(5), e_mean.num_elements());
+    for (size_t i = 0; i < 5; i++) {
+        CPPUNIT_ASSERT(std::isnan(e_mean.get<double>(i)));
+        CPPUNIT_ASSERT_EQUAL(0.0, e_sum.get<double>(i));
+    }
+    CPPUNIT_ASSERT(std::isnan(util::reduce(empty, util::ReduceOp::Max)));
+    CPPUNIT_ASSERT_EQUAL(0.0, util::reduce(empty, util::ReduceOp::Sum));
+
+    // calibration polynomials are applied
+    DataArray calibrated = block.createDataArray("calibrated", "test", nix::DataType::Int16, nix::NDSize({4}));
+    std::vector<int16_t> raw = {0, 1, 2, 3};
+    calibrated.setData(nix::DataType::Int16, raw.data(), {4}, {0});
+    calibrated.polynomCoefficients({1.0, 2.0});
+    CPPUNIT_ASSERT_EQUAL(16.0, util::reduce(calibrated, util::ReduceOp::Sum));
+    CPPUNIT_ASSERT_EQUAL(7.0, util::reduce(calibrated, util::ReduceOp::Max));
+
+    // histogram
+    util::Histogram hist = util::histogram(data_array, 0.0, 40.0, 4, 2);
+    CPPUNIT_ASSERT_EQUAL(size_t(4), hist.counts.size());
+    CPPUNIT_ASSERT_EQUAL(10.0, hist.binWidth());
+    CPPUNIT_ASSERT_EQUAL(ndsize_t(20), hist.counts[0]);
+    CPPUNIT_ASSERT_EQUAL(ndsize_t(22), hist.counts[3]); // 30..39 and 40
+    CPPUNIT_ASSERT_EQUAL(ndsize_t(0), hist.below);
+    CPPUNIT_ASSERT_EQUAL(ndsize_t(18), hist.above);
+    CPPUNIT_ASSERT_THROW(util::histogram(data_array, 1.0, 1.0, 4), std::invalid_argument);
+
+    // rows larger than a slab are read in pieces
+    for (const NDSize &shape : {NDSize({2, 3, 100000}), NDSize({2, 300000})}) {
+        std::vector<double> values(shape.nelms());
+        for (size_t i = 0; i < values.size(); i++) {
+            values[i] = static_cast<double>(i * 37 % 101);
+        }
+        DataArray wide = block.createDataArray("wide_" + util::numToStr(shape.size()), "test",
+                                               nix::DataType::Double, shape);
+        wide.setData(nix::DataType::Double, values.data(), shape, NDSize(shape.size(), 0));
+
+        double total = std::accumulate(values.begin(), values.end(), 0.0);
+        double total_sq = 0.0;
+        for (double v : values) {
+            total_sq += (v - total / values.size()) * (v - total / values.size());
+        }
+        for (size_t threads : {1, 2}) {
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(total, util::reduce(wide, util::ReduceOp::Sum, threads), 1e-6);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(total_sq / values.size(),
+                                         util::reduce(wide, util::ReduceOp::Variance, threads), 1e-6);
+            util::Histogram h = util::histogram(wide, 0.0, 101.0, 10, threads);
+            CPPUNIT_ASSERT_EQUAL(ndsize_t(values.size()), std::accumulate(h.counts.begin(), h.counts.end(), ndsize_t(0)));
+        }
+
+        // along every axis: values are combined over index a of the axis
+        const size_t rank = shape.size();
+        for (size_t axis = 0; axis < rank; axis++) {
+            ndsize_t inner = 1;
+            for (size_t i = axis + 1; i < rank; i++) {
+                inner *= shape[i];
+            }
+            const ndsize_t len = shape[axis];
+            const size_t cells = values.size() / len;
+            std::vector<double> sum(cells, 0.0), sq(cells, 0.0), mx(cells, -1.0);
+            for (size_t i = 0; i < values.size(); i++) {
+                size_t cell = i / (len * inner) * inner + i % inner;
+                sum[cell] += values[i];
+                mx[cell] = std::max(mx[cell], values[i]);
+            }
+            for (size_t i = 0; i < values.size(); i++) {
+                size_t cell = i / (len * inner) * inner + i % inner;
+                sq[cell] += (values[i] - sum[cell] / len) * (values[i] - sum[cell] / len);
+            }
+
+            NDArray r_max = util::reduce(wide, axis, util::ReduceOp::Max, 2);
+            NDArray r_mean = util::reduce(wide, axis, util::ReduceOp::Mean, 2);
+            NDArray r_var = util::reduce(wide, axis, util::ReduceOp::Variance, 1);
+            CPPUNIT_ASSERT_EQUAL(ndsize_t(cells), r_max.num_elements());
+            for (size_t c = 0; c < cells; c++) {
+                CPPUNIT_ASSERT_EQUAL(mx[c], r_max.get<double>(c));
+                CPPUNIT_ASSERT_DOUBLES_EQUAL(sum[c] / len, r_mean.get<double>(c), 1e-9);
+                CPPUNIT_ASSERT_DOUBLES_EQUAL(sq[c] / len, r_var.get<double>(c), 1e-6);
+            }
+        }
+    }
+}
@@ -13,6 +13,9 @@
 #include <iterator>
 #include <stdexcept>
 #include <limits>
+#include <cmath>
+#include <thread>
+#include <atomic>
 
 #include <boost/math/constants/constants.hpp>
 #include <boost/math/tools/rational.hpp>
@@ -21,6 +24,8 @@
 #include <nix/util/util.hpp>
 #include <nix/valid/validate.hpp>
 #include <nix/hydra/multiArray.hpp>
+#include <nix/DataArrayReader.hpp>
+#include <nix/util/dataAccess.hpp>
 
 #include "BaseTestDataArray.hpp"
 
@@ -492,6 +497,65 @@ void BaseTestDataArray::testAliasRangeDimension() {
 }
 
 
+void BaseTestDataArray::testDimensionDescriptors() {
+    CPPUNIT_ASSERT(array2.dimensionDescriptors().empty());
+
+    nix::SampledDimension sampled = array2.appendSampledDimension(0.5);
+    sampled.offset(1.0);
+    sampled.unit("ms");
+    nix::SetDimension set = array2.appendSetDimension();
+    set.labels({"a", "b", "c"});
+    array2.appendRangeDimension({1.0, 2.0, 4.0, 8.0});
+
+    std::vector<nix::DimensionDescriptor> dims = array2.dimensionDescriptors();
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(3), dims.size());
+
+    CPPUNIT_ASSERT(dims[0].dimensionType() == nix::DimensionType::Sample);
+    CPPUNIT_ASSERT_EQUAL(static_cast<ndsize_t>(1), dims[0].index());
+    CPPUNIT_ASSERT_EQUAL(0.5, dims[0].samplingInterval());
+    CPPUNIT_ASSERT(dims[0].offset() && *dims[0].offset() == 1.0);
+    CPPUNIT_ASSERT(dims[0].unit() && *dims[0].unit() == "ms");
+    CPPUNIT_ASSERT_EQUAL(sampled.indexOf(3.0), dims[0].indexOf(3.0));
+    CPPUNIT_ASSERT_EQUAL(sampled.positionAt(7), dims[0].positionAt(7));
+    CPPUNIT_ASSERT_THROW(dims[0].indexOf(0.0), nix::OutOfBounds);
+
+    CPPUNIT_ASSERT(dims[1].dimensionType() == nix::DimensionType::Set);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(3), dims[1].labels().size());
+    CPPUNIT_ASSERT_EQUAL(static_cast<ndsize_t>(2), dims[1].indexOf(1.6));
+
+    CPPUNIT_ASSERT(dims[2].dimensionType() == nix::DimensionType::Range);
+    CPPUNIT_ASSERT(!dims[2].alias());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(4), dims[2].ticks().size());
+    CPPUNIT_ASSERT_EQUAL(static_cast<ndsize_t>(2), dims[2].indexOf(3.0));
+    CPPUNIT_ASSERT_EQUAL(static_cast<ndsize_t>(3), dims[2].indexOf(100.0));
+    CPPUNIT_ASSERT_EQUAL(4.0, dims[2].positionAt(2));
+    CPPUNIT_ASSERT_THROW(dims[2].positionAt(4), nix::OutOfBounds);
+
+    // changes through any handle are picked up by the next call
+    nix::SampledDimension other;
+    other = block.getDataArray(array2.id()).getDimension(1);
+    other.samplingInterval(0.25);
+    CPPUNIT_ASSERT_EQUAL(0.5, dims[0].samplingInterval());
+    CPPUNIT_ASSERT_EQUAL(0.25, array2.dimensionDescriptors()[0].samplingInterval());
+    other.offset(nix::none);
+    CPPUNIT_ASSERT(!array2.dimensionDescriptors()[0].offset());
+
+    array2.deleteDimensions();
+    CPPUNIT_ASSERT(array2.dimensionDescriptors().empty());
+
+    // the ticks of an alias range dimension follow the data of the array
+    nix::DataArray alias = block.createDataArray("alias", "test", nix::DataType::Double, nix::NDSize({3}));
+    alias.setData(std::vector<double>{1.0, 2.0, 3.0});
+    alias.appendAliasRangeDimension();
+    CPPUNIT_ASSERT_EQUAL(static_cast<ndsize_t>(1), alias.dimensionDescriptors()[0].indexOf(2.0));
+    alias.setData(std::vector<double>{10.0, 20.0, 30.0});
+    CPPUNIT_ASSERT_EQUAL(static_cast<ndsize_t>(1), alias.dimensionDescriptors()[0].indexOf(20.0));
+    alias.dataExtent(nix::NDSize({4}));
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(4), alias.dimensionDescriptors()[0].ticks().size());
+    block.deleteDataArray(alias);
+}
+
+
 void BaseTestDataArray::testOperator() {
     std::stringstream mystream;
     mystream << array1;
@@ -500,3 +564,380 @@ void BaseTestDataArray::testOperator() {
     CPPUNIT_ASSERT(array1 == false);
     CPPUNIT_ASSERT(array1 == none);
 }
+
+
+void BaseTestDataArray::testConcurrentRead() {
+    const size_t n_arrays = 4, n_threads = 8;
+    const nix::NDSize extent({20, 16});
+    std::vector<std::string> ids;
+
+    for (size_t k = 0; k < n_arrays; k++) {
+        std::vector<double> values(extent.nelms());
+        for (size_t i = 0; i < values.size(); i++) {
+            values[i] = k * 1e6 + i;
+        }
+        DataArray da = block.createDataArray("parallel_" + nix::util::numToStr(k), "double",
+                                             nix::DataType::Double, extent);
+        da.setData(nix::DataType::Double, values.data(), extent, {0, 0});
+        ids.push_back(da.id());
+    }
+
+    std::string location = file.location();
+    std::string block_id = block.id();
+    file.close();
+
+    // every round starts with a freshly opened file, the groups of the block
+    // handle are opened by whichever of the threads, started at once, gets
+    // there first
+    std::atomic<size_t> errors(0);
+    for (size_t round = 0; round < 50; round++) {
+        nix::File ro_file = nix::File::open(location, nix::FileMode::ReadOnly);
+        nix::Block ro_block = ro_file.getBlock(block_id);
+        std::atomic<size_t> ready(0);
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < n_threads; t++) {
+            threads.emplace_back([&ro_block, &ids, &errors, &ready, &extent, t, n_arrays, n_threads] {
+                ready++;
+                while (ready.load() < n_threads) {
+                    std::this_thread::yield();
+                }
+                size_t k = t % n_arrays;
+                std::vector<double> row(extent[1]);
+                nix::NDSize count({1, 1}), offset({0, 0});
+                count[1] = extent[1];
+                for (size_t r = 0; r < extent[0]; r++) {
+                    // the block handle is shared, the array handles are not
+                    DataArray da = ro_block.getDataArray(ids[k]);
+                    offset[0] = r;
+                    da.getData(nix::DataType::Double, row.data(), count, offset);
+                    for (size_t c = 0; c < row.size(); c++) {
+                        if (row[c] != k * 1e6 + r * extent[1] + c) {
+                            errors++;
+                        }
+                    }
+                }
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+    }
+
+    CPPUNIT_ASSERT_EQUAL(size_t(0), errors.load());
+}
+
+
+void BaseTestDataArray::testReader() {
+    const nix::NDSize extent({103, 4});
+    std::vector<int32_t> values(extent.nelms());
+    for (size_t i = 0; i < values.size(); i++) {
+        values[i] = static_cast<int32_t>(i);
+    }
+    DataArray da = block.createDataArray("reader", "int", nix::DataType::Int32, extent);
+    da.setData(nix::DataType::Int32, values.data(), extent, {0, 0});
+
+    // adjacent slabs along the first axis, the last one is cut
+    nix::DataArrayReader reader(da, nix::DataType::Int32, {10, 4}, 0, 0, 3);
+    CPPUNIT_ASSERT_EQUAL(nix::ndsize_t(11), reader.slabCount());
+
+    nix::DataArrayReader::Slab slab;
+    size_t n = 0, seen = 0;
+    while (reader.next(slab)) {
+        CPPUNIT_ASSERT_EQUAL(nix::ndsize_t(n), slab.index());
+        CPPUNIT_ASSERT_EQUAL(nix::ndsize_t(n * 10), slab.offset()[0]);
+        CPPUNIT_ASSERT_EQUAL(nix::ndsize_t(n < 10 ? 10 : 3), slab.count()[0]);
+        const int32_t *data = slab.data<int32_t>();
+        for (size_t i = 0; i < slab.count().nelms(); i++) {
+            CPPUNIT_ASSERT_EQUAL(values[seen + i], data[i]);
+        }
+        seen += slab.count().nelms();
+        n++;
+    }
+    CPPUNIT_ASSERT_EQUAL(values.size(), seen);
+    CPPUNIT_ASSERT(!reader.next(slab));
+
+    // strided, converted to double, along the second axis
+    nix::DataArrayReader strided(da, nix::DataType::Double, {5, 1}, 1, 2, 4, {20, 0});
+    CPPUNIT_ASSERT_EQUAL(nix::ndsize_t(2), strided.slabCount());
+    n = 0;
+    while (strided.next(slab)) {
+        CPPUNIT_ASSERT_EQUAL(nix::ndsize_t(2 * n), slab.offset()[1]);
+        CPPUNIT_ASSERT_EQUAL(static_cast<double>(20 * 4 + 2 * n), slab.data<double>()[0]);
+        CPPUNIT_ASSERT_EQUAL(static_cast<double>(21 * 4 + 2 * n), slab.data<double>()[1]);
+        n++;
+    }
+    CPPUNIT_ASSERT_EQUAL(size_t(2), n);
+
+    // the reader can be abandoned early
+    {
+        nix::DataArrayReader early(da, nix::DataType::Int32, {1, 4}, 0, 1, 2);
+        CPPUNIT_ASSERT(early.next(slab));
+    }
+
+    CPPUNIT_ASSERT_THROW(nix::DataArrayReader(da, nix::DataType::Int32, {10}, 0), nix::InvalidRank);
+    CPPUNIT_ASSERT_THROW(nix::DataArrayReader(da, nix::DataType::Int32, {10, 4}, 2), nix::OutOfBounds);
+    CPPUNIT_ASSERT_THROW(nix::DataArrayReader(da, nix::DataType::Int32, {10, 5}, 0), nix::OutOfBounds);
+}
+
+
+void BaseTestDataArray::testMapData() {
+    const nix::NDSize extent({6, 5});
+    std::vector<int32_t> values(extent.nelms());
+    for (size_t i = 0; i < values.size(); i++) {
+        values[i] = static_cast<int32_t>(i * 3);
+    }
+    DataArray da = block.createDataArray("mapped", "int", nix::DataType::Int32, extent);
+    da.setData(nix::DataType::Int32, values.data(), extent, {0, 0});
+    da.polynomCoefficients({1.0, 2.0});
+
+    nix::MappedData view = da.mapData();
+    CPPUNIT_ASSERT(!view.empty());
+    CPPUNIT_ASSERT_EQUAL(nix::DataType::Int32, view.dataType());
+    CPPUNIT_ASSERT_EQUAL(extent, view.shape());
+    CPPUNIT_ASSERT_EQUAL(nix::NDSize({5, 1}), view.strides());
+    CPPUNIT_ASSERT_EQUAL(extent.nelms(), view.size());
+
+    // raw values, the polynomial is not applied
+    const int32_t *data = view.as<int32_t>();
+    for (size_t i = 0; i < values.size(); i++) {
+        CPPUNIT_ASSERT_EQUAL(values[i], data[i]);
+    }
+    CPPUNIT_ASSERT_EQUAL(values[2 * 5 + 3], view.at<int32_t>({2, 3}));
+    CPPUNIT_ASSERT_THROW(view.at<int32_t>({6, 0}), nix::OutOfBounds);
+    CPPUNIT_ASSERT_THROW(view.at<int32_t>({1}), nix::InvalidRank);
+    CPPUNIT_ASSERT_THROW(view.as<double>(), std::invalid_argument);
+
+    // the view outlives the file
+    std::string location = file.location();
+    std::string block_id = block.id();
+    file.close();
+    CPPUNIT_ASSERT_EQUAL(values.back(), view.at<int32_t>({5, 4}));
+    file = nix::File::open(location, nix::FileMode::ReadWrite);
+    block = file.getBlock(block_id);
+
+    DataArray strings = block.createDataArray("strings", "string", nix::DataType::String, {2});
+    CPPUNIT_ASSERT_THROW(strings.mapData(), std::invalid_argument);
+}
+
+
+void BaseTestDataArray::testChunkIO() {
+    DataArray da = block.createDataArray("chunked", "int", nix::DataType::Int32, nix::NDSize({16, 4}));
+    const nix::NDSize chunks = da.chunkExtent();
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), chunks.size());
+
+    // a 2 x 2 grid of chunks
+    nix::NDSize extent = chunks + chunks;
+    da.dataExtent(extent);
+
+    std::vector<int32_t> values(chunks.nelms());
+    for (size_t i = 0; i < values.size(); i++) {
+        values[i] = static_cast<int32_t>(i) - 7;
+    }
+    const size_t nbytes = values.size() * sizeof(int32_t);
+    da.writeChunk({0, 1}, values.data(), nbytes);
+
+    std::vector<int32_t> read(values.size());
+    nix::NDSize offset({0, 0});
+    offset[1] = chunks[1];
+    da.getData(nix::DataType::Int32, read.data(), chunks, offset);
+    CPPUNIT_ASSERT(values == read);
+
+    nix::Buffer<char> bytes;
+    uint32_t mask = 42;
+    CPPUNIT_ASSERT(da.readChunk({0, 1}, bytes, &mask));
+    CPPUNIT_ASSERT_EQUAL(static_cast<uint32_t>(0), mask);
+    CPPUNIT_ASSERT_EQUAL(nbytes, bytes.size());
+    CPPUNIT_ASSERT(std::equal(bytes.begin(), bytes.end(), reinterpret_cast<const char *>(values.data())));
+
+    CPPUNIT_ASSERT(!da.readChunk({1, 1}, bytes));
+    CPPUNIT_ASSERT(bytes.empty());
+
+    CPPUNIT_ASSERT_THROW(da.writeChunk({2, 0}, values.data(), nbytes), nix::OutOfBounds);
+    CPPUNIT_ASSERT_THROW(da.writeChunk({0}, values.data(), nbytes), nix::IncompatibleDimensions);
+    CPPUNIT_ASSERT_THROW(da.writeChunk({1, 0}, values.data(), nbytes - 4), std::invalid_argument);
+}
+
+
+static void checkOverview(const nix::Overview &ov, const std::vector<double> &values, size_t columns) {
+    const nix::ndsize_t rows = values.size() / columns;
+    const double *mn = reinterpret_cast<const double *>(ov.min.data());
+    const double *mx = reinterpret_cast<const double *>(ov.max.data());
+    const double *mean = reinterpret_cast<const double *>(ov.mean.data());
+
+    for (nix::ndsize_t k = 0; k < ov.size(); k++) {
+        const nix::ndsize_t first = ov.offset + k * ov.factor;
+        const nix::ndsize_t last = std::min(first + ov.factor, rows);
+        for (size_t j = 0; j < columns; j++) {
+            double e_min = std::numeric_limits<double>::infinity(), e_max = -e_min, sum = 0;
+            for (nix::ndsize_t i = first; i < last; i++) {
+                const double v = values[i * columns + j];
+                if (!std::isnan(v)) {
+                    e_min = std::min(e_min, v);
+                    e_max = std::max(e_max, v);
+                }
+                sum += v;
+            }
+            const size_t at = k * columns + j;
+            if (e_min > e_max) {
+                // all samples are NaN
+                CPPUNIT_ASSERT(std::isnan(mn[at]) && std::isnan(mx[at]));
+            } else {
+                CPPUNIT_ASSERT_EQUAL(e_min, mn[at]);
+                CPPUNIT_ASSERT_EQUAL(e_max, mx[at]);
+            }
+            if (std::isnan(sum)) {
+                CPPUNIT_ASSERT(std::isnan(mean[at]));
+            } else {
+                CPPUNIT_ASSERT_DOUBLES_EQUAL(sum / (last - first), mean[at], 1e-9);
+            }
+        }
+    }
+}
+
+
+void BaseTestDataArray::testOverview() {
+    const size_t columns = 2;
+    std::vector<double> values;
+    auto append = [&](nix::DataArray &da, size_t rows) {
+        const size_t start = values.size() / columns;
+        for (size_t i = start; i < start + rows; i++) {
+            values.push_back(std::sin(i * 0.01) * 100);
+            values.push_back(i % 97 == 5 ? std::numeric_limits<double>::quiet_NaN() : double(i % 13));
+        }
+        da.appendData(nix::DataType::Double, values.data() + start * columns, {rows, columns}, 0);
+    };
+
+    DataArray da = block.createDataArray("overview", "double", nix::DataType::Double, nix::NDSize({size_t(0), columns}));
+    da.appendSampledDimension(0.5).offset(1.0);
+    da.appendSetDimension();
+    append(da, 1000);
+
+    CPPUNIT_ASSERT(!da.hasOverview());
+    da.createOverview(0, 4);
+    CPPUNIT_ASSERT(da.hasOverview());
+
+    // the whole range, 1000 samples in 4^3 bins
+    nix::Overview ov = da.overview(0, 0.0, 1000.0, 20);
+    CPPUNIT_ASSERT_EQUAL(size_t(0), ov.axis);
+    CPPUNIT_ASSERT_EQUAL(nix::ndsize_t(64), ov.factor);
+    CPPUNIT_ASSERT_EQUAL(nix::ndsize_t(16), ov.size());
+    CPPUNIT_ASSERT_EQUAL(nix::NDSize({16, 2}), ov.min.shape());
+    CPPUNIT_ASSERT_EQUAL(1.0, ov.start);
+    CPPUNIT_ASSERT_EQUAL(32.0, ov.step);
+    checkOverview(ov, values, columns);
+
+    // a window, samples 100 to 300
+    ov = da.overview(0, 51.0, 151.0, 30);
+    CPPUNIT_ASSERT_EQUAL(nix::ndsize_t(16), ov.factor);
+    CPPUNIT_ASSERT_EQUAL(nix::ndsize_t(96), ov.offset);
+    CPPUNIT_ASSERT_EQUAL(nix::ndsize_t(13), ov.size());
+    CPPUNIT_ASSERT_EQUAL(49.0, ov.start);
+    checkOverview(ov, values, columns);
+
+    // few enough samples are returned as they are
+    ov = da.overview(0, 10.2, 14.0, 10);
+    CPPUNIT_ASSERT_EQUAL(nix::ndsize_t(1), ov.factor);
+    CPPUNIT_ASSERT_EQUAL(nix::ndsize_t(19), ov.offset);
+    CPPUNIT_ASSERT_EQUAL(nix::ndsize_t(8), ov.size());
+    checkOverview(ov, values, columns);
+
+    CPPUNIT_ASSERT_EQUAL(nix::ndsize_t(0), da.overview(0, 600.0, 700.0, 10).size());
+    CPPUNIT_ASSERT_EQUAL(nix::ndsize_t(0), da.overview(0, 20.0, 10.0, 10).size());
+
+    // appending along the axis keeps the pyramid up to date
+    append(da, 37);
+    append(da, 3000);
+    CPPUNIT_ASSERT(da.hasOverview());
+    for (size_t points : {1, 7, 50, 300, 5000}) {
+        ov = da.overview(0, 3.0, 2000.0, points);
+        CPPUNIT_ASSERT(ov.size() <= points);
+        CPPUNIT_ASSERT(ov.offset <= 4);
+        checkOverview(ov, values, columns);
+    }
+
+    // without the pyramid the points are computed from the data
+    nix::Overview stored = da.overview(0, 100.0, 1500.0, 40);
+    da.deleteOverview();
+    CPPUNIT_ASSERT(!da.hasOverview());
+    ov = da.overview(0, 100.0, 1500.0, 40);
+    CPPUNIT_ASSERT(ov.size() <= 40);
+    checkOverview(ov, values, columns);
+    checkOverview(stored, values, columns);
+
+    // other changes make the pyramid outdated
+    da.createOverview(0, 4);
+    CPPUNIT_ASSERT(da.hasOverview());
+    da.setData(nix::DataType::Double, values.data(), {size_t(10), columns}, {0, 0});
+    CPPUNIT_ASSERT(!da.hasOverview());
+    da.createOverview(0);
+    da.polynomCoefficients({0.0, 2.0});
+    CPPUNIT_ASSERT(!da.hasOverview());
+
+    CPPUNIT_ASSERT_THROW(da.createOverview(0, 1), std::invalid_argument);
+    CPPUNIT_ASSERT_THROW(da.createOverview(2), nix::OutOfBounds);
+    CPPUNIT_ASSERT_THROW(da.overview(0, 0.0, 1.0, 0), std::invalid_argument);
+    CPPUNIT_ASSERT_THROW(da.overview(1, 0.0, 1.0, 10), nix::IncompatibleDimensions);
+}
+
+
+void BaseTestDataArray::testSliceByPosition() {
+    const nix::NDSize extent({100, 3});
+    std::vector<double> values(extent.nelms());
+    for (size_t i = 0; i < values.size(); i++) {
+        values[i] = static_cast<double>(i);
+    }
+    DataArray da = block.createDataArray("slice", "double", nix::DataType::Double, extent);
+    da.setData(nix::DataType::Double, values.data(), extent, {0, 0});
+    nix::SampledDimension time = da.appendSampledDimension(0.1);
+    time.unit("s");
+    time.offset(0.5);
+    da.appendSetDimension();
+
+    DataArray ranged = block.createDataArray("ranged", "double", nix::DataType::Double, nix::NDSize({8}));
+    nix::RangeDimension rd = ranged.appendRangeDimension({-1.0, 0.0, 0.5, 2.0, 2.5, 4.0, 8.0, 9.0});
+    rd.unit("mV");
+
+    // the batched conversion matches the one of single positions
+    const std::vector<double> ascending = {-5.0, -1.0, 0.2, 0.5, 0.5, 3.0, 4.0, 8.5, 100.0};
+    const std::vector<double> mixed = {3.0, -0.5, 8.9, 0.0, 2.2, 2.0};
+    for (const std::vector<double> &positions : {ascending, mixed}) {
+        std::vector<ndsize_t> scaled = ranged.positionsToIndices(1, positions.data(), positions.size(), "V");
+        std::vector<ndsize_t> plain = ranged.positionsToIndices(1, positions.data(), positions.size());
+        CPPUNIT_ASSERT_EQUAL(positions.size(), scaled.size());
+        for (size_t i = 0; i < positions.size(); i++) {
+            CPPUNIT_ASSERT_EQUAL(nix::util::positionToIndex(positions[i], "V", rd), scaled[i]);
+            CPPUNIT_ASSERT_EQUAL(nix::util::positionToIndex(positions[i], "none", rd), plain[i]);
+        }
+    }
+
+    const std::vector<double> times = {600.0, 655.0, 1000.0, 549.0, 10250.0};
+    std::vector<ndsize_t> indices = da.positionsToIndices(1, times.data(), times.size(), "ms");
+    for (size_t i = 0; i < times.size(); i++) {
+        CPPUNIT_ASSERT_EQUAL(nix::util::positionToIndex(times[i], "ms", time), indices[i]);
+    }
+    CPPUNIT_ASSERT(da.positionsToIndices(1, times.data(), 0, "s").empty());
+
+    // one second of the first dimension, all of the second
+    nix::DataView view = da.sliceByPosition({{1000.0, 2000.0}}, {"ms"});
+    CPPUNIT_ASSERT_EQUAL(nix::NDSize({10, 3}), view.dataExtent());
+    std::vector<double> read(30);
+    view.getData(nix::DataType::Double, read.data(), {10, 3}, {0, 0});
+    CPPUNIT_ASSERT(std::equal(read.begin(), read.end(), values.begin() + 5 * 3));
+
+    // a single sample and label
+    view = da.sliceByPosition({{2.0, 2.0}, {1.0, 1.0}});
+    CPPUNIT_ASSERT_EQUAL(nix::NDSize({1, 1}), view.dataExtent());
+    double value = 0;
+    view.getData(nix::DataType::Double, &value, {1, 1}, {0, 0});
+    CPPUNIT_ASSERT_EQUAL(values[15 * 3 + 1], value);
+
+    CPPUNIT_ASSERT_THROW(da.positionsToIndices(0, times.data(), 1), nix::OutOfBounds);
+    CPPUNIT_ASSERT_THROW(da.positionsToIndices(3, times.data(), 1), nix::OutOfBounds);
+    CPPUNIT_ASSERT_THROW(da.positionsToIndices(1, times.data(), 1, "mV"), nix::IncompatibleDimensions);
+    CPPUNIT_ASSERT_THROW(da.positionsToIndices(2, times.data(), 1, "s"), nix::IncompatibleDimensions);
+    const double before = -1.0;
+    CPPUNIT_ASSERT_THROW(da.positionsToIndices(1, &before, 1), nix::OutOfBounds);
+    CPPUNIT_ASSERT_THROW(da.sliceByPosition({{0.5, 1.0}, {0.0, 1.0}, {0.0, 1.0}}), nix::IncompatibleDimensions);
+    CPPUNIT_ASSERT_THROW(da.sliceByPosition({{2.0, 1.0}}), std::invalid_argument);
+    CPPUNIT_ASSERT_THROW(da.sliceByPosition({{5.0, 20.0}}), nix::OutOfBounds);
+}
@@ -36,8 +36,15 @@ public:
     void testUnit();
     void testDimension();
     void testAliasRangeDimension();
+    void testDimensionDescriptors();
     void testOperator();
     void testValidate();
+    void testConcurrentRead();
+    void testReader();
+    void testMapData();
+    void testChunkIO();
+    void testOverview();
+    void testSliceByPosition();
 };
 
 #endif // NIX_BASETESTDATAARRAY_HPP
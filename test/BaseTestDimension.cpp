@@ -13,6 +13,7 @@
 #include <stdexcept>
 
 #include <nix/util/util.hpp>
+#include <nix/util/dataAccess.hpp>
 #include <nix/valid/validate.hpp>
 
 #include "BaseTestDimension.hpp"
@@ -323,6 +324,48 @@ void BaseTestDimension::testSetDimLabels() {
 }
 
 
+void BaseTestDimension::testSetDimIndexOf() {
+    std::vector<std::string> labels = {"ch_a", "ch_b", "ch_c", "ch_d", "ch_b"};
+
+    SetDimension sd = data_array.appendSetDimension();
+    CPPUNIT_ASSERT_EQUAL(static_cast<ndsize_t>(0), sd.labelCount());
+    CPPUNIT_ASSERT_THROW(sd.indexOf("ch_a"), nix::OutOfBounds);
+
+    sd.labels(labels);
+    CPPUNIT_ASSERT_EQUAL(static_cast<ndsize_t>(labels.size()), sd.labelCount());
+    CPPUNIT_ASSERT_EQUAL(static_cast<ndsize_t>(0), sd.indexOf("ch_a"));
+    CPPUNIT_ASSERT_EQUAL(static_cast<ndsize_t>(3), sd.indexOf("ch_d"));
+    // duplicates resolve to the first occurrence
+    CPPUNIT_ASSERT_EQUAL(static_cast<ndsize_t>(1), sd.indexOf("ch_b"));
+    CPPUNIT_ASSERT_THROW(sd.indexOf("ch_x"), nix::OutOfBounds);
+
+    std::vector<ndsize_t> indices = sd.indicesOf({"ch_c", "ch_a", "ch_d"});
+    std::vector<ndsize_t> expected = {2, 0, 3};
+    CPPUNIT_ASSERT(indices == expected);
+    CPPUNIT_ASSERT(sd.indicesOf({}).empty());
+    CPPUNIT_ASSERT_THROW(sd.indicesOf({"ch_a", "ch_x"}), nix::OutOfBounds);
+
+    // changes made through another handle are seen
+    SetDimension other = data_array.getDimension(sd.index()).asSetDimension();
+    CPPUNIT_ASSERT_EQUAL(static_cast<ndsize_t>(2), other.indexOf("ch_c"));
+    other.labels({"ch_c", "ch_a"});
+    CPPUNIT_ASSERT_EQUAL(static_cast<ndsize_t>(0), sd.indexOf("ch_c"));
+    CPPUNIT_ASSERT_EQUAL(static_cast<ndsize_t>(2), sd.labelCount());
+    CPPUNIT_ASSERT_THROW(sd.indexOf("ch_d"), nix::OutOfBounds);
+
+    // the resolved dimensions offer the same lookup
+    std::vector<DimensionDescriptor> descriptors = data_array.dimensionDescriptors();
+    CPPUNIT_ASSERT_EQUAL(static_cast<ndsize_t>(1), descriptors.back().indexOf("ch_a"));
+    CPPUNIT_ASSERT_EQUAL(util::positionToIndex(1.0, "none", sd), descriptors.back().indexOf("ch_a"));
+
+    sd.labels(boost::none);
+    CPPUNIT_ASSERT_EQUAL(static_cast<ndsize_t>(0), sd.labelCount());
+    CPPUNIT_ASSERT_THROW(sd.indexOf("ch_c"), nix::OutOfBounds);
+
+    data_array.deleteDimensions();
+}
+
+
 void BaseTestDimension::testRangeDimLabel() {
     std::string label = "aLabel";
     std::string other_label = "anotherLabel";
@@ -38,6 +38,7 @@ public:
     void testSampledDimAxis();
 
     void testSetDimLabels();
+    void testSetDimIndexOf();
 
     void testRangeDimLabel();
     void testRangeTicks();
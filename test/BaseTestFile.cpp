@@ -9,6 +9,7 @@
 #include "BaseTestFile.hpp"
 
 #include <nix/util/util.hpp>
+#include <nix/util/copy.hpp>
 #include <nix/valid/validate.hpp>
 #include <ctime>
 #include <boost/filesystem.hpp>
@@ -160,6 +161,284 @@ void BaseTestFile::testSectionAccess() {
 }
 
 
+void BaseTestFile::testMetadataSnapshot() {
+    Section subject = file_open.createSection("subject", "odml.subject");
+    subject.definition("the test subject");
+    subject.createProperty("species", Value("mouse"));
+    subject.createProperty("weight", std::vector<Value>{Value(21.5), Value(22.0)});
+    Section eye = subject.createSection("eye", "odml.eye");
+    eye.createProperty("dominant", Value(true));
+    Section setup = file_open.createSection("setup", "odml.setup");
+    Property empty = setup.createProperty("empty", DataType::Int32);
+    eye.link(setup.id());
+
+    MetadataSnapshot snap = file_open.loadMetadataSnapshot();
+    CPPUNIT_ASSERT_EQUAL(snap.sectionCount(), static_cast<size_t>(3));
+    CPPUNIT_ASSERT_EQUAL(snap.propertyCount(), static_cast<size_t>(4));
+    CPPUNIT_ASSERT_EQUAL(snap.rootSections().size(), static_cast<size_t>(2));
+
+    size_t s_idx = snap.findSection(subject.id());
+    CPPUNIT_ASSERT(s_idx != MetadataSnapshot::npos);
+    CPPUNIT_ASSERT_EQUAL(snap.findSection("subject"), s_idx);
+    CPPUNIT_ASSERT(snap.section(s_idx).type == "odml.subject");
+    CPPUNIT_ASSERT(*snap.section(s_idx).definition == "the test subject");
+    CPPUNIT_ASSERT_EQUAL(snap.properties(s_idx).size(), static_cast<size_t>(2));
+    CPPUNIT_ASSERT_EQUAL(snap.sections(s_idx).size(), static_cast<size_t>(1));
+
+    size_t w_idx = snap.findProperty(s_idx, "weight");
+    CPPUNIT_ASSERT(w_idx != MetadataSnapshot::npos);
+    CPPUNIT_ASSERT(snap.property(w_idx).data_type == DataType::Double);
+
+    size_t e_idx = snap.sections(s_idx)[0];
+    CPPUNIT_ASSERT(snap.path(e_idx) == "/subject/eye");
+    CPPUNIT_ASSERT(snap.section(e_idx).link && *snap.section(e_idx).link == setup.id());
+    CPPUNIT_ASSERT_EQUAL(snap.findSectionsByType("odml.eye").size(), static_cast<size_t>(1));
+
+    size_t e_prop = snap.findProperty(snap.findSection("setup"), empty.id());
+    CPPUNIT_ASSERT(e_prop != MetadataSnapshot::npos);
+    CPPUNIT_ASSERT(snap.property(e_prop).data_type == DataType::Int32);
+    CPPUNIT_ASSERT(snap.values(e_prop).empty());
+
+    // store the tree in another file, all ids are preserved
+    file_other.storeMetadataSnapshot(snap);
+    CPPUNIT_ASSERT_EQUAL(file_other.sectionCount(), static_cast<ndsize_t>(2));
+
+    Section other_subject = file_other.getSection(subject.id());
+    CPPUNIT_ASSERT(other_subject);
+    CPPUNIT_ASSERT(other_subject.definition() && *other_subject.definition() == "the test subject");
+    CPPUNIT_ASSERT(other_subject.hasProperty("species"));
+    CPPUNIT_ASSERT(other_subject.getSection(eye.id()).link().id() == setup.id());
+    CPPUNIT_ASSERT(file_other.getSection("setup").getProperty(empty.id()).dataType() == DataType::Int32);
+
+    // everything is validated before anything is written
+    CPPUNIT_ASSERT_THROW(file_other.storeMetadataSnapshot(snap), DuplicateName);
+
+    MetadataSnapshot built;
+    size_t root = built.addSection("built", "test");
+    built.addSection("child", "test", root);
+    built.addSection("child", "test", root);
+    CPPUNIT_ASSERT_THROW(file_other.storeMetadataSnapshot(built), DuplicateName);
+    CPPUNIT_ASSERT_EQUAL(file_other.sectionCount(), static_cast<ndsize_t>(2));
+
+    built.clear();
+    root = built.addSection("built", "test");
+    built.addProperty(root, "p", std::vector<Value>{Value(1.0)});
+    built.section(root).link = util::createId();
+    CPPUNIT_ASSERT_THROW(file_other.storeMetadataSnapshot(built), std::runtime_error);
+
+    built.section(root).link = none;
+    file_other.storeMetadataSnapshot(built);
+    CPPUNIT_ASSERT(file_other.hasSection("built"));
+    CPPUNIT_ASSERT(file_other.getSection("built").hasProperty("p"));
+}
+
+
+void BaseTestFile::testMetadataSnapshotValues() {
+    Section subject = file_open.createSection("subject", "odml.subject");
+    subject.createProperty("species", Value("mouse"));
+    subject.createProperty("weight", std::vector<Value>{Value(21.5), Value(22.0)});
+
+    MetadataSnapshot snap = file_open.loadMetadataSnapshot();
+    CPPUNIT_ASSERT_EQUAL(snap.valueCount(), static_cast<size_t>(3));
+
+    size_t w_idx = snap.findProperty(snap.findSection("subject"), "weight");
+    CPPUNIT_ASSERT_EQUAL(snap.values(w_idx).size(), static_cast<size_t>(2));
+    CPPUNIT_ASSERT_EQUAL(snap.values(w_idx)[1].get<double>(), 22.0);
+
+    file_other.storeMetadataSnapshot(snap);
+    Section other = file_other.getSection(subject.id());
+    CPPUNIT_ASSERT(other.getProperty("species").values()[0] == Value("mouse"));
+    CPPUNIT_ASSERT_EQUAL(other.getProperty("weight").valueCount(), static_cast<ndsize_t>(2));
+}
+
+
+void BaseTestFile::testStorageReport() {
+    Block b = file_open.createBlock("b", "test");
+    DataArray a = b.createDataArray("a", "test", DataType::Double, NDSize({100, 4}));
+    std::vector<double> values(400, 1.0);
+    a.setData(DataType::Double, values.data(), NDSize({100, 4}), NDSize({0, 0}));
+    a.appendSampledDimension(0.1);
+    a.appendSetDimension();
+    DataArray pos = b.createDataArray("pos", "test", DataType::Double, NDSize({3}));
+
+    Tag t = b.createTag("t", "test", {1.0, 0.0});
+    t.createFeature(a, LinkType::Tagged);
+    MultiTag m = b.createMultiTag("m", "test", pos);
+    m.createFeature(a, LinkType::Indexed);
+    Source s = b.createSource("s", "test");
+    s.createSource("s2", "test");
+    a.addSource(s);
+    Group g = b.createGroup("g", "test");
+    g.addDataArray(a);
+
+    Section rec = file_open.createSection("rec", "test");
+    rec.createSection("setup", "test").createProperty("gain", Value(2.0));
+    a.metadata(rec);
+
+    StorageReport report = file_open.storageReport();
+    CPPUNIT_ASSERT(report.location == file_open.location());
+    CPPUNIT_ASSERT_EQUAL(report.sections, static_cast<size_t>(2));
+    CPPUNIT_ASSERT_EQUAL(report.properties, static_cast<size_t>(1));
+
+    CPPUNIT_ASSERT_EQUAL(report.blocks.size(), static_cast<size_t>(1));
+    const StorageReport::Block &stats = report.blocks[0];
+    CPPUNIT_ASSERT(stats.name == "b");
+    CPPUNIT_ASSERT_EQUAL(stats.data_arrays, static_cast<size_t>(2));
+    CPPUNIT_ASSERT_EQUAL(stats.dimensions, static_cast<size_t>(2));
+    CPPUNIT_ASSERT_EQUAL(stats.tags, static_cast<size_t>(1));
+    CPPUNIT_ASSERT_EQUAL(stats.multi_tags, static_cast<size_t>(1));
+    CPPUNIT_ASSERT_EQUAL(stats.features, static_cast<size_t>(2));
+    CPPUNIT_ASSERT_EQUAL(stats.sources, static_cast<size_t>(2));
+    CPPUNIT_ASSERT_EQUAL(stats.groups, static_cast<size_t>(1));
+    CPPUNIT_ASSERT(stats.objects >= 11);
+
+    CPPUNIT_ASSERT_EQUAL(report.arrays.size(), static_cast<size_t>(2));
+    const StorageReport::Array &info = report.arrays[0].name == "a" ? report.arrays[0] : report.arrays[1];
+    CPPUNIT_ASSERT(info.name == "a" && info.block == "b");
+    CPPUNIT_ASSERT(info.data_type == DataType::Double);
+    CPPUNIT_ASSERT_EQUAL(info.extent, NDSize({100, 4}));
+    CPPUNIT_ASSERT_EQUAL(info.logical_bytes, static_cast<ndsize_t>(3200));
+    CPPUNIT_ASSERT(info.allocated_bytes >= info.logical_bytes);
+    CPPUNIT_ASSERT(info.storage_bytes > 0);
+    CPPUNIT_ASSERT_EQUAL(info.compressionRatio(), 1.0);
+    CPPUNIT_ASSERT(info.chunks.size() == 0 || info.chunk_count > 0);
+    CPPUNIT_ASSERT(report.storageBytes() >= info.storage_bytes);
+
+    CPPUNIT_ASSERT(!report.largest_groups.empty());
+    for (size_t i = 1; i < report.largest_groups.size(); i++) {
+        CPPUNIT_ASSERT(report.largest_groups[i - 1].children >= report.largest_groups[i].children);
+    }
+
+    // read amplification of chunked data
+    StorageReport::Array layout;
+    layout.extent = NDSize({1000, 8});
+    layout.chunks = NDSize({100, 8});
+    CPPUNIT_ASSERT_EQUAL(layout.readAmplification(layout.extent), 1.0);
+    CPPUNIT_ASSERT_EQUAL(layout.readAmplification(layout.rowSlab()), 100.0);
+    CPPUNIT_ASSERT_EQUAL(layout.readAmplification(layout.columnSlab()), 8.0);
+    CPPUNIT_ASSERT_THROW(layout.readAmplification(NDSize({10})), InvalidRank);
+    layout.chunks = NDSize();
+    CPPUNIT_ASSERT_EQUAL(layout.readAmplification(layout.rowSlab()), 1.0);
+
+    StorageReport groups;
+    for (size_t i = 0; i < StorageReport::max_largest_groups + 4; i++) {
+        groups.addGroup("/g" + util::numToStr(i), i);
+    }
+    CPPUNIT_ASSERT_EQUAL(groups.largest_groups.size(), StorageReport::max_largest_groups);
+    CPPUNIT_ASSERT_EQUAL(groups.largest_groups.front().children, StorageReport::max_largest_groups + 3);
+}
+
+
+void BaseTestFile::testCopyFile() {
+    Block b = file_open.createBlock("b", "test");
+    DataArray a = b.createDataArray("a", "test", DataType::Int16, NDSize({1000, 3}));
+    std::vector<int16_t> values(3000);
+    for (size_t i = 0; i < values.size(); i++) {
+        values[i] = static_cast<int16_t>(i % 700) - 350;
+    }
+    a.setData(DataType::Int16, values.data(), NDSize({1000, 3}), NDSize({0, 0}));
+    a.appendSampledDimension(0.5);
+    a.appendSetDimension();
+    a.polynomCoefficients({0.0, 2.0});
+    DataArray labels = b.createDataArray("labels", "test", DataType::String, NDSize({2}));
+    std::vector<std::string> names = {"x", "y"};
+    labels.setData(DataType::String, names.data(), NDSize({2}), NDSize({0}));
+
+    Tag t = b.createTag("t", "test", {1.0, 0.0});
+    t.addReference(a);
+    Feature f = t.createFeature(labels, LinkType::Untagged);
+    Section rec = file_open.createSection("rec", "test");
+    rec.createProperty("gain", Value(2.0));
+    a.metadata(rec);
+    file_open.flush();
+
+    const std::string location = "test_copy_" + b.id() + ".h5";
+    util::CopyOptions options;
+    options.chunk_bytes = 1024;
+    options.compression = 6;
+    options.shuffle = true;
+    options.jobs = 2;
+    options.verify = true;
+    util::CopyReport report = util::copyFile(file_open, location, options);
+    CPPUNIT_ASSERT_EQUAL(report.blocks, static_cast<size_t>(1));
+    CPPUNIT_ASSERT_EQUAL(report.data_arrays, static_cast<size_t>(2));
+    CPPUNIT_ASSERT_EQUAL(report.chunks, static_cast<ndsize_t>(6));
+    CPPUNIT_ASSERT_EQUAL(report.bytes, static_cast<ndsize_t>(6000));
+    options.compression = 10;
+    CPPUNIT_ASSERT_THROW(util::copyFile(file_open, location, options), std::invalid_argument);
+
+    File copy = File::open(location, FileMode::ReadOnly);
+    CPPUNIT_ASSERT(copy.getSection(rec.id()).hasProperty("gain"));
+    Block cb = copy.getBlock(b.id());
+    CPPUNIT_ASSERT(cb && cb.name() == "b");
+    DataArray ca = cb.getDataArray(a.id());
+    CPPUNIT_ASSERT(ca.chunkExtent() == NDSize({170, 3}));
+    CPPUNIT_ASSERT(ca.metadata().id() == rec.id());
+    CPPUNIT_ASSERT(ca.createdAt() == a.createdAt());
+    CPPUNIT_ASSERT_EQUAL(ca.dimensionCount(), static_cast<ndsize_t>(2));
+    std::vector<int16_t> copied(values.size());
+    ca.getDataDirect(DataType::Int16, copied.data(), NDSize({1000, 3}), NDSize({0, 0}));
+    CPPUNIT_ASSERT(copied == values);
+    std::vector<std::string> copied_names(2);
+    cb.getDataArray(labels.id()).getData(DataType::String, copied_names.data(), NDSize({2}), NDSize({0}));
+    CPPUNIT_ASSERT(copied_names == names);
+    Tag ct = cb.getTag(t.id());
+    CPPUNIT_ASSERT(ct.hasReference(a.id()) && ct.getFeature(f.id()).data().id() == labels.id());
+
+    StorageReport stats = copy.storageReport();
+    const StorageReport::Array &info = stats.arrays[0].name == "a" ? stats.arrays[0] : stats.arrays[1];
+    CPPUNIT_ASSERT(info.filters == std::vector<std::string>({"shuffle", "deflate"}));
+    CPPUNIT_ASSERT(info.compressionRatio() > 1.0);
+
+    // without options the chunks and filters of the source are kept
+    const std::string again = "test_copy_again_" + b.id() + ".h5";
+    util::copyFile(copy, again);
+    File copy_again = File::open(again, FileMode::ReadOnly);
+    CPPUNIT_ASSERT(copy_again.getBlock(b.id()).getDataArray(a.id()).chunkExtent() == NDSize({170, 3}));
+    StorageReport kept = copy_again.storageReport();
+    CPPUNIT_ASSERT(kept.arrays[0].filters == info.filters || kept.arrays[1].filters == info.filters);
+    copy_again.close();
+    util::CopyOptions plain;
+    plain.compression = 0u;
+    util::copyFile(copy, again, plain);
+    copy_again = File::open(again, FileMode::ReadOnly);
+    kept = copy_again.storageReport();
+    CPPUNIT_ASSERT(kept.arrays[0].filters.empty() && kept.arrays[1].filters.empty());
+    copy_again.close();
+    bfs::remove(again);
+
+    copy.close();
+    bfs::remove(location);
+
+#ifdef ENABLE_FS_BACKEND
+    // the same into the file system back-end
+    const std::string directory = "test_copy_" + b.id();
+    util::CopyOptions fs_options;
+    fs_options.backend = "file";
+    fs_options.jobs = 2;
+    fs_options.verify = true;
+    report = util::copyFile(file_open, directory, fs_options);
+    CPPUNIT_ASSERT_EQUAL(report.data_arrays, static_cast<size_t>(2));
+    CPPUNIT_ASSERT_EQUAL(report.bytes, static_cast<ndsize_t>(6000));
+
+    copy = File::open(directory, FileMode::ReadOnly, "file");
+    ca = copy.getBlock(b.id()).getDataArray(a.id());
+    CPPUNIT_ASSERT(ca && ca.dataExtent() == NDSize({1000, 3}));
+    std::fill(copied.begin(), copied.end(), 0);
+    ca.getDataDirect(DataType::Int16, copied.data(), NDSize({1000, 3}), NDSize({0, 0}));
+    CPPUNIT_ASSERT(copied == values);
+    CPPUNIT_ASSERT(copy.getBlock(b.id()).getTag(t.id()).hasReference(a.id()));
+    copy.close();
+    bfs::remove_all(directory);
+#endif
+
+    CPPUNIT_ASSERT(util::chunkShape(NDSize({1000, 3}), 2, 1024) == NDSize({170, 3}));
+    CPPUNIT_ASSERT(util::chunkShape(NDSize({10, 20, 30}), 8, 1 << 20) == NDSize({10, 20, 30}));
+    CPPUNIT_ASSERT(util::chunkShape(NDSize({4, 1000}), 4, 400) == NDSize({1, 100}));
+    CPPUNIT_ASSERT(util::chunkShape(NDSize({0, 16}), 8, 1024) == NDSize({8, 16}));
+}
+
+
 void BaseTestFile::testOperators(){
     CPPUNIT_ASSERT(file_null == false);
     CPPUNIT_ASSERT(file_null == none);
@@ -44,6 +44,10 @@ public:
     void testUpdatedAt();
     void testBlockAccess();
     void testSectionAccess();
+    void testMetadataSnapshot();
+    void testMetadataSnapshotValues();
+    void testStorageReport();
+    void testCopyFile();
     void testOperators();
     void testReopen();
     void testCheckHeader();
@@ -14,6 +14,9 @@
 #include <iostream>
 #include <iterator>
 #include <stdexcept>
+#include <random>
+#include <limits>
+#include <cmath>
 
 #include <nix/Exception.hpp>
 #include <nix/hydra/multiArray.hpp>
@@ -294,6 +297,102 @@ void BaseTestMultiTag::testPositionExtents() {
 }
 
 
+void BaseTestMultiTag::testIntervalQueries() {
+    typedef boost::multi_array<double, 2> array_type;
+    const size_t n = 300;
+    array_type pos(boost::extents[n][2]), ext(boost::extents[n][2]);
+
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> coord(0.0, 100.0), width(0.0, 5.0);
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < 2; j++) {
+            pos[i][j] = coord(gen);
+            ext[i][j] = width(gen);
+        }
+    }
+    // not indexed in any dimension
+    pos[7][1] = std::numeric_limits<double>::quiet_NaN();
+
+    DataArray p = block.createDataArray("interval_positions", "test", DataType::Double, {0, 0});
+    p.setData(pos);
+    DataArray e = block.createDataArray("interval_extents", "test", DataType::Double, {0, 0});
+    e.setData(ext);
+    MultiTag mt = block.createMultiTag("interval_tag", "test", p);
+    mt.extents(e);
+
+    auto sorted = [](std::vector<ndsize_t> v) {
+        std::sort(v.begin(), v.end());
+        return v;
+    };
+    auto in_range = [&](double lo, double hi, size_t d) {
+        std::vector<ndsize_t> r;
+        for (size_t i = 0; i < n; i++) {
+            if (i != 7 && pos[i][d] >= lo && pos[i][d] <= hi) {
+                r.push_back(i);
+            }
+        }
+        return r;
+    };
+    auto overlaps = [&](const std::vector<double> &lo, const std::vector<double> &hi, bool with_extents) {
+        std::vector<ndsize_t> r;
+        for (size_t i = 0; i < n; i++) {
+            bool hit = i != 7;
+            for (size_t d = 0; d < lo.size() && hit; d++) {
+                const double end = pos[i][d] + (with_extents ? ext[i][d] : 0.0);
+                hit = pos[i][d] <= hi[d] && end >= lo[d];
+            }
+            if (hit) {
+                r.push_back(i);
+            }
+        }
+        return r;
+    };
+
+    const std::vector<std::pair<double, double>> windows = {{10, 20}, {0, 100}, {50.5, 50.6}, {-10, -1}, {42, 42}};
+    for (const auto &w : windows) {
+        for (size_t d = 0; d < 2; d++) {
+            std::vector<ndsize_t> found = mt.positionsInRange(w.first, w.second, d);
+            CPPUNIT_ASSERT(sorted(found) == in_range(w.first, w.second, d));
+            for (size_t i = 1; i < found.size(); i++) {
+                CPPUNIT_ASSERT(pos[found[i - 1]][d] <= pos[found[i]][d]);
+            }
+            std::vector<double> lo(2, -1000.0), hi(2, 1000.0);
+            lo[d] = w.first;
+            hi[d] = w.second;
+            CPPUNIT_ASSERT(sorted(mt.overlapping(w.first, w.second, d)) == overlaps(lo, hi, true));
+        }
+        std::vector<double> lo = {w.first, 30}, hi = {w.second, 60};
+        CPPUNIT_ASSERT(sorted(mt.overlapping(lo, hi)) == overlaps(lo, hi, true));
+    }
+
+    // a fresh handle sees the same index
+    MultiTag other = block.getMultiTag(mt.id());
+    CPPUNIT_ASSERT(other.overlapping(10, 20) == mt.overlapping(10, 20));
+
+    // changes of the positions are picked up
+    double moved = 1000.0;
+    p.setData(DataType::Double, &moved, {1, 1}, {0, 0});
+    pos[0][0] = moved;
+    std::vector<ndsize_t> found = mt.positionsInRange(999, 1001);
+    CPPUNIT_ASSERT(found.size() == 1 && found[0] == 0);
+    CPPUNIT_ASSERT(sorted(other.overlapping(0, 50)) == overlaps({0}, {50}, true));
+
+    // without extents only the positions count
+    mt.extents(none);
+    CPPUNIT_ASSERT(sorted(mt.overlapping(10, 20)) == overlaps({10}, {20}, false));
+    CPPUNIT_ASSERT(mt.overlapping(10, 20) == mt.positionsInRange(10, 20));
+
+    CPPUNIT_ASSERT_THROW(mt.positionsInRange(0, 1, 2), OutOfBounds);
+    CPPUNIT_ASSERT_THROW(mt.overlapping({0, 0}, {1}), IncompatibleDimensions);
+    CPPUNIT_ASSERT_THROW(mt.overlapping({0, 0, 0}, {1, 1, 1}), IncompatibleDimensions);
+    CPPUNIT_ASSERT(mt.overlapping(20, 10).empty());
+
+    block.deleteMultiTag(mt);
+    block.deleteDataArray(p);
+    block.deleteDataArray(e);
+}
+
+
 void BaseTestMultiTag::testDataAccess() {
     DataArray data_array = block.createDataArray("dimensionTest",
                                        "test",
@@ -39,6 +39,7 @@ public:
     void testFeatures();
     void testDataAccess();
     void testPositionExtents();
+    void testIntervalQueries();
     void testMetadataAccess();
     void testSourceAccess();
     void testOperators();
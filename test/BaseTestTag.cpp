@@ -16,6 +16,7 @@
 
 #include "BaseTestTag.hpp"
 #include <nix/hydra/multiArray.hpp>
+#include <nix/util/copy.hpp>
 
 #include <cppunit/extensions/HelperMacros.h>
 #include <cppunit/CompilerOutputter.h>
@@ -24,6 +25,7 @@
 #include <cppunit/TestRunner.h>
 #include <cppunit/BriefTestProgressListener.h>
 #include <boost/math/constants/constants.hpp>
+#include <boost/filesystem.hpp>
 
 using namespace nix;
 using namespace valid;
@@ -250,6 +252,63 @@ void BaseTestTag::testReferences() {
 }
 
 
+void BaseTestTag::testAddReferences() {
+    std::vector<DataArray> first(refs.begin(), refs.begin() + 2);
+    CPPUNIT_ASSERT_NO_THROW(tag.addReferences(first));
+    CPPUNIT_ASSERT(tag.referenceCount() == 2);
+
+    // already referenced arrays are skipped
+    CPPUNIT_ASSERT_NO_THROW(tag.addReferences(refs));
+    CPPUNIT_ASSERT(tag.referenceCount() == refs.size());
+    for (const auto &ref : refs) {
+        CPPUNIT_ASSERT(tag.hasReference(ref));
+        CPPUNIT_ASSERT(tag.getReference(ref.name()).id() == ref.id());
+    }
+
+    // nothing is added if one of the arrays is not part of the block
+    Block other = file.createBlock("other_block", "test");
+    DataArray foreign = other.createDataArray("foreign", "reference", DataType::Double, NDSize({1}));
+    Tag fresh = block.createTag("fresh_tag", "test", {0.0});
+    CPPUNIT_ASSERT_THROW(fresh.addReferences({refs[0], foreign}), std::runtime_error);
+    CPPUNIT_ASSERT(fresh.referenceCount() == 0);
+
+    // neither is an array of another block with the name of one in this block
+    DataArray twin = other.createDataArray(refs[1].name(), "reference", DataType::Double, NDSize({1}));
+    CPPUNIT_ASSERT_THROW(fresh.addReferences({refs[0], twin}), std::runtime_error);
+    CPPUNIT_ASSERT(fresh.referenceCount() == 0);
+
+    DataArray a;
+    CPPUNIT_ASSERT_THROW(fresh.addReferences({refs[0], a}), UninitializedEntity);
+
+    // the setter replaces the references
+    std::vector<DataArray> last(refs.end() - 2, refs.end());
+    tag.references(last);
+    CPPUNIT_ASSERT(tag.referenceCount() == 2);
+    CPPUNIT_ASSERT(tag.hasReference(last[0]) && tag.hasReference(last[1]));
+    CPPUNIT_ASSERT(!tag.hasReference(refs[0]));
+
+    file.deleteBlock(other);
+}
+
+
+void BaseTestTag::testAddReferencesFromCopy() {
+    // a copy has arrays of the same name and id, handles of the copy refer
+    // to the arrays of this block
+    const std::string path = "test_tag_copy.h5";
+    util::copyFile(file, path);
+    File copy = File::open(path, FileMode::ReadOnly);
+    DataArray copied = copy.getBlock(block.name()).getDataArray(refs[0].name());
+
+    Tag fresh = block.createTag("fresh_tag", "test", {0.0});
+    CPPUNIT_ASSERT_NO_THROW(fresh.addReferences({copied}));
+    CPPUNIT_ASSERT(fresh.referenceCount() == 1);
+    CPPUNIT_ASSERT(fresh.getReference(0).id() == refs[0].id());
+
+    copy.close();
+    boost::filesystem::remove(path);
+}
+
+
 void BaseTestTag::testFeatures() {
     DataArray a;
     Feature f;
@@ -41,6 +41,8 @@ public:
     void testSourceAccess();
     void testUnits();
     void testReferences();
+    void testAddReferences();
+    void testAddReferencesFromCopy();
     void testFeatures();
     void testOperators();
     void testCreatedAt();
@@ -10,6 +10,7 @@
 
 #include <nix.hpp>
 #include <nix/NDArray.hpp>
+#include <nix/DataArrayReader.hpp>
 
 #include <cstdio>
 #include <queue>
@@ -24,6 +25,21 @@
 #include <string>
 #include <cstdint>
 #include <utility>
+#include <numeric>
+#include <cmath>
+#include <atomic>
+#include <ctime>
+
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/random.hpp>
+#include <boost/uuid/uuid.hpp>
+#include <boost/uuid/uuid_generators.hpp>
+#include <boost/uuid/uuid_io.hpp>
+
+#ifndef _WIN32
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
 
 /* ************************************ */
 namespace nix {
@@ -355,6 +371,80 @@ public:
 };
 
 
+// sustained writes of whole chunks, either through setData or directly
+// with writeChunk, which skips type conversion and the filter pipeline
+class ChunkWriteBenchmark : public Benchmark {
+
+public:
+    ChunkWriteBenchmark(const Config &cfg, bool direct)
+            : Benchmark(cfg), direct(direct), chunk_elms(0) {
+    };
+
+    void run(nix::Block block) override {
+        const std::string name = config.name() + (direct ? " chunk direct" : " chunk setData");
+        nix::DataArray da = block.createDataArray(name, "nix.test.da", config.dtype(), config.size());
+        const nix::NDSize chunk = da.chunkExtent();
+        const size_t sdim = config.singleton_dimension();
+        const size_t nbytes = chunk.nelms() * nix::data_type_to_size(config.dtype());
+        chunk_elms = chunk.nelms();
+
+        BlockGenerator::BlockMaker maker;
+        std::vector<nix::NDArray> blocks;
+        for (size_t i = 0; i < 10; i++) {
+            blocks.push_back(nix::data_type_dispatch(config.dtype(), maker, std::ref(chunk)));
+        }
+
+        size_t N = 100;
+        size_t iterations = 0;
+
+        nix::NDSize pos(chunk.size(), 0), grid(chunk.size(), 0);
+        Stopwatch sw;
+        ssize_t ms = 0;
+        do {
+            Stopwatch inner;
+
+            for (size_t i = 0; i < N; i++) {
+                const nix::NDArray &data = blocks[iterations % blocks.size()];
+                da.dataExtent(chunk + pos);
+                if (direct) {
+                    da.writeChunk(grid, data.data(), nbytes);
+                } else {
+                    da.setData(config.dtype(), data.data(), chunk, pos);
+                }
+                pos[sdim] += chunk[sdim];
+                grid[sdim] += 1;
+                iterations++;
+            }
+
+            if (inner.ms() < 100) {
+                N *= 2;
+            }
+
+        } while ((ms = sw.ms()) < 3*1000);
+
+        this->count = iterations;
+        this->millis = ms;
+    }
+
+    double speed_in_mbs() override {
+        return count * chunk_elms * nix::data_type_to_size(config.dtype()) *
+                (1000.0/millis) / (1024 * 1024);
+    }
+
+    double speed_in_nps() override {
+        return count * chunk_elms * (1000.0/millis);
+    }
+
+    std::string id() override {
+        return direct ? "CD" : "CW";
+    }
+
+private:
+    bool direct;
+    size_t chunk_elms;
+};
+
+
 class ReadBenchmark : public Benchmark {
 
 public:
@@ -410,6 +500,482 @@ public:
     }
 };
 
+class ParallelReadBenchmark : public Benchmark {
+
+public:
+    ParallelReadBenchmark(const Config &cfg, size_t n_threads)
+            : Benchmark(cfg), n_threads(n_threads) {
+    };
+
+    static std::string arrayName(const Config &cfg, size_t index) {
+        return cfg.name() + " #" + nix::util::numToStr(index);
+    }
+
+    // one data array per thread, all of them stored in the same file
+    static void prepare(nix::Block block, const Config &cfg, size_t n_arrays) {
+        BlockGenerator generator(cfg, 10);
+        const size_t n_blocks = 1024;
+
+        for (size_t t = 0; t < n_arrays; t++) {
+            nix::DataArray da = block.createDataArray(arrayName(cfg, t), "nix.test.da", cfg.dtype(), cfg.extend());
+            nix::NDSize pos = {0, 0};
+            for (size_t i = 0; i < n_blocks; i++) {
+                nix::NDArray data = generator.next_block();
+                da.dataExtent(cfg.size() + pos);
+                da.setData(cfg.dtype(), data.data(), cfg.size(), pos);
+                pos[cfg.singleton_dimension()] += 1;
+            }
+        }
+    }
+
+    // block must belong to a file that was opened read-only
+    void run(nix::Block block) override {
+        std::vector<size_t> counts(n_threads, 0);
+
+        ssize_t ms = time_it([this, &block, &counts] {
+            std::vector<std::thread> threads;
+            for (size_t t = 0; t < n_threads; t++) {
+                threads.emplace_back([this, &block, &counts, t] {
+                    nix::DataArray da = block.getDataArray(arrayName(config, t));
+                    nix::NDArray array(config.dtype(), config.size());
+                    size_t N = da.dataExtent()[config.singleton_dimension()];
+                    nix::NDSize pos = {0, 0};
+                    for (size_t i = 0; i < N; i++) {
+                        da.getData(config.dtype(), array.data(), config.size(), pos);
+                        pos[config.singleton_dimension()] += 1;
+                    }
+                    counts[t] = N;
+                });
+            }
+            for (auto &thread : threads) {
+                thread.join();
+            }
+        });
+
+        this->count = std::accumulate(counts.begin(), counts.end(), size_t(0));
+        this->millis = ms;
+    }
+
+    std::string id() override {
+        return "T" + nix::util::numToStr(n_threads);
+    }
+
+private:
+    size_t n_threads;
+};
+
+// sequential scan with some computation on every block, either with
+// synchronous reads or with the prefetching DataArrayReader
+class ScanBenchmark : public Benchmark {
+
+public:
+    ScanBenchmark(const Config &cfg, bool prefetch)
+            : Benchmark(cfg), prefetch(prefetch), sink(0) {
+    };
+
+    void compute(const double *data, size_t n) {
+        double acc = 0;
+        for (size_t i = 0; i < n; i++) {
+            double x = data[i];
+            for (int k = 0; k < 4; k++) {
+                x = std::sqrt(std::abs(x) + 1.0);
+            }
+            acc += x;
+        }
+        sink += acc;
+    }
+
+    void run(nix::Block block) override {
+        nix::DataArray da = openDataArray(block);
+        const size_t nelms = config.size().nelms();
+        const size_t sdim = config.singleton_dimension();
+        size_t N = da.dataExtent()[sdim];
+
+        ssize_t ms;
+        if (prefetch) {
+            ms = time_it([this, &da, nelms, sdim] {
+                nix::DataArrayReader reader(da, nix::DataType::Double, config.size(), sdim);
+                nix::DataArrayReader::Slab slab;
+                while (reader.next(slab)) {
+                    compute(slab.data<double>(), nelms);
+                }
+            });
+        } else {
+            ms = time_it([this, &da, N, nelms, sdim] {
+                std::vector<double> buffer(nelms);
+                nix::NDSize pos = {0, 0};
+                for (size_t i = 0; i < N; i++) {
+                    da.getData(nix::DataType::Double, buffer.data(), config.size(), pos);
+                    compute(buffer.data(), nelms);
+                    pos[sdim] += 1;
+                }
+            });
+        }
+
+        this->count = N;
+        this->millis = ms;
+    }
+
+    std::string id() override {
+        return prefetch ? "A" : "S";
+    }
+
+private:
+    bool prefetch;
+    double sink;
+};
+
+// opening every entity of a file with many small entities, which
+// measures the per-handle overhead of the back-end
+class TraversalBenchmark : public Benchmark {
+
+public:
+    TraversalBenchmark(const Config &cfg, nix::FileMode mode)
+            : Benchmark(cfg), mode(mode) {
+    };
+
+    static const std::string &path() {
+        static const std::string p = "traversal.h5";
+        return p;
+    }
+
+    static void prepare(size_t n_blocks, size_t n_arrays) {
+        nix::File file = nix::File::open(path(), nix::FileMode::Overwrite);
+        for (size_t b = 0; b < n_blocks; b++) {
+            nix::Block block = file.createBlock("block_" + std::to_string(b), "nix.test");
+            nix::Source src = block.createSource("source", "nix.test");
+            for (size_t i = 0; i < n_arrays; i++) {
+                nix::DataArray da = block.createDataArray("da_" + std::to_string(i), "nix.test.da",
+                                                          nix::DataType::Double, nix::NDSize{4});
+                da.appendSampledDimension(0.1);
+                da.addSource(src);
+                nix::Tag tag = block.createTag("tag_" + std::to_string(i), "nix.test.tag", {0.0});
+                tag.addReference(da);
+            }
+        }
+        file.close();
+    }
+
+    void run(nix::Block) override {
+        size_t n = 0;
+        ssize_t ms = time_it([this, &n] {
+            nix::File file = nix::File::open(path(), mode);
+            for (const nix::Block &block : file.blocks()) {
+                n++;
+                for (const nix::DataArray &da : block.dataArrays()) {
+                    n += 1 + da.sourceCount() + da.dimensionCount();
+                }
+                for (const nix::Tag &tag : block.tags()) {
+                    n += 1 + tag.referenceCount();
+                }
+            }
+            file.close();
+        });
+
+        this->count = n;
+        this->millis = ms;
+    }
+
+    double speed_in_mbs() override {
+        return 0.0;
+    }
+
+    double speed_in_nps() override {
+        return count * (1000.0/millis);
+    }
+
+    std::string id() override {
+        return mode == nix::FileMode::ReadOnly ? "TR" : "TW";
+    }
+
+private:
+    nix::FileMode mode;
+};
+
+// creating many small entities (arrays with a dimension and a source,
+// tags referencing them) one by one or as a single batch
+class CreationBenchmark : public Benchmark {
+
+public:
+    CreationBenchmark(const Config &cfg, bool batched)
+            : Benchmark(cfg), batched(batched) {
+    };
+
+    void run(nix::Block) override {
+        const size_t n_arrays = 2000;
+        nix::File file = nix::File::open("creation.h5", nix::FileMode::Overwrite);
+        nix::Block block = file.createBlock("creation", "nix.test");
+
+        ssize_t ms = time_it([&block, n_arrays, this] {
+            if (batched) {
+                nix::BlockBatch batch = block.batch();
+                batch.addSource("source", "nix.test");
+                for (size_t i = 0; i < n_arrays; i++) {
+                    std::string name = "da_" + std::to_string(i);
+                    size_t da = batch.addDataArray(name, "nix.test.da", nix::DataType::Double, nix::NDSize{4});
+                    batch.dataArray(da).unit = "mV";
+                    batch.dataArray(da).dimensions.push_back(nix::BlockBatch::DimensionSpec::sampled(0.1));
+                    batch.dataArray(da).sources.push_back("source");
+                    size_t tag = batch.addTag("tag_" + std::to_string(i), "nix.test.tag", {0.0});
+                    batch.tag(tag).references.push_back(name);
+                }
+                batch.commit();
+            } else {
+                nix::Source src = block.createSource("source", "nix.test");
+                for (size_t i = 0; i < n_arrays; i++) {
+                    nix::DataArray da = block.createDataArray("da_" + std::to_string(i), "nix.test.da",
+                                                              nix::DataType::Double, nix::NDSize{4});
+                    da.unit("mV");
+                    da.appendSampledDimension(0.1);
+                    da.addSource(src);
+                    nix::Tag tag = block.createTag("tag_" + std::to_string(i), "nix.test.tag", {0.0});
+                    tag.addReference(da);
+                }
+            }
+        });
+
+        file.close();
+        this->count = 1 + 2 * n_arrays;
+        this->millis = ms;
+    }
+
+    double speed_in_mbs() override {
+        return 0.0;
+    }
+
+    double speed_in_nps() override {
+        return count * (1000.0/millis);
+    }
+
+    std::string id() override {
+        return batched ? "CB" : "CE";
+    }
+
+private:
+    bool batched;
+};
+
+// ids and time stamps as created for every entity, with the library's
+// functions or with the boost based implementation they replaced
+class IdentityBenchmark : public Benchmark {
+
+public:
+    IdentityBenchmark(const Config &cfg, bool timestamps, bool legacy, size_t n_threads)
+            : Benchmark(cfg), timestamps(timestamps), legacy(legacy), n_threads(n_threads) {
+    };
+
+    void run(nix::Block) override {
+        const size_t N = 1000000;
+        std::atomic<size_t> sink(0);
+
+        ssize_t ms = time_it([&sink, N, this] {
+            std::vector<std::thread> threads;
+            for (size_t t = 0; t < n_threads; t++) {
+                threads.emplace_back([&sink, N, this] {
+                    size_t len = 0;
+                    for (size_t i = 0; i < N / n_threads; i++) {
+                        len += make().size();
+                    }
+                    sink += len;
+                });
+            }
+            for (auto &t : threads) {
+                t.join();
+            }
+        });
+
+        this->count = N;
+        this->millis = ms;
+    }
+
+    double speed_in_mbs() override {
+        return 0.0;
+    }
+
+    double speed_in_nps() override {
+        return count * (1000.0/millis);
+    }
+
+    std::string id() override {
+        return std::string(timestamps ? "TS" : "ID") + (legacy ? "B" : "") + std::to_string(n_threads);
+    }
+
+private:
+    std::string make() const {
+        if (timestamps) {
+            time_t now = nix::util::getTime();
+            return legacy ? boost::posix_time::to_iso_string(boost::posix_time::from_time_t(now))
+                          : nix::util::timeToStr(now);
+        }
+        if (!legacy) {
+            return nix::util::createId();
+        }
+        static std::mutex gen_mutex;
+        static boost::mt19937 ran(static_cast<boost::mt19937::result_type>(std::time(0)));
+        static boost::uuids::basic_random_generator<boost::mt19937> gen(&ran);
+        boost::uuids::uuid u;
+        {
+            std::lock_guard<std::mutex> lock(gen_mutex);
+            u = gen();
+        }
+        return boost::uuids::to_string(u);
+    }
+
+    bool timestamps;
+    bool legacy;
+    size_t n_threads;
+};
+
+// time-window queries on a multi tag with many events, either by reading
+// positions and extents in full or through the interval index
+class IntervalQueryBenchmark : public Benchmark {
+
+public:
+    IntervalQueryBenchmark(const Config &cfg, bool indexed)
+            : Benchmark(cfg), indexed(indexed) {
+    };
+
+    static const std::string &path() {
+        static const std::string p = "intervals.h5";
+        return p;
+    }
+
+    static void prepare(size_t n_events) {
+        nix::File file = nix::File::open(path(), nix::FileMode::Overwrite);
+        nix::Block block = file.createBlock("intervals", "nix.test");
+
+        std::mt19937 gen(1);
+        std::exponential_distribution<double> gap(1000.0), width(200.0);
+        std::vector<double> pos(n_events), ext(n_events);
+        double t = 0.0;
+        for (size_t i = 0; i < n_events; i++) {
+            t += gap(gen);
+            pos[i] = t;
+            ext[i] = width(gen);
+        }
+
+        nix::DataArray p = block.createDataArray("positions", "nix.test", pos);
+        nix::DataArray e = block.createDataArray("extents", "nix.test", ext);
+        nix::MultiTag tag = block.createMultiTag("events", "nix.test", p);
+        tag.extents(e);
+        // builds and stores the index
+        tag.overlapping(0.0, 0.0);
+        file.close();
+    }
+
+    void run(nix::Block) override {
+        const size_t n_queries = 200;
+        nix::File file = nix::File::open(path(), nix::FileMode::ReadOnly);
+        nix::MultiTag tag = file.getBlock("intervals").getMultiTag("events");
+        const double duration = tag.positions().dataExtent()[0] / 1000.0;
+
+        size_t hits = 0;
+        ssize_t ms = time_it([&] {
+            for (size_t q = 0; q < n_queries; q++) {
+                const double t0 = duration * q / n_queries, t1 = t0 + 0.5;
+                if (indexed) {
+                    hits += tag.overlapping(t0, t1).size();
+                } else {
+                    std::vector<double> pos, ext;
+                    tag.positions().getData(pos);
+                    tag.extents().getData(ext);
+                    for (size_t i = 0; i < pos.size(); i++) {
+                        hits += pos[i] <= t1 && pos[i] + ext[i] >= t0;
+                    }
+                }
+            }
+        });
+
+        file.close();
+        this->count = n_queries;
+        this->millis = ms;
+    }
+
+    double speed_in_mbs() override {
+        return 0.0;
+    }
+
+    double speed_in_nps() override {
+        return count * (1000.0/millis);
+    }
+
+    std::string id() override {
+        return indexed ? "QI" : "QS";
+    }
+
+private:
+    bool indexed;
+};
+
+class OverviewBenchmark : public Benchmark {
+
+public:
+    OverviewBenchmark(const Config &cfg, bool pyramid)
+            : Benchmark(cfg), pyramid(pyramid) {
+    };
+
+    static const std::string &path() {
+        static const std::string p = "overview.h5";
+        return p;
+    }
+
+    static void prepare(size_t n_samples) {
+        nix::File file = nix::File::open(path(), nix::FileMode::Overwrite);
+        nix::Block block = file.createBlock("overview", "nix.test");
+
+        std::mt19937 gen(1);
+        std::normal_distribution<double> noise(0.0, 1.0);
+        std::vector<double> signal(n_samples);
+        for (size_t i = 0; i < n_samples; i++) {
+            signal[i] = std::sin(i * 1e-4) + noise(gen);
+        }
+
+        for (const char *name : {"raw", "pyramid"}) {
+            nix::DataArray da = block.createDataArray(name, "nix.test", signal);
+            da.appendSampledDimension(1.0 / 30000.0);
+        }
+        block.getDataArray("pyramid").createOverview(0, 16);
+        file.close();
+    }
+
+    void run(nix::Block) override {
+        const size_t n_queries = 20;
+        nix::File file = nix::File::open(path(), nix::FileMode::ReadOnly);
+        nix::DataArray da = file.getBlock("overview").getDataArray(pyramid ? "pyramid" : "raw");
+        const double duration = da.dataExtent()[0] / 30000.0;
+
+        double sum = 0.0;
+        ssize_t ms = time_it([&] {
+            for (size_t q = 0; q < n_queries; q++) {
+                // windows from a tenth to all of the recording
+                const double width = duration * (q + 1) / n_queries;
+                nix::Overview ov = da.overview(0, duration - width, duration, 2000);
+                sum += ov.min.get<double>(0);
+            }
+        });
+
+        file.close();
+        this->count = n_queries;
+        this->millis = ms;
+    }
+
+    double speed_in_mbs() override {
+        return 0.0;
+    }
+
+    double speed_in_nps() override {
+        return count * (1000.0/millis);
+    }
+
+    std::string id() override {
+        return pyramid ? "OP" : "OR";
+    }
+
+private:
+    bool pyramid;
+};
+
+
 class DiskBenchmark : public Benchmark {
 public:
     DiskBenchmark(const Config &cfg)
@@ -531,6 +1097,129 @@ public:
     }
 };
 
+#ifndef _WIN32
+
+class SWMRLatencyBenchmark : public Benchmark {
+
+public:
+    SWMRLatencyBenchmark(const Config &cfg)
+            : Benchmark(cfg), mean_us(0.0), max_us(0.0) {
+    };
+
+    void run(nix::Block) override {
+        const std::string path = "swmr_latency.h5";
+        const size_t sdim = config.singleton_dimension();
+        const size_t N = 500;
+        std::remove(path.c_str());
+
+        int to_reader[2], to_writer[2];
+        if (pipe(to_reader) != 0 || pipe(to_writer) != 0) {
+            throw std::runtime_error("Could not create pipes for the SWMR test.");
+        }
+
+        // the reader is forked before the file is opened, so that it does
+        // not share the open file of the writer
+        pid_t pid = fork();
+        if (pid < 0) {
+            throw std::runtime_error("Could not fork the SWMR reader.");
+        } else if (pid == 0) {
+            read_latencies(path, N, to_reader[0], to_writer[1]);
+            _exit(0);
+        }
+
+        nix::File file = nix::File::open(path, nix::FileMode::SWMRWrite);
+        nix::DataArray da = file.createBlock("live", "nix.test")
+            .createDataArray("signal", "nix.test.da", nix::DataType::Double, config.extend());
+        file.flushInterval(0.0);
+        file.startSWMRWrite();
+
+        char ready = 1;
+        if (write(to_reader[1], &ready, 1) != 1 || read(to_writer[0], &ready, 1) != 1) {
+            throw std::runtime_error("SWMR reader did not start.");
+        }
+
+        std::vector<double> data(config.size().nelms(), 0.0);
+        Stopwatch sw;
+        for (size_t i = 0; i < N; i++) {
+            data[0] = now_ns();
+            da.appendData(nix::DataType::Double, data.data(), config.size(), sdim);
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        this->millis = sw.ms();
+        this->count = N;
+
+        double result[2] = {0.0, 0.0};
+        if (read(to_writer[0], result, sizeof(result)) != sizeof(result)) {
+            throw std::runtime_error("SWMR reader did not report.");
+        }
+        waitpid(pid, nullptr, 0);
+        file.close();
+        for (int fd : {to_reader[0], to_reader[1], to_writer[0], to_writer[1]}) {
+            close(fd);
+        }
+
+        mean_us = result[0];
+        max_us = result[1];
+        std::cout << config.name() << ", SWMR latency: mean " << mean_us
+                  << " us, max " << max_us << " us" << std::endl;
+    }
+
+    std::string id() override {
+        return "SWMR";
+    }
+
+private:
+    static double now_ns() {
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    // runs in the child: time between the write of a block and its arrival
+    void read_latencies(const std::string &path, size_t N, int in, int out) {
+        const size_t sdim = config.singleton_dimension();
+        double sum = 0.0, max = 0.0;
+        try {
+            char ready;
+            if (read(in, &ready, 1) != 1) {
+                return;
+            }
+            nix::File file = nix::File::open(path, nix::FileMode::SWMRRead);
+            nix::DataArray da = file.getBlock("live").getDataArray("signal");
+            if (write(out, &ready, 1) != 1) {
+                return;
+            }
+
+            nix::NDSize pos(config.size().size(), 0), one(config.size().size(), 1);
+            size_t seen = 0;
+            while (seen < N) {
+                nix::NDSize extent = da.dataExtent();
+                if (extent[sdim] == seen) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                for (; seen < extent[sdim]; seen++) {
+                    double stamp;
+                    pos[sdim] = seen;
+                    da.getData(nix::DataType::Double, &stamp, one, pos);
+                    double latency = (now_ns() - stamp) / 1000.0;
+                    sum += latency;
+                    max = std::max(max, latency);
+                }
+            }
+        } catch (...) { }
+
+        double result[2] = {sum / N, max};
+        if (write(out, result, sizeof(result)) != sizeof(result)) {
+            return;
+        }
+    }
+
+    double mean_us;
+    double max_us;
+};
+
+#endif
+
 /* ************************************ */
 
 static std::vector<Config> make_configs() {
@@ -579,6 +1268,15 @@ int main(int argc, char **argv)
         marks.push_back(benchmark);
     }
 
+    std::cout << "Performing chunk write tests (setData/direct)..." << std::endl;
+    for (const Config &cfg : configs) {
+        for (bool direct : {false, true}) {
+            ChunkWriteBenchmark *benchmark = new ChunkWriteBenchmark(cfg, direct);
+            benchmark->run(block);
+            marks.push_back(benchmark);
+        }
+    }
+
     std::cout << "Performing read tests..." << std::endl;
     for (const Config &cfg : configs) {
         ReadBenchmark *benchmark = new ReadBenchmark(cfg);
@@ -593,6 +1291,82 @@ int main(int argc, char **argv)
         marks.push_back(benchmark);
     }
 
+    std::cout << "Performing parallel read tests..." << std::endl;
+    const std::vector<size_t> thread_counts = {1, 2, 4, 8};
+    for (const Config &cfg : configs) {
+        ParallelReadBenchmark::prepare(block, cfg, thread_counts.back());
+    }
+    fd.close();
+    fd = nix::File::open("iospeed.h5", nix::FileMode::ReadOnly);
+    block = fd.getBlock("speed");
+    for (size_t n_threads : thread_counts) {
+        for (const Config &cfg : configs) {
+            ParallelReadBenchmark *benchmark = new ParallelReadBenchmark(cfg, n_threads);
+            benchmark->run(block);
+            marks.push_back(benchmark);
+        }
+    }
+
+    std::cout << "Performing scan tests (sync/prefetch)..." << std::endl;
+    for (const Config &cfg : configs) {
+        for (bool prefetch : {false, true}) {
+            ScanBenchmark *benchmark = new ScanBenchmark(cfg, prefetch);
+            benchmark->run(block);
+            marks.push_back(benchmark);
+        }
+    }
+
+    std::cout << "Performing metadata traversal tests (read-only/read-write)..." << std::endl;
+    TraversalBenchmark::prepare(20, 250);
+    for (nix::FileMode mode : {nix::FileMode::ReadOnly, nix::FileMode::ReadWrite}) {
+        TraversalBenchmark *benchmark = new TraversalBenchmark(configs[0], mode);
+        benchmark->run(block);
+        marks.push_back(benchmark);
+    }
+
+    std::cout << "Performing entity creation tests (single/batch)..." << std::endl;
+    for (bool batched : {false, true}) {
+        CreationBenchmark *benchmark = new CreationBenchmark(configs[0], batched);
+        benchmark->run(block);
+        marks.push_back(benchmark);
+    }
+
+    std::cout << "Performing id and time stamp tests (boost/library)..." << std::endl;
+    for (bool timestamps : {false, true}) {
+        for (size_t n_threads : {1, 4}) {
+            for (bool legacy : {true, false}) {
+                IdentityBenchmark *benchmark = new IdentityBenchmark(configs[0], timestamps, legacy, n_threads);
+                benchmark->run(block);
+                marks.push_back(benchmark);
+            }
+        }
+    }
+
+    std::cout << "Performing interval query tests (scan/index)..." << std::endl;
+    IntervalQueryBenchmark::prepare(1000000);
+    for (bool indexed : {false, true}) {
+        IntervalQueryBenchmark *benchmark = new IntervalQueryBenchmark(configs[0], indexed);
+        benchmark->run(block);
+        marks.push_back(benchmark);
+    }
+
+    std::cout << "Performing overview tests (raw/pyramid)..." << std::endl;
+    OverviewBenchmark::prepare(20000000);
+    for (bool pyramid : {false, true}) {
+        OverviewBenchmark *benchmark = new OverviewBenchmark(configs[0], pyramid);
+        benchmark->run(block);
+        marks.push_back(benchmark);
+    }
+
+#ifndef _WIN32
+    std::cout << "Performing SWMR latency tests..." << std::endl;
+    for (const Config &cfg : configs) {
+        SWMRLatencyBenchmark *benchmark = new SWMRLatencyBenchmark(cfg);
+        benchmark->run(block);
+        marks.push_back(benchmark);
+    }
+#endif
+
     std::cout << " === Reports ===" << std::endl;
     std::cout.precision(5);
     std::cout.unsetf (std::ios::floatfield);
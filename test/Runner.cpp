@@ -57,6 +57,25 @@
 #include "fs/TestDimensionFS.hpp"
 #endif
 
+#ifdef ENABLE_MEM_BACKEND
+#include "mem/TestFileMem.hpp"
+#include "mem/TestBlockMem.hpp"
+#include "mem/TestEntityMem.hpp"
+#include "mem/TestEntityWithMetadataMem.hpp"
+#include "mem/TestEntityWithSourcesMem.hpp"
+#include "mem/TestFeatureMem.hpp"
+#include "mem/TestGroupMem.hpp"
+#include "mem/TestMultiTagMem.hpp"
+#include "mem/TestPropertyMem.hpp"
+#include "mem/TestDataArrayMem.hpp"
+#include "mem/TestDataAccessMem.hpp"
+#include "mem/TestSectionMem.hpp"
+#include "mem/TestSourceMem.hpp"
+#include "mem/TestTagMem.hpp"
+#include "mem/TestBaseTagMem.hpp"
+#include "mem/TestDimensionMem.hpp"
+#endif
+
 int main(int argc, char* argv[]) {
     CPPUNIT_TEST_SUITE_REGISTRATION(TestH5);
     CPPUNIT_TEST_SUITE_REGISTRATION(TestEntityHDF5);
@@ -107,6 +126,25 @@ int main(int argc, char* argv[]) {
     CPPUNIT_TEST_SUITE_REGISTRATION(TestDimensionFS);
 #endif
 
+#ifdef ENABLE_MEM_BACKEND
+    CPPUNIT_TEST_SUITE_REGISTRATION(TestFileMem);
+    CPPUNIT_TEST_SUITE_REGISTRATION(TestBlockMem);
+    CPPUNIT_TEST_SUITE_REGISTRATION(TestEntityMem);
+    CPPUNIT_TEST_SUITE_REGISTRATION(TestEntityWithMetadataMem);
+    CPPUNIT_TEST_SUITE_REGISTRATION(TestEntityWithSourcesMem);
+    CPPUNIT_TEST_SUITE_REGISTRATION(TestFeatureMem);
+    CPPUNIT_TEST_SUITE_REGISTRATION(TestGroupMem);
+    CPPUNIT_TEST_SUITE_REGISTRATION(TestMultiTagMem);
+    CPPUNIT_TEST_SUITE_REGISTRATION(TestPropertyMem);
+    CPPUNIT_TEST_SUITE_REGISTRATION(TestDataArrayMem);
+    CPPUNIT_TEST_SUITE_REGISTRATION(TestDataAccessMem);
+    CPPUNIT_TEST_SUITE_REGISTRATION(TestSectionMem);
+    CPPUNIT_TEST_SUITE_REGISTRATION(TestSourceMem);
+    CPPUNIT_TEST_SUITE_REGISTRATION(TestTagMem);
+    CPPUNIT_TEST_SUITE_REGISTRATION(TestBaseTagMem);
+    CPPUNIT_TEST_SUITE_REGISTRATION(TestDimensionMem);
+#endif
+
     CPPUNIT_NS::TestResult testresult;
     CPPUNIT_NS::TestResultCollector collectedresults;
     testresult.addListener(&collectedresults);
@@ -9,6 +9,9 @@
 #include "TestNDArray.hpp"
 
 #include <nix/NDArray.hpp>
+#include <nix/Buffer.hpp>
+
+#include <cstdint>
 
 void TestNDArray::setUp() {
 }
@@ -45,5 +48,34 @@ void TestNDArray::basic() {
 
 }
 
+void TestNDArray::buffer() {
+    nix::Buffer<double> buf(1000);
+    CPPUNIT_ASSERT_EQUAL(static_cast<uintptr_t>(0), reinterpret_cast<uintptr_t>(buf.data()) % 64);
+    buf.resize(100000);
+    CPPUNIT_ASSERT_EQUAL(static_cast<uintptr_t>(0), reinterpret_cast<uintptr_t>(buf.data()) % 64);
+
+    // explicit values are still honoured
+    nix::Buffer<int> ones(10, 1);
+    CPPUNIT_ASSERT_EQUAL(1, ones[9]);
+
+    nix::Buffer<char> bytes(3);
+    CPPUNIT_ASSERT(nix::data_traits<nix::Buffer<char>>::data_type(bytes) == nix::DataType::Char);
+    nix::data_traits<nix::Buffer<char>>::resize(bytes, nix::NDSize({1, 7}));
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(7), bytes.size());
+
+    nix::NDArray zeros(nix::DataType::Int32, nix::NDSize({4, 4}));
+    CPPUNIT_ASSERT_EQUAL(static_cast<uintptr_t>(0), reinterpret_cast<uintptr_t>(zeros.data()) % 64);
+    for (size_t i = 0; i < 16; i++) {
+        CPPUNIT_ASSERT_EQUAL(0, zeros.get<int32_t>(i));
+    }
+    zeros.resize(nix::NDSize({8, 4}));
+    CPPUNIT_ASSERT_EQUAL(0, zeros.get<int32_t>(31));
+
+    nix::NDArray raw(nix::DataType::Double, nix::NDSize({2, 3}), false);
+    CPPUNIT_ASSERT(raw.shape() == nix::NDSize({2, 3}));
+    raw.set<double>(5, 1.5);
+    CPPUNIT_ASSERT_EQUAL(1.5, raw.get<double>(nix::NDSize({1, 2})));
+}
+
 void TestNDArray::tearDown() {
 }
@@ -9,7 +9,10 @@
 #include "TestUtil.hpp"
 
 #include <ctime>
+#include <cctype>
 #include <cmath>
+#include <set>
+#include <thread>
 
 
 using namespace std;
@@ -199,3 +202,50 @@ void TestUtil::testStringVectors() {
     CPPUNIT_ASSERT(util::isSetAtSamePos(vec_a, vec_c));
     CPPUNIT_ASSERT(!util::isSetAtSamePos(vec_a, vec_d));
 }
+
+void TestUtil::testCreateId() {
+    std::vector<std::vector<std::string>> ids(4);
+    std::vector<std::thread> threads;
+    for (auto &out : ids) {
+        threads.emplace_back([&out] {
+            for (int i = 0; i < 1000; i++) {
+                out.push_back(util::createId());
+            }
+        });
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+
+    std::set<std::string> all;
+    for (const auto &out : ids) {
+        for (const std::string &id : out) {
+            CPPUNIT_ASSERT_EQUAL(size_t(36), id.size());
+            for (size_t i = 0; i < id.size(); i++) {
+                if (i == 8 || i == 13 || i == 18 || i == 23) {
+                    CPPUNIT_ASSERT_EQUAL('-', id[i]);
+                } else {
+                    CPPUNIT_ASSERT(std::isxdigit(id[i]) && !std::isupper(id[i]));
+                }
+            }
+            CPPUNIT_ASSERT_EQUAL('4', id[14]);
+            CPPUNIT_ASSERT(std::string("89ab").find(id[19]) != std::string::npos);
+            all.insert(id);
+        }
+    }
+    CPPUNIT_ASSERT_EQUAL(size_t(4000), all.size());
+}
+
+void TestUtil::testTimeToStr() {
+    CPPUNIT_ASSERT_EQUAL(string("19700101T000000"), util::timeToStr(0));
+    CPPUNIT_ASSERT_EQUAL(string("19691231T235959"), util::timeToStr(-1));
+    CPPUNIT_ASSERT_EQUAL(string("20000229T000000"), util::timeToStr(951782400));
+    CPPUNIT_ASSERT_EQUAL(string("20140101T120000"), util::timeToStr(1388577600));
+    // repeated calls are served from the cache
+    CPPUNIT_ASSERT_EQUAL(string("20140101T120000"), util::timeToStr(1388577600));
+    CPPUNIT_ASSERT_EQUAL(string("20140101T120001"), util::timeToStr(1388577601));
+
+    for (time_t t = -2000000000; t < 4000000000; t += 7654321) {
+        CPPUNIT_ASSERT_EQUAL(t, util::strToTime(util::timeToStr(t)));
+    }
+}
@@ -41,6 +41,8 @@ private:
     CPPUNIT_TEST(testDimTypeToStr);
     CPPUNIT_TEST(testChecks);
     CPPUNIT_TEST(testStringVectors);
+    CPPUNIT_TEST(testCreateId);
+    CPPUNIT_TEST(testTimeToStr);
     CPPUNIT_TEST_SUITE_END ();
 
 public:
@@ -59,5 +61,7 @@ public:
     void testDimTypeToStr();
     void testChecks();
     void testStringVectors();
+    void testCreateId();
+    void testTimeToStr();
 };
 
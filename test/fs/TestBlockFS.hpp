@@ -23,6 +23,8 @@ class TestBlockFS : public BaseTestBlock {
     CPPUNIT_TEST(testMetadataAccess);
     CPPUNIT_TEST(testSourceAccess);
     CPPUNIT_TEST(testDataArrayAccess);
+    // CPPUNIT_TEST(testDeleteDataArrays);
+    // CPPUNIT_TEST(testBatch);
     CPPUNIT_TEST(testTagAccess);
     CPPUNIT_TEST(testMultiTagAccess);
     CPPUNIT_TEST(testGroupAccess);
@@ -26,6 +26,7 @@ class TestDataArrayFS : public BaseTestDataArray {
     CPPUNIT_TEST(testAliasRangeDimension);
     CPPUNIT_TEST(testOperator);
     CPPUNIT_TEST(testValidate);
+    CPPUNIT_TEST(testReader);
     CPPUNIT_TEST_SUITE_END ();
 
 public:
@@ -58,10 +59,6 @@ public:
         file.close();
     }
 
-    void testData() {
-        // TODO data is not implemented yet
-    }
-
     void testPolynomial() {
         // TODO
     }
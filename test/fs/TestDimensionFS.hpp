@@ -29,6 +29,7 @@ class TestDimensionFS : public BaseTestDimension {
     CPPUNIT_TEST(testSampledDimPositionAt);
     CPPUNIT_TEST(testSampledDimAxis);
     // CPPUNIT_TEST(testSetDimLabels);
+    // CPPUNIT_TEST(testSetDimIndexOf);
     CPPUNIT_TEST(testRangeDimLabel);
     CPPUNIT_TEST(testRangeDimUnit);
     // CPPUNIT_TEST(testRangeTicks);
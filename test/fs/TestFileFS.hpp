@@ -23,6 +23,9 @@ class TestFileFS: public BaseTestFile {
     CPPUNIT_TEST(testUpdatedAt);
     CPPUNIT_TEST(testBlockAccess);
     CPPUNIT_TEST(testSectionAccess);
+    CPPUNIT_TEST(testMetadataSnapshot);
+    CPPUNIT_TEST(testStorageReport);
+    CPPUNIT_TEST(testCopyFile);
     CPPUNIT_TEST(testOperators);
     CPPUNIT_TEST(testReopen);
     CPPUNIT_TEST(testCheckHeader);
@@ -24,6 +24,7 @@ class TestMultiTagFS : public BaseTestMultiTag {
     CPPUNIT_TEST(testUnits);
     CPPUNIT_TEST(testPositions);
     CPPUNIT_TEST(testPositionExtents);
+    //CPPUNIT_TEST(testIntervalQueries);
     CPPUNIT_TEST(testReferences);
     CPPUNIT_TEST(testFeatures);
     CPPUNIT_TEST(testDataAccess);
@@ -13,6 +13,9 @@
 
 #include "BaseTestDataArray.hpp"
 
+#include "hdf5/DataArrayHDF5.hpp"
+#include "hdf5/h5x/H5DataType.hpp"
+
 class TestDataArrayHDF5 : public BaseTestDataArray {
 
     CPPUNIT_TEST_SUITE(TestDataArrayHDF5);
@@ -26,8 +29,18 @@ class TestDataArrayHDF5 : public BaseTestDataArray {
     CPPUNIT_TEST(testUnit);
     CPPUNIT_TEST(testDimension);
     CPPUNIT_TEST(testAliasRangeDimension);
+    CPPUNIT_TEST(testDimensionDescriptors);
     CPPUNIT_TEST(testOperator);
     CPPUNIT_TEST(testValidate);
+    CPPUNIT_TEST(testReader);
+    CPPUNIT_TEST(testConcurrentRead);
+    CPPUNIT_TEST(testMapData);
+    CPPUNIT_TEST(testMapContiguous);
+#if H5_VERSION_GE(1, 10, 5)
+    CPPUNIT_TEST(testChunkIO);
+#endif
+    CPPUNIT_TEST(testOverview);
+    CPPUNIT_TEST(testSliceByPosition);
     CPPUNIT_TEST_SUITE_END ();
 
 public:
@@ -60,6 +73,47 @@ public:
         file.close();
     }
 
+    void testMapContiguous() {
+        const nix::NDSize extent({40, 3});
+        std::vector<double> values(extent.nelms());
+        for (size_t i = 0; i < values.size(); i++) {
+            values[i] = 0.5 * i;
+        }
+
+        // data arrays are chunked by default and fall back to a copy
+        nix::DataArray da = block.createDataArray("contiguous", "double", nix::DataType::Double, extent);
+        da.setData(nix::DataType::Double, values.data(), extent, {0, 0});
+        CPPUNIT_ASSERT(!da.mapData().isMapped());
+
+        // replace the data set by a contiguous one
+        auto impl = std::dynamic_pointer_cast<nix::hdf5::DataArrayHDF5>(da.impl());
+        nix::hdf5::H5Group g = impl->group();
+        g.removeData("data");
+        g.createData("data", nix::hdf5::data_type_to_h5_filetype(nix::DataType::Double), extent,
+                     {}, {}, false, false);
+        da.setData(nix::DataType::Double, values.data(), extent, {0, 0});
+
+        nix::MappedData view = da.mapData();
+        CPPUNIT_ASSERT(view.isMapped());
+        CPPUNIT_ASSERT_EQUAL(extent, view.shape());
+        const double *data = view.as<double>();
+        for (size_t i = 0; i < values.size(); i++) {
+            CPPUNIT_ASSERT_EQUAL(values[i], data[i]);
+        }
+
+        // a read-only file maps as well and the view survives closing it
+        std::string location = file.location();
+        std::string block_id = block.id();
+        file.close();
+        file = nix::File::open(location, nix::FileMode::ReadOnly);
+        nix::MappedData ro_view = file.getBlock(block_id).getDataArray("contiguous").mapData();
+        CPPUNIT_ASSERT(ro_view.isMapped());
+        file.close();
+        CPPUNIT_ASSERT_EQUAL(values[7 * 3 + 2], ro_view.at<double>({7, 2}));
+        CPPUNIT_ASSERT_EQUAL(values.back(), view.at<double>({39, 2}));
+        file = nix::File::open(location, nix::FileMode::ReadWrite);
+    }
+
 };
 
 #endif //NIX_TESTDATAARRAYHDF5_HPP
@@ -15,8 +15,18 @@
 #include "hdf5/FileHDF5.hpp"
 
 #include <sstream>
+#include <fstream>
+#include <cstdio>
+#include <chrono>
+#include <thread>
 #include <nix/util/util.hpp>
 
+#ifndef _WIN32
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
 namespace h5x = nix::hdf5;
 
 static std::string make_file_with_version(int x, int y, int z) {
@@ -89,3 +99,174 @@ void TestFileHDF5::testVersion() {
     ASSERT_NOOPEN(mbc.c_str(), nix::FileMode::ReadWrite);
     ASSERT_NOOPEN(mbc.c_str(), nix::FileMode::ReadOnly);
 }
+
+
+#ifndef _WIN32
+
+// reader process of testSWMR, returns the exit code of the process
+static int swmr_reader(const std::string &name, const std::string &ready, nix::ndsize_t rows, nix::ndsize_t cols) {
+    using clock = std::chrono::steady_clock;
+    const clock::time_point deadline = clock::now() + std::chrono::seconds(30);
+
+    try {
+        while (!std::ifstream(ready)) {
+            if (clock::now() > deadline) {
+                return 2;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        nix::File f = nix::File::open(name, nix::FileMode::SWMRRead);
+        nix::DataArray da = f.getBlock("live").getDataArray("signal");
+
+        nix::ndsize_t seen = 0;
+        while (seen < rows) {
+            if (clock::now() > deadline) {
+                return 3;
+            }
+
+            nix::ndsize_t extent = da.dataExtent()[0];
+            if (extent == seen) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                continue;
+            }
+
+            std::vector<double> values((extent - seen) * cols);
+            nix::NDSize count(2, cols), offset(2, 0);
+            count[0] = extent - seen;
+            offset[0] = seen;
+            da.getData(nix::DataType::Double, values.data(), count, offset);
+            for (size_t i = 0; i < values.size(); i++) {
+                if (values[i] != static_cast<double>(seen * cols + i)) {
+                    return 4;
+                }
+            }
+            seen = extent;
+        }
+
+        f.close();
+    } catch (...) {
+        return 1;
+    }
+
+    return 0;
+}
+
+#endif
+
+
+void TestFileHDF5::testSWMR() {
+    CPPUNIT_ASSERT_THROW(file_open.startSWMRWrite(), std::logic_error);
+    CPPUNIT_ASSERT_THROW(file_open.flushInterval(-1.0), std::invalid_argument);
+    CPPUNIT_ASSERT_EQUAL(0.0, file_open.flushInterval());
+
+#ifndef _WIN32
+    const std::string name = "test_file_swmr.h5";
+    const std::string ready = name + ".ready";
+    const nix::ndsize_t rows = 40, cols = 3;
+    std::remove(name.c_str());
+    std::remove(ready.c_str());
+
+    pid_t pid = fork();
+    CPPUNIT_ASSERT(pid >= 0);
+    if (pid == 0) {
+        _exit(swmr_reader(name, ready, rows, cols));
+    }
+
+    // do not leave the reader waiting if an assertion fails
+    struct Reaper {
+        pid_t pid;
+        ~Reaper() {
+            if (pid > 0) {
+                kill(pid, SIGKILL);
+                waitpid(pid, nullptr, 0);
+            }
+        }
+    } reaper{pid};
+
+    nix::File f = nix::File::open(name, nix::FileMode::SWMRWrite);
+    CPPUNIT_ASSERT(f.fileMode() == nix::FileMode::SWMRWrite);
+    nix::Block b = f.createBlock("live", "recording");
+    nix::NDSize shape(2, cols);
+    shape[0] = 0;
+    nix::DataArray da = b.createDataArray("signal", "double", nix::DataType::Double, shape);
+    da.appendSampledDimension(0.001);
+    da.appendSetDimension();
+
+    f.startSWMRWrite();
+    f.startSWMRWrite();
+
+    // the structure is fixed now
+    CPPUNIT_ASSERT_THROW(f.createBlock("other", "recording"), std::logic_error);
+    CPPUNIT_ASSERT_THROW(b.createDataArray("other", "double", nix::DataType::Double, {1}), std::logic_error);
+    CPPUNIT_ASSERT_THROW(da.unit("mV"), std::logic_error);
+
+    std::ofstream(ready).put('1');
+    std::vector<double> row(cols);
+    nix::NDSize row_shape(2, cols);
+    row_shape[0] = 1;
+    for (nix::ndsize_t r = 0; r < rows; r++) {
+        for (nix::ndsize_t c = 0; c < cols; c++) {
+            row[c] = static_cast<double>(r * cols + c);
+        }
+        da.appendData(nix::DataType::Double, row.data(), row_shape, 0);
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+
+    int status = 0;
+    waitpid(pid, &status, 0);
+    reaper.pid = 0;
+    da = nix::none;
+    b = nix::none;
+    f.close();
+    std::remove(ready.c_str());
+
+    CPPUNIT_ASSERT(WIFEXITED(status));
+    CPPUNIT_ASSERT_EQUAL(0, WEXITSTATUS(status));
+
+    // an existing file is opened for SWMR writing right away
+    f = nix::File::open(name, nix::FileMode::SWMRWrite);
+    da = f.getBlock("live").getDataArray("signal");
+    nix::NDSize extent = da.dataExtent();
+    CPPUNIT_ASSERT_EQUAL(rows, extent[0]);
+    CPPUNIT_ASSERT_THROW(f.createBlock("other", "recording"), std::logic_error);
+    f.close();
+#endif
+}
+
+
+void TestFileHDF5::testReadOnlyNoWrites() {
+    const std::string name = "test_file_read_only.h5";
+    nix::File f = nix::File::open(name, nix::FileMode::Overwrite);
+    nix::Block b = f.createBlock("block", "test");
+    nix::DataArray da = b.createDataArray("array", "test", nix::DataType::Double, {4});
+    da.appendSampledDimension(1.0);
+    f.close();
+
+    // entities without the bookkeeping attributes can only be opened
+    // if no attempt is made to (re-)create them
+    h5x::H5Object file = H5Fopen(name.c_str(), H5F_ACC_RDWR, H5P_DEFAULT);
+    file.check("Could not open plain h5 file");
+    h5x::H5Group root = H5Gopen(file.h5id(), "/", H5P_DEFAULT);
+    root.check("Could not open root group");
+    h5x::H5Group block = root.openGroup("data", false).openGroup("block", false);
+    h5x::H5Group array = block.openGroup("data_arrays", false).openGroup("array", false);
+    for (const h5x::H5Group &g : {root, block, array}) {
+        g.removeAttr("updated_at");
+    }
+    array.close();
+    block.close();
+    root.close();
+    file.close();
+
+    f = nix::File::open(name, nix::FileMode::ReadOnly);
+    for (const nix::Block &blk : f.blocks()) {
+        for (const nix::DataArray &a : blk.dataArrays()) {
+            CPPUNIT_ASSERT_EQUAL(nix::ndsize_t(1), a.dimensionCount());
+            CPPUNIT_ASSERT(a.getDimension(1).dimensionType() == nix::DimensionType::Sample);
+        }
+    }
+    // nothing was written back
+    CPPUNIT_ASSERT_THROW(static_cast<void>(f.updatedAt()), std::exception);
+    f.close();
+}
@@ -7,6 +7,8 @@
 
 #include "BaseTestFile.hpp"
 
+#include "hdf5/FileHDF5.hpp"
+
 class TestFileHDF5: public BaseTestFile {
 
     CPPUNIT_TEST_SUITE(TestFileHDF5);
@@ -20,14 +22,26 @@ class TestFileHDF5: public BaseTestFile {
     CPPUNIT_TEST(testUpdatedAt);
     CPPUNIT_TEST(testBlockAccess);
     CPPUNIT_TEST(testSectionAccess);
+    CPPUNIT_TEST(testMetadataSnapshot);
+    CPPUNIT_TEST(testMetadataSnapshotValues);
+    CPPUNIT_TEST(testStorageReport);
+    CPPUNIT_TEST(testCopyFile);
     CPPUNIT_TEST(testOperators);
     CPPUNIT_TEST(testReopen);
+#if H5_VERSION_GE(1, 10, 0)
+    CPPUNIT_TEST(testSWMR);
+#endif
+    CPPUNIT_TEST(testReadOnlyNoWrites);
     CPPUNIT_TEST_SUITE_END ();
 
 public:
 
     void testVersion() override;
 
+    void testSWMR();
+
+    void testReadOnlyNoWrites();
+
     void setUp() override {
         startup_time = time(NULL);
         file_open = nix::File::open("test_file.h5", nix::FileMode::Overwrite);
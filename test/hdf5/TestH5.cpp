@@ -229,6 +229,15 @@ void TestH5::testDataType() {
     }
     CPPUNIT_ASSERT_EQUAL(0, H5Iget_ref(H5T_NATIVE_DOUBLE));
 
+    // the types for the NIX data types are shared and read-only
+    const h5x::DataType &mem_dbl = nix::hdf5::data_type_to_h5_memtype(nix::DataType::Double);
+    CPPUNIT_ASSERT_EQUAL(mem_dbl.h5id(), nix::hdf5::data_type_to_h5_memtype(nix::DataType::Double).h5id());
+    CPPUNIT_ASSERT(H5Tequal(mem_dbl.h5id(), H5T_NATIVE_DOUBLE) > 0);
+    h5x::DataType file_str = nix::hdf5::data_type_to_h5_filetype(nix::DataType::String);
+    CPPUNIT_ASSERT_EQUAL(true, file_str.isVariableString());
+    CPPUNIT_ASSERT_THROW(file_str.size(42), nix::hdf5::H5Exception);
+    CPPUNIT_ASSERT_THROW(nix::hdf5::data_type_to_h5_memtype(nix::DataType::Nothing), std::invalid_argument);
+
 
     // enum test
     //  enum type int bool
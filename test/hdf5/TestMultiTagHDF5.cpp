@@ -0,0 +1,62 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/hydra/multiArray.hpp>
+
+#include "TestMultiTagHDF5.hpp"
+
+#include "hdf5/FileHDF5.hpp"
+
+#include <cstdio>
+
+// appends and overwrites during SWMR writing keep the data version of the positions
+// (SWMR writing needs HDF5 1.10, with older versions there is nothing to test)
+void TestMultiTagHDF5::testIntervalIndexAppend() {
+#if H5_VERSION_GE(1, 10, 0)
+    const std::string name = "test_multiTag_append.h5";
+    const nix::NDSize one({1});
+    std::remove(name.c_str());
+    {
+        nix::File f = nix::File::open(name, nix::FileMode::SWMRWrite);
+        nix::Block b = f.createBlock("live", "recording");
+        nix::DataArray p = b.createDataArray("events", "event", nix::DataType::Double, {0});
+        b.createMultiTag("events", "event", p);
+        f.close();
+    }
+    {
+        nix::File f = nix::File::open(name, nix::FileMode::ReadWrite);
+        nix::Block b = f.getBlock("live");
+        nix::DataArray p = b.getDataArray("events");
+        for (double t : {1.0, 2.0, 3.0}) {
+            p.appendData(nix::DataType::Double, &t, one, 0);
+        }
+        // stores the index
+        CPPUNIT_ASSERT_EQUAL(size_t(3), b.getMultiTag("events").positionsInRange(0, 10).size());
+        f.close();
+    }
+
+    nix::File f = nix::File::open(name, nix::FileMode::SWMRWrite);
+    nix::Block b = f.getBlock("live");
+    nix::DataArray p = b.getDataArray("events");
+    for (double t : {4.0, 5.0}) {
+        p.appendData(nix::DataType::Double, &t, one, 0);
+    }
+    nix::MultiTag mt = b.getMultiTag("events");
+    CPPUNIT_ASSERT_EQUAL(size_t(5), mt.positionsInRange(0, 10).size());
+    CPPUNIT_ASSERT_EQUAL(size_t(2), mt.positionsInRange(3.5, 10).size());
+
+    // overwritten in place, the cached index is rebuilt
+    double moved = 7.0;
+    p.setData(nix::DataType::Double, &moved, one, {0});
+    std::vector<nix::ndsize_t> found = mt.positionsInRange(6.5, 10);
+    CPPUNIT_ASSERT(found.size() == 1 && found[0] == 0);
+    CPPUNIT_ASSERT_EQUAL(size_t(3), b.getMultiTag("events").positionsInRange(3.5, 10).size());
+    f.close();
+    std::remove(name.c_str());
+#endif
+}
@@ -24,6 +24,8 @@ class TestMultiTagHDF5 : public BaseTestMultiTag {
     CPPUNIT_TEST(testUnits);
     CPPUNIT_TEST(testPositions);
     CPPUNIT_TEST(testPositionExtents);
+    CPPUNIT_TEST(testIntervalQueries);
+    CPPUNIT_TEST(testIntervalIndexAppend);
     CPPUNIT_TEST(testReferences);
     CPPUNIT_TEST(testFeatures);
     CPPUNIT_TEST(testDataAccess);
@@ -76,6 +78,8 @@ public:
         file.deleteSection(section.id());
         file.close();
     }
+
+    void testIntervalIndexAppend();
 };
 
 
@@ -27,6 +27,8 @@ class TestTagHDF5 : public BaseTestTag {
     CPPUNIT_TEST(testSourceAccess);
     CPPUNIT_TEST(testUnits);
     CPPUNIT_TEST(testReferences);
+    CPPUNIT_TEST(testAddReferences);
+    CPPUNIT_TEST(testAddReferencesFromCopy);
     CPPUNIT_TEST(testFeatures);
     CPPUNIT_TEST(testCreatedAt);
     CPPUNIT_TEST(testUpdatedAt);
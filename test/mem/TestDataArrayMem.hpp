@@ -0,0 +1,120 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_TESTDATAARRAYMEM_HPP
+#define NIX_TESTDATAARRAYMEM_HPP
+
+#include "BaseTestDataArray.hpp"
+
+class TestDataArrayMem : public BaseTestDataArray {
+
+    CPPUNIT_TEST_SUITE(TestDataArrayMem);
+    CPPUNIT_TEST(testId);
+    CPPUNIT_TEST(testType);
+    CPPUNIT_TEST(testName);
+    CPPUNIT_TEST(testDefinition);
+    CPPUNIT_TEST(testData);
+    CPPUNIT_TEST(testPolynomial);
+    CPPUNIT_TEST(testLabel);
+    CPPUNIT_TEST(testUnit);
+    CPPUNIT_TEST(testDimension);
+    CPPUNIT_TEST(testAliasRangeDimension);
+    CPPUNIT_TEST(testDimensionDescriptors);
+    CPPUNIT_TEST(testOperator);
+    CPPUNIT_TEST(testValidate);
+    CPPUNIT_TEST(testReader);
+    CPPUNIT_TEST(testMapData);
+    CPPUNIT_TEST(testResize);
+    CPPUNIT_TEST(testOverview);
+    CPPUNIT_TEST(testSliceByPosition);
+    CPPUNIT_TEST_SUITE_END ();
+
+public:
+    void setUp() {
+        startup_time = time(NULL);
+        file = nix::File::open("test_DataArray", nix::FileMode::Overwrite, "memory");
+
+        block = file.createBlock("block_one", "dataset");
+        array1 = block.createDataArray("array_one",
+                                       "testdata",
+                                       nix::DataType::Double,
+                                       nix::NDSize({ 0, 0, 0 }));
+        array2 = block.createDataArray("random",
+                                       "double",
+                                       nix::DataType::Double,
+                                       nix::NDSize({ 20, 20 }));
+        array3 = block.createDataArray("one_d",
+                                       "double",
+                                       nix::DataType::Double,
+                                       nix::NDSize({ 20 }));
+        std::vector<double> t;
+        for (size_t i = 0; i < 20; i++)
+            t.push_back(1.3 * i);
+        array3.setData(nix::DataType::Double, t.data(), nix::NDSize({ 20 }), nix::NDSize({ 0 }));
+        array3.label("label");
+        array3.unit("Hz");
+    }
+
+    void tearDown() {
+        file.close();
+    }
+
+    void testMapData() {
+        const nix::NDSize extent({6, 5});
+        std::vector<int32_t> values(extent.nelms());
+        for (size_t i = 0; i < values.size(); i++) {
+            values[i] = static_cast<int32_t>(i * 3);
+        }
+        nix::DataArray da = block.createDataArray("mapped", "int", nix::DataType::Int32, extent);
+        da.setData(nix::DataType::Int32, values.data(), extent, {0, 0});
+
+        // the view points to the data of the file itself
+        nix::MappedData view = da.mapData();
+        CPPUNIT_ASSERT(view.isMapped());
+        CPPUNIT_ASSERT_EQUAL(extent, view.shape());
+        CPPUNIT_ASSERT_EQUAL(values[2 * 5 + 3], view.at<int32_t>({2, 3}));
+
+        int32_t x = 42;
+        da.setData(nix::DataType::Int32, &x, {1, 1}, {2, 3});
+        CPPUNIT_ASSERT_EQUAL(x, view.at<int32_t>({2, 3}));
+
+        // and outlives the file
+        file.close();
+        CPPUNIT_ASSERT_EQUAL(values.back(), view.at<int32_t>({5, 4}));
+        file = nix::File::open("test_DataArray", nix::FileMode::Overwrite, "memory");
+        block = file.createBlock("block_one", "dataset");
+
+        nix::DataArray strings = block.createDataArray("strings", "string", nix::DataType::String, {2});
+        CPPUNIT_ASSERT_THROW(strings.mapData(), std::invalid_argument);
+        CPPUNIT_ASSERT_THROW(strings.writeChunk({0}, nullptr, 0), std::runtime_error);
+    }
+
+
+    void testResize() {
+        nix::DataArray da = block.createDataArray("growing", "double", nix::DataType::Double, {0, 2});
+        for (size_t i = 0; i < 100; i++) {
+            double row[2] = {static_cast<double>(i), -static_cast<double>(i)};
+            da.appendData(nix::DataType::Double, row, {1, 2}, 0);
+        }
+        CPPUNIT_ASSERT_EQUAL(nix::NDSize({100, 2}), da.dataExtent());
+
+        // shrinking and growing along another axis keeps the overlap
+        da.dataExtent({50, 3});
+        std::vector<double> read(150);
+        da.getData(nix::DataType::Double, read.data(), {50, 3}, {0, 0});
+        for (size_t r = 0; r < 50; r++) {
+            CPPUNIT_ASSERT_EQUAL(static_cast<double>(r), read[r * 3]);
+            CPPUNIT_ASSERT_EQUAL(-static_cast<double>(r), read[r * 3 + 1]);
+            CPPUNIT_ASSERT_EQUAL(0.0, read[r * 3 + 2]);
+        }
+        CPPUNIT_ASSERT_THROW(da.dataExtent({50}), nix::IncompatibleDimensions);
+    }
+
+};
+
+#endif //NIX_TESTDATAARRAYMEM_HPP
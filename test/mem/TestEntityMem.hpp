@@ -0,0 +1,44 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_TESTENTITYMEM_HPP
+#define NIX_TESTENTITYMEM_HPP
+
+#include "BaseTestEntity.hpp"
+
+class TestEntityMem : public BaseTestEntity {
+
+    CPPUNIT_TEST_SUITE(TestEntityMem);
+
+    CPPUNIT_TEST(testId);
+    CPPUNIT_TEST(testType);
+    CPPUNIT_TEST(testName);
+    CPPUNIT_TEST(testDefinition);
+
+    CPPUNIT_TEST(testUpdatedAt);
+    CPPUNIT_TEST(testCreatedAt);
+
+    CPPUNIT_TEST(testIsValidEntity);
+
+    CPPUNIT_TEST_SUITE_END ();
+
+public:
+    void setUp() {
+        startup_time = time(NULL);
+        file = nix::File::open("test_block", nix::FileMode::Overwrite, "memory");
+        block = file.createBlock("block_one", "dataset");
+        block_other = file.createBlock("block_other", "dataset");
+        block_null = nix::none;
+    }
+
+    void tearDown() {
+        file.close();
+    }
+};
+
+#endif //NIX_TESTENTITYMEM_HPP
@@ -0,0 +1,33 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_TESTENTITYWITHMETADATAMEM_HPP
+#define NIX_TESTENTITYWITHMETADATAMEM_HPP
+
+#include "BaseTestEntityWithMetadata.hpp"
+
+class TestEntityWithMetadataMem : public BaseTestEntityWithMetadata {
+
+    CPPUNIT_TEST_SUITE(TestEntityWithMetadataMem);
+    CPPUNIT_TEST(testMetadataAccess);
+    CPPUNIT_TEST_SUITE_END ();
+
+public:
+    void setUp() {
+        file = nix::File::open("test_block", nix::FileMode::Overwrite, "memory");
+        section = file.createSection("foo_section", "metadata");
+        wrong = file.createSection("bar_section", "metadata");
+        block = file.createBlock("block_one", "dataset");
+    }
+
+    void tearDown() {
+        file.close();
+    }
+};
+
+#endif //NIX_TESTENTITYWITHMETADATAMEM_HPP
\ No newline at end of file
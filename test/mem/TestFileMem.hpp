@@ -0,0 +1,159 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_TESTFILEMEM_HPP
+#define NIX_TESTFILEMEM_HPP
+
+#include "BaseTestFile.hpp"
+
+class TestFileMem: public BaseTestFile {
+
+    CPPUNIT_TEST_SUITE(TestFileMem);
+    CPPUNIT_TEST(testOpen);
+    CPPUNIT_TEST(testFlush);
+    CPPUNIT_TEST(testValidate);
+    CPPUNIT_TEST(testFormat);
+    CPPUNIT_TEST(testLocation);
+    CPPUNIT_TEST(testVersion);
+    CPPUNIT_TEST(testCreatedAt);
+    CPPUNIT_TEST(testUpdatedAt);
+    CPPUNIT_TEST(testBlockAccess);
+    CPPUNIT_TEST(testSectionAccess);
+    CPPUNIT_TEST(testMetadataSnapshot);
+    CPPUNIT_TEST(testMetadataSnapshotValues);
+    CPPUNIT_TEST(testStorageReport);
+    CPPUNIT_TEST(testCopyFile);
+    CPPUNIT_TEST(testOperators);
+    CPPUNIT_TEST(testModes);
+    CPPUNIT_TEST(testSaveAs);
+    CPPUNIT_TEST_SUITE_END ();
+
+public:
+
+    void setUp() override {
+        startup_time = time(NULL);
+        file_open = nix::File::open("test_file", nix::FileMode::Overwrite, "memory");
+        file_other = nix::File::open("test_file_other", nix::FileMode::Overwrite, "memory");
+        file_null = nix::none;
+    }
+
+
+    void tearDown() override {
+        file_open.close();
+        file_other.close();
+    }
+
+
+    void testLocation() override {
+        CPPUNIT_ASSERT(file_open.location() == "test_file");
+        CPPUNIT_ASSERT(file_other.location() == "test_file_other");
+    }
+
+
+    void testModes() {
+        CPPUNIT_ASSERT_THROW(nix::File::open("test_file", nix::FileMode::SWMRWrite, "memory"),
+                             std::invalid_argument);
+        CPPUNIT_ASSERT_THROW(file_open.startSWMRWrite(), std::logic_error);
+        CPPUNIT_ASSERT_EQUAL(0.0, file_open.flushInterval());
+
+        nix::Block b = file_open.createBlock("gone", "test");
+        file_open.close();
+        CPPUNIT_ASSERT(!file_open.isOpen());
+        CPPUNIT_ASSERT(!b.isValidEntity());
+    }
+
+
+    void testSaveAs() {
+        nix::Section sec = file_open.createSection("session", "recording");
+        sec.createProperty("rate", nix::Value(1000.0));
+        nix::Section sub = sec.createSection("electrode", "hardware");
+        nix::Section other = file_open.createSection("template", "recording");
+        sub.link(other);
+
+        nix::Block b = file_open.createBlock("trial", "nix.trial");
+        b.metadata(sec);
+        nix::Source src = b.createSource("cell", "neuron");
+        nix::Source child = src.createSource("compartment", "neuron");
+
+        std::vector<double> values(30);
+        for (size_t i = 0; i < values.size(); i++) {
+            values[i] = 0.25 * i;
+        }
+        nix::DataArray da = b.createDataArray("signal", "voltage", nix::DataType::Double, {10, 3});
+        da.setData(nix::DataType::Double, values.data(), {10, 3}, {0, 0});
+        da.unit("mV");
+        da.label("voltage");
+        da.addSource(child);
+        da.appendSampledDimension(0.1).unit("s");
+        da.appendSetDimension().labels({"a", "b", "c"});
+
+        nix::DataArray words = b.createDataArray("words", "text", nix::DataType::String, {2});
+        std::vector<std::string> text = {"hello", "world"};
+        words.setData(nix::DataType::String, text.data(), {2}, {0});
+        words.appendSetDimension();
+
+        nix::DataArray times = b.createDataArray("times", "time", nix::DataType::Double, {4});
+        times.setData(std::vector<double>{0.0, 0.5, 1.0, 2.5});
+        times.appendAliasRangeDimension();
+
+        nix::Tag tag = b.createTag("stimulus", "event", {0.5, 0.0});
+        tag.extent({0.5, 2.0});
+        tag.addReference(da);
+        nix::Feature feat = tag.createFeature(words, nix::LinkType::Indexed);
+
+        nix::MultiTag mtag = b.createMultiTag("spikes", "event", times);
+        mtag.addReference(times);
+        nix::Group g = b.createGroup("selection", "subset");
+        g.addDataArray(da);
+        g.addTag(tag);
+
+        const std::string location = "test_file_mem.h5";
+        file_open.saveAs(location);
+        nix::File h5 = nix::File::open("test_file_mem_b.h5", nix::FileMode::Overwrite);
+        CPPUNIT_ASSERT_THROW(h5.saveAs(location), std::logic_error);
+        h5.close();
+
+        nix::File saved = nix::File::open(location, nix::FileMode::ReadOnly);
+        CPPUNIT_ASSERT(file_open.validate().getErrors().empty());
+        CPPUNIT_ASSERT(saved.validate().getErrors().empty());
+        nix::Block sb = saved.getBlock(b.id());
+        CPPUNIT_ASSERT(sb);
+        CPPUNIT_ASSERT_EQUAL(b.createdAt(), sb.createdAt());
+        CPPUNIT_ASSERT_EQUAL(sec.id(), sb.metadata().id());
+        CPPUNIT_ASSERT_EQUAL(other.id(), saved.getSection(sec.id()).getSection(sub.id()).link().id());
+        CPPUNIT_ASSERT_EQUAL(1000.0, sb.metadata().getProperty("rate").values()[0].get<double>());
+        CPPUNIT_ASSERT(sb.getSource(src.id()).hasSource(child.id()));
+
+        nix::DataArray sda = sb.getDataArray(da.id());
+        CPPUNIT_ASSERT_EQUAL(nix::NDSize({10, 3}), sda.dataExtent());
+        std::vector<double> read(values.size());
+        sda.getData(nix::DataType::Double, read.data(), {10, 3}, {0, 0});
+        CPPUNIT_ASSERT(values == read);
+        CPPUNIT_ASSERT_EQUAL(std::string("mV"), *sda.unit());
+        CPPUNIT_ASSERT(sda.hasSource(child.id()));
+        CPPUNIT_ASSERT_EQUAL(nix::ndsize_t(2), sda.dimensionCount());
+        CPPUNIT_ASSERT_EQUAL(0.1, sda.getDimension(1).asSampledDimension().samplingInterval());
+        CPPUNIT_ASSERT_EQUAL(std::string("c"), sda.getDimension(2).asSetDimension().labels()[2]);
+
+        std::vector<std::string> stext(2);
+        sb.getDataArray(words.id()).getData(nix::DataType::String, stext.data(), {2}, {0});
+        CPPUNIT_ASSERT(text == stext);
+        CPPUNIT_ASSERT(sb.getDataArray(times.id()).getDimension(1).asRangeDimension().alias());
+
+        nix::Tag stag = sb.getTag(tag.id());
+        CPPUNIT_ASSERT(stag.extent() == tag.extent());
+        CPPUNIT_ASSERT(stag.hasReference(da.id()));
+        CPPUNIT_ASSERT_EQUAL(words.id(), stag.getFeature(feat.id()).data().id());
+        CPPUNIT_ASSERT_EQUAL(times.id(), sb.getMultiTag(mtag.id()).positions().id());
+        CPPUNIT_ASSERT(sb.getGroup(g.id()).hasTag(tag.id()));
+        saved.close();
+    }
+
+};
+
+#endif //NIX_TESTFILEMEM_HPP
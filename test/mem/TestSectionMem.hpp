@@ -0,0 +1,60 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_TESTSECTIONMEM_HPP
+#define NIX_TESTSECTIONMEM_HPP
+
+#include "BaseTestSection.hpp"
+
+class TestSectionMem : public BaseTestSection {
+
+    CPPUNIT_TEST_SUITE(TestSectionMem);
+
+    CPPUNIT_TEST(testValidate);
+    CPPUNIT_TEST(testId);
+    CPPUNIT_TEST(testType);
+    CPPUNIT_TEST(testName);
+    CPPUNIT_TEST(testDefinition);
+
+    CPPUNIT_TEST(testParent);
+    CPPUNIT_TEST(testRepository);
+    CPPUNIT_TEST(testLink);
+    CPPUNIT_TEST(testMapping);
+    CPPUNIT_TEST(testSectionAccess);
+    CPPUNIT_TEST(testFindSection);
+    CPPUNIT_TEST(testFindRelated);
+    CPPUNIT_TEST(testPropertyAccess);
+    CPPUNIT_TEST(testReferringData);
+    CPPUNIT_TEST(testReferringTags);
+    CPPUNIT_TEST(testReferringMultiTags);
+    CPPUNIT_TEST(testReferringSources);
+    CPPUNIT_TEST(testReferringBlocks);
+
+    CPPUNIT_TEST(testOperators);
+    CPPUNIT_TEST(testUpdatedAt);
+    CPPUNIT_TEST(testCreatedAt);
+
+    CPPUNIT_TEST_SUITE_END ();
+
+public:
+    void setUp() {
+        startup_time = time(NULL);
+        file = nix::File::open("test_section", nix::FileMode::Overwrite, "memory");
+
+        section = file.createSection("section", "metadata");
+        section_other = file.createSection("other_section", "metadata");
+        section_null  = nullptr;
+    }
+
+    void tearDown() {
+        file.close();
+    }
+};
+
+
+#endif //NIX_TESTSECTIONMEM_HPP